@@ -7,8 +7,16 @@
 #include "katana/analytics/jaccard/jaccard.h"
 #include "katana/analytics/k_core/k_core.h"
 #include "katana/analytics/k_truss/k_truss.h"
+#include "katana/analytics/matrix_completion/matrix_completion.h"
+#include "katana/analytics/max_flow/max_flow.h"
+#include "katana/analytics/minimum_spanning_forest/minimum_spanning_forest.h"
 #include "katana/analytics/pagerank/pagerank.h"
+#include "katana/analytics/partition/partition.h"
+#include "katana/analytics/reorder/reorder.h"
+#include "katana/analytics/shortest_path/shortest_path.h"
+#include "katana/analytics/similarity_join/similarity_join.h"
 #include "katana/analytics/sssp/sssp.h"
+#include "katana/analytics/strongly_connected_components/strongly_connected_components.h"
 #include "katana/analytics/triangle_count/triangle_count.h"
 
 #endif
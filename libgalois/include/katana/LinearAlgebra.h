@@ -0,0 +1,471 @@
+#ifndef KATANA_LIBGALOIS_KATANA_LINEARALGEBRA_H_
+#define KATANA_LIBGALOIS_KATANA_LINEARALGEBRA_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "katana/DynamicBitset.h"
+#include "katana/Galois.h"
+#include "katana/NUMAArray.h"
+#include "katana/ParallelSTL.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/PropertyGraph.h"
+#include "katana/Reduction.h"
+#include "katana/config.h"
+
+/// A GraphBLAS-like interface to write analytics as sparse matrix-vector
+/// products over a semiring. A GraphTopology is the sparse matrix A where
+/// A(i, j) is present if there is an edge i -> j. Its values come from a
+/// function of the edge ID, which makes it possible to use an edge property
+/// as the matrix values, or one for every edge (PatternValues).
+///
+/// Dense vectors are NUMAArrays with one entry per node where the semiring
+/// zero stands for an absent entry; sparse vectors list their present
+/// entries. The products come in two directions:
+///
+///   - MxV(A, x) = A x pulls, for every node i, from the out-edges of i.
+///   - VxM(x, A) = x^T A pushes, for every entry of x, along its out-edges.
+///
+/// As both are computed from the out-edges, a pull product over the transpose
+/// of a graph (see CreateTransposeGraphTopology) is equivalent to a push
+/// product over the graph. Pulling needs no synchronization and is best for
+/// dense vectors; pushing only touches the edges of the entries of x and is
+/// best for sparse vectors, e.g., BFS frontiers.
+///
+/// A semiring is a type with the following static members:
+///
+///   - value_type, the type of the vector entries;
+///   - Zero(), the identity of Add and the value of absent entries;
+///   - Add(a, b), an associative and commutative operator;
+///   - Multiply(a, x), the product of a matrix value a and a vector entry x.
+///
+/// A semiring may also define IsTerminal(a), which is true when Add(a, b) is
+/// a for every b, to stop a pull reduction early.
+namespace katana {
+
+/// Standard arithmetic, e.g., for PageRank, HITS or Katz centrality
+template <typename T>
+struct PlusTimesSemiring {
+  using value_type = T;
+
+  static constexpr T Zero() { return T{0}; }
+  static constexpr T Add(T a, T b) { return a + b; }
+  template <typename A>
+  static constexpr T Multiply(const A& a, T x) {
+    return static_cast<T>(a) * x;
+  }
+};
+
+/// The tropical semiring, e.g., for shortest paths
+template <typename T>
+struct MinPlusSemiring {
+  using value_type = T;
+
+  static constexpr T Zero() {
+    if constexpr (std::numeric_limits<T>::has_infinity) {
+      return std::numeric_limits<T>::infinity();
+    } else {
+      return std::numeric_limits<T>::max();
+    }
+  }
+  static constexpr T Add(T a, T b) { return std::min(a, b); }
+  template <typename A>
+  static constexpr T Multiply(const A& a, T x) {
+    // An absent entry must not wrap around to a small distance
+    return x == Zero() ? Zero() : static_cast<T>(a) + x;
+  }
+};
+
+/// The most reliable path semiring, e.g., for widest paths with
+/// probabilities as values
+template <typename T>
+struct MaxTimesSemiring {
+  using value_type = T;
+
+  static constexpr T Zero() { return T{0}; }
+  static constexpr T Add(T a, T b) { return std::max(a, b); }
+  template <typename A>
+  static constexpr T Multiply(const A& a, T x) {
+    return static_cast<T>(a) * x;
+  }
+};
+
+/// Ignores the matrix values and keeps the smallest vector entry, e.g., for
+/// label propagation or to pick BFS parents
+template <typename T>
+struct MinSecondSemiring {
+  using value_type = T;
+
+  static constexpr T Zero() { return std::numeric_limits<T>::max(); }
+  static constexpr T Add(T a, T b) { return std::min(a, b); }
+  template <typename A>
+  static constexpr T Multiply(const A&, T x) {
+    return x;
+  }
+  static constexpr bool IsTerminal(T a) {
+    return a == std::numeric_limits<T>::lowest();
+  }
+};
+
+/// Boolean reachability, e.g., for BFS
+struct LogicalOrAndSemiring {
+  using value_type = uint8_t;
+
+  static constexpr uint8_t Zero() { return 0; }
+  static constexpr uint8_t Add(uint8_t a, uint8_t b) { return a | b; }
+  template <typename A>
+  static constexpr uint8_t Multiply(const A& a, uint8_t x) {
+    return a != A{0} && x != 0;
+  }
+  static constexpr bool IsTerminal(uint8_t a) { return a != 0; }
+};
+
+/// Matrix values of one for every edge
+struct PatternValues {
+  constexpr uint8_t operator()(GraphTopology::Edge) const { return 1; }
+};
+
+/// Matrix values read from an array indexed by edge ID, e.g., the data of an
+/// edge property
+template <typename T>
+class ArrayValues {
+public:
+  explicit ArrayValues(const T* values) : values_(values) {}
+
+  T operator()(GraphTopology::Edge e) const { return values_[e]; }
+
+private:
+  const T* values_;
+};
+
+/// Restricts the entries of the output of a product that are written. An
+/// empty mask allows all entries.
+class Mask {
+public:
+  Mask() = default;
+
+  /// Allow the entries set in bits
+  static Mask Of(const DynamicBitset& bits) { return Mask(&bits, false); }
+
+  /// Allow the entries not set in bits, e.g., the unvisited nodes of a BFS
+  static Mask Complement(const DynamicBitset& bits) {
+    return Mask(&bits, true);
+  }
+
+  bool Allows(GraphTopology::Node n) const {
+    return bits_ == nullptr || bits_->test(n) != complement_;
+  }
+
+private:
+  Mask(const DynamicBitset* bits, bool complement)
+      : bits_(bits), complement_(complement) {}
+
+  const DynamicBitset* bits_{nullptr};
+  bool complement_{false};
+};
+
+/// The present entries of a vector, sorted by index
+template <typename T>
+struct SparseVector {
+  using Node = GraphTopology::Node;
+
+  std::vector<Node> indices;
+  std::vector<T> values;
+
+  size_t size() const { return indices.size(); }
+
+  bool empty() const { return indices.empty(); }
+
+  void clear() {
+    indices.clear();
+    values.clear();
+  }
+
+  void push_back(Node index, T value) {
+    indices.emplace_back(index);
+    values.emplace_back(value);
+  }
+};
+
+namespace internal {
+
+template <typename Semiring, typename = void>
+struct HasTerminal : std::false_type {};
+
+template <typename Semiring>
+struct HasTerminal<
+    Semiring,
+    std::void_t<decltype(Semiring::IsTerminal(Semiring::Zero()))>>
+    : std::true_type {};
+
+template <typename Semiring>
+struct SemiringAdd {
+  using T = typename Semiring::value_type;
+  T operator()(const T& a, const T& b) const { return Semiring::Add(a, b); }
+};
+
+template <typename Semiring>
+struct SemiringZero {
+  typename Semiring::value_type operator()() const { return Semiring::Zero(); }
+};
+
+/// Atomically replace *target by Add(*target, value) and skip the write when
+/// it would not change the value
+template <typename Semiring, typename T>
+void
+AtomicAdd(T* target, T value) {
+  T old_value;
+  __atomic_load(target, &old_value, __ATOMIC_RELAXED);
+  T new_value = Semiring::Add(old_value, value);
+  while (new_value != old_value &&
+         !__atomic_compare_exchange(
+             target, &old_value, &new_value, true, __ATOMIC_RELAXED,
+             __ATOMIC_RELAXED)) {
+    new_value = Semiring::Add(old_value, value);
+  }
+}
+
+/// Sort (index, value) pairs and add up the values with the same index into
+/// y
+template <typename Semiring>
+void
+CombineDuplicates(
+    std::vector<std::pair<GraphTopology::Node, typename Semiring::value_type>>*
+        pairs,
+    SparseVector<typename Semiring::value_type>* y) {
+  using T = typename Semiring::value_type;
+  using Pair = std::pair<GraphTopology::Node, T>;
+
+  katana::ParallelSTL::sort(
+      pairs->begin(), pairs->end(),
+      [](const Pair& a, const Pair& b) { return a.first < b.first; });
+
+  // Number the runs of equal indices
+  const size_t num_pairs = pairs->size();
+  NUMAArray<uint64_t> run_ids;
+  run_ids.allocateInterleaved(num_pairs + 1);
+  run_ids[0] = 0;
+  katana::do_all(
+      katana::iterate(size_t{0}, num_pairs),
+      [&](size_t i) {
+        run_ids[i + 1] =
+            i + 1 < num_pairs && (*pairs)[i + 1].first != (*pairs)[i].first;
+      },
+      katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      run_ids.begin(), run_ids.end(), run_ids.begin());
+
+  const size_t num_runs = num_pairs == 0 ? 0 : run_ids[num_pairs - 1] + 1;
+  y->indices.resize(num_runs);
+  y->values.resize(num_runs);
+  katana::do_all(
+      katana::iterate(size_t{0}, num_pairs),
+      [&](size_t i) {
+        if (i != 0 && (*pairs)[i - 1].first == (*pairs)[i].first) {
+          return;
+        }
+        T sum = (*pairs)[i].second;
+        size_t j = i + 1;
+        for (; j < num_pairs && (*pairs)[j].first == (*pairs)[i].first; ++j) {
+          sum = Semiring::Add(sum, (*pairs)[j].second);
+        }
+        y->indices[run_ids[i]] = (*pairs)[i].first;
+        y->values[run_ids[i]] = sum;
+      },
+      katana::steal(), katana::no_stats());
+}
+
+}  // namespace internal
+
+/// y = A x, pulling from the out-edges of every node allowed by mask. The
+/// entries of y not allowed by mask are left unchanged. x and y must not
+/// alias.
+template <
+    typename Semiring, typename MatrixValues = PatternValues,
+    typename T = typename Semiring::value_type>
+void
+MxV(const GraphTopology& A, const NUMAArray<T>& x, NUMAArray<T>* y,
+    Mask mask = Mask(), MatrixValues values = MatrixValues()) {
+  KATANA_LOG_DEBUG_ASSERT(x.size() == A.num_nodes());
+  KATANA_LOG_DEBUG_ASSERT(y->size() == A.num_nodes());
+
+  const GraphTopology::Edge* adj = A.adj_data();
+  const GraphTopology::Node* dests = A.dest_data();
+  katana::do_all(
+      katana::iterate(A),
+      [&](GraphTopology::Node n) {
+        if (!mask.Allows(n)) {
+          return;
+        }
+        T sum = Semiring::Zero();
+        const GraphTopology::Edge end = adj[n];
+        for (GraphTopology::Edge e = n == 0 ? 0 : adj[n - 1]; e < end; ++e) {
+          sum = Semiring::Add(sum, Semiring::Multiply(values(e), x[dests[e]]));
+          if constexpr (internal::HasTerminal<Semiring>::value) {
+            if (Semiring::IsTerminal(sum)) {
+              break;
+            }
+          }
+        }
+        (*y)[n] = sum;
+      },
+      katana::steal(), katana::no_stats(), katana::loopname("MxV"));
+}
+
+/// y = x^T A, pushing along the out-edges of the present entries of a dense
+/// x. The entries of y allowed by mask are overwritten and the others are
+/// left unchanged. x and y must not alias.
+template <
+    typename Semiring, typename MatrixValues = PatternValues,
+    typename T = typename Semiring::value_type>
+void
+VxM(const NUMAArray<T>& x, const GraphTopology& A, NUMAArray<T>* y,
+    Mask mask = Mask(), MatrixValues values = MatrixValues()) {
+  KATANA_LOG_DEBUG_ASSERT(x.size() == A.num_nodes());
+  KATANA_LOG_DEBUG_ASSERT(y->size() == A.num_nodes());
+
+  katana::do_all(
+      katana::iterate(A),
+      [&](GraphTopology::Node n) {
+        if (mask.Allows(n)) {
+          (*y)[n] = Semiring::Zero();
+        }
+      },
+      katana::no_stats());
+
+  katana::do_all(
+      katana::iterate(A),
+      [&](GraphTopology::Node src) {
+        const T value = x[src];
+        if (value == Semiring::Zero()) {
+          return;
+        }
+        for (GraphTopology::Edge e : A.edges(src)) {
+          GraphTopology::Node dest = A.edge_dest(e);
+          if (mask.Allows(dest)) {
+            internal::AtomicAdd<Semiring>(
+                &(*y)[dest], Semiring::Multiply(values(e), value));
+          }
+        }
+      },
+      katana::steal(), katana::no_stats(), katana::loopname("VxMDense"));
+}
+
+/// y = x^T A, pushing along the out-edges of a sparse x. y only holds the
+/// entries allowed by mask that are reached from x; its previous entries
+/// are discarded. x and y must not alias.
+///
+/// The work is proportional to the number of out-edges of the entries of x,
+/// not to the number of nodes.
+template <
+    typename Semiring, typename MatrixValues = PatternValues,
+    typename T = typename Semiring::value_type>
+void
+VxM(const SparseVector<T>& x, const GraphTopology& A, SparseVector<T>* y,
+    Mask mask = Mask(), MatrixValues values = MatrixValues()) {
+  using Pair = std::pair<GraphTopology::Node, T>;
+
+  katana::PerThreadStorage<std::vector<Pair>> products;
+  katana::do_all(
+      katana::iterate(size_t{0}, x.size()),
+      [&](size_t i) {
+        std::vector<Pair>& local = *products.getLocal();
+        const T value = x.values[i];
+        for (GraphTopology::Edge e : A.edges(x.indices[i])) {
+          GraphTopology::Node dest = A.edge_dest(e);
+          if (mask.Allows(dest)) {
+            local.emplace_back(dest, Semiring::Multiply(values(e), value));
+          }
+        }
+      },
+      katana::steal(), katana::no_stats(), katana::loopname("VxMSparse"));
+
+  std::vector<size_t> offsets(products.size() + 1, 0);
+  for (unsigned i = 0; i < products.size(); ++i) {
+    offsets[i + 1] = offsets[i] + products.getRemote(i)->size();
+  }
+  std::vector<Pair> pairs(offsets.back());
+  katana::on_each([&](unsigned tid, unsigned) {
+    std::vector<Pair>& local = *products.getLocal();
+    std::copy(local.begin(), local.end(), pairs.begin() + offsets[tid]);
+  });
+
+  internal::CombineDuplicates<Semiring>(&pairs, y);
+}
+
+/// Gather the entries of x that are not the semiring zero
+template <typename Semiring, typename T = typename Semiring::value_type>
+void
+ToSparse(const NUMAArray<T>& x, SparseVector<T>* y) {
+  // Shifted by one to make the prefix sum exclusive
+  NUMAArray<uint64_t> positions;
+  positions.allocateInterleaved(x.size() + 1);
+  positions[0] = 0;
+  katana::do_all(
+      katana::iterate(size_t{0}, x.size()),
+      [&](size_t i) { positions[i + 1] = x[i] != Semiring::Zero(); },
+      katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      positions.begin(), positions.end(), positions.begin());
+
+  y->indices.resize(positions[x.size()]);
+  y->values.resize(positions[x.size()]);
+  katana::do_all(
+      katana::iterate(size_t{0}, x.size()),
+      [&](size_t i) {
+        if (positions[i + 1] != positions[i]) {
+          y->indices[positions[i]] = i;
+          y->values[positions[i]] = x[i];
+        }
+      },
+      katana::no_stats());
+}
+
+/// Scatter the entries of x into y after setting all entries of y to the
+/// semiring zero
+template <typename Semiring, typename T = typename Semiring::value_type>
+void
+ToDense(const SparseVector<T>& x, NUMAArray<T>* y) {
+  katana::ParallelSTL::fill(y->begin(), y->end(), Semiring::Zero());
+  katana::do_all(
+      katana::iterate(size_t{0}, x.size()),
+      [&](size_t i) { (*y)[x.indices[i]] = x.values[i]; }, katana::no_stats());
+}
+
+/// The semiring sum of the entries of x allowed by mask
+template <typename Semiring, typename T = typename Semiring::value_type>
+T
+Reduce(const NUMAArray<T>& x, Mask mask = Mask()) {
+  auto sum = katana::make_reducible(
+      internal::SemiringAdd<Semiring>(), internal::SemiringZero<Semiring>());
+  katana::do_all(
+      katana::iterate(size_t{0}, x.size()),
+      [&](size_t i) {
+        if (mask.Allows(i)) {
+          sum.update(x[i]);
+        }
+      },
+      katana::no_stats(), katana::loopname("Reduce"));
+  return sum.reduce();
+}
+
+/// The semiring sum of the entries of x
+template <typename Semiring, typename T = typename Semiring::value_type>
+T
+Reduce(const SparseVector<T>& x) {
+  auto sum = katana::make_reducible(
+      internal::SemiringAdd<Semiring>(), internal::SemiringZero<Semiring>());
+  katana::do_all(
+      katana::iterate(size_t{0}, x.size()),
+      [&](size_t i) { sum.update(x.values[i]); }, katana::no_stats(),
+      katana::loopname("Reduce"));
+  return sum.reduce();
+}
+
+}  // namespace katana
+
+#endif
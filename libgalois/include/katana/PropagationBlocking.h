@@ -0,0 +1,175 @@
+#ifndef KATANA_LIBGALOIS_KATANA_PROPAGATIONBLOCKING_H_
+#define KATANA_LIBGALOIS_KATANA_PROPAGATIONBLOCKING_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "katana/Galois.h"
+#include "katana/NUMAArray.h"
+#include "katana/ParallelSTL.h"
+#include "katana/PropertyGraph.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// Propagation blocking for SpMV-like kernels over a GraphTopology: values
+/// sent along the out-edges of the nodes are first appended to bins, one per
+/// block of destination nodes, and then combined into the destinations one
+/// block at a time. Sized to fit in the last level cache, a block keeps the
+/// random accesses to destination values in cache, while the bins are only
+/// written and read sequentially.
+///
+/// The sources are split into contiguous chunks with about the same number
+/// of edges, and each chunk owns a fixed range of every bin. The layout only
+/// depends on the topology, so it is computed once, along with the
+/// destination of every bin entry, and each propagation just streams values
+/// into the bins in parallel without synchronization.
+///
+/// The topology must outlive this object and must not change.
+template <typename T>
+class PropagationBlocking {
+public:
+  using Node = GraphTopology::Node;
+  using Edge = GraphTopology::Edge;
+
+  /// The default number of destination nodes per block. The values of a
+  /// block of 4-byte values fill 1MB.
+  static constexpr uint32_t kDefaultBlockSize = 1U << 18;
+  /// The number of chunks of sources per thread
+  static constexpr uint32_t kChunksPerThread = 4;
+
+  explicit PropagationBlocking(
+      const GraphTopology& topology, uint32_t block_size = kDefaultBlockSize)
+      : topology_(topology),
+        block_size_(std::max<uint32_t>(block_size, 1)),
+        num_blocks_((topology.num_nodes() + block_size_ - 1) / block_size_),
+        num_chunks_(katana::getActiveThreads() * kChunksPerThread) {
+    SplitSources();
+    LayOutBins();
+  }
+
+  uint32_t block_size() const { return block_size_; }
+
+  uint64_t num_blocks() const { return num_blocks_; }
+
+  /// Call combine(dest, source_value(src)) for every edge src -> dest.
+  /// source_value is called once per node with outgoing edges. All calls to
+  /// combine for the destinations of one block are made by the same thread,
+  /// so combine needs no synchronization to update per-node state.
+  template <typename SourceValue, typename Combine>
+  void Propagate(SourceValue source_value, Combine combine) {
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_chunks_),
+        [&](uint64_t chunk) {
+          uint64_t* cursor = &cursors_[chunk * num_blocks_];
+          for (uint64_t b = 0; b < num_blocks_; ++b) {
+            cursor[b] = bin_begin_[b * num_chunks_ + chunk];
+          }
+          for (Node src = chunk_begin_[chunk]; src < chunk_begin_[chunk + 1];
+               ++src) {
+            auto edges = topology_.edges(src);
+            if (edges.empty()) {
+              continue;
+            }
+            T value = source_value(src);
+            for (Edge e : edges) {
+              bins_[cursor[topology_.edge_dest(e) / block_size_]++] = value;
+            }
+          }
+        },
+        katana::no_stats(), katana::loopname("PropagationBlockingBin"));
+
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_blocks_),
+        [&](uint64_t b) {
+          const uint64_t end = bin_begin_[(b + 1) * num_chunks_];
+          for (uint64_t i = bin_begin_[b * num_chunks_]; i < end; ++i) {
+            combine(bin_dests_[i], bins_[i]);
+          }
+        },
+        katana::steal(), katana::no_stats(),
+        katana::loopname("PropagationBlockingAccumulate"));
+  }
+
+private:
+  void SplitSources() {
+    const uint64_t num_nodes = topology_.num_nodes();
+    const uint64_t num_edges = topology_.num_edges();
+    chunk_begin_.allocateInterleaved(num_chunks_ + 1);
+    const Edge* adj = topology_.adj_data();
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_chunks_ + 1),
+        [&](uint64_t chunk) {
+          // The first node whose edges end after the first edge of the chunk
+          Edge first_edge = num_edges * chunk / num_chunks_;
+          chunk_begin_[chunk] =
+              chunk == num_chunks_
+                  ? num_nodes
+                  : std::upper_bound(adj, adj + num_nodes, first_edge) - adj;
+        },
+        katana::no_stats());
+  }
+
+  /// Bin b holds the values for the destinations in block b, grouped by the
+  /// chunk of their sources: bin_begin_[b * num_chunks_ + c] is where the
+  /// values sent from chunk c start.
+  void LayOutBins() {
+    cursors_.allocateInterleaved(num_chunks_ * num_blocks_);
+    bin_begin_.allocateInterleaved(num_blocks_ * num_chunks_ + 1);
+    katana::ParallelSTL::fill(bin_begin_.begin(), bin_begin_.end(), 0);
+
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_chunks_),
+        [&](uint64_t chunk) {
+          for (Node src = chunk_begin_[chunk]; src < chunk_begin_[chunk + 1];
+               ++src) {
+            for (Edge e : topology_.edges(src)) {
+              uint64_t b = topology_.edge_dest(e) / block_size_;
+              // Shifted by one to make the prefix sum exclusive
+              ++bin_begin_[b * num_chunks_ + chunk + 1];
+            }
+          }
+        },
+        katana::no_stats(), katana::loopname("PropagationBlockingCount"));
+    katana::ParallelSTL::partial_sum(
+        bin_begin_.begin(), bin_begin_.end(), bin_begin_.begin());
+
+    bins_.allocateInterleaved(topology_.num_edges());
+    bin_dests_.allocateInterleaved(topology_.num_edges());
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_chunks_),
+        [&](uint64_t chunk) {
+          uint64_t* cursor = &cursors_[chunk * num_blocks_];
+          for (uint64_t b = 0; b < num_blocks_; ++b) {
+            cursor[b] = bin_begin_[b * num_chunks_ + chunk];
+          }
+          for (Node src = chunk_begin_[chunk]; src < chunk_begin_[chunk + 1];
+               ++src) {
+            for (Edge e : topology_.edges(src)) {
+              Node dest = topology_.edge_dest(e);
+              bin_dests_[cursor[dest / block_size_]++] = dest;
+            }
+          }
+        },
+        katana::no_stats(), katana::loopname("PropagationBlockingLayOut"));
+  }
+
+  const GraphTopology& topology_;
+  uint32_t block_size_;
+  uint64_t num_blocks_;
+  uint64_t num_chunks_;
+
+  /// The first source node of each chunk, followed by the number of nodes
+  NUMAArray<Node> chunk_begin_;
+  NUMAArray<uint64_t> bin_begin_;
+  /// The next position to write to in each bin, per chunk
+  NUMAArray<uint64_t> cursors_;
+  NUMAArray<Node> bin_dests_;
+  NUMAArray<T> bins_;
+};
+
+}  // namespace katana
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef KATANA_LIBGALOIS_KATANA_PROPERTYEXPORT_H_
+#define KATANA_LIBGALOIS_KATANA_PROPERTYEXPORT_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "katana/PropertyGraph.h"
+#include "katana/Result.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// Options controlling ExportNodeProperties and ExportEdgeProperties
+struct KATANA_EXPORT ExportOptions {
+  enum class Format {
+    kParquet,
+    /// Uncompressed Arrow IPC file format (Feather V2)
+    kArrowIPC,
+  };
+
+  Format format{Format::kParquet};
+
+  /// Maximum number of rows in each output file. The rows of the graph are
+  /// split into chunks of this size and the chunks are encoded and written
+  /// in parallel.
+  uint64_t rows_per_file{1ULL << 22};
+
+  /// Maximum number of chunks being encoded or written at once; 0 means the
+  /// number of active threads. The KATANA_TSUBA_WRITE_* limits also apply.
+  uint32_t max_concurrent_files{0};
+
+  /// If true, prefix the exported properties with the ids of the nodes as
+  /// they were at import time: an "id" column for node exports and "source"
+  /// and "destination" columns for edge exports. When the graph does not
+  /// carry import ids, local node ids are written instead.
+  bool include_ids{true};
+
+  static ExportOptions Defaults() { return ExportOptions{}; }
+};
+
+/// Write a set of node properties of pg out of the graph, without writing
+/// the rest of the graph or creating a new RDG version.
+///
+/// Output is split into files named `<uri_prefix>.<i>`, where i is the six
+/// digit, zero-padded index of the chunk of rows in the file. Columns are
+/// sliced from the property arrays without copying; fixed-width columns are
+/// handed to the encoder as is.
+///
+/// \param pg graph holding the properties
+/// \param properties names of the node properties to write, in column order
+/// \param uri_prefix storage location prefix of the output files
+/// \param opts output format and chunking
+KATANA_EXPORT Result<void> ExportNodeProperties(
+    const PropertyGraph& pg, const std::vector<std::string>& properties,
+    const std::string& uri_prefix,
+    const ExportOptions& opts = ExportOptions::Defaults());
+
+/// Write a set of edge properties of pg out of the graph. See
+/// ExportNodeProperties.
+KATANA_EXPORT Result<void> ExportEdgeProperties(
+    const PropertyGraph& pg, const std::vector<std::string>& properties,
+    const std::string& uri_prefix,
+    const ExportOptions& opts = ExportOptions::Defaults());
+
+}  // namespace katana
+
+#endif
@@ -667,8 +667,34 @@ public:
     return rdg_.MarkEdgePropertiesPersistent(persist_edge_props);
   }
 
+  /// SetNodePropertyFormat chooses the storage format of a node property
+  /// the next time this graph is written. Properties stored as
+  /// tsuba::PropertyFormat::kArrowIPC are memory mapped rather than decoded
+  /// when the graph is loaded, at the cost of more space on storage.
+  Result<void> SetNodePropertyFormat(
+      const std::string& name, tsuba::PropertyFormat format) {
+    return rdg_.SetNodePropertyFormat(name, format);
+  }
+
+  Result<void> SetEdgePropertyFormat(
+      const std::string& name, tsuba::PropertyFormat format) {
+    return rdg_.SetEdgePropertyFormat(name, format);
+  }
+
   const GraphTopology& topology() const noexcept { return topology_; }
 
+  /// Replace the topology of this graph along with all of its node and edge
+  /// properties, which must have one row per node and edge of the new
+  /// topology. The new topology is written out by the next Commit or Write.
+  ///
+  /// Fails, without changing the graph, if any property has been unloaded.
+  /// Properties that keep their name keep their persistence and storage
+  /// format. Any views of this graph are invalidated.
+  Result<void> ReplaceTopology(
+      GraphTopology&& topology,
+      const std::shared_ptr<arrow::Table>& node_props,
+      const std::shared_ptr<arrow::Table>& edge_props);
+
   /// Add Node properties that do not exist in the current graph
   Result<void> AddNodeProperties(const std::shared_ptr<arrow::Table>& props);
   /// Add Edge properties that do not exist in the current graph
@@ -694,6 +720,11 @@ public:
   Result<void> UnloadEdgeProperty(int i);
   Result<void> UnloadEdgeProperty(const std::string& prop_name);
 
+  /// Fail if any node or edge property has been unloaded
+  Result<void> CheckPropertiesLoaded() const {
+    return rdg_.CheckPropertiesLoaded();
+  }
+
   /// Remove all node properties
   void DropNodeProperties() { rdg_.DropNodeProperties(); }
   /// Remove all edge properties
@@ -0,0 +1,191 @@
+#ifndef KATANA_LIBGALOIS_KATANA_PROPERTYGRAPHDELTA_H_
+#define KATANA_LIBGALOIS_KATANA_PROPERTYGRAPHDELTA_H_
+
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "katana/DynamicBitset.h"
+#include "katana/NUMAArray.h"
+#include "katana/PropertyGraph.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// A PropertyGraphDelta buffers batches of node and edge insertions and
+/// deletions against a PropertyGraph and merges them into a new CSR topology
+/// for it.
+///
+/// Inserted nodes and edges are appended to buffers and deleted ones are
+/// marked with tombstones; the graph itself is not modified until Merge.
+/// Until then, edges() and property access on the graph see the topology
+/// and properties as of the last merge, so readers always see a consistent
+/// graph. Merge groups the buffered edges by source node, drops everything
+/// that has a tombstone and builds the new topology and property columns in
+/// parallel. Commit merges and then commits the graph, so the result is
+/// persisted like any other change to the graph.
+///
+/// The graph must outlive the delta and must not be changed by other means
+/// while updates are buffered.
+class KATANA_EXPORT PropertyGraphDelta {
+public:
+  using Node = GraphTopology::Node;
+  using Edge = GraphTopology::Edge;
+
+  /// The new ID reported by Merge for removed nodes
+  static constexpr Node kRemovedNode = std::numeric_limits<Node>::max();
+
+  explicit PropertyGraphDelta(PropertyGraph* pg);
+
+  /// The number of node IDs in use: the nodes of the graph followed by the
+  /// inserted nodes, including removed ones.
+  uint64_t num_nodes() const { return pg_->num_nodes() + num_inserted_nodes_; }
+
+  /// \returns true if any update is buffered
+  bool HasUpdates() const;
+
+  /// Buffer the insertion of num_new_nodes nodes. The new nodes get
+  /// consecutive IDs starting at the returned ID, and may be used as edge
+  /// endpoints right away.
+  ///
+  /// \param props the properties of the new nodes, one row per node. Every
+  ///     column must be an existing node property of the same type; missing
+  ///     properties are null for the new nodes. May be null.
+  Result<Node> AddNodes(
+      uint64_t num_new_nodes,
+      const std::shared_ptr<arrow::Table>& props = nullptr);
+
+  /// Buffer the insertion of the edges srcs[i] -> dsts[i].
+  ///
+  /// \param props the properties of the new edges, one row per edge, with
+  ///     the same requirements as for AddNodes. May be null.
+  Result<void> AddEdges(
+      const std::vector<Node>& srcs, const std::vector<Node>& dsts,
+      const std::shared_ptr<arrow::Table>& props = nullptr);
+
+  /// Remove the given edges of the graph. Edges inserted since the last merge
+  /// have no ID yet and cannot be removed this way.
+  Result<void> RemoveEdges(const std::vector<Edge>& edges);
+
+  /// Remove every edge srcs[i] -> dsts[i] of the graph. Like RemoveEdges,
+  /// this does not remove edges inserted since the last merge, so an edge
+  /// that is both removed and inserted before a merge ends up in the graph.
+  Result<void> RemoveEdges(
+      const std::vector<Node>& srcs, const std::vector<Node>& dsts);
+
+  /// Remove the given nodes, which may be inserted nodes, along with all of
+  /// their incoming and outgoing edges.
+  Result<void> RemoveNodes(const std::vector<Node>& nodes);
+
+  /// \returns true if node has been removed since the last merge
+  bool IsNodeRemoved(Node node) const {
+    return node < removed_nodes_.size() && removed_nodes_.test(node);
+  }
+
+  /// \returns true if the edge of the graph or its destination has been
+  /// removed since the last merge. The edge is also dropped by the merge if
+  /// its source has been removed.
+  bool IsEdgeRemoved(Edge edge) const {
+    return removed_edges_.test(edge) ||
+           IsNodeRemoved(pg_->topology().edge_dest(edge));
+  }
+
+  /// Call fn(dst) for each outgoing edge of node that the next merge keeps:
+  /// the edges of the graph that are not removed, followed by the edges
+  /// inserted since the last merge in insertion order. Nothing is visited
+  /// for removed nodes.
+  ///
+  /// The first call after AddEdges groups the inserted edges by source, which
+  /// takes time linear in the number of node IDs and inserted edges; later
+  /// calls only visit the edges of node. Calls may be made concurrently, but
+  /// not concurrently with updates.
+  template <typename F>
+  void ForEachOutNeighbor(Node node, F fn) const {
+    if (IsNodeRemoved(node)) {
+      return;
+    }
+    const GraphTopology& topology = pg_->topology();
+    if (node < topology.num_nodes()) {
+      for (Edge e : topology.edges(node)) {
+        if (!IsEdgeRemoved(e)) {
+          fn(topology.edge_dest(e));
+        }
+      }
+    }
+    if (!inserted_grouped_.load(std::memory_order_acquire)) {
+      GroupInsertedEdges();
+    }
+    // Nodes added after the grouping have no inserted edges
+    if (node + 1 >= inserted_offsets_.size()) {
+      return;
+    }
+    for (uint64_t i = inserted_offsets_[node]; i < inserted_offsets_[node + 1];
+         ++i) {
+      Node dst = inserted_dsts_[inserted_order_[i]];
+      if (!IsNodeRemoved(dst)) {
+        fn(dst);
+      }
+    }
+  }
+
+  /// Apply all buffered updates to the graph and clear them. Node IDs are
+  /// compacted so that the graph has no holes where nodes were removed, and
+  /// the outgoing edges of a node keep their order, followed by its inserted
+  /// edges in insertion order.
+  ///
+  /// Fails, leaving the updates buffered, if a property of the graph has been
+  /// unloaded.
+  ///
+  /// \returns the new ID of each of the num_nodes() node IDs before the
+  ///     merge, or kRemovedNode for removed nodes
+  Result<NUMAArray<Node>> Merge();
+
+  /// Merge and then commit the graph.
+  ///
+  /// \see PropertyGraph::Commit
+  Result<NUMAArray<Node>> Commit(const std::string& command_line);
+
+private:
+  struct Batch {
+    uint64_t num_rows;
+    std::shared_ptr<arrow::Table> props;
+  };
+
+  Result<void> CheckNodes(const std::vector<Node>& nodes) const;
+
+  /// Fill inserted_order_ and inserted_offsets_ unless they are up to date.
+  void GroupInsertedEdges() const;
+
+  PropertyGraph* pg_;
+
+  uint64_t num_inserted_nodes_{0};
+  std::vector<Batch> node_batches_;
+
+  std::vector<Node> inserted_srcs_;
+  std::vector<Node> inserted_dsts_;
+  std::vector<Batch> edge_batches_;
+
+  /// The indices of the inserted edges grouped by source, keeping insertion
+  /// order within a source: the inserted edges of node n are
+  /// inserted_order_[inserted_offsets_[n]] up to
+  /// inserted_order_[inserted_offsets_[n + 1]]. Built on demand by
+  /// GroupInsertedEdges and invalidated by AddEdges.
+  mutable std::vector<uint64_t> inserted_order_;
+  mutable std::vector<uint64_t> inserted_offsets_;
+  mutable std::atomic<bool> inserted_grouped_{false};
+  mutable std::mutex group_mutex_;
+
+  /// Tombstones for the nodes of the graph and inserted nodes
+  DynamicBitset removed_nodes_;
+  /// Tombstones for the edges of the graph
+  DynamicBitset removed_edges_;
+};
+
+}  // namespace katana
+
+#endif
@@ -20,9 +20,12 @@
 #ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_CLUSTERINGIMPLEMENTATIONBASE_H_
 #define KATANA_LIBGALOIS_KATANA_ANALYTICS_CLUSTERINGIMPLEMENTATIONBASE_H_
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <random>
+#include <vector>
 
 #include "katana/AtomicHelpers.h"
 #include "katana/Galois.h"
@@ -48,6 +51,96 @@ using DegreeWeight = katana::PODProperty<EdgeWeightType>;
 template <typename EdgeWeightType>
 using EdgeWeight = katana::PODProperty<EdgeWeightType>;
 
+/// Accumulates edge weights by neighboring community while scanning the
+/// edges of a node or a set of nodes.
+///
+/// This is an open addressing hash table with linear probing whose entries
+/// are also kept in a dense array in insertion order. Clear only touches the
+/// slots used since the last Clear, so one accumulator can be kept per thread
+/// and reused for every node without reallocating.
+template <typename WeightType>
+class NeighborCommunityAccumulator {
+public:
+  struct Entry {
+    uint64_t community;
+    WeightType weight;
+  };
+
+  /// Remove all entries; the table keeps its capacity
+  void Clear() {
+    for (uint32_t slot : used_slots_) {
+      slots_[slot] = kEmpty;
+    }
+    used_slots_.clear();
+    entries_.clear();
+  }
+
+  /// Add weight to the total of community, inserting it if needed
+  void Add(uint64_t community, WeightType weight) {
+    Find(community).weight += weight;
+  }
+
+  /// Insert community with a weight of zero if it is not present
+  void Touch(uint64_t community) { Find(community); }
+
+  /// Entries in the order they were first added
+  const std::vector<Entry>& entries() const { return entries_; }
+  size_t size() const { return entries_.size(); }
+  bool empty() const { return entries_.empty(); }
+
+private:
+  static constexpr uint32_t kEmpty = std::numeric_limits<uint32_t>::max();
+  static constexpr size_t kMinCapacity = 16;
+
+  uint64_t Hash(uint64_t community) const {
+    // Fibonacci hashing spreads consecutive community ids across the table
+    return (community * UINT64_C(0x9E3779B97F4A7C15)) >> shift_;
+  }
+
+  Entry& Find(uint64_t community) {
+    // Keep the load factor at most 1/2
+    if (2 * (entries_.size() + 1) > slots_.size()) {
+      Grow();
+    }
+    uint64_t slot = Hash(community);
+    for (;; slot = (slot + 1) & mask_) {
+      uint32_t idx = slots_[slot];
+      if (idx == kEmpty) {
+        break;
+      }
+      if (entries_[idx].community == community) {
+        return entries_[idx];
+      }
+    }
+    slots_[slot] = entries_.size();
+    used_slots_.push_back(slot);
+    entries_.push_back(Entry{community, WeightType{0}});
+    return entries_.back();
+  }
+
+  void Grow() {
+    size_t capacity = std::max(kMinCapacity, 2 * slots_.size());
+    slots_.assign(capacity, kEmpty);
+    mask_ = capacity - 1;
+    shift_ = 64 - __builtin_ctzll(capacity);
+    used_slots_.clear();
+    for (uint32_t idx = 0; idx < entries_.size(); ++idx) {
+      uint64_t slot = Hash(entries_[idx].community);
+      while (slots_[slot] != kEmpty) {
+        slot = (slot + 1) & mask_;
+      }
+      slots_[slot] = idx;
+      used_slots_.push_back(slot);
+    }
+  }
+
+  std::vector<uint32_t> slots_;
+  std::vector<uint32_t> used_slots_;
+  std::vector<Entry> entries_;
+  uint64_t mask_{0};
+  uint32_t shift_{64};
+};
+
 template <typename _Graph, typename _EdgeType, typename _CommunityType>
 struct ClusteringImplementationBase {
   using Graph = _Graph;
@@ -60,28 +153,26 @@ struct ClusteringImplementationBase {
 
   using CommunityArray = katana::NUMAArray<CommunityType>;
 
+  using NeighborAccumulator = NeighborCommunityAccumulator<EdgeTy>;
+
   /**
    * Algorithm to find the best cluster for the node
    * to move to among its neighbors in the graph and moves.
    *
-   * It updates the mapping of neighboring nodes clusters
-   * in cluster_local_map, total unique cluster edge weights
-   * in counter as well as total weight of self edges in self_loop_wt.
+   * It accumulates the total edge weight from n to each neighboring
+   * cluster in neighbors, whose first entry is n's current cluster,
+   * as well as total weight of self edges in self_loop_wt.
+   * neighbors is cleared first.
    */
   template <typename EdgeWeightType>
   void FindNeighboringClusters(
-      const Graph& graph, GNode& n,
-      std::map<uint64_t, uint64_t>& cluster_local_map,
-      std::vector<EdgeTy>& counter, EdgeTy& self_loop_wt) {
-    uint64_t num_unique_clusters = 0;
+      const Graph& graph, GNode& n, NeighborAccumulator* neighbors,
+      EdgeTy& self_loop_wt) {
+    neighbors->Clear();
 
     // Add the node's current cluster to be considered
     // for movement as well
-    cluster_local_map[graph.template GetData<CurrentCommunityId>(n)] =
-        0;                 // Add n's current cluster
-    counter.push_back(0);  // Initialize the counter to zero (no edges incident
-                           // yet)
-    num_unique_clusters++;
+    neighbors->Touch(graph.template GetData<CurrentCommunityId>(n));
 
     // Assuming we have grabbed lock on all the neighbors
     for (auto ii = graph.edge_begin(n); ii != graph.edge_end(n); ++ii) {
@@ -91,17 +182,8 @@ struct ClusteringImplementationBase {
       if (*dst == n) {
         self_loop_wt += edge_wt;  // Self loop weights is recorded
       }
-      auto stored_already =
-          cluster_local_map.find(graph.template GetData<CurrentCommunityId>(
-              dst));  // Check if it already exists
-      if (stored_already != cluster_local_map.end()) {
-        counter[stored_already->second] += edge_wt;
-      } else {
-        cluster_local_map[graph.template GetData<CurrentCommunityId>(dst)] =
-            num_unique_clusters;
-        counter.push_back(edge_wt);
-        num_unique_clusters++;
-      }
+      neighbors->Add(
+          graph.template GetData<CurrentCommunityId>(dst), edge_wt);
     }  // End edge loop
     return;
   }
@@ -207,44 +289,40 @@ struct ClusteringImplementationBase {
    * without swapping the cluster assignment.
    */
   uint64_t MaxModularityWithoutSwaps(
-      std::map<uint64_t, uint64_t>& cluster_local_map,
-      std::vector<EdgeTy>& counter, uint64_t self_loop_wt,
+      const NeighborAccumulator& neighbors, uint64_t self_loop_wt,
       CommunityArray& c_info, EdgeTy degree_wt, uint64_t sc, double constant) {
     uint64_t max_index = sc;  // Assign the intial value as self community
     double cur_gain = 0;
     double max_gain = 0;
-    double eix = counter[0] - self_loop_wt;
+    // The first entry is always the current cluster
+    double eix = neighbors.entries()[0].weight - self_loop_wt;
     double ax = c_info[sc].degree_wt - degree_wt;
     double eiy = 0;
     double ay = 0;
 
-    auto stored_already = cluster_local_map.begin();
-    do {
-      if (sc != stored_already->first) {
-        ay = c_info[stored_already->first].degree_wt;  // Degree wt of cluster y
-
-        if (ay < (ax + degree_wt)) {
-          stored_already++;
-          continue;
-        } else if (ay == (ax + degree_wt) && stored_already->first > sc) {
-          stored_already++;
-          continue;
-        }
+    for (const auto& [community, weight] : neighbors.entries()) {
+      if (sc == community) {
+        continue;
+      }
+      ay = c_info[community].degree_wt;  // Degree wt of cluster y
 
-        eiy = counter[stored_already
-                          ->second];  // Total edges incident on cluster y
-        cur_gain = 2 * constant * (eiy - eix) +
-                   2 * degree_wt * ((ax - ay) * constant * constant);
+      if (ay < (ax + degree_wt)) {
+        continue;
+      } else if (ay == (ax + degree_wt) && community > sc) {
+        continue;
+      }
 
-        if ((cur_gain > max_gain) ||
-            ((cur_gain == max_gain) && (cur_gain != 0) &&
-             (stored_already->first < max_index))) {
-          max_gain = cur_gain;
-          max_index = stored_already->first;
-        }
+      eiy = weight;  // Total edges incident on cluster y
+      cur_gain = 2 * constant * (eiy - eix) +
+                 2 * degree_wt * ((ax - ay) * constant * constant);
+
+      if ((cur_gain > max_gain) ||
+          ((cur_gain == max_gain) && (cur_gain != 0) &&
+           (community < max_index))) {
+        max_gain = cur_gain;
+        max_index = community;
       }
-      stored_already++;  // Explore next cluster
-    } while (stored_already != cluster_local_map.end());
+    }
 
     if ((c_info[max_index].size == 1 && c_info[sc].size == 1 &&
          max_index > sc)) {
@@ -401,7 +479,13 @@ struct ClusteringImplementationBase {
  * to fill the holes in the cluster id assignments.
  */
   uint64_t RenumberClustersContiguously(Graph* graph) {
-    std::map<uint64_t, uint64_t> cluster_local_map;
+    // Cluster ids are node ids, so a dense array can map them
+    katana::NUMAArray<uint64_t> new_id;
+    new_id.allocateBlocked(graph->num_nodes());
+    katana::do_all(
+        katana::iterate(*graph), [&](GNode n) { new_id[n] = UNASSIGNED; },
+        katana::no_stats());
+
     uint64_t num_unique_clusters = 0;
 
     for (GNode n = 0; n < graph->num_nodes(); ++n) {
@@ -409,14 +493,11 @@ struct ClusteringImplementationBase {
           graph->template GetData<CurrentCommunityId>(n);
       if (n_data_curr_comm_id != UNASSIGNED) {
         KATANA_LOG_DEBUG_ASSERT(n_data_curr_comm_id < graph->num_nodes());
-        auto stored_already = cluster_local_map.find(n_data_curr_comm_id);
-        if (stored_already != cluster_local_map.end()) {
-          n_data_curr_comm_id = stored_already->second;
-        } else {
-          cluster_local_map[n_data_curr_comm_id] = num_unique_clusters;
-          n_data_curr_comm_id = num_unique_clusters;
-          num_unique_clusters++;
+        uint64_t& id = new_id[n_data_curr_comm_id];
+        if (id == UNASSIGNED) {
+          id = num_unique_clusters++;
         }
+        n_data_curr_comm_id = id;
       }
     }
     return num_unique_clusters;
@@ -525,11 +606,14 @@ struct ClusteringImplementationBase {
     std::vector<katana::gstl::Vector<EdgeTy>> edges_data(num_unique_clusters);
 
     /* First pass to find the number of edges */
+    using Entry = typename NeighborAccumulator::Entry;
+    katana::PerThreadStorage<NeighborAccumulator> accumulators;
+    katana::PerThreadStorage<std::vector<Entry>> sorted_entries;
     katana::do_all(
         katana::iterate(uint64_t{0}, num_unique_clusters),
         [&](uint64_t c) {
-          katana::gstl::Map<uint64_t, uint64_t> cluster_local_map;
-          uint64_t num_unique_clusters = 0;
+          NeighborAccumulator& neighbors = *accumulators.getLocal();
+          neighbors.Clear();
           for (auto node : cluster_bags[c]) {
             KATANA_LOG_DEBUG_ASSERT(
                 graph.template GetData<CurrentCommunityId>(node) ==
@@ -541,20 +625,25 @@ struct ClusteringImplementationBase {
               auto dst_data_curr_comm_id =
                   graph.template GetData<CurrentCommunityId>(dst);
               KATANA_LOG_DEBUG_ASSERT(dst_data_curr_comm_id != UNASSIGNED);
-              auto stored_already = cluster_local_map.find(
-                  dst_data_curr_comm_id);  // Check if it already exists
-              if (stored_already != cluster_local_map.end()) {
-                edges_data[c][stored_already->second] +=
-                    graph.template GetEdgeData<EdgeWeight<EdgeWeightType>>(ii);
-              } else {
-                cluster_local_map[dst_data_curr_comm_id] = num_unique_clusters;
-                edges_id[c].push_back(dst_data_curr_comm_id);
-                edges_data[c].push_back(
-                    graph.template GetEdgeData<EdgeWeight<EdgeWeightType>>(ii));
-                num_unique_clusters++;
-              }
+              neighbors.Add(
+                  dst_data_curr_comm_id,
+                  graph.template GetEdgeData<EdgeWeight<EdgeWeightType>>(ii));
             }  // End edge loop
           }
+          // Keep the edges of each super node sorted by destination
+          std::vector<Entry>& sorted = *sorted_entries.getLocal();
+          sorted.assign(neighbors.entries().begin(), neighbors.entries().end());
+          std::sort(
+              sorted.begin(), sorted.end(),
+              [](const Entry& a, const Entry& b) {
+                return a.community < b.community;
+              });
+          edges_id[c].reserve(sorted.size());
+          edges_data[c].reserve(sorted.size());
+          for (const auto& [community, weight] : sorted) {
+            edges_id[c].push_back(community);
+            edges_data[c].push_back(weight);
+          }
         },
         katana::steal(), katana::loopname("BuildGraph: Find edges"));
 
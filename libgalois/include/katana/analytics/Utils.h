@@ -6,6 +6,7 @@
 #include <utility>
 
 #include "katana/ErrorCode.h"
+#include "katana/Loops.h"
 #include "katana/Properties.h"
 #include "katana/PropertyGraph.h"
 #include "katana/Result.h"
@@ -72,6 +73,64 @@ ConstructEdgeProperties(
   return pg->AddEdgeProperties(res_table.value());
 }
 
+/// Replace the nulls in the node property named name, such as those of nodes
+/// inserted after the property was computed, with fill(node). The property is
+/// only rewritten if it has nulls.
+template <typename T, typename FillFn>
+inline katana::Result<void>
+FillNullNodeProperty(PropertyGraph* pg, const std::string& name, FillFn fill) {
+  auto array = KATANA_CHECKED(pg->GetNodePropertyTyped<T>(name));
+  if (array->null_count() == 0) {
+    return katana::ResultSuccess();
+  }
+
+  std::shared_ptr<arrow::Buffer> buffer =
+      KATANA_CHECKED(arrow::AllocateBuffer(array->length() * sizeof(T)));
+  T* values = reinterpret_cast<T*>(buffer->mutable_data());
+  katana::do_all(
+      katana::iterate(int64_t{0}, array->length()),
+      [&](int64_t n) {
+        values[n] = array->IsNull(n) ? fill(n) : array->Value(n);
+      },
+      katana::no_stats());
+
+  auto filled = std::make_shared<typename arrow::CTypeTraits<T>::ArrayType>(
+      array->length(), buffer);
+  return pg->UpsertNodeProperties(arrow::Table::Make(
+      arrow::schema({arrow::field(name, filled->type())}), {filled}));
+}
+
+/// Call fn(e, value) for every edge e, in parallel, with the value of the
+/// edge property named name, which must have type T. Unlike
+/// GetEdgePropertyTyped, this reads every chunk of the property.
+template <typename T, typename Fn>
+inline katana::Result<void>
+ForEachEdgePropertyValue(
+    const PropertyGraph& pg, const std::string& name, Fn fn) {
+  using ArrayType = typename arrow::CTypeTraits<T>::ArrayType;
+  auto property = pg.GetEdgeProperty(name);
+  if (!property) {
+    return KATANA_ERROR(
+        ErrorCode::PropertyNotFound, "no edge property named {}", name);
+  }
+  if (!property->type()->Equals(arrow::CTypeTraits<T>::type_singleton())) {
+    return KATANA_ERROR(
+        ErrorCode::TypeError, "edge property {} has type {}", name,
+        property->type()->ToString());
+  }
+
+  uint64_t offset = 0;
+  for (const auto& chunk : property->chunks()) {
+    auto array = std::static_pointer_cast<ArrayType>(chunk);
+    katana::do_all(
+        katana::iterate(int64_t{0}, array->length()),
+        [&](int64_t i) { fn(offset + i, array->Value(i)); },
+        katana::no_stats());
+    offset += array->length();
+  }
+  return katana::ResultSuccess();
+}
+
 class KATANA_EXPORT TemporaryPropertyGuard {
   static thread_local int temporary_property_counter;
 
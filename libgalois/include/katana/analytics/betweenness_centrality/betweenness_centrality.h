@@ -18,16 +18,27 @@ public:
   enum Algorithm {
     kLevel,
     kOuter,
+    kAdaptiveSampling,
     // TODO(gill): Reinstate async and auto once we have bidirectional graphs.
     // kAsynchronous,
     // kAutomatic,
   };
 
+  static constexpr double kDefaultEpsilon = 0.01;
+  static constexpr double kDefaultDelta = 0.1;
+
 private:
   Algorithm algorithm_;
+  float epsilon_;
+  float delta_;
 
-  BetweennessCentralityPlan(Architecture architecture, Algorithm algorithm)
-      : Plan(architecture), algorithm_(algorithm) {}
+  BetweennessCentralityPlan(
+      Architecture architecture, Algorithm algorithm,
+      float epsilon = kDefaultEpsilon, float delta = kDefaultDelta)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        epsilon_(epsilon),
+        delta_(delta) {}
 
 public:
   BetweennessCentralityPlan() : BetweennessCentralityPlan{kCPU, kLevel} {}
@@ -50,11 +61,32 @@ public:
   }
 
   Algorithm algorithm() const { return algorithm_; }
+  /// The maximum error of the normalized centrality (the fraction of node
+  /// pairs whose shortest paths pass through a node) for kAdaptiveSampling
+  float epsilon() const { return epsilon_; }
+  /// The probability that some node exceeds the epsilon error for
+  /// kAdaptiveSampling
+  float delta() const { return delta_; }
 
   static BetweennessCentralityPlan Level() { return {kCPU, kLevel}; }
 
   static BetweennessCentralityPlan Outer() { return {kCPU, kOuter}; }
 
+  /// Approximate the centrality by sampling random shortest paths between
+  /// random pairs of nodes, stopping as soon as, with probability at least
+  /// 1 - delta, every node's normalized centrality is within epsilon of the
+  /// exact one. Samples are taken in parallel, each with a balanced
+  /// bidirectional BFS that only visits the nodes near its endpoints. The
+  /// sources argument of BetweennessCentrality is ignored.
+  ///
+  /// BORASSI, Michele, and NATALE, Emanuele. KADABRA is an ADaptive Algorithm
+  /// for Betweenness via Random Approximation. In: 24th Annual European
+  /// Symposium on Algorithms (ESA 2016). 2016. p. 20:1-20:18.
+  static BetweennessCentralityPlan AdaptiveSampling(
+      float epsilon = kDefaultEpsilon, float delta = kDefaultDelta) {
+    return {kCPU, kAdaptiveSampling, epsilon, delta};
+  }
+
   static BetweennessCentralityPlan FromAlgorithm(Algorithm algo) {
     return BetweennessCentralityPlan(kCPU, algo);
   }
@@ -73,6 +105,10 @@ KATANA_EXPORT extern const BetweennessCentralitySources
 /// The property named output_property_name is created by this function and may
 /// not exist before the call.
 ///
+/// With BetweennessCentralityPlan::AdaptiveSampling the computed values are
+/// the estimated normalized centralities scaled by n(n-1), so that they are
+/// comparable to the exact values computed from all sources.
+///
 /// @param pg The graph to process.
 /// @param output_property_name The parameter to create with the computed value.
 /// @param sources Only process some sources, producing an approximate
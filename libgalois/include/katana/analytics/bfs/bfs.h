@@ -2,6 +2,8 @@
 #define KATANA_LIBGALOIS_KATANA_ANALYTICS_BFS_BFS_H_
 
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include "katana/analytics/Plan.h"
 #include "katana/analytics/Utils.h"
@@ -86,6 +88,25 @@ KATANA_EXPORT Result<void> Bfs(
 KATANA_EXPORT Result<void> BfsAssertValid(
     PropertyGraph* pg, uint32_t source, const std::string& property_name);
 
+/// Maximum number of sources that MultiSourceBfs traverses together
+constexpr uint32_t kMultiSourceBfsBatchSize = 512;
+
+/// Compute the BFS distance from each node in sources to every node in pg.
+/// The distances from sources[i] are stored in a uint32_t property named by
+/// output_property_names[i]; nodes not reachable from sources[i] have the
+/// maximum uint32_t value. The properties are created by this function and
+/// may not exist before the call.
+///
+/// Sources are traversed in batches of up to kMultiSourceBfsBatchSize. Each
+/// node keeps one bit per source of the batch for its frontier and visited
+/// sets, so a single scan of an edge advances every source of the batch that
+/// reached its endpoint at the same level. Only kSynchronousDirectOpt is
+/// supported; its alpha and beta parameters control the switch between
+/// pushing from the frontier and pulling over the transpose graph.
+KATANA_EXPORT Result<void> MultiSourceBfs(
+    PropertyGraph* pg, const std::vector<uint32_t>& sources,
+    const std::vector<std::string>& output_property_names, BfsPlan algo = {});
+
 /// Statistics about a graph that can be extracted from the results of BFS.
 struct KATANA_EXPORT BfsStatistics {
   /// The number of nodes reachable from the source node.
@@ -2,6 +2,8 @@
 #define KATANA_LIBGALOIS_KATANA_ANALYTICS_CONNECTEDCOMPONENTS_CONNECTEDCOMPONENTS_H_
 
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include "katana/AtomicHelpers.h"
 #include "katana/analytics/Plan.h"
@@ -161,6 +163,20 @@ KATANA_EXPORT Result<void> ConnectedComponents(
     PropertyGraph* pg, const std::string& output_property_name,
     ConnectedComponentsPlan plan = ConnectedComponentsPlan());
 
+/// Update the components in the property named property_name, computed by
+/// ConnectedComponents before the edges srcs[i] -> dsts[i] were inserted into
+/// pg, so that they are the components of pg with those edges. Nodes whose
+/// component is null, such as nodes inserted with the edges, start out in
+/// components of their own.
+///
+/// The components joined by the new edges are found with a union-find over
+/// just the components of their endpoints, so no edges of pg are traversed;
+/// only the component IDs of the nodes are scanned once to relabel the joined
+/// components.
+KATANA_EXPORT Result<void> IncrementalConnectedComponents(
+    PropertyGraph* pg, const std::string& property_name,
+    const std::vector<uint32_t>& srcs, const std::vector<uint32_t>& dsts);
+
 KATANA_EXPORT Result<void> ConnectedComponentsAssertValid(
     PropertyGraph* pg, const std::string& property_name);
 
@@ -0,0 +1,127 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_MATRIXCOMPLETION_MATRIXCOMPLETION_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_MATRIXCOMPLETION_MATRIXCOMPLETION_H_
+
+#include <iostream>
+#include <string>
+
+#include "katana/PropertyGraph.h"
+#include "katana/analytics/Plan.h"
+
+namespace katana::analytics {
+
+/// A computational plan for MatrixCompletion, specifying the algorithm and any
+/// parameters associated with it.
+class MatrixCompletionPlan : public Plan {
+public:
+  enum Algorithm {
+    kSGD,
+    kALS,
+  };
+
+  static constexpr double kDefaultLearningRate = 0.012;
+  static constexpr double kDefaultLambda = 0.05;
+  static const uint32_t kDefaultMaxIterations = 100;
+  static constexpr double kDefaultTolerance = 0.01;
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+  double learning_rate_;
+  double lambda_;
+  uint32_t max_iterations_;
+  double tolerance_;
+
+  MatrixCompletionPlan(
+      Architecture architecture, Algorithm algorithm, double learning_rate,
+      double lambda, uint32_t max_iterations, double tolerance)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        learning_rate_(learning_rate),
+        lambda_(lambda),
+        max_iterations_(max_iterations),
+        tolerance_(tolerance) {}
+
+public:
+  MatrixCompletionPlan()
+      : MatrixCompletionPlan(
+            kCPU, kSGD, kDefaultLearningRate, kDefaultLambda,
+            kDefaultMaxIterations, kDefaultTolerance) {}
+
+  MatrixCompletionPlan& operator=(const MatrixCompletionPlan&) = default;
+
+  Algorithm algorithm() const { return algorithm_; }
+
+  /// The initial step size of SGD.
+  double learning_rate() const { return learning_rate_; }
+
+  /// The weight of the regularization of the latent vectors.
+  double lambda() const { return lambda_; }
+
+  /// The maximum number of passes over the ratings.
+  uint32_t max_iterations() const { return max_iterations_; }
+
+  /// Stop once a pass changes the squared error by less than this fraction.
+  double tolerance() const { return tolerance_; }
+
+  /// Stochastic gradient descent. The ratings are split into a 2D grid of
+  /// blocks by item and user, and each pass over the ratings is made of
+  /// sub-passes in which every thread updates a block that shares no item or
+  /// user with the blocks of the other threads, so no locks are needed. The
+  /// step size is adapted after every pass with the bold driver heuristic.
+  ///
+  /// Gemulla, Rainer, et al. "Large-scale matrix factorization with
+  /// distributed stochastic gradient descent." KDD 2011.
+  static MatrixCompletionPlan SGD(
+      double learning_rate = kDefaultLearningRate,
+      double lambda = kDefaultLambda,
+      uint32_t max_iterations = kDefaultMaxIterations,
+      double tolerance = kDefaultTolerance) {
+    return {kCPU, kSGD, learning_rate, lambda, max_iterations, tolerance};
+  }
+
+  /// Alternating least squares. Each pass solves for the latent vectors of
+  /// all items in parallel with the latent vectors of the users fixed, and
+  /// then the other way around.
+  static MatrixCompletionPlan ALS(
+      double lambda = kDefaultLambda,
+      uint32_t max_iterations = kDefaultMaxIterations,
+      double tolerance = kDefaultTolerance) {
+    return {kCPU, kALS, 0, lambda, max_iterations, tolerance};
+  }
+};
+
+/// Factor the sparse matrix of ratings given by the edges of the graph into
+/// latent vectors of latent_dimension values, so that the dot product of the
+/// latent vectors of the endpoints of an edge approximates its rating. The
+/// graph must be bipartite with edges from items to users: no node may have
+/// both incoming and outgoing edges. The property named
+/// edge_rating_property_name must be a numeric edge property.
+/// The property named output_property_name is created by this function and
+/// may not exist before the call. The created property is a fixed size list
+/// of latent_dimension float values for each node.
+KATANA_EXPORT Result<void> MatrixCompletion(
+    PropertyGraph* pg, const std::string& edge_rating_property_name,
+    const std::string& output_property_name, uint32_t latent_dimension,
+    MatrixCompletionPlan plan = {});
+
+KATANA_EXPORT Result<void> MatrixCompletionAssertValid(
+    PropertyGraph* pg, const std::string& property_name);
+
+struct KATANA_EXPORT MatrixCompletionStatistics {
+  /// The number of values in each latent vector.
+  uint32_t latent_dimension;
+  /// The root mean square error of the predicted ratings.
+  double root_mean_square_error;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<MatrixCompletionStatistics> Compute(
+      PropertyGraph* pg, const std::string& edge_rating_property_name,
+      const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+
+#endif
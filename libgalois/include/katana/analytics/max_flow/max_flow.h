@@ -0,0 +1,112 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_MAXFLOW_MAXFLOW_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_MAXFLOW_MAXFLOW_H_
+
+#include <iostream>
+#include <string>
+
+#include "katana/PropertyGraph.h"
+#include "katana/analytics/Plan.h"
+
+namespace katana::analytics {
+
+/// A computational plan for MaxFlow, specifying the algorithm and any
+/// parameters associated with it.
+class MaxFlowPlan : public Plan {
+public:
+  enum Algorithm {
+    kPushRelabel,
+  };
+
+  /// Use the interval of Goldberg's implementation, 6 relabels per node plus
+  /// one third of the number of edges.
+  static const uint64_t kDefaultGlobalRelabelInterval = 0;
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+  uint64_t global_relabel_interval_;
+
+  MaxFlowPlan(
+      Architecture architecture, Algorithm algorithm,
+      uint64_t global_relabel_interval)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        global_relabel_interval_(global_relabel_interval) {}
+
+public:
+  MaxFlowPlan()
+      : MaxFlowPlan(kCPU, kPushRelabel, kDefaultGlobalRelabelInterval) {}
+
+  MaxFlowPlan& operator=(const MaxFlowPlan&) = default;
+
+  Algorithm algorithm() const { return algorithm_; }
+
+  /// The amount of work, counting one per push and 12 per relabel, after
+  /// which the heights are recomputed from scratch. 0 picks an interval from
+  /// the size of the graph.
+  uint64_t global_relabel_interval() const { return global_relabel_interval_; }
+
+  /// Asynchronous push-relabel. Each active node is discharged by one thread
+  /// at a time, which pushes to its lowest neighbors in the residual graph
+  /// with atomic updates and no locks. The heights are periodically reset to
+  /// the exact distances to the sink by a parallel BFS on the residual graph
+  /// (global relabeling), which also lifts the nodes that cannot reach the
+  /// sink any more; a relabel that empties a height level triggers one early
+  /// (gap heuristic). The excess left once no node can reach the sink is
+  /// then returned to the source in the same way.
+  ///
+  /// Hong, Bo, and Zhengyu He. "An asynchronous multithreaded algorithm for
+  /// the maximum network flow problem with nonblocking global relabeling
+  /// heuristic." IEEE TPDS 2011.
+  static MaxFlowPlan PushRelabel(
+      uint64_t global_relabel_interval = kDefaultGlobalRelabelInterval) {
+    return {kCPU, kPushRelabel, global_relabel_interval};
+  }
+};
+
+/// Compute a maximum flow from source to sink with the capacities in the
+/// edge property named edge_capacity_property_name, which must hold
+/// non-negative integers. Every edge can carry flow in its own direction
+/// only; the residual edges in the other direction are paired with the edges
+/// of the transpose of the graph, so the graph needs no reverse edges.
+/// The properties named output_flow_property_name and output_cut_property_name
+/// are created by this function and may not exist before the call. The
+/// created edge property has type uint64_t and holds the flow along each
+/// edge. The created node property has type uint8_t and is 1 for the nodes
+/// on the source side of a minimum cut, and 0 for the others.
+/// \returns the value of the flow
+KATANA_EXPORT Result<uint64_t> MaxFlow(
+    PropertyGraph* pg, uint32_t source, uint32_t sink,
+    const std::string& edge_capacity_property_name,
+    const std::string& output_flow_property_name,
+    const std::string& output_cut_property_name, MaxFlowPlan plan = {});
+
+/// Check that the flow respects the capacities and is conserved, and that
+/// the cut saturates every edge leaving the source side and carries no flow
+/// into it, which proves that both are optimal.
+KATANA_EXPORT Result<void> MaxFlowAssertValid(
+    PropertyGraph* pg, uint32_t source, uint32_t sink,
+    const std::string& edge_capacity_property_name,
+    const std::string& flow_property_name,
+    const std::string& cut_property_name);
+
+struct KATANA_EXPORT MaxFlowStatistics {
+  /// The net flow out of the source.
+  uint64_t flow_value;
+  /// The number of edges from the source side to the sink side of the cut.
+  uint64_t cut_edges;
+  /// The number of nodes on the source side of the cut.
+  uint64_t source_side_size;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<MaxFlowStatistics> Compute(
+      PropertyGraph* pg, uint32_t source, const std::string& flow_property_name,
+      const std::string& cut_property_name);
+};
+
+}  // namespace katana::analytics
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_MINIMUMSPANNINGFOREST_MINIMUMSPANNINGFOREST_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_MINIMUMSPANNINGFOREST_MINIMUMSPANNINGFOREST_H_
+
+#include <iostream>
+#include <string>
+
+#include "katana/PropertyGraph.h"
+#include "katana/analytics/Plan.h"
+
+namespace katana::analytics {
+
+/// A computational plan for MinimumSpanningForest, specifying the algorithm
+/// and any parameters associated with it.
+class MinimumSpanningForestPlan : public Plan {
+public:
+  enum Algorithm {
+    kBoruvka,
+    kFilterKruskal,
+  };
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+
+  MinimumSpanningForestPlan(Architecture architecture, Algorithm algorithm)
+      : Plan(architecture), algorithm_(algorithm) {}
+
+public:
+  MinimumSpanningForestPlan() : MinimumSpanningForestPlan(kCPU, kBoruvka) {}
+
+  MinimumSpanningForestPlan& operator=(const MinimumSpanningForestPlan&) =
+      default;
+
+  Algorithm algorithm() const { return algorithm_; }
+
+  /// Bulk-synchronous Boruvka. In each round, every component finds its
+  /// lightest outgoing edge with atomic updates, and all of these edges are
+  /// added to the forest at once by merging the components in a lock-free
+  /// union-find. The edges inside a component are dropped after each round.
+  static MinimumSpanningForestPlan Boruvka() { return {kCPU, kBoruvka}; }
+
+  /// Filter-Kruskal. The edges are partitioned around a pivot weight, the
+  /// forest of the light edges is computed recursively, and the heavy edges
+  /// whose endpoints are already connected are filtered out in parallel before
+  /// recursing on the rest. Small sets of edges are handled by Kruskal's
+  /// algorithm. This avoids sorting most of the edges of sparse graphs.
+  ///
+  /// Osipov, Vitaly, Peter Sanders, and Johannes Singler. "The
+  /// filter-kruskal minimum spanning tree algorithm." ALENEX 2009.
+  static MinimumSpanningForestPlan FilterKruskal() {
+    return {kCPU, kFilterKruskal};
+  }
+};
+
+/// Compute a minimum spanning forest of the graph, in which every edge is
+/// taken as undirected, and return its total weight. Ties between edges of
+/// equal weight are broken by edge ID, so all plans find the same forest. For
+/// a symmetric graph, only one of the two copies of an edge of the forest is
+/// part of it. The property named edge_weight_property_name must be a numeric
+/// edge property.
+/// The property named output_property_name is created by this function and
+/// may not exist before the call. The created property is a uint8 edge
+/// property which is 1 for the edges of the forest and 0 for the others.
+KATANA_EXPORT Result<double> MinimumSpanningForest(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& output_property_name,
+    MinimumSpanningForestPlan plan = {});
+
+KATANA_EXPORT Result<void> MinimumSpanningForestAssertValid(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& property_name);
+
+struct KATANA_EXPORT MinimumSpanningForestStatistics {
+  /// The number of edges in the forest.
+  uint64_t num_forest_edges;
+  /// The number of trees in the forest, counting isolated nodes.
+  uint64_t num_trees;
+  /// The sum of the weights of the edges in the forest.
+  double total_weight;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<MinimumSpanningForestStatistics> Compute(
+      PropertyGraph* pg, const std::string& edge_weight_property_name,
+      const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+
+#endif
@@ -2,6 +2,9 @@
 #define KATANA_LIBGALOIS_KATANA_ANALYTICS_PAGERANK_PAGERANK_H_
 
 #include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "katana/Properties.h"
 #include "katana/PropertyGraph.h"
@@ -18,27 +21,32 @@ public:
     kPullResidual,
     kPushSynchronous,
     kPushAsynchronous,
+    kPropagationBlocking,
   };
 
   static constexpr double kDefaultTolerance = 1.0e-3;
   static const int kDefaultMaxIterations = 1000;
   static constexpr double kDefaultAlpha = 0.85;
+  static const uint32_t kDefaultBlockSize = 1U << 18;
 
 private:
   Algorithm algorithm_;
   float tolerance_;
   unsigned int max_iterations_;
   float alpha_;
+  uint32_t block_size_;
 
 public:
   PagerankPlan(
       Architecture architecture, Algorithm algorithm, float tolerance,
-      unsigned int max_iterations, float alpha)
+      unsigned int max_iterations, float alpha,
+      uint32_t block_size = kDefaultBlockSize)
       : Plan(architecture),
         algorithm_(algorithm),
         tolerance_(tolerance),
         max_iterations_(max_iterations),
-        alpha_(alpha) {}
+        alpha_(alpha),
+        block_size_(block_size) {}
 
   constexpr static const unsigned kChunkSize = 16U;
 
@@ -55,6 +63,9 @@ public:
   unsigned int max_iterations() const { return max_iterations_; }
   float alpha() const { return alpha_; }
   float initial_residual() const { return 1 - alpha_; }
+  /// The number of destination nodes whose ranks are updated together by
+  /// PropagationBlocking.
+  uint32_t block_size() const { return block_size_; }
 
   /// Topological pull algorithm
   ///
@@ -103,8 +114,103 @@ public:
       float alpha = kDefaultAlpha) {
     return {kCPU, kPushSynchronous, tolerance, max_iterations, alpha};
   }
+
+  /// Propagation blocking algorithm
+  ///
+  /// Computes the same ranks as the topological algorithm but pushes along
+  /// the edges of the graph, which must not be transposed. Rank contributions
+  /// are binned by blocks of block_size destination nodes, and each block is
+  /// then accumulated on its own, so that the random accesses to ranks stay
+  /// in cache. This pays off when the ranks of all nodes do not fit in the
+  /// last level cache.
+  ///
+  /// BEAMER, Scott; ASANOVIC, Krste; PATTERSON, David. Reducing PageRank
+  /// communication via propagation blocking. In: 2017 IEEE International
+  /// Parallel and Distributed Processing Symposium. IEEE, 2017. p. 820-831.
+  static PagerankPlan PropagationBlocking(
+      float tolerance = kDefaultTolerance,
+      unsigned int max_iterations = kDefaultMaxIterations,
+      float alpha = kDefaultAlpha, uint32_t block_size = kDefaultBlockSize) {
+    return {
+        kCPU, kPropagationBlocking, tolerance, max_iterations, alpha,
+        block_size};
+  }
+};
+
+/// A computational plan for personalized Page Rank, specifying the algorithm
+/// and any parameters associated with it.
+///
+/// Personalized Page Rank is the stationary distribution of a random walk
+/// that, at each step, follows an out-edge with probability alpha and jumps
+/// back to a seed node otherwise. Both algorithms push residual mass forward
+/// until no node u holds more than epsilon * outdegree(u) of it, so a node's
+/// score is short of its exact value by at most that residual.
+class PersonalizedPagerankPlan : public Plan {
+public:
+  enum Algorithm {
+    kForwardPush,
+    kPushAsynchronous,
+  };
+
+  static constexpr double kDefaultEpsilon = 1.0e-6;
+  static constexpr double kDefaultAlpha = 0.85;
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+  float epsilon_;
+  float alpha_;
+
+  PersonalizedPagerankPlan(
+      Architecture architecture, Algorithm algorithm, float epsilon,
+      float alpha)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        epsilon_(epsilon),
+        alpha_(alpha) {}
+
+public:
+  PersonalizedPagerankPlan()
+      : PersonalizedPagerankPlan(
+            kCPU, kForwardPush, kDefaultEpsilon, kDefaultAlpha) {}
+
+  Algorithm algorithm() const { return algorithm_; }
+  float epsilon() const { return epsilon_; }
+  float alpha() const { return alpha_; }
+
+  /// Local forward push
+  ///
+  /// A single thread pushes residual from a FIFO queue and keeps scores only
+  /// for the nodes the push reaches, so the work is bounded by
+  /// 1 / (epsilon * (1 - alpha)) independently of the size of the graph.
+  /// Batched queries run one local push per seed in parallel.
+  ///
+  /// ANDERSEN, Reid, CHUNG, Fan, and LANG, Kevin. Local graph partitioning
+  /// using PageRank vectors. In: 47th Annual IEEE Symposium on Foundations of
+  /// Computer Science (FOCS'06). IEEE, 2006. p. 475-486.
+  static PersonalizedPagerankPlan ForwardPush(
+      float epsilon = kDefaultEpsilon, float alpha = kDefaultAlpha) {
+    return {kCPU, kForwardPush, epsilon, alpha};
+  }
+
+  /// Asynchronous push algorithm
+  ///
+  /// The worklist driven push of PagerankPlan::PushAsynchronous over
+  /// residuals stored for every node. Batched queries carry the residuals of
+  /// up to kBatchedPersonalizedPagerankLanes seeds per node so that one
+  /// traversal serves all of them. Prefer this to ForwardPush when the seeds
+  /// reach a large part of the graph.
+  static PersonalizedPagerankPlan PushAsynchronous(
+      float epsilon = kDefaultEpsilon, float alpha = kDefaultAlpha) {
+    return {kCPU, kPushAsynchronous, epsilon, alpha};
+  }
 };
 
+/// The number of seeds whose personalized Page Rank is computed together by
+/// BatchedPersonalizedPagerank with PersonalizedPagerankPlan::PushAsynchronous.
+constexpr uint32_t kBatchedPersonalizedPagerankLanes = 16;
+
 /// Compute the Page Rank of each node in the graph.
 /// The property named output_property_name is created by this function and may
 /// not exist before the call.
@@ -112,6 +218,51 @@ KATANA_EXPORT Result<void> Pagerank(
     PropertyGraph* pg, const std::string& output_property_name,
     PagerankPlan plan = {});
 
+/// Update the Page Rank in the property named property_name, computed by
+/// Pagerank before the edges srcs[i] -> dsts[i] were inserted into pg, so
+/// that it is the Page Rank of pg with those edges. Nodes whose rank is null,
+/// such as nodes inserted with the edges, start out with rank 0.
+///
+/// The new edges change the residual of only the out-neighbors of their
+/// sources (and of new nodes). The update computes those residuals from the
+/// previous ranks and pushes them asynchronously until every residual is
+/// within the tolerance of plan, so the work is proportional to the part of
+/// the graph the change reaches rather than to the whole graph. The ranks
+/// must have been computed with the residual algorithms (PullResidual,
+/// PushAsynchronous or PushSynchronous), whose ranks are not normalized.
+KATANA_EXPORT Result<void> IncrementalPagerank(
+    PropertyGraph* pg, const std::string& property_name,
+    const std::vector<uint32_t>& srcs, const std::vector<uint32_t>& dsts,
+    PagerankPlan plan = {});
+
+/// Compute the Page Rank of each node personalized to the seed nodes, which
+/// share the restart probability equally. Nodes that the walk does not reach
+/// have rank 0.
+/// The property named output_property_name is created by this function and may
+/// not exist before the call.
+KATANA_EXPORT Result<void> PersonalizedPagerank(
+    PropertyGraph* pg, const std::vector<uint32_t>& seeds,
+    const std::string& output_property_name,
+    PersonalizedPagerankPlan plan = {});
+
+/// Compute the personalized Page Rank of seeds without touching any node that
+/// the walk does not reach, and return the nodes with a non-zero rank in
+/// order of decreasing rank. This always uses the local forward push with
+/// the epsilon and alpha of plan.
+KATANA_EXPORT Result<std::vector<std::pair<uint32_t, float>>>
+LocalPersonalizedPagerank(
+    PropertyGraph* pg, const std::vector<uint32_t>& seeds,
+    PersonalizedPagerankPlan plan = {});
+
+/// Compute the Page Rank personalized to each seed node separately, storing
+/// the ranks for seeds[i] in the property named output_property_names[i].
+/// The output properties are created by this function and may not exist before
+/// the call.
+KATANA_EXPORT Result<void> BatchedPersonalizedPagerank(
+    PropertyGraph* pg, const std::vector<uint32_t>& seeds,
+    const std::vector<std::string>& output_property_names,
+    PersonalizedPagerankPlan plan = {});
+
 KATANA_EXPORT Result<void> PagerankAssertValid(
     PropertyGraph* pg, const std::string& property_name);
 
@@ -0,0 +1,117 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_PARTITION_PARTITION_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_PARTITION_PARTITION_H_
+
+#include <iostream>
+#include <string>
+
+#include "katana/PropertyGraph.h"
+#include "katana/analytics/Plan.h"
+
+namespace katana::analytics {
+
+/// A computational plan for Partition, specifying the algorithm and any
+/// parameters associated with it.
+class PartitionPlan : public Plan {
+public:
+  enum Algorithm {
+    kMultilevel,
+  };
+
+  static constexpr double kDefaultImbalance = 0.03;
+  static const uint32_t kDefaultCoarseningThreshold = 20;
+  static const uint32_t kDefaultRefinementIterations = 8;
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+  double imbalance_;
+  uint32_t coarsening_threshold_;
+  uint32_t refinement_iterations_;
+
+  PartitionPlan(
+      Architecture architecture, Algorithm algorithm, double imbalance,
+      uint32_t coarsening_threshold, uint32_t refinement_iterations)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        imbalance_(imbalance),
+        coarsening_threshold_(coarsening_threshold),
+        refinement_iterations_(refinement_iterations) {}
+
+public:
+  PartitionPlan()
+      : PartitionPlan(
+            kCPU, kMultilevel, kDefaultImbalance, kDefaultCoarseningThreshold,
+            kDefaultRefinementIterations) {}
+
+  PartitionPlan& operator=(const PartitionPlan&) = default;
+
+  Algorithm algorithm() const { return algorithm_; }
+
+  /// The fraction by which the total node weight of a partition may exceed
+  /// the average.
+  double imbalance() const { return imbalance_; }
+
+  /// Stop coarsening once there are at most this many nodes per partition.
+  uint32_t coarsening_threshold() const { return coarsening_threshold_; }
+
+  /// The maximum number of refinement passes at each level.
+  uint32_t refinement_iterations() const { return refinement_iterations_; }
+
+  /// Multilevel k-way partitioning in the style of METIS. The graph is
+  /// coarsened by repeatedly contracting a heavy edge matching, found in
+  /// parallel by handshakes between nodes. The coarsest graph is partitioned
+  /// by greedy graph growing, and the partition is projected back level by
+  /// level, refining it at each level with parallel greedy moves of boundary
+  /// nodes that reduce the edge cut while keeping the partitions balanced.
+  static PartitionPlan Multilevel(
+      double imbalance = kDefaultImbalance,
+      uint32_t coarsening_threshold = kDefaultCoarseningThreshold,
+      uint32_t refinement_iterations = kDefaultRefinementIterations) {
+    return {
+        kCPU, kMultilevel, imbalance, coarsening_threshold,
+        refinement_iterations};
+  }
+};
+
+/// Partition the nodes of the graph into num_partitions parts of about equal
+/// size while keeping the number of edges between parts small. The graph
+/// must be symmetric.
+/// The property named output_property_name is created by this function and
+/// may not exist before the call. The created property has type uint32_t and
+/// holds the partition ID of each node.
+///
+/// The partition IDs are only a node property, meant for grouping nodes in
+/// memory, e.g., with ReorderPlan::Partitioned. They do not make the graph a
+/// partitioned RDG: storing the graph still writes a single RDG partition,
+/// and the IDs are not recorded in its partition metadata.
+///
+/// \see ReorderPlan::Partitioned to place the nodes of each partition next
+///     to each other.
+KATANA_EXPORT Result<void> Partition(
+    PropertyGraph* pg, uint32_t num_partitions,
+    const std::string& output_property_name, PartitionPlan plan = {});
+
+KATANA_EXPORT Result<void> PartitionAssertValid(
+    PropertyGraph* pg, uint32_t num_partitions,
+    const std::string& property_name);
+
+struct KATANA_EXPORT PartitionStatistics {
+  /// The number of edges whose endpoints are in different partitions.
+  uint64_t edge_cut;
+  /// The number of nodes in the largest partition.
+  uint64_t max_partition_size;
+  /// The size of the largest partition relative to the average size.
+  double imbalance;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<PartitionStatistics> Compute(
+      PropertyGraph* pg, uint32_t num_partitions,
+      const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+
+#endif
@@ -2,7 +2,10 @@
 #define KATANA_LIBGALOIS_KATANA_ANALYTICS_RANDOMWALKS_RANDOMWALKS_H_
 
 #include <iostream>
+#include <limits>
+#include <memory>
 
+#include <arrow/api.h>
 #include <katana/analytics/Plan.h>
 
 #include "katana/AtomicHelpers.h"
@@ -133,6 +136,9 @@ public:
   }
 };
 
+/// The value of the entries after the end of a walk in RandomWalksArray
+constexpr uint32_t kRandomWalksPadding = std::numeric_limits<uint32_t>::max();
+
 /// Compute the random-walks for pg. The pg is expected to be symmetric. The
 /// parameters can be specified, but have reasonable defaults. Not all
 /// parameters are used by the algorithms. The generated random-walks generated
@@ -140,6 +146,22 @@ public:
 KATANA_EXPORT Result<std::vector<std::vector<uint32_t>>> RandomWalks(
     PropertyGraph* pg, RandomWalksPlan plan = RandomWalksPlan());
 
+/// Compute the random-walks for pg like RandomWalks, but write them directly
+/// into a single preallocated buffer instead of allocating each walk. Walk i
+/// starts at node i % num_nodes and is element i of the returned array, which
+/// has walk_length + 1 nodes per element. Walks that end early, at a node
+/// without neighbors, are padded with kRandomWalksPadding; this includes the
+/// walks from nodes without neighbors, which only contain their start node.
+/// The values of the array have no null bitmap and can be viewed as a
+/// num_rows x (walk_length + 1) matrix without copying.
+///
+/// For Node2vec there are num_nodes * number_of_walks rows. Edge2vec keeps
+/// the walks of all max_iterations iterations one after the other, and
+/// discards walks that reach a node without neighbors after their start;
+/// their rows contain only padding.
+KATANA_EXPORT Result<std::shared_ptr<arrow::FixedSizeListArray>>
+RandomWalksArray(PropertyGraph* pg, RandomWalksPlan plan = RandomWalksPlan());
+
 KATANA_EXPORT Result<void> RandomWalksAssertValid(PropertyGraph* pg);
 
 }  // namespace katana::analytics
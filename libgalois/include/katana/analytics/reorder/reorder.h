@@ -0,0 +1,131 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_REORDER_REORDER_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_REORDER_REORDER_H_
+
+#include <iostream>
+#include <string>
+
+#include "katana/PropertyGraph.h"
+#include "katana/analytics/Plan.h"
+
+namespace katana::analytics {
+
+/// A computational plan for Reorder, specifying the ordering to compute and
+/// any parameters associated with it.
+class ReorderPlan : public Plan {
+public:
+  enum Algorithm {
+    kReverseCuthillMcKee,
+    kHubSort,
+    kHubCluster,
+    kRabbit,
+    kGorder,
+    kPartitioned
+  };
+
+  static const uint32_t kDefaultGorderWindow = 5;
+  static const uint32_t kDefaultNumPartitions = 64;
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+  uint32_t gorder_window_;
+  uint32_t num_partitions_;
+
+  ReorderPlan(
+      Architecture architecture, Algorithm algorithm,
+      uint32_t gorder_window = kDefaultGorderWindow,
+      uint32_t num_partitions = kDefaultNumPartitions)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        gorder_window_(gorder_window),
+        num_partitions_(num_partitions) {}
+
+public:
+  ReorderPlan() : ReorderPlan(kCPU, kHubSort) {}
+
+  ReorderPlan& operator=(const ReorderPlan&) = default;
+
+  Algorithm algorithm() const { return algorithm_; }
+
+  /// The number of most recently placed nodes Gorder scores candidates
+  /// against.
+  uint32_t gorder_window() const { return gorder_window_; }
+
+  /// The number of partitions the nodes are grouped into by Partitioned.
+  uint32_t num_partitions() const { return num_partitions_; }
+
+  /// Breadth first search from a low degree node of each component, visiting
+  /// the children of each level in the order of their parents and by
+  /// ascending degree, and then reverse the order. This reduces the bandwidth
+  /// of the adjacency matrix. Levels are expanded in parallel.
+  static ReorderPlan ReverseCuthillMcKee() {
+    return {kCPU, kReverseCuthillMcKee};
+  }
+
+  /// Move the nodes with more than the average degree to the front, sorted by
+  /// descending degree, and leave the other nodes in their original order.
+  static ReorderPlan HubSort() { return {kCPU, kHubSort}; }
+
+  /// Like HubSort but keep the original order among the hubs too.
+  static ReorderPlan HubCluster() { return {kCPU, kHubCluster}; }
+
+  /// Rabbit order: merge each node, by ascending degree, into the neighboring
+  /// community that increases modularity the most, and then place the nodes
+  /// of each community of the resulting dendrogram next to each other.
+  static ReorderPlan Rabbit() { return {kCPU, kRabbit}; }
+
+  /// An approximation of Gorder: greedily place next the node that shares the
+  /// most edges and neighbors with the last gorder_window placed nodes.
+  /// Neighbors with more than the square root of the number of nodes edges
+  /// are not counted as shared.
+  static ReorderPlan Gorder(uint32_t gorder_window = kDefaultGorderWindow) {
+    return {kCPU, kGorder, gorder_window};
+  }
+
+  /// Partition the graph with the default plan of Partition and place the
+  /// nodes of each partition next to each other, keeping their original
+  /// order within a partition.
+  static ReorderPlan Partitioned(
+      uint32_t num_partitions = kDefaultNumPartitions) {
+    return {kCPU, kPartitioned, kDefaultGorderWindow, num_partitions};
+  }
+};
+
+/// Relabel the nodes of the graph to improve the locality of graph
+/// algorithms. The topology and all node and edge properties are permuted
+/// together; the outgoing edges of a node keep their order. The algorithms
+/// other than the hub orderings treat the outgoing edges of a node as its
+/// neighborhood and work best on symmetric graphs.
+///
+/// The original ID of each node is stored in the node property named
+/// original_id_property_name so that results can be mapped back. This
+/// property is created by this function and may not exist before the call.
+/// The created property has type uint32_t. Every other property is permuted
+/// along with the nodes and edges, so the call fails, without changing the
+/// graph, if any property has been unloaded.
+KATANA_EXPORT Result<void> Reorder(
+    PropertyGraph* pg, const std::string& original_id_property_name,
+    ReorderPlan plan = {});
+
+/// Check that the original node IDs are a permutation of the node IDs.
+KATANA_EXPORT Result<void> ReorderAssertValid(
+    PropertyGraph* pg, const std::string& original_id_property_name);
+
+struct KATANA_EXPORT ReorderStatistics {
+  /// The average absolute difference between the IDs of the endpoints of
+  /// each edge.
+  double average_edge_span;
+  /// The largest absolute difference between the IDs of the endpoints of an
+  /// edge. This is the bandwidth of the adjacency matrix.
+  uint64_t max_edge_span;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<ReorderStatistics> Compute(PropertyGraph* pg);
+};
+
+}  // namespace katana::analytics
+
+#endif
@@ -0,0 +1,165 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_SHORTESTPATH_SHORTESTPATH_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_SHORTESTPATH_SHORTESTPATH_H_
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "katana/analytics/Plan.h"
+#include "katana/analytics/Utils.h"
+
+namespace katana::analytics {
+
+/// A computational plan for point-to-point shortest path queries, specifying
+/// the algorithm and any parameters associated with it.
+class ShortestPathPlan : public Plan {
+public:
+  /// Algorithm selectors for point-to-point shortest paths
+  enum Algorithm {
+    kBidirectionalDijkstra,
+    kBidirectionalAStar,
+    kAutomatic,
+  };
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+
+  ShortestPathPlan(Architecture architecture, Algorithm algorithm)
+      : Plan(architecture), algorithm_(algorithm) {}
+
+public:
+  /// Use A* when coordinate properties are given and Dijkstra otherwise.
+  ShortestPathPlan() : ShortestPathPlan{kCPU, kAutomatic} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+
+  /// Dijkstra's algorithm searching forward from the source and backward
+  /// from the target at the same time. The search stops as soon as the two
+  /// frontiers prove that no shorter path than the best one found so far
+  /// exists.
+  static ShortestPathPlan BidirectionalDijkstra() {
+    return {kCPU, kBidirectionalDijkstra};
+  }
+
+  /// Bidirectional Dijkstra guided towards the other end by the straight
+  /// line distance between node coordinates. The coordinates must be scaled
+  /// so that the straight line distance between the endpoints of an edge
+  /// never exceeds the weight of the edge.
+  static ShortestPathPlan BidirectionalAStar() {
+    return {kCPU, kBidirectionalAStar};
+  }
+};
+
+/// A computational plan for k shortest simple paths, specifying the algorithm
+/// and any parameters associated with it.
+class KShortestSimplePathsPlan : public Plan {
+public:
+  /// Algorithm selectors for k shortest simple paths
+  enum Algorithm {
+    kYen,
+  };
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+  ShortestPathPlan search_plan_;
+
+  KShortestSimplePathsPlan(
+      Architecture architecture, Algorithm algorithm,
+      ShortestPathPlan search_plan)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        search_plan_(search_plan) {}
+
+public:
+  KShortestSimplePathsPlan() : KShortestSimplePathsPlan{kCPU, kYen, {}} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+  /// The plan of the point-to-point searches used to find each path
+  ShortestPathPlan search_plan() const { return search_plan_; }
+
+  /// Yen's algorithm. Each new path is found by searching from every node
+  /// (the spur node) of the previous path with its prefix (the root path)
+  /// and the edges already used after that root masked out. The spur
+  /// searches of a path run in parallel; the graph itself is not copied or
+  /// modified.
+  static KShortestSimplePathsPlan Yen(ShortestPathPlan search_plan = {}) {
+    return {kCPU, kYen, search_plan};
+  }
+};
+
+/// A path between two nodes
+struct KATANA_EXPORT ShortestPath {
+  /// The sum of the edge weights along the path, or infinity if the target is
+  /// not reachable from the source.
+  double distance;
+  /// The nodes of the path from the source to the target, inclusive. Empty if
+  /// the target is not reachable from the source.
+  std::vector<uint32_t> path;
+  /// The number of nodes whose distance was finalized by the search. For k
+  /// shortest simple paths, the number finalized by all searches together.
+  uint64_t n_settled_nodes;
+
+  /// Print the path in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+};
+
+/// Answers repeated point-to-point shortest path queries on pg. Making a
+/// query object indexes the incoming edges of pg once; each query then
+/// touches only the nodes around the source and target that the search
+/// settles.
+///
+/// The edge weights are taken from the property named
+/// edge_weight_property_name (which may be a 32- or 64-bit sign or unsigned
+/// int, or a float or double) and must not be negative. The optional
+/// coordinate_property_names name numeric node properties that together
+/// give each node a position for A*.
+///
+/// The query object refers to pg, which must outlive it and must not be
+/// modified while it is in use.
+class KATANA_EXPORT ShortestPathQuery {
+public:
+  static Result<std::unique_ptr<ShortestPathQuery>> Make(
+      PropertyGraph* pg, const std::string& edge_weight_property_name,
+      const std::vector<std::string>& coordinate_property_names = {},
+      ShortestPathPlan plan = {});
+
+  virtual ~ShortestPathQuery();
+
+  /// Find a shortest path from source to target.
+  virtual Result<ShortestPath> Find(uint32_t source, uint32_t target) = 0;
+
+  /// Find up to k shortest paths from source to target that do not repeat
+  /// nodes, in order of increasing distance. Fewer than k paths are returned
+  /// if there are not that many simple paths. The search plan of plan is
+  /// ignored; searches use the plan this query was made with.
+  virtual Result<std::vector<ShortestPath>> FindKShortestSimplePaths(
+      uint32_t source, uint32_t target, uint32_t k,
+      KShortestSimplePathsPlan plan) = 0;
+};
+
+/// Find a shortest path in pg from source to target. This is a single query
+/// on a ShortestPathQuery; use ShortestPathQuery directly to answer several
+/// queries on the same graph.
+KATANA_EXPORT Result<ShortestPath> FindShortestPath(
+    PropertyGraph* pg, uint32_t source, uint32_t target,
+    const std::string& edge_weight_property_name,
+    const std::vector<std::string>& coordinate_property_names = {},
+    ShortestPathPlan plan = {});
+
+/// Find up to k shortest simple paths in pg from source to target, in order
+/// of increasing distance. This is a single query on a ShortestPathQuery made
+/// with the search plan of plan.
+KATANA_EXPORT Result<std::vector<ShortestPath>> KShortestSimplePaths(
+    PropertyGraph* pg, uint32_t source, uint32_t target, uint32_t k,
+    const std::string& edge_weight_property_name,
+    const std::vector<std::string>& coordinate_property_names = {},
+    KShortestSimplePathsPlan plan = {});
+
+}  // namespace katana::analytics
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_SIMILARITYJOIN_SIMILARITYJOIN_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_SIMILARITYJOIN_SIMILARITYJOIN_H_
+
+#include <memory>
+
+#include <arrow/api.h>
+
+#include "katana/PropertyGraph.h"
+#include "katana/analytics/Plan.h"
+
+namespace katana::analytics {
+
+/// A computational plan for the all-pairs top-k similarity join, specifying
+/// the algorithm and any parameters associated with it.
+class SimilarityJoinPlan : public Plan {
+public:
+  enum Algorithm {
+    kMinHashLsh,
+  };
+
+  /// The similarity of the out-neighbor sets of two nodes
+  enum Measure {
+    /// |A & B| / |A | B|
+    kJaccard,
+    /// |A & B| / sqrt(|A| |B|)
+    kCosine,
+  };
+
+  static const uint32_t kDefaultNumBands = 16;
+  static const uint32_t kDefaultRowsPerBand = 4;
+  static const uint32_t kDefaultMaxBucketSize = 256;
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+  Measure measure_;
+  uint32_t num_bands_;
+  uint32_t rows_per_band_;
+  uint32_t max_bucket_size_;
+
+  SimilarityJoinPlan(
+      Architecture architecture, Algorithm algorithm, Measure measure,
+      uint32_t num_bands, uint32_t rows_per_band, uint32_t max_bucket_size)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        measure_(measure),
+        num_bands_(num_bands),
+        rows_per_band_(rows_per_band),
+        max_bucket_size_(max_bucket_size) {}
+
+public:
+  SimilarityJoinPlan()
+      : SimilarityJoinPlan(
+            kCPU, kMinHashLsh, kJaccard, kDefaultNumBands, kDefaultRowsPerBand,
+            kDefaultMaxBucketSize) {}
+
+  Algorithm algorithm() const { return algorithm_; }
+  Measure measure() const { return measure_; }
+  uint32_t num_bands() const { return num_bands_; }
+  uint32_t rows_per_band() const { return rows_per_band_; }
+  uint32_t max_bucket_size() const { return max_bucket_size_; }
+
+  /// MinHash locality sensitive hashing
+  ///
+  /// Each node gets num_bands * rows_per_band MinHash values of its
+  /// out-neighbors. Nodes whose values agree on all rows of some band become
+  /// candidate pairs, and only candidates are compared exactly. A pair with
+  /// Jaccard similarity s is a candidate with probability
+  /// 1 - (1 - s^rows_per_band)^num_bands, so more bands find more pairs and
+  /// more rows per band generate fewer dissimilar candidates. Within a bucket
+  /// of more than max_bucket_size nodes, each node is only paired with the
+  /// next max_bucket_size nodes of the bucket, which bounds the work on hubs.
+  ///
+  /// Cosine similarity uses the same candidates since it is at least the
+  /// Jaccard similarity.
+  static SimilarityJoinPlan MinHashLsh(
+      Measure measure = kJaccard, uint32_t num_bands = kDefaultNumBands,
+      uint32_t rows_per_band = kDefaultRowsPerBand,
+      uint32_t max_bucket_size = kDefaultMaxBucketSize) {
+    return SimilarityJoinPlan(
+        kCPU, kMinHashLsh, measure, num_bands, rows_per_band,
+        max_bucket_size);
+  }
+};
+
+/// Find, for each node of pg, up to k other nodes with the most similar set of
+/// out-neighbors. Nodes without out-edges are not compared.
+///
+/// The result is a k-nearest-neighbor edge list: a table with the uint32
+/// columns "source" and "destination" and the double column "similarity". The
+/// rows of each source are consecutive and in order of decreasing
+/// similarity, and every similarity is positive. The graph is not modified.
+KATANA_EXPORT Result<std::shared_ptr<arrow::Table>> SimilarityJoin(
+    PropertyGraph* pg, uint32_t k, SimilarityJoinPlan plan = {});
+
+}  // namespace katana::analytics
+
+#endif
@@ -2,6 +2,8 @@
 #define KATANA_LIBGALOIS_KATANA_ANALYTICS_SSSP_SSSP_H_
 
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include "katana/AtomicHelpers.h"
 #include "katana/analytics/Plan.h"
@@ -126,6 +128,26 @@ KATANA_EXPORT Result<void> Sssp(
     const std::string& edge_weight_property_name,
     const std::string& output_property_name, SsspPlan plan = {});
 
+/// Number of sources that BatchedSssp relaxes together
+constexpr uint32_t kBatchedSsspLanes = 16;
+
+/// Compute the Single-Source Shortest Path for pg from each node in sources.
+/// The path lengths from sources[i] are stored in the property named
+/// output_property_names[i], with the same type as the edge weights. The
+/// properties are created by this function and may not exist before the
+/// call.
+///
+/// Sources are processed kBatchedSsspLanes at a time. Every node holds one
+/// distance lane per source of the batch, and a single delta-stepping
+/// traversal relaxes an edge for all lanes that improved at its source.
+/// Edge weights and working arrays are set up once for all batches. Only the
+/// kDeltaStep and kDeltaStepBarrier plans are supported; kAutomatic chooses
+/// between them.
+KATANA_EXPORT Result<void> BatchedSssp(
+    PropertyGraph* pg, const std::vector<uint32_t>& sources,
+    const std::string& edge_weight_property_name,
+    const std::vector<std::string>& output_property_names, SsspPlan plan = {});
+
 KATANA_EXPORT Result<void> SsspAssertValid(
     PropertyGraph* pg, size_t start_node,
     const std::string& edge_weight_property_name,
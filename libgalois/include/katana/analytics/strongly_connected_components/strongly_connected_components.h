@@ -0,0 +1,97 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_STRONGLYCONNECTEDCOMPONENTS_STRONGLYCONNECTEDCOMPONENTS_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_STRONGLYCONNECTEDCOMPONENTS_STRONGLYCONNECTEDCOMPONENTS_H_
+
+#include <iostream>
+#include <string>
+
+#include "katana/PropertyGraph.h"
+#include "katana/analytics/Plan.h"
+
+namespace katana::analytics {
+
+/// A computational plan for StronglyConnectedComponents, specifying the
+/// algorithm and any parameters associated with it.
+class StronglyConnectedComponentsPlan : public Plan {
+public:
+  enum Algorithm {
+    kMultistep,
+    kColoring,
+  };
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+
+  StronglyConnectedComponentsPlan(
+      Architecture architecture, Algorithm algorithm)
+      : Plan(architecture), algorithm_(algorithm) {}
+
+public:
+  StronglyConnectedComponentsPlan()
+      : StronglyConnectedComponentsPlan(kCPU, kMultistep) {}
+
+  StronglyConnectedComponentsPlan& operator=(
+      const StronglyConnectedComponentsPlan&) = default;
+
+  Algorithm algorithm() const { return algorithm_; }
+
+  /// Trim the nodes that have no incoming or no outgoing edges, which are
+  /// components of their own, repeatedly. Then find the component of the node
+  /// with the most incoming and outgoing edges, which is usually the giant
+  /// component of a small-world graph, as the intersection of a forward and a
+  /// backward search from it. The remaining nodes are split by coloring (see
+  /// Coloring).
+  ///
+  /// Slota, George M., Sivasankaran Rajamanickam, and Kamesh Madduri. "BFS
+  /// and coloring-based parallel algorithms for strongly connected components
+  /// and related problems." IPDPS 2014.
+  static StronglyConnectedComponentsPlan Multistep() {
+    return {kCPU, kMultistep};
+  }
+
+  /// Trim, and then repeatedly propagate the largest node ID forward as a
+  /// color until no color changes. Every node whose color is its own ID is
+  /// the root of a component, made of the nodes of its color that reach it,
+  /// which are found by a backward search from all roots at once. The nodes
+  /// left are trimmed again before the next round.
+  ///
+  /// Orzan, Simona. "On distributed verification and verified
+  /// distribution." PhD thesis, Vrije Universiteit Amsterdam, 2004.
+  static StronglyConnectedComponentsPlan Coloring() {
+    return {kCPU, kColoring};
+  }
+};
+
+/// Compute the strongly connected components of pg, following the direction
+/// of the edges. The ID of a component is the smallest ID of its nodes.
+/// The property named output_property_name is created by this function and
+/// may not exist before the call. The created property is a uint64 node
+/// property.
+KATANA_EXPORT Result<void> StronglyConnectedComponents(
+    PropertyGraph* pg, const std::string& output_property_name,
+    StronglyConnectedComponentsPlan plan = {});
+
+KATANA_EXPORT Result<void> StronglyConnectedComponentsAssertValid(
+    PropertyGraph* pg, const std::string& property_name);
+
+struct KATANA_EXPORT StronglyConnectedComponentsStatistics {
+  /// Total number of strongly connected components in the graph.
+  uint64_t total_components;
+  /// Total number of components with more than 1 node.
+  uint64_t total_non_trivial_components;
+  /// The number of nodes present in the largest component.
+  uint64_t largest_component_size;
+  /// The ratio of nodes present in the largest component.
+  double largest_component_ratio;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<StronglyConnectedComponentsStatistics> Compute(
+      PropertyGraph* pg, const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+
+#endif
@@ -0,0 +1,305 @@
+#include "katana/PropertyExport.h"
+
+#include <algorithm>
+#include <functional>
+
+#include <arrow/array/concatenate.h>
+
+#include "katana/Logging.h"
+#include "katana/Loops.h"
+#include "katana/Result.h"
+#include "katana/Threads.h"
+#include "katana/URI.h"
+#include "tsuba/ArrowIPC.h"
+#include "tsuba/ParquetWriter.h"
+#include "tsuba/WriteGroup.h"
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+using Edge = katana::GraphTopology::Edge;
+
+/// Import ids of the local nodes as one contiguous array, or null if the
+/// graph does not have usable import ids
+katana::Result<std::shared_ptr<arrow::UInt64Array>>
+GetUserIDs(const katana::PropertyGraph& pg) {
+  const auto& ids = pg.local_to_user_id();
+  if (!ids || ids->length() != static_cast<int64_t>(pg.num_nodes()) ||
+      ids->type()->id() != arrow::Type::UINT64) {
+    return nullptr;
+  }
+  std::shared_ptr<arrow::Array> flat;
+  if (ids->num_chunks() == 1) {
+    flat = ids->chunk(0);
+  } else if (ids->num_chunks() == 0) {
+    flat = KATANA_CHECKED(arrow::MakeArrayOfNull(ids->type(), 0));
+  } else {
+    flat = KATANA_CHECKED(
+        arrow::Concatenate(ids->chunks(), arrow::default_memory_pool()));
+  }
+  return std::static_pointer_cast<arrow::UInt64Array>(flat);
+}
+
+/// Gather the named properties into a table, sharing the property arrays
+katana::Result<std::shared_ptr<arrow::Table>>
+SelectColumns(
+    const std::shared_ptr<arrow::Schema>& schema,
+    const std::function<std::shared_ptr<arrow::ChunkedArray>(
+        const std::string&)>& get_property,
+    const std::vector<std::string>& properties, int64_t num_rows) {
+  std::vector<std::shared_ptr<arrow::Field>> fields;
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+  for (const auto& name : properties) {
+    auto field = schema->GetFieldByName(name);
+    if (!field) {
+      return KATANA_ERROR(
+          katana::ErrorCode::PropertyNotFound, "no property named {}", name);
+    }
+    fields.emplace_back(field);
+    columns.emplace_back(get_property(name));
+  }
+  return arrow::Table::Make(arrow::schema(fields), columns, num_rows);
+}
+
+/// Allocate a buffer of length elements of T and fill it in parallel with
+/// fn(i) for i in [0, length)
+template <typename T, typename F>
+katana::Result<std::shared_ptr<arrow::Array>>
+MakeColumn(int64_t length, F fn) {
+  std::shared_ptr<arrow::Buffer> buf =
+      KATANA_CHECKED(arrow::AllocateBuffer(length * sizeof(T)));
+  T* data = reinterpret_cast<T*>(buf->mutable_data());
+  katana::do_all(
+      katana::iterate(int64_t{0}, length), [&](int64_t i) { data[i] = fn(i); },
+      katana::no_stats());
+  using ArrowType = typename arrow::CTypeTraits<T>::ArrowType;
+  return std::make_shared<arrow::NumericArray<ArrowType>>(length, buf);
+}
+
+/// Zero-copy view of a range of local node ids translated to import ids when
+/// the graph has them
+katana::Result<std::shared_ptr<arrow::Array>>
+NodeIDColumn(
+    const std::shared_ptr<arrow::UInt64Array>& user_ids, int64_t offset,
+    int64_t length) {
+  if (user_ids) {
+    return user_ids->Slice(offset, length);
+  }
+  return MakeColumn<Node>(
+      length, [offset](int64_t i) { return static_cast<Node>(offset + i); });
+}
+
+/// Source ids of the edges [offset, offset + length)
+katana::Result<std::shared_ptr<arrow::Array>>
+EdgeSourceColumn(
+    const katana::GraphTopology& topo,
+    const std::shared_ptr<arrow::UInt64Array>& user_ids, int64_t offset,
+    int64_t length) {
+  if (length == 0) {
+    // There are no first and last sources to look up
+    if (!user_ids) {
+      return MakeColumn<Node>(0, [](int64_t) { return Node{0}; });
+    }
+    return MakeColumn<uint64_t>(0, [](int64_t) { return uint64_t{0}; });
+  }
+
+  const Edge* adj = topo.adj_data();
+  const Node first =
+      std::upper_bound(adj, adj + topo.num_nodes(), Edge(offset)) - adj;
+  const Node last =
+      std::upper_bound(adj, adj + topo.num_nodes(), Edge(offset + length - 1)) -
+      adj;
+
+  // Materialize the local sources node by node, then translate them if
+  // needed. Edge ranges of different nodes are disjoint so nodes can be
+  // filled in parallel.
+  std::shared_ptr<arrow::Buffer> buf =
+      KATANA_CHECKED(arrow::AllocateBuffer(length * sizeof(Node)));
+  Node* sources = reinterpret_cast<Node*>(buf->mutable_data());
+  katana::do_all(
+      katana::iterate(first, last + 1),
+      [&](Node n) {
+        Edge begin = std::max<Edge>(n == 0 ? 0 : adj[n - 1], offset);
+        Edge end = std::min<Edge>(adj[n], offset + length);
+        for (Edge e = begin; e < end; ++e) {
+          sources[e - offset] = n;
+        }
+      },
+      katana::no_stats());
+
+  if (!user_ids) {
+    return std::make_shared<arrow::UInt32Array>(length, buf);
+  }
+  return MakeColumn<uint64_t>(
+      length, [&](int64_t i) { return user_ids->Value(sources[i]); });
+}
+
+/// Destination ids of the edges [offset, offset + length)
+katana::Result<std::shared_ptr<arrow::Array>>
+EdgeDestinationColumn(
+    const katana::GraphTopology& topo,
+    const std::shared_ptr<arrow::UInt64Array>& user_ids, int64_t offset,
+    int64_t length) {
+  const Node* dests = topo.dest_data() + offset;
+  if (!user_ids) {
+    return katana::ProjectAsArrowArray(dests, length);
+  }
+  return MakeColumn<uint64_t>(
+      length, [&](int64_t i) { return user_ids->Value(dests[i]); });
+}
+
+/// Start encoding and writing a chunk as an op of desc. The op runs
+/// concurrently with the caller and with the other chunks; desc bounds how
+/// many are in flight.
+katana::Result<void>
+StartStoreChunk(
+    std::shared_ptr<arrow::Table> table, const katana::Uri& uri,
+    katana::ExportOptions::Format format, tsuba::WriteGroup* desc) {
+  switch (format) {
+  case katana::ExportOptions::Format::kParquet: {
+    auto writer = KATANA_CHECKED(tsuba::ParquetWriter::Make(std::move(table)));
+    return writer->WriteToUri(uri, desc);
+  }
+  case katana::ExportOptions::Format::kArrowIPC:
+    return tsuba::WriteArrowIPC(std::move(table), uri, desc);
+  default:
+    return KATANA_ERROR(katana::ErrorCode::InvalidArgument, "unknown format");
+  }
+}
+
+/// Function producing the id columns prepended to the chunk of rows
+/// [offset, offset + length)
+using IDColumnsFn =
+    std::function<katana::Result<std::vector<std::shared_ptr<arrow::Array>>>(
+        int64_t offset, int64_t length)>;
+
+katana::Result<void>
+ExportTable(
+    const std::shared_ptr<arrow::Table>& table,
+    const std::vector<std::shared_ptr<arrow::Field>>& id_fields,
+    const IDColumnsFn& id_columns, const std::string& uri_prefix,
+    const katana::ExportOptions& opts) {
+  if (opts.rows_per_file == 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "rows_per_file must be positive");
+  }
+  auto uri = KATANA_CHECKED(katana::Uri::Make(uri_prefix));
+
+  std::vector<std::shared_ptr<arrow::Field>> fields(id_fields);
+  const auto& prop_fields = table->schema()->fields();
+  fields.insert(fields.end(), prop_fields.begin(), prop_fields.end());
+  auto schema = arrow::schema(fields);
+
+  auto wg_opts = tsuba::WriteGroup::Options::Defaults();
+  uint32_t max_files = opts.max_concurrent_files > 0
+                           ? opts.max_concurrent_files
+                           : katana::getActiveThreads();
+  if (wg_opts.max_concurrent_ops == 0 ||
+      wg_opts.max_concurrent_ops > max_files) {
+    wg_opts.max_concurrent_ops = max_files;
+  }
+  auto desc = KATANA_CHECKED(tsuba::WriteGroup::Make(wg_opts));
+
+  katana::Result<void> ret = katana::ResultSuccess();
+  const int64_t num_rows = table->num_rows();
+  const int64_t rows_per_file = opts.rows_per_file;
+  // Always produce at least one file so that an empty export is still
+  // readable with the right schema
+  for (int64_t offset = 0, i = 0; offset < num_rows || i == 0;
+       offset += rows_per_file, ++i) {
+    int64_t length = std::min(rows_per_file, num_rows - offset);
+
+    std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+    if (!id_fields.empty()) {
+      auto ids_res = id_columns(offset, length);
+      if (!ids_res) {
+        ret = ids_res.error();
+        break;
+      }
+      for (auto& arr : ids_res.value()) {
+        columns.emplace_back(std::make_shared<arrow::ChunkedArray>(arr));
+      }
+    }
+    // Slicing a chunked array shares the underlying buffers
+    for (const auto& col : table->columns()) {
+      columns.emplace_back(col->Slice(offset, length));
+    }
+
+    ret = StartStoreChunk(
+        arrow::Table::Make(schema, columns, length),
+        uri + fmt::format(".{:06}", i), opts.format, desc.get());
+    if (!ret) {
+      break;
+    }
+  }
+
+  auto final_ret = desc->Finish();
+  if (!final_ret && !ret) {
+    KATANA_LOG_ERROR("multiple errors, masking: {}", final_ret.error());
+    return ret;
+  }
+  if (!ret) {
+    return ret;
+  }
+  return final_ret;
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::ExportNodeProperties(
+    const PropertyGraph& pg, const std::vector<std::string>& properties,
+    const std::string& uri_prefix, const ExportOptions& opts) {
+  auto table = KATANA_CHECKED(SelectColumns(
+      pg.node_schema(),
+      [&](const std::string& name) { return pg.GetNodeProperty(name); },
+      properties, pg.num_nodes()));
+  if (!opts.include_ids) {
+    return ExportTable(table, {}, nullptr, uri_prefix, opts);
+  }
+
+  auto user_ids = KATANA_CHECKED(GetUserIDs(pg));
+  auto id_type = user_ids ? arrow::uint64() : arrow::uint32();
+  return ExportTable(
+      table, {arrow::field("id", id_type)},
+      [&](int64_t offset, int64_t length)
+          -> katana::Result<std::vector<std::shared_ptr<arrow::Array>>> {
+        auto ids = KATANA_CHECKED(NodeIDColumn(user_ids, offset, length));
+        return std::vector<std::shared_ptr<arrow::Array>>{ids};
+      },
+      uri_prefix, opts);
+}
+
+katana::Result<void>
+katana::ExportEdgeProperties(
+    const PropertyGraph& pg, const std::vector<std::string>& properties,
+    const std::string& uri_prefix, const ExportOptions& opts) {
+  auto table = KATANA_CHECKED(SelectColumns(
+      pg.edge_schema(),
+      [&](const std::string& name) { return pg.GetEdgeProperty(name); },
+      properties, pg.num_edges()));
+  if (!opts.include_ids) {
+    return ExportTable(table, {}, nullptr, uri_prefix, opts);
+  }
+
+  auto user_ids = KATANA_CHECKED(GetUserIDs(pg));
+  auto id_type = user_ids ? arrow::uint64() : arrow::uint32();
+  const GraphTopology& topo = pg.topology();
+  return ExportTable(
+      table,
+      {arrow::field("source", id_type), arrow::field("destination", id_type)},
+      [&](int64_t offset, int64_t length)
+          -> katana::Result<std::vector<std::shared_ptr<arrow::Array>>> {
+        if (length == 0) {
+          return std::vector<std::shared_ptr<arrow::Array>>{
+              KATANA_CHECKED(arrow::MakeArrayOfNull(id_type, 0)),
+              KATANA_CHECKED(arrow::MakeArrayOfNull(id_type, 0))};
+        }
+        auto sources =
+            KATANA_CHECKED(EdgeSourceColumn(topo, user_ids, offset, length));
+        auto dests = KATANA_CHECKED(
+            EdgeDestinationColumn(topo, user_ids, offset, length));
+        return std::vector<std::shared_ptr<arrow::Array>>{sources, dests};
+      },
+      uri_prefix, opts);
+}
@@ -9,6 +9,7 @@
 #include "katana/Platform.h"
 #include "katana/Properties.h"
 #include "katana/Result.h"
+#include "katana/Statistics.h"
 #include "tsuba/Errors.h"
 #include "tsuba/FileFrame.h"
 #include "tsuba/RDG.h"
@@ -493,16 +494,28 @@ katana::Result<void>
 katana::PropertyGraph::DoWrite(
     tsuba::RDGHandle handle, const std::string& command_line,
     tsuba::RDG::RDGVersioningPolicy versioning_action) {
+  std::unique_ptr<tsuba::FileFrame> topology_ff;
   if (!rdg_.topology_file_storage().Valid()) {
     auto result = WriteTopology(topology());
     if (!result) {
       return result.error();
     }
-    return rdg_.Store(
-        handle, command_line, versioning_action, std::move(result.value()));
+    topology_ff = std::move(result.value());
   }
 
-  return rdg_.Store(handle, command_line, versioning_action);
+  auto res = rdg_.Store(
+      handle, command_line, versioning_action, std::move(topology_ff));
+
+  const auto& stats = rdg_.last_store_stats();
+  katana::ReportStatSingle("PropertyGraph", "WriteBytes", stats.bytes_written);
+  katana::ReportStatSingle("PropertyGraph", "WriteTimeNs", stats.elapsed_ns);
+  katana::ReportStatSingle("PropertyGraph", "WriteEncodeNs", stats.encode_ns);
+  katana::ReportStatSingle("PropertyGraph", "WriteIONs", stats.io_ns);
+  katana::ReportStatSingle("PropertyGraph", "WriteStallNs", stats.stall_ns);
+  katana::ReportStatSingle(
+      "PropertyGraph", "WriteThroughputMBps", stats.Throughput() / (1 << 20));
+
+  return res;
 }
 
 katana::Result<void>
@@ -809,6 +822,41 @@ katana::PropertyGraph::InformPath(const std::string& input_path) {
   return ResultSuccess();
 }
 
+katana::Result<void>
+katana::PropertyGraph::ReplaceTopology(
+    GraphTopology&& topology,
+    const std::shared_ptr<arrow::Table>& node_props,
+    const std::shared_ptr<arrow::Table>& edge_props) {
+  if (node_props->num_columns() > 0 &&
+      topology.num_nodes() != static_cast<uint64_t>(node_props->num_rows())) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "expected {} node rows found {} instead",
+        topology.num_nodes(), node_props->num_rows());
+  }
+  if (edge_props->num_columns() > 0 &&
+      topology.num_edges() != static_cast<uint64_t>(edge_props->num_rows())) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "expected {} edge rows found {} instead",
+        topology.num_edges(), edge_props->num_rows());
+  }
+  // An unloaded property is only in storage, so it cannot be rebuilt for
+  // the new topology, and its stale record must not be committed. The
+  // properties are replaced first, and leave the graph unchanged if they
+  // cannot be.
+  KATANA_CHECKED_CONTEXT(
+      rdg_.ReplaceProperties(node_props, edge_props), "replacing the topology");
+
+  // The topology in storage no longer describes this graph; unbinding it
+  // makes the next store write out topology_.
+  topology_ = std::move(topology);
+  KATANA_CHECKED(rdg_.UnbindTopologyFileStorage());
+
+  if (node_type_set_id_.size() > 0 || edge_type_set_id_.size() > 0) {
+    return ConstructTypeSetIDs();
+  }
+  return katana::ResultSuccess();
+}
+
 katana::Result<std::unique_ptr<katana::NUMAArray<uint64_t>>>
 katana::SortAllEdgesByDest(katana::PropertyGraph* pg) {
   // TODO(amber): This function will soon change so that it produces a new sorted
@@ -0,0 +1,385 @@
+#include "katana/PropertyGraphDelta.h"
+
+#include <mutex>
+#include <numeric>
+
+#include <arrow/compute/api.h>
+
+#include "katana/ArrowInterchange.h"
+#include "katana/Loops.h"
+#include "katana/ParallelSTL.h"
+#include "katana/Reduction.h"
+#include "katana/Result.h"
+
+namespace {
+
+using Node = katana::PropertyGraphDelta::Node;
+using Edge = katana::PropertyGraphDelta::Edge;
+
+/// Check that the properties of a batch of inserted rows can be appended to
+/// properties with the given schema.
+katana::Result<void>
+CheckBatch(
+    const std::shared_ptr<arrow::Table>& props, uint64_t num_rows,
+    const std::shared_ptr<arrow::Schema>& schema) {
+  if (!props) {
+    return katana::ResultSuccess();
+  }
+  if (static_cast<uint64_t>(props->num_rows()) != num_rows) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "expected {} rows found {} instead",
+        num_rows, props->num_rows());
+  }
+  for (const auto& field : props->schema()->fields()) {
+    auto existing = schema->GetFieldByName(field->name());
+    if (!existing) {
+      return KATANA_ERROR(
+          katana::ErrorCode::PropertyNotFound, "no property named {}",
+          field->name());
+    }
+    if (!existing->type()->Equals(field->type())) {
+      return KATANA_ERROR(
+          katana::ErrorCode::TypeError,
+          "property {} has type {} but inserted rows have type {}",
+          field->name(), existing->type()->ToString(),
+          field->type()->ToString());
+    }
+  }
+  return katana::ResultSuccess();
+}
+
+/// Append the rows of each batch to the properties in view and gather the
+/// rows of the result in the order given by rows.
+template <typename Batches>
+katana::Result<std::shared_ptr<arrow::Table>>
+MergeProperties(
+    const katana::PropertyGraph::ReadOnlyPropertyView& view,
+    const Batches& batches, const katana::NUMAArray<int64_t>& rows) {
+  std::shared_ptr<arrow::Schema> schema = view.schema();
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+  if (schema->num_fields() == 0) {
+    return arrow::Table::Make(schema, columns, 0);
+  }
+
+  auto indices = katana::ProjectAsArrowArray(rows.data(), rows.size());
+
+  for (int i = 0, n = schema->num_fields(); i < n; ++i) {
+    const std::shared_ptr<arrow::Field>& field = schema->field(i);
+    arrow::ArrayVector chunks = view.GetProperty(i)->chunks();
+    for (const auto& batch : batches) {
+      std::shared_ptr<arrow::ChunkedArray> inserted =
+          batch.props ? batch.props->GetColumnByName(field->name()) : nullptr;
+      if (!inserted) {
+        inserted = katana::NullChunkedArray(field->type(), batch.num_rows);
+        if (!inserted) {
+          return KATANA_ERROR(
+              katana::ErrorCode::ArrowError,
+              "cannot make null rows for property {}", field->name());
+        }
+      }
+      chunks.insert(
+          chunks.end(), inserted->chunks().begin(), inserted->chunks().end());
+    }
+    auto appended = std::make_shared<arrow::ChunkedArray>(
+        std::move(chunks), field->type());
+    arrow::Datum taken =
+        KATANA_CHECKED(arrow::compute::Take(appended, indices));
+    columns.emplace_back(taken.chunked_array());
+  }
+
+  return arrow::Table::Make(schema, columns, rows.size());
+}
+
+}  // namespace
+
+katana::PropertyGraphDelta::PropertyGraphDelta(PropertyGraph* pg) : pg_(pg) {
+  removed_nodes_.resize(pg_->num_nodes());
+  removed_edges_.resize(pg_->num_edges());
+}
+
+bool
+katana::PropertyGraphDelta::HasUpdates() const {
+  return num_inserted_nodes_ > 0 || !inserted_srcs_.empty() ||
+         removed_nodes_.count() > 0 || removed_edges_.count() > 0;
+}
+
+katana::Result<void>
+katana::PropertyGraphDelta::CheckNodes(const std::vector<Node>& nodes) const {
+  katana::GReduceMax<Node> max_node;
+  katana::do_all(
+      katana::iterate(nodes), [&](Node n) { max_node.update(n); },
+      katana::no_stats());
+  if (!nodes.empty() && max_node.reduce() >= num_nodes()) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "node {} does not exist ({} nodes)",
+        max_node.reduce(), num_nodes());
+  }
+  return katana::ResultSuccess();
+}
+
+void
+katana::PropertyGraphDelta::GroupInsertedEdges() const {
+  std::lock_guard<std::mutex> lock(group_mutex_);
+  if (inserted_grouped_.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  // A counting sort by source, which keeps insertion order within a source.
+  // It is serial so that queries can be made from parallel loops.
+  const uint64_t num_ids = num_nodes();
+  const uint64_t num_inserted_edges = inserted_srcs_.size();
+  inserted_offsets_.assign(num_ids + 1, 0);
+  for (Node src : inserted_srcs_) {
+    ++inserted_offsets_[src + 1];
+  }
+  std::partial_sum(
+      inserted_offsets_.begin(), inserted_offsets_.end(),
+      inserted_offsets_.begin());
+
+  std::vector<uint64_t> next(
+      inserted_offsets_.begin(), inserted_offsets_.end() - 1);
+  inserted_order_.resize(num_inserted_edges);
+  for (uint64_t i = 0; i < num_inserted_edges; ++i) {
+    inserted_order_[next[inserted_srcs_[i]]++] = i;
+  }
+
+  inserted_grouped_.store(true, std::memory_order_release);
+}
+
+katana::Result<katana::PropertyGraphDelta::Node>
+katana::PropertyGraphDelta::AddNodes(
+    uint64_t num_new_nodes, const std::shared_ptr<arrow::Table>& props) {
+  if (num_nodes() + num_new_nodes > kRemovedNode) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "cannot have more than {} nodes",
+        kRemovedNode);
+  }
+  KATANA_CHECKED(CheckBatch(props, num_new_nodes, pg_->node_schema()));
+
+  Node first = num_nodes();
+  num_inserted_nodes_ += num_new_nodes;
+  node_batches_.emplace_back(Batch{num_new_nodes, props});
+  removed_nodes_.resize(num_nodes());
+  return first;
+}
+
+katana::Result<void>
+katana::PropertyGraphDelta::AddEdges(
+    const std::vector<Node>& srcs, const std::vector<Node>& dsts,
+    const std::shared_ptr<arrow::Table>& props) {
+  if (srcs.size() != dsts.size()) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "{} sources but {} destinations",
+        srcs.size(), dsts.size());
+  }
+  KATANA_CHECKED(CheckNodes(srcs));
+  KATANA_CHECKED(CheckNodes(dsts));
+  KATANA_CHECKED(CheckBatch(props, srcs.size(), pg_->edge_schema()));
+
+  inserted_srcs_.insert(inserted_srcs_.end(), srcs.begin(), srcs.end());
+  inserted_dsts_.insert(inserted_dsts_.end(), dsts.begin(), dsts.end());
+  edge_batches_.emplace_back(Batch{srcs.size(), props});
+  inserted_grouped_.store(false, std::memory_order_release);
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+katana::PropertyGraphDelta::RemoveEdges(const std::vector<Edge>& edges) {
+  katana::GReduceMax<Edge> max_edge;
+  katana::do_all(
+      katana::iterate(edges), [&](Edge e) { max_edge.update(e); },
+      katana::no_stats());
+  if (!edges.empty() && max_edge.reduce() >= pg_->num_edges()) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "edge {} does not exist ({} edges)",
+        max_edge.reduce(), pg_->num_edges());
+  }
+
+  katana::do_all(
+      katana::iterate(edges), [&](Edge e) { removed_edges_.set(e); },
+      katana::no_stats(), katana::loopname("RemoveEdges"));
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+katana::PropertyGraphDelta::RemoveEdges(
+    const std::vector<Node>& srcs, const std::vector<Node>& dsts) {
+  if (srcs.size() != dsts.size()) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "{} sources but {} destinations",
+        srcs.size(), dsts.size());
+  }
+  KATANA_CHECKED(CheckNodes(srcs));
+  KATANA_CHECKED(CheckNodes(dsts));
+
+  const GraphTopology& topology = pg_->topology();
+  katana::do_all(
+      katana::iterate(size_t{0}, srcs.size()),
+      [&](size_t i) {
+        // Inserted nodes have no edges in the graph yet
+        if (srcs[i] >= topology.num_nodes()) {
+          return;
+        }
+        for (Edge e : topology.edges(srcs[i])) {
+          if (topology.edge_dest(e) == dsts[i]) {
+            removed_edges_.set(e);
+          }
+        }
+      },
+      katana::steal(), katana::no_stats(),
+      katana::loopname("RemoveEdgesByEndpoints"));
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+katana::PropertyGraphDelta::RemoveNodes(const std::vector<Node>& nodes) {
+  KATANA_CHECKED(CheckNodes(nodes));
+  katana::do_all(
+      katana::iterate(nodes), [&](Node n) { removed_nodes_.set(n); },
+      katana::no_stats(), katana::loopname("RemoveNodes"));
+  return katana::ResultSuccess();
+}
+
+katana::Result<katana::NUMAArray<katana::PropertyGraphDelta::Node>>
+katana::PropertyGraphDelta::Merge() {
+  KATANA_CHECKED_CONTEXT(pg_->CheckPropertiesLoaded(), "merging updates");
+
+  const GraphTopology& topology = pg_->topology();
+  const uint64_t num_old_nodes = topology.num_nodes();
+  const uint64_t num_old_edges = topology.num_edges();
+  const uint64_t num_ids = num_nodes();
+  const uint64_t num_inserted_edges = inserted_srcs_.size();
+
+  // Compact the IDs of the nodes that remain.
+  NUMAArray<Node> new_ids;
+  new_ids.allocateInterleaved(num_ids);
+  NUMAArray<uint64_t> num_kept;
+  num_kept.allocateInterleaved(num_ids);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_ids),
+      [&](uint64_t n) { num_kept[n] = IsNodeRemoved(n) ? 0 : 1; },
+      katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      num_kept.begin(), num_kept.end(), num_kept.begin());
+  const uint64_t num_new_nodes = num_ids > 0 ? num_kept[num_ids - 1] : 0;
+
+  NUMAArray<int64_t> node_rows;
+  node_rows.allocateInterleaved(num_new_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_ids),
+      [&](uint64_t n) {
+        if (IsNodeRemoved(n)) {
+          new_ids[n] = kRemovedNode;
+          return;
+        }
+        new_ids[n] = num_kept[n] - 1;
+        node_rows[num_kept[n] - 1] = n;
+      },
+      katana::no_stats());
+
+  // Group the inserted edges by source so that each node has a contiguous
+  // range of inserted edges.
+  GroupInsertedEdges();
+  const uint64_t num_grouped_ids = inserted_offsets_.size() - 1;
+  auto inserted_begin = [&](uint64_t n) {
+    return n < num_grouped_ids ? inserted_offsets_[n] : num_inserted_edges;
+  };
+  auto inserted_end = [&](uint64_t n) {
+    return n < num_grouped_ids ? inserted_offsets_[n + 1] : num_inserted_edges;
+  };
+
+  auto kept_old_edge = [&](Edge e) {
+    return !removed_edges_.test(e) && !IsNodeRemoved(topology.edge_dest(e));
+  };
+  auto kept_inserted_edge = [&](uint64_t i) {
+    return !IsNodeRemoved(inserted_dsts_[inserted_order_[i]]);
+  };
+
+  NUMAArray<Edge> new_indices;
+  new_indices.allocateInterleaved(num_new_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_ids),
+      [&](uint64_t n) {
+        if (IsNodeRemoved(n)) {
+          return;
+        }
+        Edge degree = 0;
+        if (n < num_old_nodes) {
+          for (Edge e : topology.edges(n)) {
+            degree += kept_old_edge(e);
+          }
+        }
+        for (uint64_t i = inserted_begin(n); i < inserted_end(n); ++i) {
+          degree += kept_inserted_edge(i);
+        }
+        new_indices[new_ids[n]] = degree;
+      },
+      katana::steal(), katana::no_stats(),
+      katana::loopname("MergeCountEdges"));
+  katana::ParallelSTL::partial_sum(
+      new_indices.begin(), new_indices.end(), new_indices.begin());
+  const uint64_t num_new_edges =
+      num_new_nodes > 0 ? new_indices[num_new_nodes - 1] : 0;
+
+  NUMAArray<Node> new_dests;
+  new_dests.allocateInterleaved(num_new_edges);
+  NUMAArray<int64_t> edge_rows;
+  edge_rows.allocateInterleaved(num_new_edges);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_ids),
+      [&](uint64_t n) {
+        if (IsNodeRemoved(n)) {
+          return;
+        }
+        Edge out = new_ids[n] > 0 ? new_indices[new_ids[n] - 1] : 0;
+        if (n < num_old_nodes) {
+          for (Edge e : topology.edges(n)) {
+            if (kept_old_edge(e)) {
+              new_dests[out] = new_ids[topology.edge_dest(e)];
+              edge_rows[out] = e;
+              ++out;
+            }
+          }
+        }
+        for (uint64_t i = inserted_begin(n); i < inserted_end(n); ++i) {
+          if (kept_inserted_edge(i)) {
+            new_dests[out] = new_ids[inserted_dsts_[inserted_order_[i]]];
+            edge_rows[out] = num_old_edges + inserted_order_[i];
+            ++out;
+          }
+        }
+        KATANA_LOG_DEBUG_ASSERT(out == new_indices[new_ids[n]]);
+      },
+      katana::steal(), katana::no_stats(), katana::loopname("MergeFillEdges"));
+
+  std::shared_ptr<arrow::Table> node_props = KATANA_CHECKED(MergeProperties(
+      pg_->NodeReadOnlyPropertyView(), node_batches_, node_rows));
+  std::shared_ptr<arrow::Table> edge_props = KATANA_CHECKED(MergeProperties(
+      pg_->EdgeReadOnlyPropertyView(), edge_batches_, edge_rows));
+
+  KATANA_CHECKED(pg_->ReplaceTopology(
+      GraphTopology(std::move(new_indices), std::move(new_dests)), node_props,
+      edge_props));
+
+  num_inserted_nodes_ = 0;
+  node_batches_.clear();
+  inserted_srcs_.clear();
+  inserted_dsts_.clear();
+  edge_batches_.clear();
+  inserted_order_.clear();
+  inserted_offsets_.clear();
+  inserted_grouped_.store(false, std::memory_order_release);
+  removed_nodes_.clear();
+  removed_nodes_.resize(pg_->num_nodes());
+  removed_edges_.clear();
+  removed_edges_.resize(pg_->num_edges());
+
+  return katana::Result<NUMAArray<Node>>(std::move(new_ids));
+}
+
+katana::Result<katana::NUMAArray<katana::PropertyGraphDelta::Node>>
+katana::PropertyGraphDelta::Commit(const std::string& command_line) {
+  NUMAArray<Node> new_ids = KATANA_CHECKED(Merge());
+  KATANA_CHECKED(pg_->Commit(command_line));
+  return katana::Result<NUMAArray<Node>>(std::move(new_ids));
+}
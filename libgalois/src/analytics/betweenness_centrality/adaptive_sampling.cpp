@@ -0,0 +1,425 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2020, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "betweenness_centrality_impl.h"
+#include "katana/NUMAArray.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/Reduction.h"
+
+using katana::analytics::BetweennessCentralityPlan;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+
+constexpr static const uint32_t kUnvisited =
+    std::numeric_limits<uint32_t>::max();
+
+/// The number of checks of the stopping condition before reaching the
+/// maximum number of samples
+constexpr static const uint64_t kStoppingChecks = 100;
+constexpr static const uint64_t kMinSamplesPerRound = 1024;
+constexpr static const unsigned kSampleChunkSize = 16;
+
+/// The largest BFS level from root in topology over the nodes of component
+/// comp. Only nodes of the component are visited. dist must be kUnvisited for
+/// all of them and is restored before returning.
+uint32_t
+ComponentEccentricity(
+    const katana::GraphTopology& topology, const std::vector<uint32_t>& comp,
+    Node root, std::vector<uint32_t>* dist, std::vector<Node>* visited) {
+  visited->assign(1, root);
+  (*dist)[root] = 0;
+  uint32_t ecc = 0;
+  for (size_t i = 0; i < visited->size(); ++i) {
+    Node n = (*visited)[i];
+    ecc = (*dist)[n];
+    for (auto e : topology.edges(n)) {
+      Node dest = topology.edge_dest(e);
+      if (comp[dest] == comp[root] && (*dist)[dest] == kUnvisited) {
+        (*dist)[dest] = (*dist)[n] + 1;
+        visited->push_back(dest);
+      }
+    }
+  }
+  for (Node n : *visited) {
+    (*dist)[n] = kUnvisited;
+  }
+  return ecc;
+}
+
+/// An upper bound on the vertex diameter, the number of nodes on the longest
+/// shortest path of the graph.
+///
+/// A shortest path visits strongly connected components in topological
+/// order, and the part of it in one component is a shortest path of that
+/// component. Such a part has at most ecc_out(h) + ecc_in(h) + 1 nodes for
+/// any node h of the component, so the bound is the heaviest path of the
+/// component DAG with those weights. The components are found with Tarjan's
+/// algorithm, which finishes them in reverse topological order.
+uint64_t
+VertexDiameterBound(
+    const katana::GraphTopology& out, const katana::GraphTopology& in) {
+  uint64_t num_nodes = out.num_nodes();
+  std::vector<uint32_t> index(num_nodes, kUnvisited);
+  std::vector<uint32_t> low(num_nodes);
+  std::vector<uint32_t> comp(num_nodes, kUnvisited);
+  std::vector<Node> stack;
+  // Nodes of each component, grouped in the order components are finished
+  std::vector<Node> members;
+  std::vector<uint64_t> comp_begin;
+  std::vector<std::pair<Node, katana::GraphTopology::Edge>> calls;
+  uint32_t next_index = 0;
+
+  for (Node root = 0; root < num_nodes; ++root) {
+    if (index[root] != kUnvisited) {
+      continue;
+    }
+    index[root] = low[root] = next_index++;
+    stack.push_back(root);
+    calls.emplace_back(root, *out.edges(root).begin());
+    while (!calls.empty()) {
+      auto& [n, e] = calls.back();
+      if (e != *out.edges(n).end()) {
+        Node dest = out.edge_dest(e);
+        ++e;
+        if (index[dest] == kUnvisited) {
+          index[dest] = low[dest] = next_index++;
+          stack.push_back(dest);
+          calls.emplace_back(dest, *out.edges(dest).begin());
+        } else if (comp[dest] == kUnvisited) {
+          low[n] = std::min(low[n], index[dest]);
+        }
+        continue;
+      }
+
+      Node done = n;
+      calls.pop_back();
+      if (!calls.empty()) {
+        Node parent = calls.back().first;
+        low[parent] = std::min(low[parent], low[done]);
+      }
+      if (low[done] == index[done]) {
+        uint32_t id = comp_begin.size();
+        comp_begin.push_back(members.size());
+        Node member;
+        do {
+          member = stack.back();
+          stack.pop_back();
+          comp[member] = id;
+          members.push_back(member);
+        } while (member != done);
+      }
+    }
+  }
+  comp_begin.push_back(members.size());
+
+  std::vector<uint32_t> dist(num_nodes, kUnvisited);
+  std::vector<Node> visited;
+  std::vector<uint64_t> heaviest(comp_begin.size() - 1);
+  uint64_t bound = 0;
+  for (uint32_t c = 0; c + 1 < comp_begin.size(); ++c) {
+    auto begin = members.begin() + comp_begin[c];
+    auto end = members.begin() + comp_begin[c + 1];
+    uint64_t weight = 1;
+    if (end - begin > 1) {
+      Node hub = *std::max_element(begin, end, [&](Node a, Node b) {
+        return out.edges(a).size() + in.edges(a).size() <
+               out.edges(b).size() + in.edges(b).size();
+      });
+      weight = std::min<uint64_t>(
+          end - begin,
+          ComponentEccentricity(out, comp, hub, &dist, &visited) +
+              ComponentEccentricity(in, comp, hub, &dist, &visited) + 1);
+    }
+
+    // Components reached from this one were finished before it
+    uint64_t after = 0;
+    for (auto it = begin; it != end; ++it) {
+      for (auto e : out.edges(*it)) {
+        uint32_t dest_comp = comp[out.edge_dest(e)];
+        if (dest_comp != c) {
+          after = std::max(after, heaviest[dest_comp]);
+        }
+      }
+    }
+    heaviest[c] = weight + after;
+    bound = std::max(bound, heaviest[c]);
+  }
+  return bound;
+}
+
+/// The label of a node reached by one side of a bidirectional BFS
+struct SearchLabel {
+  uint32_t dist;
+  /// The number of shortest paths from the root of the side
+  double paths;
+};
+
+/// Per-thread state for sampling a uniformly random shortest path between two
+/// nodes with a balanced bidirectional BFS
+class PathSampler {
+public:
+  PathSampler() = default;
+
+  void Seed(uint64_t seed) { rng_.seed(seed); }
+
+  std::mt19937_64& rng() { return rng_; }
+
+  /// Sample a shortest path from s to t, calling fn on each of its nodes
+  /// other than s and t. Nothing is called if t is not reachable from s.
+  template <typename Fn>
+  void Sample(
+      const katana::GraphTopology& out, const katana::GraphTopology& in,
+      Node s, Node t, Fn fn) {
+    forward_.clear();
+    backward_.clear();
+    forward_frontier_.assign(1, s);
+    backward_frontier_.assign(1, t);
+    forward_.emplace(s, SearchLabel{0, 1});
+    backward_.emplace(t, SearchLabel{0, 1});
+    uint64_t forward_work = out.edges(s).size();
+    uint64_t backward_work = in.edges(t).size();
+
+    while (!forward_frontier_.empty() && !backward_frontier_.empty()) {
+      // Expand the side whose next level scans fewer edges.
+      bool forward = forward_work <= backward_work;
+      const auto& graph = forward ? out : in;
+      auto& frontier = forward ? forward_frontier_ : backward_frontier_;
+      auto& labels = forward ? forward_ : backward_;
+      const auto& other = forward ? backward_ : forward_;
+
+      uint32_t level = labels.at(frontier[0]).dist + 1;
+      next_.clear();
+      for (Node u : frontier) {
+        double u_paths = labels.at(u).paths;
+        for (auto e : graph.edges(u)) {
+          Node v = graph.edge_dest(e);
+          auto [it, inserted] = labels.try_emplace(v, SearchLabel{level, 0});
+          if (inserted) {
+            next_.push_back(v);
+          }
+          if (it->second.dist == level) {
+            it->second.paths += u_paths;
+          }
+        }
+      }
+      frontier.swap(next_);
+
+      // The first level that reaches the other side holds exactly the nodes
+      // at this distance on the shortest paths, and all of them are at the
+      // same distance from the other root.
+      meeting_.clear();
+      meeting_paths_.clear();
+      uint64_t work = 0;
+      for (Node v : frontier) {
+        if (auto it = other.find(v); it != other.end()) {
+          meeting_.push_back(v);
+          meeting_paths_.push_back(labels.at(v).paths * it->second.paths);
+        }
+        work += graph.edges(v).size();
+      }
+      if (!meeting_.empty()) {
+        std::discrete_distribution<size_t> pick(
+            meeting_paths_.begin(), meeting_paths_.end());
+        Node x = meeting_[pick(rng_)];
+        if (x != s && x != t) {
+          fn(x);
+        }
+        Walk(in, forward_, x, s, fn);
+        Walk(out, backward_, x, t, fn);
+        return;
+      }
+      (forward ? forward_work : backward_work) = work;
+    }
+  }
+
+private:
+  /// Walk from x to root choosing each next node with probability
+  /// proportional to its number of shortest paths from root
+  template <typename Fn>
+  void Walk(
+      const katana::GraphTopology& graph,
+      const std::unordered_map<Node, SearchLabel>& labels, Node x, Node root,
+      Fn fn) {
+    while (x != root) {
+      uint32_t dist = labels.at(x).dist - 1;
+      next_.clear();
+      meeting_paths_.clear();
+      for (auto e : graph.edges(x)) {
+        Node v = graph.edge_dest(e);
+        auto it = labels.find(v);
+        if (it != labels.end() && it->second.dist == dist) {
+          next_.push_back(v);
+          meeting_paths_.push_back(it->second.paths);
+        }
+      }
+      std::discrete_distribution<size_t> pick(
+          meeting_paths_.begin(), meeting_paths_.end());
+      x = next_[pick(rng_)];
+      if (x != root) {
+        fn(x);
+      }
+    }
+  }
+
+  std::mt19937_64 rng_;
+  std::unordered_map<Node, SearchLabel> forward_;
+  std::unordered_map<Node, SearchLabel> backward_;
+  std::vector<Node> forward_frontier_;
+  std::vector<Node> backward_frontier_;
+  std::vector<Node> next_;
+  std::vector<Node> meeting_;
+  std::vector<double> meeting_paths_;
+};
+
+/// The deviation bounds of KADABRA (Theorem 7 of Borassi and Natale): with
+/// tau samples of at most omega, the estimate b is within LowerError below
+/// and UpperError above the exact value, except with probability
+/// log_inv_delta = log(1 / delta) for each side.
+double
+LowerError(double b, double log_inv_delta, double omega, double tau) {
+  double a = 1.0 / 3.0 - omega / tau;
+  return log_inv_delta / tau *
+         (a + std::sqrt(a * a + 2 * b * omega / log_inv_delta));
+}
+
+double
+UpperError(double b, double log_inv_delta, double omega, double tau) {
+  double a = 1.0 / 3.0 + omega / tau;
+  return log_inv_delta / tau *
+         (a + std::sqrt(a * a + 2 * b * omega / log_inv_delta));
+}
+
+}  // namespace
+
+katana::Result<void>
+BetweennessCentralityAdaptiveSampling(
+    katana::PropertyGraph* pg, const std::string& output_property_name,
+    BetweennessCentralityPlan plan) {
+  if (!(plan.epsilon() > 0 && plan.epsilon() < 1)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "epsilon must be in (0, 1)");
+  }
+  if (!(plan.delta() > 0 && plan.delta() < 1)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "delta must be in (0, 1)");
+  }
+
+  const katana::GraphTopology& out = pg->topology();
+  uint64_t num_nodes = out.num_nodes();
+  // The backward side of each search needs the in-edges.
+  auto transpose_graph =
+      KATANA_CHECKED(katana::CreateTransposeGraphTopology(out));
+  const katana::GraphTopology& in = transpose_graph->topology();
+
+  katana::NUMAArray<std::atomic<uint64_t>> counts;
+  counts.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(out), [&](Node n) { counts[n] = 0; },
+      katana::no_stats());
+
+  uint64_t num_samples = 0;
+  if (num_nodes > 1) {
+    double vertex_diameter = VertexDiameterBound(out, in);
+
+    // Half of delta bounds the failure of the maximum number of samples and
+    // the other half is shared equally by the two bounds of every node.
+    double epsilon = plan.epsilon();
+    double omega =
+        0.5 / (epsilon * epsilon) *
+        (std::floor(std::log2(std::max(vertex_diameter - 2, 1.0))) + 1 +
+         std::log(2 / plan.delta()));
+    double log_inv_delta = std::log(4.0 * num_nodes / plan.delta());
+    uint64_t max_samples = std::ceil(omega);
+    uint64_t round_size = std::max(
+        kMinSamplesPerRound,
+        (max_samples + kStoppingChecks - 1) / kStoppingChecks);
+
+    katana::PerThreadStorage<PathSampler> samplers;
+    katana::on_each([&](unsigned tid, unsigned) {
+      samplers.getLocal()->Seed(std::mt19937_64::default_seed + tid);
+    });
+
+    katana::StatTimer exec_time("AdaptiveSampling", "BetweennessCentrality");
+    exec_time.start();
+    while (num_samples < max_samples) {
+      uint64_t samples = std::min(round_size, max_samples - num_samples);
+      katana::do_all(
+          katana::iterate(uint64_t{0}, samples),
+          [&](uint64_t) {
+            PathSampler* sampler = samplers.getLocal();
+            std::uniform_int_distribution<Node> pick_node(0, num_nodes - 1);
+            Node s = pick_node(sampler->rng());
+            Node t = pick_node(sampler->rng());
+            while (t == s) {
+              t = pick_node(sampler->rng());
+            }
+            sampler->Sample(out, in, s, t, [&](Node n) {
+              counts[n].fetch_add(1, std::memory_order_relaxed);
+            });
+          },
+          katana::steal(), katana::chunk_size<kSampleChunkSize>(),
+          katana::loopname("SamplePaths"));
+      num_samples += samples;
+
+      katana::GReduceLogicalOr unconverged;
+      double tau = num_samples;
+      katana::do_all(
+          katana::iterate(out),
+          [&](Node n) {
+            double b = counts[n].load(std::memory_order_relaxed) / tau;
+            if (LowerError(b, log_inv_delta, omega, tau) >= epsilon ||
+                UpperError(b, log_inv_delta, omega, tau) >= epsilon) {
+              unconverged.update(true);
+            }
+          },
+          katana::no_stats(), katana::loopname("CheckStoppingCondition"));
+      if (!unconverged.reduce()) {
+        break;
+      }
+    }
+    exec_time.stop();
+  }
+  katana::ReportStatSingle(
+      "BetweennessCentrality", "NumSamples", num_samples);
+
+  std::shared_ptr<arrow::Buffer> buf =
+      KATANA_CHECKED(arrow::AllocateBuffer(num_nodes * sizeof(float)));
+  float* data = reinterpret_cast<float*>(buf->mutable_data());
+  double scale = num_samples == 0 ? 0
+                                  : static_cast<double>(num_nodes) *
+                                        (num_nodes - 1) / num_samples;
+  katana::do_all(
+      katana::iterate(out),
+      [&](Node n) { data[n] = counts[n].load() * scale; }, katana::no_stats());
+
+  auto table = arrow::Table::Make(
+      arrow::schema({arrow::field(output_property_name, arrow::float32())}),
+      {std::make_shared<arrow::FloatArray>(num_nodes, buf)}, num_nodes);
+  KATANA_CHECKED(pg->AddNodeProperties(table));
+  return katana::ResultSuccess();
+}
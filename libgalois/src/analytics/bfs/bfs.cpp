@@ -19,9 +19,12 @@
 
 #include "katana/analytics/bfs/bfs.h"
 
+#include <array>
 #include <deque>
 #include <type_traits>
 
+#include <arrow/api.h>
+
 #include "katana/DynamicBitset.h"
 #include "katana/ErrorCode.h"
 #include "katana/Result.h"
@@ -525,6 +528,259 @@ BfsImpl(
   return katana::ResultSuccess();
 }
 
+/// One bit per source of a multi-source BFS batch
+template <size_t kWords>
+struct SourceMask {
+  std::array<uint64_t, kWords> words{};
+
+  bool Any() const {
+    uint64_t any = 0;
+    for (size_t i = 0; i < kWords; ++i) {
+      any |= words[i];
+    }
+    return any != 0;
+  }
+
+  void Set(size_t bit) { words[bit / 64] |= uint64_t{1} << (bit % 64); }
+
+  void Clear() { words.fill(0); }
+
+  /// Bits of this mask that are not set in other
+  SourceMask AndNot(const SourceMask& other) const {
+    SourceMask ret;
+    for (size_t i = 0; i < kWords; ++i) {
+      ret.words[i] = words[i] & ~other.words[i];
+    }
+    return ret;
+  }
+
+  SourceMask& operator|=(const SourceMask& other) {
+    for (size_t i = 0; i < kWords; ++i) {
+      words[i] |= other.words[i];
+    }
+    return *this;
+  }
+
+  /// Atomically or other into this mask, one word at a time. Concurrent
+  /// callers may each see the others' bits, so this says nothing about
+  /// whether the mask was empty.
+  void AtomicOr(const SourceMask& other) {
+    for (size_t i = 0; i < kWords; ++i) {
+      if (other.words[i] != 0) {
+        __atomic_fetch_or(&words[i], other.words[i], __ATOMIC_RELAXED);
+      }
+    }
+  }
+
+  /// Call fn(i) for every set bit i
+  template <typename F>
+  void ForEachBit(F fn) const {
+    for (size_t i = 0; i < kWords; ++i) {
+      for (uint64_t w = words[i]; w != 0; w &= w - 1) {
+        fn(i * 64 + __builtin_ctzll(w));
+      }
+    }
+  }
+};
+
+/// Traverse from all of sources at once, writing the distance from
+/// sources[i] to node n into distances[i][n]. distances must be initialized
+/// to kDistanceInfinity.
+///
+/// visit holds the sources that reached a node at the current level, seen
+/// the sources that reached it at any level and next the sources reaching it
+/// at the next level. Levels alternate between pushing from the frontier and
+/// pulling into unfinished nodes over the transpose graph, as in
+/// SynchronousDirectOpt. When pushing, the first push to a node claims it as
+/// a candidate for the next level in is_candidate.
+template <size_t kWords>
+void
+MultiSourceSynchronousDirectOpt(
+    const katana::PropertyGraph& graph,
+    const katana::PropertyGraph& transpose_graph,
+    const std::vector<GNode>& sources, const std::vector<Dist*>& distances,
+    const uint32_t alpha, const uint32_t beta) {
+  using Mask = SourceMask<kWords>;
+
+  uint32_t num_nodes = graph.size();
+  uint64_t num_edges = graph.num_edges();
+
+  katana::NUMAArray<Mask> seen;
+  katana::NUMAArray<Mask> visit;
+  katana::NUMAArray<Mask> next;
+  katana::DynamicBitset is_candidate;
+  is_candidate.resize(num_nodes);
+  seen.allocateInterleaved(num_nodes);
+  visit.allocateInterleaved(num_nodes);
+  next.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(0u, num_nodes),
+      [&](GNode n) {
+        seen[n].Clear();
+        visit[n].Clear();
+        next[n].Clear();
+      },
+      katana::no_stats());
+
+  Mask all;
+  auto frontier = std::make_unique<katana::InsertBag<GNode>>();
+  auto next_frontier = std::make_unique<katana::InsertBag<GNode>>();
+  auto candidates = std::make_unique<katana::InsertBag<GNode>>();
+
+  katana::GAccumulator<uint64_t> frontier_edges;
+  katana::GAccumulator<uint64_t> frontier_size;
+
+  for (size_t i = 0; i < sources.size(); ++i) {
+    GNode s = sources[i];
+    all.Set(i);
+    if (!visit[s].Any()) {
+      next_frontier->push(s);
+      auto e_range = graph.topology().edges(s);
+      frontier_edges += std::distance(e_range.begin(), e_range.end());
+      frontier_size += 1;
+    }
+    seen[s].Set(i);
+    visit[s].Set(i);
+    distances[i][s] = 0;
+  }
+
+  bool pull = false;
+  Dist level = 0;
+
+  while (!next_frontier->empty()) {
+    std::swap(frontier, next_frontier);
+    next_frontier->clear();
+    candidates->clear();
+    ++level;
+
+    if (!pull && frontier_edges.reduce() > num_edges / alpha) {
+      pull = true;
+    } else if (pull && frontier_size.reduce() < num_nodes / beta) {
+      pull = false;
+    }
+
+    if (pull) {
+      katana::do_all(
+          katana::iterate(transpose_graph),
+          [&](const GNode& dst) {
+            Mask missing = all.AndNot(seen[dst]);
+            if (!missing.Any()) {
+              return;
+            }
+            Mask& dnext = next[dst];
+            for (auto e : transpose_graph.edges(dst)) {
+              auto src = transpose_graph.GetEdgeDest(e);
+              dnext |= visit[*src];
+              if (!missing.AndNot(dnext).Any()) {
+                break;
+              }
+            }
+          },
+          katana::steal(), katana::chunk_size<kChunkSize>(),
+          katana::loopname("MultiSourceBfs-pull"));
+    } else {
+      katana::do_all(
+          katana::iterate(*frontier),
+          [&](const GNode& src) {
+            const Mask& svisit = visit[src];
+            for (auto e : graph.edges(src)) {
+              auto dst = graph.GetEdgeDest(e);
+              // seen is only written between levels
+              Mask reached = svisit.AndNot(seen[*dst]);
+              if (!reached.Any()) {
+                continue;
+              }
+              next[*dst].AtomicOr(reached);
+              if (!is_candidate.set(*dst)) {
+                candidates->push(*dst);
+              }
+            }
+          },
+          katana::steal(), katana::chunk_size<kChunkSize>(),
+          katana::loopname("MultiSourceBfs-push"));
+    }
+
+    katana::do_all(
+        katana::iterate(*frontier), [&](const GNode& n) { visit[n].Clear(); },
+        katana::chunk_size<kChunkSize>(), katana::no_stats());
+
+    frontier_edges.reset();
+    frontier_size.reset();
+
+    auto update = [&](const GNode& n) {
+      is_candidate.reset(n);
+      Mask reached = next[n].AndNot(seen[n]);
+      next[n].Clear();
+      if (!reached.Any()) {
+        return;
+      }
+      seen[n] |= reached;
+      visit[n] = reached;
+      reached.ForEachBit([&](size_t i) { distances[i][n] = level; });
+      next_frontier->push(n);
+      auto e_range = graph.topology().edges(n);
+      frontier_edges += std::distance(e_range.begin(), e_range.end());
+      frontier_size += 1;
+    };
+
+    if (pull) {
+      katana::do_all(
+          katana::iterate(graph), update, katana::steal(),
+          katana::chunk_size<kChunkSize>(),
+          katana::loopname("MultiSourceBfs-update"));
+    } else {
+      katana::do_all(
+          katana::iterate(*candidates), update, katana::steal(),
+          katana::chunk_size<kChunkSize>(),
+          katana::loopname("MultiSourceBfs-update"));
+    }
+  }
+}
+
+katana::Result<void>
+MultiSourceBfsBatch(
+    katana::PropertyGraph* pg, const katana::PropertyGraph& transpose_graph,
+    const std::vector<GNode>& sources, const std::vector<std::string>& names,
+    const BfsPlan& algo) {
+  int64_t num_nodes = pg->num_nodes();
+
+  std::vector<std::shared_ptr<arrow::Field>> fields;
+  std::vector<std::shared_ptr<arrow::Array>> columns;
+  std::vector<Dist*> distances;
+  for (const auto& name : names) {
+    std::shared_ptr<arrow::Buffer> buf =
+        KATANA_CHECKED(arrow::AllocateBuffer(num_nodes * sizeof(Dist)));
+    Dist* data = reinterpret_cast<Dist*>(buf->mutable_data());
+    katana::do_all(
+        katana::iterate(int64_t{0}, num_nodes),
+        [&](int64_t n) { data[n] = BfsImplementation::kDistanceInfinity; },
+        katana::no_stats());
+    distances.emplace_back(data);
+    fields.emplace_back(arrow::field(name, arrow::uint32()));
+    columns.emplace_back(std::make_shared<arrow::UInt32Array>(num_nodes, buf));
+  }
+
+  size_t num_words = (sources.size() + 63) / 64;
+  if (num_words <= 1) {
+    MultiSourceSynchronousDirectOpt<1>(
+        *pg, transpose_graph, sources, distances, algo.alpha(), algo.beta());
+  } else if (num_words <= 2) {
+    MultiSourceSynchronousDirectOpt<2>(
+        *pg, transpose_graph, sources, distances, algo.alpha(), algo.beta());
+  } else if (num_words <= 4) {
+    MultiSourceSynchronousDirectOpt<4>(
+        *pg, transpose_graph, sources, distances, algo.alpha(), algo.beta());
+  } else {
+    static_assert(kMultiSourceBfsBatchSize <= 8 * 64);
+    MultiSourceSynchronousDirectOpt<8>(
+        *pg, transpose_graph, sources, distances, algo.alpha(), algo.beta());
+  }
+
+  auto table = arrow::Table::Make(arrow::schema(fields), columns, num_nodes);
+  KATANA_CHECKED(pg->AddNodeProperties(table));
+  return katana::ResultSuccess();
+}
+
 }  // namespace
 
 katana::Result<void>
@@ -545,6 +801,59 @@ katana::analytics::Bfs(
   return BfsImpl(pg_result.value(), pg, start_node, algo);
 }
 
+katana::Result<void>
+katana::analytics::MultiSourceBfs(
+    PropertyGraph* pg, const std::vector<uint32_t>& sources,
+    const std::vector<std::string>& output_property_names, BfsPlan algo) {
+  if (sources.size() != output_property_names.size()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "{} sources but {} output property names", sources.size(),
+        output_property_names.size());
+  }
+  for (auto source : sources) {
+    if (source >= pg->num_nodes()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument, "source {} is not a node",
+          source);
+    }
+  }
+  if (algo.algorithm() != BfsPlan::kSynchronousDirectOpt) {
+    return KATANA_ERROR(
+        katana::ErrorCode::NotImplemented, "Unsupported algorithm: {}",
+        algo.algorithm());
+  }
+  if (sources.empty()) {
+    return katana::ResultSuccess();
+  }
+
+  size_t approxNodeData = 4 * (pg->num_nodes() + pg->num_edges());
+  katana::EnsurePreallocated(8, approxNodeData);
+  katana::ReportPageAllocGuard page_alloc;
+
+  // TODO(lhc): due to lack of in-edge iteration, manually creates a transposed graph
+  auto transpose_graph =
+      KATANA_CHECKED(katana::CreateTransposeGraphTopology(pg->topology()));
+
+  katana::StatTimer exec_time("MultiSourceBFS");
+  exec_time.start();
+  for (size_t begin = 0; begin < sources.size();
+       begin += kMultiSourceBfsBatchSize) {
+    size_t end = std::min<size_t>(
+        sources.size(), begin + kMultiSourceBfsBatchSize);
+    std::vector<GNode> batch_sources(
+        sources.begin() + begin, sources.begin() + end);
+    std::vector<std::string> batch_names(
+        output_property_names.begin() + begin,
+        output_property_names.begin() + end);
+    KATANA_CHECKED(MultiSourceBfsBatch(
+        pg, *transpose_graph, batch_sources, batch_names, algo));
+  }
+  exec_time.stop();
+
+  return katana::ResultSuccess();
+}
+
 katana::Result<void>
 katana::analytics::BfsAssertValid(
     PropertyGraph* pg, const GNode source, const std::string& property_name) {
@@ -1178,6 +1178,125 @@ katana::analytics::ConnectedComponents(
   }
 }
 
+katana::Result<void>
+katana::analytics::IncrementalConnectedComponents(
+    PropertyGraph* pg, const std::string& property_name,
+    const std::vector<uint32_t>& srcs, const std::vector<uint32_t>& dsts) {
+  using ComponentType = uint64_t;
+  struct NodeComponent : public katana::PODProperty<ComponentType> {};
+
+  using NodeData = std::tuple<NodeComponent>;
+  using EdgeData = std::tuple<>;
+  typedef katana::TypedPropertyGraph<NodeData, EdgeData> Graph;
+  typedef typename Graph::Node GNode;
+
+  if (srcs.size() != dsts.size()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "{} sources but {} destinations",
+        srcs.size(), dsts.size());
+  }
+  katana::GReduceMax<uint32_t> max_endpoint;
+  katana::do_all(
+      katana::iterate(size_t{0}, srcs.size()),
+      [&](size_t i) {
+        max_endpoint.update(srcs[i]);
+        max_endpoint.update(dsts[i]);
+      },
+      katana::no_stats());
+  if (!srcs.empty() && max_endpoint.reduce() >= pg->num_nodes()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "node {} does not exist",
+        max_endpoint.reduce());
+  }
+
+  // Give each node without a component a component of its own, with an ID
+  // above all existing ones.
+  auto components =
+      KATANA_CHECKED(pg->GetNodePropertyTyped<ComponentType>(property_name));
+  if (components->null_count() > 0) {
+    katana::GReduceMax<ComponentType> max_component;
+    katana::do_all(
+        katana::iterate(int64_t{0}, components->length()),
+        [&](int64_t n) {
+          if (!components->IsNull(n)) {
+            max_component.update(components->Value(n));
+          }
+        },
+        katana::no_stats());
+    ComponentType first_new =
+        components->null_count() == components->length()
+            ? 0
+            : max_component.reduce() + 1;
+    if (first_new >
+        std::numeric_limits<ComponentType>::max() - pg->num_nodes()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "no component IDs left for new nodes");
+    }
+    KATANA_CHECKED(FillNullNodeProperty<ComponentType>(
+        pg, property_name, [&](int64_t n) { return first_new + n; }));
+  }
+
+  auto graph = KATANA_CHECKED(Graph::Make(pg, {property_name}, {}));
+
+  // Union-find over the components of the endpoints of the new edges. The
+  // components are sorted so that each union-find tree is rooted at the node
+  // of its smallest component ID.
+  std::vector<ComponentType> touched(srcs.size() + dsts.size());
+  katana::do_all(
+      katana::iterate(size_t{0}, srcs.size()),
+      [&](size_t i) {
+        touched[2 * i] = graph.GetData<NodeComponent>(srcs[i]);
+        touched[2 * i + 1] = graph.GetData<NodeComponent>(dsts[i]);
+      },
+      katana::no_stats());
+  katana::ParallelSTL::sort(touched.begin(), touched.end());
+  touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+
+  auto index_of = [&](ComponentType c) {
+    return std::lower_bound(touched.begin(), touched.end(), c) -
+           touched.begin();
+  };
+
+  std::vector<ConnectedComponentsNode> union_find(touched.size());
+  katana::do_all(
+      katana::iterate(size_t{0}, srcs.size()),
+      [&](size_t i) {
+        auto& src_node =
+            union_find[index_of(graph.GetData<NodeComponent>(srcs[i]))];
+        auto& dst_node =
+            union_find[index_of(graph.GetData<NodeComponent>(dsts[i]))];
+        src_node.merge(&dst_node);
+      },
+      katana::steal(), katana::loopname("IncrementalUnion"));
+
+  std::vector<std::pair<ComponentType, ComponentType>> relabel;
+  for (size_t i = 0; i < touched.size(); ++i) {
+    size_t root = union_find[i].findAndCompress() - union_find.data();
+    if (root != i) {
+      relabel.emplace_back(touched[i], touched[root]);
+    }
+  }
+  if (relabel.empty()) {
+    return katana::ResultSuccess();
+  }
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) {
+        auto& component = graph.GetData<NodeComponent>(n);
+        auto it = std::lower_bound(
+            relabel.begin(), relabel.end(),
+            std::make_pair(component, ComponentType{0}));
+        if (it != relabel.end() && it->first == component) {
+          component = it->second;
+        }
+      },
+      katana::steal(), katana::loopname("IncrementalRelabel"));
+
+  return katana::ResultSuccess();
+}
+
 katana::Result<void>
 katana::analytics::ConnectedComponentsAssertValid(
     PropertyGraph* pg, const std::string& property_name) {
@@ -0,0 +1,830 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/analytics/leiden_clustering/leiden_clustering.h"
+
+#include <type_traits>
+
+#include "katana/TypedPropertyGraph.h"
+#include "katana/analytics/ClusteringImplementationBase.h"
+
+using namespace katana::analytics;
+namespace {
+
+template <typename EdgeWeightType>
+struct LeidenClusteringImplementation
+    : public katana::analytics::ClusteringImplementationBase<
+          katana::TypedPropertyGraph<
+              std::tuple<
+                  PreviousCommunityId, CurrentCommunityId,
+                  DegreeWeight<EdgeWeightType>>,
+              std::tuple<EdgeWeight<EdgeWeightType>>>,
+          EdgeWeightType, CommunityType<EdgeWeightType>> {
+  using NodeData = std::tuple<
+      PreviousCommunityId, CurrentCommunityId, DegreeWeight<EdgeWeightType>>;
+  using EdgeData = std::tuple<EdgeWeight<EdgeWeightType>>;
+  using CommTy = CommunityType<EdgeWeightType>;
+  using CommunityArray = katana::NUMAArray<CommTy>;
+
+  using Graph = katana::TypedPropertyGraph<NodeData, EdgeData>;
+  using GNode = typename Graph::Node;
+
+  using Base = katana::analytics::ClusteringImplementationBase<
+      Graph, EdgeWeightType, CommTy>;
+
+  /// States of a node during refinement
+  enum RefineState : uint8_t {
+    /// Alone in its refined community and free to move
+    kFree,
+    /// Moved into the refined community of another node
+    kMoved,
+    /// Other nodes moved into its refined community; it stays put
+    kAnchored,
+  };
+
+  /**
+   * Puts each node in its initial community, initial[n] or n itself if
+   * initial is empty, and sums up the degree weight of each community.
+   */
+  void InitializeCommunities(
+      Graph* graph, const katana::NUMAArray<uint64_t>& initial,
+      CommunityArray& c_info) {
+    katana::do_all(katana::iterate(*graph), [&](GNode n) {
+      EdgeWeightType total_weight = 0;
+      for (auto ii = graph->edge_begin(n); ii != graph->edge_end(n); ++ii) {
+        total_weight +=
+            graph->template GetEdgeData<EdgeWeight<EdgeWeightType>>(ii);
+      }
+      graph->template GetData<DegreeWeight<EdgeWeightType>>(n) = total_weight;
+      uint64_t comm = initial.size() == 0 ? n : initial[n];
+      graph->template GetData<CurrentCommunityId>(n) = comm;
+      graph->template GetData<PreviousCommunityId>(n) = comm;
+      c_info[n].degree_wt = 0;
+      c_info[n].size = 0;
+    });
+
+    katana::do_all(katana::iterate(*graph), [&](GNode n) {
+      uint64_t comm = graph->template GetData<CurrentCommunityId>(n);
+      katana::atomicAdd(
+          c_info[comm].degree_wt,
+          graph->template GetData<DegreeWeight<EdgeWeightType>>(n));
+      katana::atomicAdd(c_info[comm].size, uint64_t{1});
+    });
+  }
+
+  /**
+   * Moves nodes to the neighboring community with the best modularity gain
+   * until no node can improve. Unlike the Louvain phases, which sweep over
+   * all the nodes in every round, only the neighbors of a node that moved
+   * are queued to be visited again.
+   */
+  void LocalMoving(Graph* graph, CommunityArray& c_info, double constant) {
+    katana::NUMAArray<std::atomic<bool>> in_queue;
+    in_queue.allocateBlocked(graph->num_nodes());
+    katana::do_all(
+        katana::iterate(*graph), [&](GNode n) { in_queue[n] = true; });
+
+    katana::PerThreadStorage<typename Base::NeighborAccumulator> accumulators;
+
+    katana::for_each(
+        katana::iterate(*graph),
+        [&](GNode n, auto& ctx) {
+          in_queue[n] = false;
+          if (graph->edge_begin(n) == graph->edge_end(n)) {
+            return;
+          }
+
+          auto& n_data_curr_comm_id =
+              graph->template GetData<CurrentCommunityId>(n);
+          auto& n_data_degree_wt =
+              graph->template GetData<DegreeWeight<EdgeWeightType>>(n);
+
+          auto* neighbors = accumulators.getLocal();
+          EdgeWeightType self_loop_wt = 0;
+          Base::template FindNeighboringClusters<EdgeWeightType>(
+              *graph, n, neighbors, self_loop_wt);
+          uint64_t local_target = Base::MaxModularityWithoutSwaps(
+              *neighbors, self_loop_wt, c_info, n_data_degree_wt,
+              n_data_curr_comm_id, constant);
+
+          if (local_target == n_data_curr_comm_id ||
+              local_target == Base::UNASSIGNED) {
+            return;
+          }
+
+          katana::atomicAdd(c_info[local_target].degree_wt, n_data_degree_wt);
+          katana::atomicAdd(c_info[local_target].size, uint64_t{1});
+          katana::atomicSub(
+              c_info[n_data_curr_comm_id].degree_wt, n_data_degree_wt);
+          katana::atomicSub(c_info[n_data_curr_comm_id].size, uint64_t{1});
+          n_data_curr_comm_id = local_target;
+
+          // The best community of neighbors outside the new community may
+          // have changed
+          for (auto ii = graph->edge_begin(n); ii != graph->edge_end(n);
+               ++ii) {
+            auto dst = graph->GetEdgeDest(ii);
+            if (graph->template GetData<CurrentCommunityId>(dst) !=
+                    local_target &&
+                !in_queue[*dst].exchange(true)) {
+              ctx.push(*dst);
+            }
+          }
+        },
+        katana::disable_conflict_detection(),
+        katana::loopname("Leiden: Local Moving"));
+  }
+
+  /**
+   * Splits each community found by LocalMoving into refined communities.
+   *
+   * Every node starts alone in its refined community. A node that is still
+   * alone and well connected to its community may merge into the refined
+   * community of a neighbor in the same community, if that refined community
+   * is well connected too and the merge increases modularity. A node that
+   * others have merged into never moves, so every refined community is
+   * connected through the edges its members merged along.
+   */
+  void Refine(
+      const Graph& graph, CommunityArray& c_info, double constant,
+      katana::NUMAArray<uint64_t>* refined) {
+    CommunityArray r_info;
+    r_info.allocateBlocked(graph.num_nodes());
+    // Weight of the edges from each refined community to the rest of its
+    // community
+    katana::NUMAArray<std::atomic<EdgeWeightType>> r_external;
+    r_external.allocateBlocked(graph.num_nodes());
+    katana::NUMAArray<std::atomic<uint8_t>> state;
+    state.allocateBlocked(graph.num_nodes());
+
+    katana::do_all(katana::iterate(graph), [&](GNode n) {
+      auto n_data_curr_comm_id = graph.template GetData<CurrentCommunityId>(n);
+      EdgeWeightType external = 0;
+      for (auto ii = graph.edge_begin(n); ii != graph.edge_end(n); ++ii) {
+        auto dst = graph.GetEdgeDest(ii);
+        if (*dst != n && graph.template GetData<CurrentCommunityId>(dst) ==
+                             n_data_curr_comm_id) {
+          external +=
+              graph.template GetEdgeData<EdgeWeight<EdgeWeightType>>(ii);
+        }
+      }
+      (*refined)[n] = n;
+      r_info[n].degree_wt =
+          graph.template GetData<DegreeWeight<EdgeWeightType>>(n);
+      r_info[n].size = 1;
+      r_external[n] = external;
+      state[n] = kFree;
+    });
+
+    // A set of nodes with degree weight k is well connected to the rest of
+    // its community with degree weight k_total if the weight of the edges
+    // between them is at least k * (k_total - k) / 2m
+    auto well_connected = [constant](
+                              double external, double k, double k_total) {
+      return external >= k * (k_total - k) * constant;
+    };
+
+    katana::PerThreadStorage<typename Base::NeighborAccumulator> accumulators;
+
+    katana::do_all(
+        katana::iterate(graph),
+        [&](GNode n) {
+          if (state[n] != kFree) {
+            return;
+          }
+          auto n_data_curr_comm_id =
+              graph.template GetData<CurrentCommunityId>(n);
+          double k_n = graph.template GetData<DegreeWeight<EdgeWeightType>>(n);
+          double k_total = c_info[n_data_curr_comm_id].degree_wt;
+          if (!well_connected(r_external[n], k_n, k_total)) {
+            return;
+          }
+
+          auto* neighbors = accumulators.getLocal();
+          neighbors->Clear();
+          for (auto ii = graph.edge_begin(n); ii != graph.edge_end(n); ++ii) {
+            auto dst = graph.GetEdgeDest(ii);
+            if (*dst != n && graph.template GetData<CurrentCommunityId>(dst) ==
+                                 n_data_curr_comm_id) {
+              neighbors->Add(
+                  (*refined)[*dst],
+                  graph.template GetEdgeData<EdgeWeight<EdgeWeightType>>(ii));
+            }
+          }
+
+          uint64_t target = Base::UNASSIGNED;
+          EdgeWeightType target_wt = 0;
+          double max_gain = 0;
+          for (const auto& [community, weight] : neighbors->entries()) {
+            if (community == n) {
+              continue;
+            }
+            double k_r = r_info[community].degree_wt;
+            if (!well_connected(r_external[community], k_r, k_total)) {
+              continue;
+            }
+            double gain = weight - k_n * k_r * constant;
+            if (gain > max_gain || (gain == max_gain && gain > 0 &&
+                                    community < target)) {
+              max_gain = gain;
+              target = community;
+              target_wt = weight;
+            }
+          }
+          if (target == Base::UNASSIGNED) {
+            return;
+          }
+
+          // Leave the refined community of n; fails if another node has
+          // merged into it in the meantime
+          uint8_t expected = kFree;
+          if (!state[n].compare_exchange_strong(expected, kMoved)) {
+            return;
+          }
+          // Pin the target in place; fails if it has merged elsewhere
+          expected = kFree;
+          if (!state[target].compare_exchange_strong(expected, kAnchored) &&
+              expected != kAnchored) {
+            state[n] = kFree;
+            return;
+          }
+
+          (*refined)[n] = target;
+          katana::atomicAdd(
+              r_info[target].degree_wt,
+              graph.template GetData<DegreeWeight<EdgeWeightType>>(n));
+          katana::atomicAdd(r_info[target].size, uint64_t{1});
+          // Edges between n and target become internal
+          katana::atomicAdd(r_external[target], r_external[n].load());
+          katana::atomicSub(
+              r_external[target], static_cast<EdgeWeightType>(2 * target_wt));
+        },
+        katana::steal(), katana::loopname("Leiden: Refinement"));
+  }
+
+  /**
+   * Splits every community that is not connected in graph into its connected
+   * components.
+   *
+   * Each node of a coarsened graph stands for a refined community, which is
+   * connected, so a community that is connected in the coarsest graph is
+   * connected in the original graph as well. Running this on the coarsest
+   * graph only is much cheaper than checking the communities in the
+   * original graph.
+   */
+  static void SplitDisconnectedCommunities(Graph* graph) {
+    katana::NUMAArray<std::atomic<GNode>> parent;
+    parent.allocateBlocked(graph->num_nodes());
+    katana::do_all(katana::iterate(*graph), [&](GNode n) { parent[n] = n; });
+
+    auto find = [&parent](GNode n) {
+      while (true) {
+        GNode p = parent[n];
+        if (p == n) {
+          return n;
+        }
+        GNode gp = parent[p];
+        // Path halving; losing the race only delays compression
+        parent[n].compare_exchange_weak(p, gp);
+        n = gp;
+      }
+    };
+
+    katana::do_all(
+        katana::iterate(*graph),
+        [&](GNode n) {
+          auto n_data_curr_comm_id =
+              graph->template GetData<CurrentCommunityId>(n);
+          for (auto ii = graph->edge_begin(n); ii != graph->edge_end(n);
+               ++ii) {
+            auto dst = graph->GetEdgeDest(ii);
+            if (graph->template GetData<CurrentCommunityId>(dst) !=
+                n_data_curr_comm_id) {
+              continue;
+            }
+            while (true) {
+              GNode a = find(n);
+              GNode b = find(*dst);
+              if (a == b) {
+                break;
+              }
+              // Link the larger root below the smaller one
+              if (a < b) {
+                std::swap(a, b);
+              }
+              if (parent[a].compare_exchange_strong(a, b)) {
+                break;
+              }
+            }
+          }
+        },
+        katana::steal(), katana::loopname("Leiden: Split Communities"));
+
+    // Components never span communities, so their roots can serve as the
+    // community ids
+    katana::do_all(katana::iterate(*graph), [&](GNode n) {
+      graph->template GetData<CurrentCommunityId>(n) = find(n);
+    });
+  }
+
+  /**
+   * Renumbers the communities in ids to contiguous ids in the order they
+   * first appear and returns the number of communities. Ids must be node
+   * ids of graph.
+   */
+  static uint64_t RenumberContiguously(
+      const Graph& graph, katana::NUMAArray<uint64_t>* ids) {
+    katana::NUMAArray<uint64_t> new_id;
+    new_id.allocateBlocked(graph.num_nodes());
+    katana::do_all(
+        katana::iterate(graph), [&](GNode n) { new_id[n] = Base::UNASSIGNED; },
+        katana::no_stats());
+
+    uint64_t num_unique = 0;
+    for (uint64_t& id : *ids) {
+      uint64_t& renumbered = new_id[id];
+      if (renumbered == Base::UNASSIGNED) {
+        renumbered = num_unique++;
+      }
+      id = renumbered;
+    }
+    return num_unique;
+  }
+
+public:
+  katana::Result<void> LeidenClustering(
+      katana::PropertyGraph* pfg, const std::string& edge_weight_property_name,
+      const std::vector<std::string>& temp_node_property_names,
+      katana::NUMAArray<uint64_t>& clusters_orig, LeidenClusteringPlan plan) {
+    TemporaryPropertyGuard temp_edge_property{pfg};
+    std::vector<std::string> temp_edge_property_names = {
+        temp_edge_property.name()};
+
+    /*
+     * Construct temp property graph. This graph gets coarsened as the
+     * computation proceeds.
+     */
+    std::unique_ptr<katana::PropertyGraph> pfg_mutable;
+
+    auto graph_result = Graph::Make(pfg);
+    if (!graph_result) {
+      return graph_result.error();
+    }
+    Graph graph_orig = graph_result.value();
+
+    /*
+    * Vertex following optimization
+    */
+    if (plan.enable_vf()) {
+      Base::VertexFollowing(&graph_orig);  // Find nodes that follow other nodes
+
+      uint64_t num_unique_clusters =
+          Base::RenumberClustersContiguously(&graph_orig);
+
+      katana::do_all(katana::iterate(graph_orig), [&](GNode n) {
+        clusters_orig[n] = graph_orig.template GetData<CurrentCommunityId>(n);
+      });
+
+      auto pfg_empty = std::make_unique<katana::PropertyGraph>();
+
+      // Build new graph to remove the isolated nodes
+      auto coarsened_graph_result =
+          Base::template GraphCoarsening<NodeData, EdgeData, EdgeWeightType>(
+              graph_orig, pfg_empty.get(), num_unique_clusters,
+              temp_node_property_names, temp_edge_property_names);
+      if (!coarsened_graph_result) {
+        return coarsened_graph_result.error();
+      }
+
+      pfg_mutable = std::move(coarsened_graph_result.value());
+
+    } else {
+      katana::do_all(
+          katana::iterate(graph_orig), [&](GNode n) { clusters_orig[n] = n; });
+
+      auto pfg_dup_r = Base::template DuplicateGraph<NodeData>(
+          pfg, edge_weight_property_name, temp_edge_property_names[0]);
+
+      if (!pfg_dup_r) {
+        return pfg_dup_r.error();
+      }
+
+      pfg_mutable = std::move(pfg_dup_r.value());
+    }
+
+    KATANA_LOG_ASSERT(pfg_mutable);
+
+    double prev_mod = -1;  // Previous modularity
+    double curr_mod = -1;  // Current modularity
+
+    std::unique_ptr<katana::PropertyGraph> pfg_curr = std::move(pfg_mutable);
+    // Communities that the nodes of the current graph start in; empty means
+    // every node starts in its own community
+    katana::NUMAArray<uint64_t> initial;
+    uint32_t iter = 0;
+    while (true) {
+      iter++;
+
+      auto graph_result = Graph::Make(pfg_curr.get());
+      if (!graph_result) {
+        return graph_result.error();
+      }
+      Graph graph_curr = graph_result.value();
+
+      CommunityArray c_info;
+      c_info.allocateBlocked(graph_curr.num_nodes());
+      InitializeCommunities(&graph_curr, initial, c_info);
+
+      double constant_for_second_term =
+          Base::template CalConstantForSecondTerm<EdgeWeightType>(graph_curr);
+
+      bool done = graph_curr.num_nodes() <= plan.min_graph_size() ||
+                  iter > plan.max_iterations();
+      if (!done) {
+        katana::StatTimer TimerLocalMoving("Timer_Local_Moving");
+        TimerLocalMoving.start();
+        LocalMoving(&graph_curr, c_info, constant_for_second_term);
+        TimerLocalMoving.stop();
+
+        double e_xx = 0;
+        double a2_x = 0;
+        curr_mod = Base::template CalModularity<EdgeWeightType>(
+            graph_curr, c_info, e_xx, a2_x, constant_for_second_term);
+        done = (curr_mod - prev_mod) <= plan.modularity_threshold_total();
+      }
+
+      katana::NUMAArray<uint64_t> refined;
+      refined.allocateBlocked(graph_curr.num_nodes());
+      uint64_t num_refined = graph_curr.num_nodes();
+      if (!done) {
+        katana::StatTimer TimerRefine("Timer_Refine");
+        TimerRefine.start();
+        Refine(graph_curr, c_info, constant_for_second_term, &refined);
+        TimerRefine.stop();
+
+        num_refined = RenumberContiguously(graph_curr, &refined);
+      }
+
+      // Nothing left to aggregate: the communities of this level are final
+      if (done || num_refined == graph_curr.num_nodes()) {
+        uint64_t num_nodes_curr = graph_curr.num_nodes();
+        SplitDisconnectedCommunities(&graph_curr);
+        Base::RenumberClustersContiguously(&graph_curr);
+        katana::do_all(
+            katana::iterate(uint64_t{0}, clusters_orig.size()),
+            [&](uint64_t n) {
+              uint64_t& c = clusters_orig[n];
+              if (c != Base::UNASSIGNED) {
+                KATANA_LOG_DEBUG_ASSERT(c < num_nodes_curr);
+                c = graph_curr.template GetData<CurrentCommunityId>(c);
+              }
+            });
+        break;
+      }
+
+      // The next level starts from the unrefined communities of its nodes
+      katana::NUMAArray<uint64_t> comm;
+      comm.allocateBlocked(graph_curr.num_nodes());
+      katana::do_all(katana::iterate(graph_curr), [&](GNode n) {
+        comm[n] = graph_curr.template GetData<CurrentCommunityId>(n);
+      });
+      RenumberContiguously(graph_curr, &comm);
+
+      katana::NUMAArray<uint64_t> next_initial;
+      next_initial.allocateBlocked(num_refined);
+      katana::do_all(katana::iterate(graph_curr), [&](GNode n) {
+        // All nodes of a refined community are in the same community
+        next_initial[refined[n]] = comm[n];
+        graph_curr.template GetData<CurrentCommunityId>(n) = refined[n];
+      });
+
+      katana::do_all(
+          katana::iterate(uint64_t{0}, clusters_orig.size()), [&](uint64_t n) {
+            uint64_t& c = clusters_orig[n];
+            if (c != Base::UNASSIGNED) {
+              c = refined[c];
+            }
+          });
+
+      // Aggregate the graph over the refined communities
+      auto coarsened_graph_result =
+          Base::template GraphCoarsening<NodeData, EdgeData, EdgeWeightType>(
+              graph_curr, pfg_curr.get(), num_refined,
+              temp_node_property_names, temp_edge_property_names);
+      if (!coarsened_graph_result) {
+        return coarsened_graph_result.error();
+      }
+
+      pfg_curr = std::move(coarsened_graph_result.value());
+      initial = std::move(next_initial);
+      prev_mod = curr_mod;
+    }
+    return katana::ResultSuccess();
+  }
+};
+
+template <typename EdgeWeightType>
+static katana::Result<void>
+LeidenClusteringWithWrap(
+    katana::PropertyGraph* pfg, const std::string& edge_weight_property_name,
+    const std::string& output_property_name, LeidenClusteringPlan plan) {
+  static_assert(
+      std::is_integral_v<EdgeWeightType> ||
+      std::is_floating_point_v<EdgeWeightType>);
+
+  std::vector<TemporaryPropertyGuard> temp_node_properties(3);
+  std::generate_n(
+      temp_node_properties.begin(), temp_node_properties.size(),
+      [&]() { return TemporaryPropertyGuard{pfg}; });
+  std::vector<std::string> temp_node_property_names(
+      temp_node_properties.size());
+  std::transform(
+      temp_node_properties.begin(), temp_node_properties.end(),
+      temp_node_property_names.begin(),
+      [](const TemporaryPropertyGuard& p) { return p.name(); });
+
+  using Impl = LeidenClusteringImplementation<EdgeWeightType>;
+  if (auto result = ConstructNodeProperties<typename Impl::NodeData>(
+          pfg, temp_node_property_names);
+      !result) {
+    return result.error();
+  }
+
+  /*
+   * To keep track of communities for nodes in the original graph.
+   * Community will be set to -1 for isolated nodes removed by vertex
+   * following
+   */
+  katana::NUMAArray<uint64_t> clusters_orig;
+  clusters_orig.allocateBlocked(pfg->num_nodes());
+
+  Impl impl{};
+  if (auto r = impl.LeidenClustering(
+          pfg, edge_weight_property_name, temp_node_property_names,
+          clusters_orig, plan);
+      !r) {
+    return r.error();
+  }
+
+  if (auto r = ConstructNodeProperties<std::tuple<CurrentCommunityId>>(
+          pfg, {output_property_name});
+      !r) {
+    return r.error();
+  }
+
+  auto graph_result =
+      katana::TypedPropertyGraph<std::tuple<CurrentCommunityId>, std::tuple<>>::
+          Make(pfg, {output_property_name}, {});
+  if (!graph_result) {
+    return graph_result.error();
+  }
+  auto graph = graph_result.value();
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](uint32_t i) {
+        graph.GetData<CurrentCommunityId>(i) = clusters_orig[i];
+      },
+      katana::loopname("Add clusterIds"), katana::no_stats());
+
+  return katana::ResultSuccess();
+}
+
+template <typename EdgeWeightType>
+katana::Result<double>
+LeidenModularity(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& property_name) {
+  using CommTy = CommunityType<EdgeWeightType>;
+  using NodeData = std::tuple<PreviousCommunityId>;
+  using EdgeData = std::tuple<EdgeWeight<EdgeWeightType>>;
+  using Graph = katana::TypedPropertyGraph<NodeData, EdgeData>;
+  using ClusterBase = katana::analytics::ClusteringImplementationBase<
+      Graph, EdgeWeightType, CommTy>;
+  auto graph_result =
+      Graph::Make(pg, {property_name}, {edge_weight_property_name});
+  if (!graph_result) {
+    return graph_result.error();
+  }
+  auto graph = graph_result.value();
+  return ClusterBase::template CalModularityFinal<
+      Graph, EdgeWeightType, PreviousCommunityId>(graph);
+}
+
+}  // anonymous namespace
+
+katana::Result<void>
+katana::analytics::LeidenClustering(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& output_property_name, LeidenClusteringPlan plan) {
+  if (plan.algorithm() != LeidenClusteringPlan::kDoAll) {
+    return katana::ErrorCode::InvalidArgument;
+  }
+  switch (pg->GetEdgeProperty(edge_weight_property_name)->type()->id()) {
+  case arrow::UInt32Type::type_id:
+    return LeidenClusteringWithWrap<uint32_t>(
+        pg, edge_weight_property_name, output_property_name, plan);
+  case arrow::Int32Type::type_id:
+    return LeidenClusteringWithWrap<int32_t>(
+        pg, edge_weight_property_name, output_property_name, plan);
+  case arrow::UInt64Type::type_id:
+    return LeidenClusteringWithWrap<uint64_t>(
+        pg, edge_weight_property_name, output_property_name, plan);
+  case arrow::Int64Type::type_id:
+    return LeidenClusteringWithWrap<int64_t>(
+        pg, edge_weight_property_name, output_property_name, plan);
+  case arrow::FloatType::type_id:
+    return LeidenClusteringWithWrap<float>(
+        pg, edge_weight_property_name, output_property_name, plan);
+  case arrow::DoubleType::type_id:
+    return LeidenClusteringWithWrap<double>(
+        pg, edge_weight_property_name, output_property_name, plan);
+  default:
+    return katana::ErrorCode::TypeError;
+  }
+}
+
+katana::Result<void>
+katana::analytics::LeidenClusteringAssertValid(
+    katana::PropertyGraph* pg,
+    [[maybe_unused]] const std::string& edge_weight_property_name,
+    const std::string& property_name) {
+  auto graph_result = katana::
+      TypedPropertyGraph<std::tuple<PreviousCommunityId>, std::tuple<>>::Make(
+          pg, {property_name}, {});
+  if (!graph_result) {
+    return graph_result.error();
+  }
+  auto graph = graph_result.value();
+  using GNode = decltype(graph)::Node;
+  constexpr uint64_t kUnassigned = std::numeric_limits<uint64_t>::max();
+
+  // Union the endpoints of edges inside a cluster; each cluster must end up
+  // as a single set
+  katana::NUMAArray<GNode> parent;
+  parent.allocateBlocked(graph.num_nodes());
+  katana::do_all(katana::iterate(graph), [&](GNode n) { parent[n] = n; });
+  auto find = [&parent](GNode n) {
+    while (parent[n] != n) {
+      parent[n] = parent[parent[n]];
+      n = parent[n];
+    }
+    return n;
+  };
+
+  for (GNode n : graph) {
+    uint64_t cluster = graph.GetData<PreviousCommunityId>(n);
+    for (auto e : graph.edges(n)) {
+      auto dst = graph.GetEdgeDest(e);
+      if (graph.GetData<PreviousCommunityId>(dst) == cluster) {
+        GNode a = find(n);
+        GNode b = find(*dst);
+        if (a != b) {
+          parent[std::max(a, b)] = std::min(a, b);
+        }
+      }
+    }
+  }
+
+  katana::NUMAArray<uint64_t> cluster_root;
+  cluster_root.allocateBlocked(graph.num_nodes());
+  katana::do_all(
+      katana::iterate(graph), [&](GNode n) { cluster_root[n] = kUnassigned; });
+
+  for (GNode n : graph) {
+    uint64_t cluster = graph.GetData<PreviousCommunityId>(n);
+    if (cluster == kUnassigned) {
+      continue;
+    }
+    if (cluster >= graph.num_nodes()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::AssertionFailed, "node {} has invalid cluster {}",
+          n, cluster);
+    }
+    GNode root = find(n);
+    if (cluster_root[cluster] == kUnassigned) {
+      cluster_root[cluster] = root;
+    } else if (cluster_root[cluster] != root) {
+      return KATANA_ERROR(
+          katana::ErrorCode::AssertionFailed, "cluster {} is not connected",
+          cluster);
+    }
+  }
+  return katana::ResultSuccess();
+}
+
+void
+katana::analytics::LeidenClusteringStatistics::Print(std::ostream& os) const {
+  os << "Total number of clusters = " << n_clusters << std::endl;
+  os << "Total number of non trivial clusters = " << n_non_trivial_clusters
+     << std::endl;
+  os << "Number of nodes in the largest cluster = " << largest_cluster_size
+     << std::endl;
+  os << "Ratio of nodes in the largest cluster = " << largest_cluster_proportion
+     << std::endl;
+  os << "Leiden modularity = " << modularity << std::endl;
+}
+
+katana::Result<katana::analytics::LeidenClusteringStatistics>
+katana::analytics::LeidenClusteringStatistics::Compute(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& property_name) {
+  auto graph_result = katana::
+      TypedPropertyGraph<std::tuple<PreviousCommunityId>, std::tuple<>>::Make(
+          pg, {property_name}, {});
+  if (!graph_result) {
+    return graph_result.error();
+  }
+  auto graph = graph_result.value();
+  using GNode = decltype(graph)::Node;
+
+  // Cluster ids are contiguous, so sizes can be counted in a dense array
+  katana::NUMAArray<std::atomic<uint64_t>> cluster_size;
+  cluster_size.allocateBlocked(graph.num_nodes());
+  katana::do_all(
+      katana::iterate(graph), [&](GNode n) { cluster_size[n] = 0; },
+      katana::no_stats());
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](GNode n) {
+        uint64_t cluster = graph.GetData<PreviousCommunityId>(n);
+        if (cluster < graph.num_nodes()) {
+          katana::atomicAdd(cluster_size[cluster], uint64_t{1});
+        }
+      },
+      katana::loopname("CountClusterSizes"));
+
+  katana::GAccumulator<uint64_t> clusters;
+  katana::GAccumulator<uint64_t> non_trivial_clusters;
+  katana::GReduceMax<uint64_t> largest;
+  katana::do_all(katana::iterate(graph), [&](GNode c) {
+    uint64_t size = cluster_size[c];
+    if (size > 0) {
+      clusters += 1;
+      largest.update(size);
+    }
+    if (size > 1) {
+      non_trivial_clusters += 1;
+    }
+  });
+
+  uint64_t largest_cluster_size = largest.reduce();
+  double largest_cluster_proportion = 0;
+  if (!graph.empty()) {
+    largest_cluster_proportion = double(largest_cluster_size) / graph.size();
+  }
+
+  katana::Result<double> modularity_result = katana::ErrorCode::TypeError;
+  switch (pg->GetEdgeProperty(edge_weight_property_name)->type()->id()) {
+  case arrow::UInt32Type::type_id:
+    modularity_result = LeidenModularity<uint32_t>(
+        pg, edge_weight_property_name, property_name);
+    break;
+  case arrow::Int32Type::type_id:
+    modularity_result =
+        LeidenModularity<int32_t>(pg, edge_weight_property_name, property_name);
+    break;
+  case arrow::UInt64Type::type_id:
+    modularity_result = LeidenModularity<uint64_t>(
+        pg, edge_weight_property_name, property_name);
+    break;
+  case arrow::Int64Type::type_id:
+    modularity_result =
+        LeidenModularity<int64_t>(pg, edge_weight_property_name, property_name);
+    break;
+  case arrow::FloatType::type_id:
+    modularity_result =
+        LeidenModularity<float>(pg, edge_weight_property_name, property_name);
+    break;
+  case arrow::DoubleType::type_id:
+    modularity_result =
+        LeidenModularity<double>(pg, edge_weight_property_name, property_name);
+    break;
+  default:
+    break;
+  }
+  if (!modularity_result) {
+    return modularity_result.error();
+  }
+
+  return LeidenClusteringStatistics{
+      clusters.reduce(), non_trivial_clusters.reduce(), largest_cluster_size,
+      largest_cluster_proportion, modularity_result.value()};
+}
@@ -0,0 +1,628 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/analytics/matrix_completion/matrix_completion.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <arrow/api.h>
+#include <arrow/array/concatenate.h>
+
+#include "katana/Galois.h"
+#include "katana/NUMAArray.h"
+#include "katana/ParallelSTL.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/Reduction.h"
+#include "katana/analytics/Utils.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+using Edge = katana::GraphTopology::Edge;
+
+/// The number of independent partial sums in Dot. It lets the compiler keep
+/// the sums in a vector register without reassociating the additions.
+constexpr uint32_t kDotLanes = 8;
+
+/// The smallest pivot of the Cholesky factorization. Only reached without
+/// regularization, when the ratings of a node do not determine its vector.
+constexpr double kMinPivot = 1e-12;
+
+float
+Dot(const float* __restrict__ a, const float* __restrict__ b,
+    uint32_t dimension) {
+  float lanes[kDotLanes] = {};
+  uint32_t k = 0;
+  for (; k + kDotLanes <= dimension; k += kDotLanes) {
+    for (uint32_t l = 0; l < kDotLanes; ++l) {
+      lanes[l] += a[k + l] * b[k + l];
+    }
+  }
+  float sum = 0;
+  for (; k < dimension; ++k) {
+    sum += a[k] * b[k];
+  }
+  for (uint32_t l = 0; l < kDotLanes; ++l) {
+    sum += lanes[l];
+  }
+  return sum;
+}
+
+/// Take a gradient step on the regularized squared error of one rating.
+void
+GradientStep(
+    float* __restrict__ item, float* __restrict__ user, uint32_t dimension,
+    float rating, float step, float lambda) {
+  const float error = Dot(item, user, dimension) - rating;
+  for (uint32_t k = 0; k < dimension; ++k) {
+    const float item_k = item[k];
+    const float user_k = user[k];
+    item[k] -= step * (error * user_k + lambda * item_k);
+    user[k] -= step * (error * item_k + lambda * user_k);
+  }
+}
+
+template <typename T>
+katana::Result<void>
+ReadRatingsAs(
+    katana::PropertyGraph* pg, const std::string& name,
+    katana::NUMAArray<float>* ratings) {
+  return katana::analytics::ForEachEdgePropertyValue<T>(
+      *pg, name, [&](uint64_t e, T rating) { (*ratings)[e] = rating; });
+}
+
+/// Read the ratings of the edges as floats whatever their numeric type.
+katana::Result<katana::NUMAArray<float>>
+ReadRatings(katana::PropertyGraph* pg, const std::string& name) {
+  auto property = pg->GetEdgeProperty(name);
+  if (!property) {
+    return KATANA_ERROR(
+        katana::ErrorCode::PropertyNotFound, "no edge property named {}",
+        name);
+  }
+
+  katana::NUMAArray<float> ratings;
+  ratings.allocateInterleaved(pg->num_edges());
+  switch (property->type()->id()) {
+  case arrow::UInt32Type::type_id:
+    KATANA_CHECKED(ReadRatingsAs<uint32_t>(pg, name, &ratings));
+    break;
+  case arrow::Int32Type::type_id:
+    KATANA_CHECKED(ReadRatingsAs<int32_t>(pg, name, &ratings));
+    break;
+  case arrow::UInt64Type::type_id:
+    KATANA_CHECKED(ReadRatingsAs<uint64_t>(pg, name, &ratings));
+    break;
+  case arrow::Int64Type::type_id:
+    KATANA_CHECKED(ReadRatingsAs<int64_t>(pg, name, &ratings));
+    break;
+  case arrow::FloatType::type_id:
+    KATANA_CHECKED(ReadRatingsAs<float>(pg, name, &ratings));
+    break;
+  case arrow::DoubleType::type_id:
+    KATANA_CHECKED(ReadRatingsAs<double>(pg, name, &ratings));
+    break;
+  default:
+    return KATANA_ERROR(
+        katana::ErrorCode::TypeError, "ratings must be numeric, not {}",
+        property->type()->ToString());
+  }
+  return katana::NUMAArray<float>(std::move(ratings));
+}
+
+/// The incoming edges of every node as IDs of edges of the topology, sorted
+/// by ID, along with the source of every edge.
+struct InEdges {
+  /// The end of the incoming edges of each node, like in GraphTopology
+  katana::NUMAArray<Edge> indices;
+  katana::NUMAArray<Edge> edges;
+  katana::NUMAArray<Node> sources;
+
+  Edge begin(Node n) const { return n == 0 ? 0 : indices[n - 1]; }
+  Edge end(Node n) const { return indices[n]; }
+  bool empty(Node n) const { return begin(n) == end(n); }
+};
+
+InEdges
+MakeInEdges(const katana::GraphTopology& topology) {
+  const uint64_t num_nodes = topology.num_nodes();
+  InEdges in;
+  in.indices.allocateInterleaved(num_nodes);
+  in.edges.allocateInterleaved(topology.num_edges());
+  in.sources.allocateInterleaved(topology.num_edges());
+  katana::ParallelSTL::fill(in.indices.begin(), in.indices.end(), Edge{0});
+
+  katana::do_all(
+      katana::iterate(topology),
+      [&](Node src) {
+        for (Edge e : topology.edges(src)) {
+          in.sources[e] = src;
+          __sync_fetch_and_add(&in.indices[topology.edge_dest(e)], 1);
+        }
+      },
+      katana::steal(), katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      in.indices.begin(), in.indices.end(), in.indices.begin());
+
+  katana::NUMAArray<Edge> cursors;
+  cursors.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) { cursors[n] = in.begin(n); }, katana::no_stats());
+  katana::do_all(
+      katana::iterate(topology),
+      [&](Node src) {
+        for (Edge e : topology.edges(src)) {
+          in.edges[__sync_fetch_and_add(&cursors[topology.edge_dest(e)], 1)] =
+              e;
+        }
+      },
+      katana::steal(), katana::no_stats());
+  // Make the order of the updates, and so the results, deterministic
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        Edge* edges = in.edges.data();
+        std::sort(edges + in.begin(n), edges + in.end(n));
+      },
+      katana::steal(), katana::no_stats());
+  return in;
+}
+
+/// A deterministic pseudo-random value in [0, 1) (splitmix64).
+float
+RandomFraction(uint64_t key) {
+  uint64_t z = key + 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  z ^= z >> 31;
+  return static_cast<float>(z >> 40) / static_cast<float>(1ULL << 24);
+}
+
+void
+InitializeLatentVectors(uint64_t num_nodes, uint32_t dimension, float* latent) {
+  const float scale = 1.0f / std::sqrt(static_cast<float>(dimension));
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes * dimension),
+      [&](uint64_t i) { latent[i] = scale * RandomFraction(i); },
+      katana::no_stats());
+}
+
+double
+SquaredError(
+    const katana::GraphTopology& topology, const float* ratings,
+    const float* latent, uint32_t dimension) {
+  katana::GAccumulator<double> error;
+  katana::do_all(
+      katana::iterate(topology),
+      [&](Node src) {
+        const float* item = &latent[uint64_t{src} * dimension];
+        for (Edge e : topology.edges(src)) {
+          const float* user =
+              &latent[uint64_t{topology.edge_dest(e)} * dimension];
+          const double diff = Dot(item, user, dimension) - ratings[e];
+          error += diff * diff;
+        }
+      },
+      katana::steal(), katana::no_stats(),
+      katana::loopname("MatrixCompletionError"));
+  return error.reduce();
+}
+
+/// Check the error after a pass and decide whether to stop.
+katana::Result<bool>
+Converged(double last_error, double error, double tolerance) {
+  if (!std::isfinite(error)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "matrix completion diverged; try a smaller learning rate");
+  }
+  return last_error == 0 ||
+         std::abs(last_error - error) / last_error < tolerance;
+}
+
+/// Stable ranks of the nodes for which is_member holds, and their number.
+template <typename IsMember>
+uint64_t
+Rank(
+    uint64_t num_nodes, const IsMember& is_member,
+    katana::NUMAArray<uint64_t>* ranks) {
+  // Shifted by one to make the prefix sum exclusive
+  ranks->allocateInterleaved(num_nodes + 1);
+  (*ranks)[0] = 0;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) { (*ranks)[n + 1] = is_member(n); }, katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      ranks->begin(), ranks->end(), ranks->begin());
+  return (*ranks)[num_nodes];
+}
+
+katana::Result<void>
+MatrixCompletionSGD(
+    const katana::GraphTopology& topology, const InEdges& in,
+    const float* ratings, float* latent, uint32_t dimension,
+    const MatrixCompletionPlan& plan) {
+  const uint64_t num_nodes = topology.num_nodes();
+  const uint64_t num_edges = topology.num_edges();
+
+  // Rank items and users separately so that every row and column of blocks
+  // gets about as many of them
+  katana::NUMAArray<uint64_t> item_ranks;
+  const uint64_t num_items = Rank(
+      num_nodes, [&](Node n) { return !topology.edges(n).empty(); },
+      &item_ranks);
+  katana::NUMAArray<uint64_t> user_ranks;
+  const uint64_t num_users =
+      Rank(num_nodes, [&](Node n) { return !in.empty(n); }, &user_ranks);
+  const uint64_t num_blocks = std::max<uint64_t>(
+      1, std::min<uint64_t>(
+             {katana::getActiveThreads(), num_items, num_users}));
+
+  // Sort the edges by block, keeping the edges of a block in topology order
+  katana::NUMAArray<uint64_t> block_of;
+  block_of.allocateInterleaved(num_edges);
+  katana::NUMAArray<uint64_t> block_begin;
+  block_begin.allocateInterleaved(num_blocks * num_blocks + 1);
+  katana::ParallelSTL::fill(
+      block_begin.begin(), block_begin.end(), uint64_t{0});
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_edges),
+      [&](uint64_t e) {
+        const uint64_t row = item_ranks[in.sources[e]] * num_blocks / num_items;
+        const uint64_t column =
+            user_ranks[topology.edge_dest(e)] * num_blocks / num_users;
+        block_of[e] = row * num_blocks + column;
+        __sync_fetch_and_add(&block_begin[block_of[e] + 1], 1);
+      },
+      katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      block_begin.begin(), block_begin.end(), block_begin.begin());
+
+  katana::NUMAArray<Edge> order;
+  order.allocateInterleaved(num_edges);
+  katana::ParallelSTL::iota(order.begin(), order.end(), Edge{0});
+  katana::ParallelSTL::sort(order.begin(), order.end(), [&](Edge a, Edge b) {
+    return std::make_pair(block_of[a], a) < std::make_pair(block_of[b], b);
+  });
+
+  const auto lambda = static_cast<float>(plan.lambda());
+  auto step = static_cast<float>(plan.learning_rate());
+  double last_error = SquaredError(topology, ratings, latent, dimension);
+  for (uint32_t round = 0; round < plan.max_iterations(); ++round) {
+    // In sub-pass s, thread i owns block (i, i + s): no two blocks of a
+    // sub-pass share an item or a user.
+    for (uint64_t shift = 0; shift < num_blocks; ++shift) {
+      katana::do_all(
+          katana::iterate(uint64_t{0}, num_blocks),
+          [&](uint64_t row) {
+            const uint64_t block =
+                row * num_blocks + (row + shift) % num_blocks;
+            for (uint64_t i = block_begin[block]; i < block_begin[block + 1];
+                 ++i) {
+              const Edge e = order[i];
+              GradientStep(
+                  &latent[uint64_t{in.sources[e]} * dimension],
+                  &latent[uint64_t{topology.edge_dest(e)} * dimension],
+                  dimension, ratings[e], step, lambda);
+            }
+          },
+          katana::no_stats(), katana::loopname("MatrixCompletionSGD"));
+    }
+
+    const double error = SquaredError(topology, ratings, latent, dimension);
+    // Bold driver: speed up while the error decreases, back off otherwise
+    step *= error > last_error ? 0.5f : 1.05f;
+    if (KATANA_CHECKED(Converged(last_error, error, plan.tolerance()))) {
+      break;
+    }
+    last_error = error;
+  }
+  return katana::ResultSuccess();
+}
+
+/// Solve a x = b in place of b for a symmetric positive definite a of which
+/// only the lower triangle is used, and overwritten by its Cholesky factor.
+void
+CholeskySolve(double* a, double* b, uint32_t dimension) {
+  for (uint32_t j = 0; j < dimension; ++j) {
+    double* row_j = &a[j * dimension];
+    double pivot = row_j[j];
+    for (uint32_t k = 0; k < j; ++k) {
+      pivot -= row_j[k] * row_j[k];
+    }
+    row_j[j] = std::sqrt(std::max(pivot, kMinPivot));
+    for (uint32_t i = j + 1; i < dimension; ++i) {
+      double* row_i = &a[i * dimension];
+      double sum = row_i[j];
+      for (uint32_t k = 0; k < j; ++k) {
+        sum -= row_i[k] * row_j[k];
+      }
+      row_i[j] = sum / row_j[j];
+    }
+  }
+
+  for (uint32_t i = 0; i < dimension; ++i) {
+    const double* row_i = &a[i * dimension];
+    for (uint32_t k = 0; k < i; ++k) {
+      b[i] -= row_i[k] * b[k];
+    }
+    b[i] /= row_i[i];
+  }
+  for (uint32_t i = dimension; i-- > 0;) {
+    for (uint32_t k = i + 1; k < dimension; ++k) {
+      b[i] -= a[k * dimension + i] * b[k];
+    }
+    b[i] /= a[i * dimension + i];
+  }
+}
+
+struct NormalEquations {
+  std::vector<double> matrix;
+  std::vector<double> rhs;
+};
+
+/// Set x to the least squares solution for the ratings of one node:
+/// (lambda I + sum y y^T) x = sum r y over the latent vectors y of the
+/// neighbors of the node and the ratings r of the edges to them.
+/// for_each_rating(fn) calls fn(neighbor, rating) for every rating.
+template <typename ForEachRating>
+void
+SolveLatentVector(
+    float* x, const float* latent, uint32_t dimension, double lambda,
+    NormalEquations* equations, const ForEachRating& for_each_rating) {
+  std::vector<double>& a = equations->matrix;
+  std::vector<double>& b = equations->rhs;
+  a.assign(uint64_t{dimension} * dimension, 0);
+  b.assign(dimension, 0);
+  for (uint32_t i = 0; i < dimension; ++i) {
+    a[i * dimension + i] = lambda;
+  }
+
+  for_each_rating([&](Node neighbor, float rating) {
+    const float* __restrict__ y = &latent[uint64_t{neighbor} * dimension];
+    for (uint32_t i = 0; i < dimension; ++i) {
+      double* __restrict__ row = &a[i * dimension];
+      const double y_i = y[i];
+      for (uint32_t k = 0; k <= i; ++k) {
+        row[k] += y_i * y[k];
+      }
+      b[i] += rating * y_i;
+    }
+  });
+
+  CholeskySolve(a.data(), b.data(), dimension);
+  for (uint32_t i = 0; i < dimension; ++i) {
+    x[i] = b[i];
+  }
+}
+
+katana::Result<void>
+MatrixCompletionALS(
+    const katana::GraphTopology& topology, const InEdges& in,
+    const float* ratings, float* latent, uint32_t dimension,
+    const MatrixCompletionPlan& plan) {
+  katana::PerThreadStorage<NormalEquations> equations;
+  double last_error = SquaredError(topology, ratings, latent, dimension);
+  for (uint32_t round = 0; round < plan.max_iterations(); ++round) {
+    katana::do_all(
+        katana::iterate(topology),
+        [&](Node item) {
+          if (topology.edges(item).empty()) {
+            return;
+          }
+          SolveLatentVector(
+              &latent[uint64_t{item} * dimension], latent, dimension,
+              plan.lambda(), equations.getLocal(), [&](const auto& fn) {
+                for (Edge e : topology.edges(item)) {
+                  fn(topology.edge_dest(e), ratings[e]);
+                }
+              });
+        },
+        katana::steal(), katana::no_stats(),
+        katana::loopname("MatrixCompletionALSItems"));
+
+    katana::do_all(
+        katana::iterate(topology),
+        [&](Node user) {
+          if (in.empty(user)) {
+            return;
+          }
+          SolveLatentVector(
+              &latent[uint64_t{user} * dimension], latent, dimension,
+              plan.lambda(), equations.getLocal(), [&](const auto& fn) {
+                for (Edge i = in.begin(user); i < in.end(user); ++i) {
+                  fn(in.sources[in.edges[i]], ratings[in.edges[i]]);
+                }
+              });
+        },
+        katana::steal(), katana::no_stats(),
+        katana::loopname("MatrixCompletionALSUsers"));
+
+    const double error = SquaredError(topology, ratings, latent, dimension);
+    if (KATANA_CHECKED(Converged(last_error, error, plan.tolerance()))) {
+      break;
+    }
+    last_error = error;
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<std::shared_ptr<arrow::FixedSizeListArray>>
+GetLatentVectors(katana::PropertyGraph* pg, const std::string& property_name) {
+  auto property = pg->GetNodeProperty(property_name);
+  if (!property) {
+    return KATANA_ERROR(
+        katana::ErrorCode::PropertyNotFound, "no node property named {}",
+        property_name);
+  }
+  const auto& type = property->type();
+  if (type->id() != arrow::Type::FIXED_SIZE_LIST ||
+      std::static_pointer_cast<arrow::FixedSizeListType>(type)
+              ->value_type()
+              ->id() != arrow::Type::FLOAT) {
+    return KATANA_ERROR(
+        katana::ErrorCode::TypeError,
+        "latent vectors must be fixed size lists of floats, not {}",
+        type->ToString());
+  }
+
+  // LatentValues needs the vectors of all nodes in one array
+  std::shared_ptr<arrow::Array> flat;
+  if (property->num_chunks() == 1) {
+    flat = property->chunk(0);
+  } else if (property->num_chunks() == 0) {
+    flat = KATANA_CHECKED(arrow::MakeArrayOfNull(type, 0));
+  } else {
+    flat = KATANA_CHECKED(
+        arrow::Concatenate(property->chunks(), arrow::default_memory_pool()));
+  }
+  return std::static_pointer_cast<arrow::FixedSizeListArray>(flat);
+}
+
+const float*
+LatentValues(const arrow::FixedSizeListArray& vectors) {
+  const float* values =
+      std::static_pointer_cast<arrow::FloatArray>(vectors.values())
+          ->raw_values();
+  return vectors.length() == 0 ? values : values + vectors.value_offset(0);
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::MatrixCompletion(
+    katana::PropertyGraph* pg, const std::string& edge_rating_property_name,
+    const std::string& output_property_name, uint32_t latent_dimension,
+    MatrixCompletionPlan plan) {
+  if (latent_dimension == 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "latent dimension must be at least 1");
+  }
+  if (pg->GetNodeProperty(output_property_name)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AlreadyExists, "node property {} already exists",
+        output_property_name);
+  }
+
+  const katana::GraphTopology& topology = pg->topology();
+  const uint64_t num_nodes = topology.num_nodes();
+  katana::NUMAArray<float> ratings =
+      KATANA_CHECKED(ReadRatings(pg, edge_rating_property_name));
+  InEdges in = MakeInEdges(topology);
+
+  katana::GReduceLogicalOr not_bipartite;
+  katana::do_all(
+      katana::iterate(topology),
+      [&](Node n) {
+        if (!topology.edges(n).empty() && !in.empty(n)) {
+          not_bipartite.update(true);
+        }
+      },
+      katana::no_stats());
+  if (not_bipartite.reduce()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "the graph must be bipartite with edges from items to users");
+  }
+
+  std::shared_ptr<arrow::Buffer> buf = KATANA_CHECKED(arrow::AllocateBuffer(
+      num_nodes * latent_dimension * sizeof(float)));
+  float* latent = reinterpret_cast<float*>(buf->mutable_data());
+  InitializeLatentVectors(num_nodes, latent_dimension, latent);
+
+  switch (plan.algorithm()) {
+  case MatrixCompletionPlan::kSGD:
+    KATANA_CHECKED(MatrixCompletionSGD(
+        topology, in, ratings.data(), latent, latent_dimension, plan));
+    break;
+  case MatrixCompletionPlan::kALS:
+    KATANA_CHECKED(MatrixCompletionALS(
+        topology, in, ratings.data(), latent, latent_dimension, plan));
+    break;
+  default:
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  auto values =
+      std::make_shared<arrow::FloatArray>(num_nodes * latent_dimension, buf);
+  auto vectors = std::make_shared<arrow::FixedSizeListArray>(
+      arrow::fixed_size_list(arrow::float32(), latent_dimension), num_nodes,
+      values);
+  return pg->AddNodeProperties(arrow::Table::Make(
+      arrow::schema({arrow::field(output_property_name, vectors->type())}),
+      {vectors}));
+}
+
+katana::Result<void>
+katana::analytics::MatrixCompletionAssertValid(
+    katana::PropertyGraph* pg, const std::string& property_name) {
+  auto vectors = KATANA_CHECKED(GetLatentVectors(pg, property_name));
+  if (static_cast<uint64_t>(vectors->length()) != pg->num_nodes()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AssertionFailed,
+        "there must be a latent vector for every node");
+  }
+
+  const float* values = LatentValues(*vectors);
+  katana::GReduceLogicalOr invalid;
+  katana::do_all(
+      katana::iterate(
+          uint64_t{0}, pg->num_nodes() * uint64_t(vectors->value_length())),
+      [&](uint64_t i) {
+        if (!std::isfinite(values[i])) {
+          invalid.update(true);
+        }
+      },
+      katana::no_stats());
+  if (invalid.reduce()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AssertionFailed, "latent values must be finite");
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<MatrixCompletionStatistics>
+katana::analytics::MatrixCompletionStatistics::Compute(
+    katana::PropertyGraph* pg, const std::string& edge_rating_property_name,
+    const std::string& property_name) {
+  KATANA_CHECKED(MatrixCompletionAssertValid(pg, property_name));
+  auto vectors = KATANA_CHECKED(GetLatentVectors(pg, property_name));
+  katana::NUMAArray<float> ratings =
+      KATANA_CHECKED(ReadRatings(pg, edge_rating_property_name));
+
+  const uint32_t dimension = vectors->value_length();
+  const double error = SquaredError(
+      pg->topology(), ratings.data(), LatentValues(*vectors), dimension);
+  const uint64_t num_edges = pg->num_edges();
+  return MatrixCompletionStatistics{
+      dimension, num_edges == 0 ? 0 : std::sqrt(error / num_edges)};
+}
+
+void
+katana::analytics::MatrixCompletionStatistics::Print(std::ostream& os) const {
+  os << "Latent dimension = " << latent_dimension << std::endl;
+  os << "Root mean square error = " << root_mean_square_error << std::endl;
+}
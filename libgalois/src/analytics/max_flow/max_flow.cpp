@@ -0,0 +1,588 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/analytics/max_flow/max_flow.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <utility>
+
+#include "katana/AtomicHelpers.h"
+#include "katana/Bag.h"
+#include "katana/DynamicBitset.h"
+#include "katana/Galois.h"
+#include "katana/NUMAArray.h"
+#include "katana/ParallelSTL.h"
+#include "katana/Reduction.h"
+#include "katana/TypedPropertyGraph.h"
+#include "katana/analytics/Utils.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+using Edge = katana::GraphTopology::Edge;
+
+struct NodeCut : public katana::PODProperty<uint8_t> {};
+struct EdgeFlow : public katana::PODProperty<uint64_t> {};
+
+using NodeData = std::tuple<NodeCut>;
+using EdgeData = std::tuple<EdgeFlow>;
+using Graph = katana::TypedPropertyGraph<NodeData, EdgeData>;
+
+/// The work counted for a relabel relative to a push (BETA in Goldberg's
+/// implementation)
+constexpr uint64_t kRelabelWork = 12;
+/// The parameters of the default global relabel interval (ALPHA in
+/// Goldberg's implementation)
+constexpr uint64_t kRelabelsPerNode = 6;
+constexpr uint64_t kEdgesPerRelabel = 3;
+
+template <typename T>
+katana::Result<void>
+ReadCapacitiesAs(
+    katana::PropertyGraph* pg, const std::string& name,
+    katana::NUMAArray<int64_t>* capacities) {
+  katana::GReduceLogicalOr negative;
+  KATANA_CHECKED(ForEachEdgePropertyValue<T>(
+      *pg, name, [&](uint64_t e, T capacity) {
+        (*capacities)[e] = capacity;
+        if ((*capacities)[e] < 0) {
+          negative.update(true);
+        }
+      }));
+  if (negative.reduce()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "capacities must not be negative");
+  }
+  return katana::ResultSuccess();
+}
+
+/// Read the capacities of the edges whatever their integer type.
+katana::Result<katana::NUMAArray<int64_t>>
+ReadCapacities(katana::PropertyGraph* pg, const std::string& name) {
+  auto property = pg->GetEdgeProperty(name);
+  if (!property) {
+    return KATANA_ERROR(
+        katana::ErrorCode::PropertyNotFound, "no edge property named {}",
+        name);
+  }
+
+  katana::NUMAArray<int64_t> capacities;
+  capacities.allocateInterleaved(pg->num_edges());
+  switch (property->type()->id()) {
+  case arrow::UInt32Type::type_id:
+    KATANA_CHECKED(ReadCapacitiesAs<uint32_t>(pg, name, &capacities));
+    break;
+  case arrow::Int32Type::type_id:
+    KATANA_CHECKED(ReadCapacitiesAs<int32_t>(pg, name, &capacities));
+    break;
+  case arrow::UInt64Type::type_id:
+    KATANA_CHECKED(ReadCapacitiesAs<uint64_t>(pg, name, &capacities));
+    break;
+  case arrow::Int64Type::type_id:
+    KATANA_CHECKED(ReadCapacitiesAs<int64_t>(pg, name, &capacities));
+    break;
+  default:
+    return KATANA_ERROR(
+        katana::ErrorCode::TypeError, "capacities must be integers, not {}",
+        property->type()->ToString());
+  }
+  return katana::NUMAArray<int64_t>(std::move(capacities));
+}
+
+/// Push-relabel over the residual graph of a topology. The arcs of a node
+/// are its outgoing edges followed by the reverses of its incoming edges, and
+/// every arc knows the arc in the other direction (its partner).
+///
+/// A node is discharged by one thread at a time, which is the only one to
+/// change its height, decrease its excess and decrease the residual
+/// capacities of its arcs; the other threads only add to its excess and to
+/// the residual capacities of its arcs. Under these conditions, pushing to
+/// the lowest neighbors without locks is correct (Hong and He).
+class PushRelabel {
+public:
+  PushRelabel(
+      const katana::GraphTopology& topology,
+      const katana::NUMAArray<int64_t>& capacities, Node source, Node sink,
+      uint64_t global_relabel_interval)
+      : topology_(topology),
+        num_nodes_(topology.num_nodes()),
+        source_(source),
+        sink_(sink),
+        global_relabel_interval_(
+            global_relabel_interval != 0
+                ? global_relabel_interval
+                : kRelabelsPerNode * topology.num_nodes() +
+                      topology.num_edges() / kEdgesPerRelabel) {
+    MakeResidualGraph(capacities);
+    excess_.allocateInterleaved(num_nodes_);
+    heights_.allocateInterleaved(num_nodes_);
+    counts_.allocateInterleaved(num_nodes_ + 1);
+    queued_.resize(num_nodes_);
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes_),
+        [&](uint64_t n) { excess_[n] = 0; }, katana::no_stats());
+  }
+
+  /// Compute a maximum flow and the cut, and return the flow value.
+  uint64_t Run() {
+    // Saturate the edges out of the source
+    for (uint64_t a = arc_begin_[source_]; a < arc_begin_[source_ + 1]; ++a) {
+      const int64_t amount = residual_[a];
+      if (amount > 0 && arc_dest_[a] != source_) {
+        residual_[a] = 0;
+        residual_[arc_partner_[a]] += amount;
+        excess_[arc_dest_[a]] += amount;
+      }
+    }
+
+    // Push as much flow as possible to the sink...
+    Discharge(sink_, source_);
+    // ...which leaves the nodes that can still reach it on the sink side
+    cut_.allocateInterleaved(num_nodes_);
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes_),
+        [&](uint64_t n) { cut_[n] = heights_[n] == num_nodes_; },
+        katana::no_stats());
+    // Turn the preflow into a flow
+    Discharge(source_, sink_);
+
+    return excess_[sink_];
+  }
+
+  /// The flow along edge e out of node src.
+  uint64_t Flow(Node src, Edge e, int64_t capacity) const {
+    const Edge first = src == 0 ? 0 : topology_.adj_data()[src - 1];
+    return capacity - residual_[arc_begin_[src] + (e - first)];
+  }
+
+  /// Whether node n is on the source side of the cut.
+  bool SourceSide(Node n) const { return cut_[n]; }
+
+private:
+  void MakeResidualGraph(const katana::NUMAArray<int64_t>& capacities) {
+    const uint64_t num_edges = topology_.num_edges();
+    const Edge* adj = topology_.adj_data();
+
+    // Number the incoming edges of each node
+    katana::NUMAArray<Edge> in_begin;
+    in_begin.allocateInterleaved(num_nodes_ + 1);
+    katana::ParallelSTL::fill(in_begin.begin(), in_begin.end(), Edge{0});
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_edges),
+        [&](uint64_t e) {
+          __sync_fetch_and_add(&in_begin[topology_.edge_dest(e) + 1], 1);
+        },
+        katana::no_stats());
+    katana::ParallelSTL::partial_sum(
+        in_begin.begin(), in_begin.end(), in_begin.begin());
+
+    arc_begin_.allocateInterleaved(num_nodes_ + 1);
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes_ + 1),
+        [&](uint64_t n) {
+          arc_begin_[n] = in_begin[n] + (n == 0 ? 0 : adj[n - 1]);
+        },
+        katana::no_stats());
+
+    arc_dest_.allocateInterleaved(2 * num_edges);
+    arc_partner_.allocateInterleaved(2 * num_edges);
+    residual_.allocateInterleaved(2 * num_edges);
+    katana::NUMAArray<Edge> cursors;
+    cursors.allocateInterleaved(num_nodes_);
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes_),
+        [&](uint64_t n) {
+          cursors[n] = arc_begin_[n] + topology_.edges(n).size();
+        },
+        katana::no_stats());
+    katana::do_all(
+        katana::iterate(topology_),
+        [&](Node src) {
+          uint64_t arc = arc_begin_[src];
+          for (Edge e : topology_.edges(src)) {
+            const Node dest = topology_.edge_dest(e);
+            const uint64_t reverse = __sync_fetch_and_add(&cursors[dest], 1);
+            arc_dest_[arc] = dest;
+            arc_partner_[arc] = reverse;
+            residual_[arc] = capacities[e];
+            arc_dest_[reverse] = src;
+            arc_partner_[reverse] = arc;
+            residual_[reverse] = 0;
+            ++arc;
+          }
+        },
+        katana::steal(), katana::no_stats());
+  }
+
+  /// Set the heights to the distances to target in the residual graph with
+  /// a parallel BFS, lifting the nodes that cannot reach it and the node
+  /// excluded to num_nodes_, and collect the active nodes.
+  void GlobalRelabel(
+      Node target, Node excluded, katana::InsertBag<Node>* active) {
+    const auto unreached = static_cast<uint32_t>(num_nodes_);
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes_),
+        [&](uint64_t n) {
+          heights_[n] = unreached;
+          counts_[n] = 0;
+        },
+        katana::no_stats());
+    counts_[num_nodes_] = 0;
+    heights_[target] = 0;
+
+    katana::InsertBag<Node> frontier;
+    katana::InsertBag<Node> next;
+    frontier.push(target);
+    for (uint32_t height = 1; !frontier.empty(); ++height) {
+      katana::do_all(
+          katana::iterate(frontier),
+          [&](Node n) {
+            for (uint64_t a = arc_begin_[n]; a < arc_begin_[n + 1]; ++a) {
+              const Node pred = arc_dest_[a];
+              uint32_t expected = unreached;
+              if (pred != excluded && residual_[arc_partner_[a]] > 0 &&
+                  heights_[pred].compare_exchange_strong(expected, height)) {
+                next.push(pred);
+              }
+            }
+          },
+          katana::steal(), katana::no_stats(),
+          katana::loopname("MaxFlowGlobalRelabel"));
+      frontier.clear();
+      frontier.swap(next);
+    }
+
+    queued_.reset();
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes_),
+        [&](uint64_t n) {
+          const uint32_t height = heights_[n];
+          katana::atomicAdd(counts_[height], uint64_t{1});
+          if (height < unreached && n != source_ && n != sink_ &&
+              excess_[n] > 0) {
+            queued_.set(n);
+            active->push(n);
+          }
+        },
+        katana::no_stats());
+  }
+
+  /// Push the excess of every node towards target until no node with excess
+  /// can reach it, with excluded never receiving flow.
+  void Discharge(Node target, Node excluded) {
+    const uint64_t local_interval = std::max<uint64_t>(
+        1, global_relabel_interval_ / katana::getActiveThreads());
+    while (true) {
+      katana::InsertBag<Node> active;
+      GlobalRelabel(target, excluded, &active);
+      if (active.empty()) {
+        // Only stop after a global relabel: the heuristics may have lifted
+        // nodes that can still reach the target
+        return;
+      }
+
+      katana::GAccumulator<uint64_t> work;
+      katana::for_each(
+          katana::iterate(active),
+          [&](Node n, auto& ctx) {
+            work += DischargeNode(n, ctx);
+            if (work.getLocal() >= local_interval || gap_found_) {
+              ctx.breakLoop();
+            }
+          },
+          katana::wl<katana::PerSocketChunkFIFO<16>>(),
+          katana::disable_conflict_detection(), katana::parallel_break(),
+          katana::no_stats(), katana::loopname("MaxFlowDischarge"));
+      gap_found_ = false;
+    }
+  }
+
+  /// Push the excess of node n to its lowest neighbors, relabeling it when
+  /// there are none below it, and return the amount of work.
+  template <typename Context>
+  uint64_t DischargeNode(Node n, Context& ctx) {
+    uint64_t work = 0;
+    while (true) {
+      int64_t excess = excess_[n].load(std::memory_order_relaxed);
+      const uint32_t height = heights_[n].load(std::memory_order_relaxed);
+      if (excess <= 0 || height >= num_nodes_) {
+        break;
+      }
+
+      uint32_t lowest = std::numeric_limits<uint32_t>::max();
+      for (uint64_t a = arc_begin_[n]; a < arc_begin_[n + 1]; ++a) {
+        if (residual_[a].load(std::memory_order_relaxed) > 0) {
+          lowest = std::min(
+              lowest, heights_[arc_dest_[a]].load(std::memory_order_relaxed));
+        }
+      }
+
+      if (lowest >= height) {
+        Relabel(n, height, lowest);
+        work += kRelabelWork;
+        continue;
+      }
+
+      // Heights only grow, so the neighbors still at the lowest height are
+      // still the lowest and pushing to all of them is the same as pushing to
+      // them one at a time.
+      for (uint64_t a = arc_begin_[n]; a < arc_begin_[n + 1] && excess > 0;
+           ++a) {
+        const Node dest = arc_dest_[a];
+        const int64_t residual = residual_[a].load(std::memory_order_relaxed);
+        if (residual <= 0 || heights_[dest] != lowest) {
+          continue;
+        }
+        const int64_t amount = std::min(excess, residual);
+        katana::atomicSub(residual_[a], amount);
+        katana::atomicAdd(residual_[arc_partner_[a]], amount);
+        katana::atomicSub(excess_[n], amount);
+        katana::atomicAdd(excess_[dest], amount);
+        excess -= amount;
+        ++work;
+        if (dest != source_ && dest != sink_ && !queued_.set(dest)) {
+          ctx.push(dest);
+        }
+      }
+    }
+
+    queued_.reset(n);
+    // Flow may have arrived between the last check and the reset
+    if (excess_[n] > 0 && heights_[n] < num_nodes_ && !queued_.set(n)) {
+      ctx.push(n);
+    }
+    return work;
+  }
+
+  void Relabel(Node n, uint32_t height, uint32_t lowest) {
+    uint32_t new_height = lowest >= num_nodes_ - 1
+                              ? static_cast<uint32_t>(num_nodes_)
+                              : lowest + 1;
+    // Count the node at its new height before leaving the old one, so that
+    // an empty level is never reported while a node is on it
+    katana::atomicAdd(counts_[new_height], uint64_t{1});
+    heights_[n] = new_height;
+    if (katana::atomicSub(counts_[height], uint64_t{1}) == 1 &&
+        new_height < num_nodes_) {
+      // Gap: no node above the empty level can reach the target
+      katana::atomicSub(counts_[new_height], uint64_t{1});
+      heights_[n] = num_nodes_;
+      katana::atomicAdd(counts_[num_nodes_], uint64_t{1});
+      gap_found_ = true;
+    }
+  }
+
+  const katana::GraphTopology& topology_;
+  const uint64_t num_nodes_;
+  const Node source_;
+  const Node sink_;
+  const uint64_t global_relabel_interval_;
+
+  katana::NUMAArray<uint64_t> arc_begin_;
+  katana::NUMAArray<Node> arc_dest_;
+  katana::NUMAArray<uint64_t> arc_partner_;
+  katana::NUMAArray<std::atomic<int64_t>> residual_;
+
+  katana::NUMAArray<std::atomic<int64_t>> excess_;
+  katana::NUMAArray<std::atomic<uint32_t>> heights_;
+  /// The number of nodes at each height
+  katana::NUMAArray<std::atomic<uint64_t>> counts_;
+  /// Whether a node is in the worklist or being discharged
+  katana::DynamicBitset queued_;
+  std::atomic<bool> gap_found_{false};
+
+  katana::NUMAArray<uint8_t> cut_;
+};
+
+}  // namespace
+
+katana::Result<uint64_t>
+katana::analytics::MaxFlow(
+    katana::PropertyGraph* pg, uint32_t source, uint32_t sink,
+    const std::string& edge_capacity_property_name,
+    const std::string& output_flow_property_name,
+    const std::string& output_cut_property_name, MaxFlowPlan plan) {
+  if (source >= pg->num_nodes() || sink >= pg->num_nodes()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "source and sink must be nodes of the graph");
+  }
+  if (source == sink) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "source and sink must be different");
+  }
+  if (plan.algorithm() != MaxFlowPlan::kPushRelabel) {
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  katana::NUMAArray<int64_t> capacities =
+      KATANA_CHECKED(ReadCapacities(pg, edge_capacity_property_name));
+
+  KATANA_CHECKED(
+      ConstructNodeProperties<NodeData>(pg, {output_cut_property_name}));
+  KATANA_CHECKED(
+      ConstructEdgeProperties<EdgeData>(pg, {output_flow_property_name}));
+  auto graph = KATANA_CHECKED(Graph::Make(
+      pg, {output_cut_property_name}, {output_flow_property_name}));
+
+  PushRelabel push_relabel(
+      pg->topology(), capacities, source, sink,
+      plan.global_relabel_interval());
+  const uint64_t flow_value = push_relabel.Run();
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](Node n) {
+        graph.GetData<NodeCut>(n) = push_relabel.SourceSide(n);
+        for (Edge e : graph.edges(n)) {
+          graph.GetEdgeData<EdgeFlow>(e) =
+              push_relabel.Flow(n, e, capacities[e]);
+        }
+      },
+      katana::steal(), katana::no_stats());
+  return flow_value;
+}
+
+katana::Result<void>
+katana::analytics::MaxFlowAssertValid(
+    katana::PropertyGraph* pg, uint32_t source, uint32_t sink,
+    const std::string& edge_capacity_property_name,
+    const std::string& flow_property_name,
+    const std::string& cut_property_name) {
+  katana::NUMAArray<int64_t> capacities =
+      KATANA_CHECKED(ReadCapacities(pg, edge_capacity_property_name));
+  auto graph = KATANA_CHECKED(
+      Graph::Make(pg, {cut_property_name}, {flow_property_name}));
+
+  if (!graph.GetData<NodeCut>(source) || graph.GetData<NodeCut>(sink)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AssertionFailed,
+        "the cut must separate the source from the sink");
+  }
+
+  katana::NUMAArray<std::atomic<int64_t>> net_inflow;
+  net_inflow.allocateInterleaved(pg->num_nodes());
+  katana::do_all(
+      katana::iterate(graph), [&](Node n) { net_inflow[n] = 0; },
+      katana::no_stats());
+
+  katana::GReduceLogicalOr over_capacity;
+  katana::GReduceLogicalOr not_minimum;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](Node n) {
+        for (Edge e : graph.edges(n)) {
+          const Node dest = *graph.GetEdgeDest(e);
+          const auto flow =
+              static_cast<int64_t>(graph.GetEdgeData<EdgeFlow>(e));
+          if (flow > capacities[e]) {
+            over_capacity.update(true);
+          }
+          const uint8_t src_side = graph.GetData<NodeCut>(n);
+          const uint8_t dest_side = graph.GetData<NodeCut>(dest);
+          if ((src_side && !dest_side && flow != capacities[e]) ||
+              (!src_side && dest_side && flow != 0)) {
+            not_minimum.update(true);
+          }
+          katana::atomicSub(net_inflow[n], flow);
+          katana::atomicAdd(net_inflow[dest], flow);
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  if (over_capacity.reduce()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AssertionFailed,
+        "the flow along an edge exceeds its capacity");
+  }
+  if (not_minimum.reduce()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AssertionFailed,
+        "the cut is not saturated, so the flow is not maximum");
+  }
+
+  katana::GReduceLogicalOr not_conserved;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](Node n) {
+        if (n != source && n != sink && net_inflow[n] != 0) {
+          not_conserved.update(true);
+        }
+      },
+      katana::no_stats());
+  if (not_conserved.reduce()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AssertionFailed,
+        "the flow is not conserved at every node");
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<MaxFlowStatistics>
+katana::analytics::MaxFlowStatistics::Compute(
+    katana::PropertyGraph* pg, uint32_t source,
+    const std::string& flow_property_name,
+    const std::string& cut_property_name) {
+  auto graph = KATANA_CHECKED(
+      Graph::Make(pg, {cut_property_name}, {flow_property_name}));
+
+  katana::GAccumulator<int64_t> source_outflow;
+  katana::GAccumulator<uint64_t> cut_edges;
+  katana::GAccumulator<uint64_t> source_side_size;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](Node n) {
+        const uint8_t src_side = graph.GetData<NodeCut>(n);
+        if (src_side) {
+          source_side_size += 1;
+        }
+        for (Edge e : graph.edges(n)) {
+          const Node dest = *graph.GetEdgeDest(e);
+          const auto flow =
+              static_cast<int64_t>(graph.GetEdgeData<EdgeFlow>(e));
+          if (n == source) {
+            source_outflow += flow;
+          }
+          if (dest == source) {
+            source_outflow -= flow;
+          }
+          if (src_side && !graph.GetData<NodeCut>(dest)) {
+            cut_edges += 1;
+          }
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  return MaxFlowStatistics{
+      static_cast<uint64_t>(source_outflow.reduce()), cut_edges.reduce(),
+      source_side_size.reduce()};
+}
+
+void
+katana::analytics::MaxFlowStatistics::Print(std::ostream& os) const {
+  os << "Flow value = " << flow_value << std::endl;
+  os << "Cut edges = " << cut_edges << std::endl;
+  os << "Source side size = " << source_side_size << std::endl;
+}
@@ -0,0 +1,463 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/analytics/minimum_spanning_forest/minimum_spanning_forest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "katana/Bag.h"
+#include "katana/Galois.h"
+#include "katana/NUMAArray.h"
+#include "katana/ParallelSTL.h"
+#include "katana/Reduction.h"
+#include "katana/TypedPropertyGraph.h"
+#include "katana/UnionFind.h"
+#include "katana/analytics/Utils.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+using Edge = katana::GraphTopology::Edge;
+
+struct EdgeInForest : public katana::PODProperty<uint8_t> {};
+
+using EdgeData = std::tuple<EdgeInForest>;
+using Graph = katana::TypedPropertyGraph<std::tuple<>, EdgeData>;
+
+/// The lightest outgoing edge of a component that has not found one
+constexpr Edge kNoEdge = std::numeric_limits<Edge>::max();
+
+/// Filter-Kruskal runs Kruskal's algorithm on sets of at most this many edges
+constexpr ptrdiff_t kKruskalBaseCase = 4096;
+
+/// A node of the union-find forest of components. The representative of a
+/// component also holds its lightest outgoing edge during a Boruvka round.
+struct Component : public katana::UnionFindNode<Component> {
+  std::atomic<Edge> lightest;
+
+  Component() : katana::UnionFindNode<Component>(this), lightest(kNoEdge) {}
+};
+
+template <typename T>
+katana::Result<void>
+ReadWeightsAs(
+    katana::PropertyGraph* pg, const std::string& name,
+    katana::NUMAArray<double>* weights) {
+  katana::GReduceLogicalOr not_a_number;
+  KATANA_CHECKED(ForEachEdgePropertyValue<T>(
+      *pg, name, [&](uint64_t e, T weight) {
+        (*weights)[e] = weight;
+        if (std::isnan((*weights)[e])) {
+          not_a_number.update(true);
+        }
+      }));
+  if (not_a_number.reduce()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "weights must not be NaN");
+  }
+  return katana::ResultSuccess();
+}
+
+/// Read the weights of the edges whatever their numeric type.
+katana::Result<katana::NUMAArray<double>>
+ReadWeights(katana::PropertyGraph* pg, const std::string& name) {
+  auto property = pg->GetEdgeProperty(name);
+  if (!property) {
+    return KATANA_ERROR(
+        katana::ErrorCode::PropertyNotFound, "no edge property named {}",
+        name);
+  }
+
+  katana::NUMAArray<double> weights;
+  weights.allocateInterleaved(pg->num_edges());
+  switch (property->type()->id()) {
+  case arrow::UInt32Type::type_id:
+    KATANA_CHECKED(ReadWeightsAs<uint32_t>(pg, name, &weights));
+    break;
+  case arrow::Int32Type::type_id:
+    KATANA_CHECKED(ReadWeightsAs<int32_t>(pg, name, &weights));
+    break;
+  case arrow::UInt64Type::type_id:
+    KATANA_CHECKED(ReadWeightsAs<uint64_t>(pg, name, &weights));
+    break;
+  case arrow::Int64Type::type_id:
+    KATANA_CHECKED(ReadWeightsAs<int64_t>(pg, name, &weights));
+    break;
+  case arrow::FloatType::type_id:
+    KATANA_CHECKED(ReadWeightsAs<float>(pg, name, &weights));
+    break;
+  case arrow::DoubleType::type_id:
+    KATANA_CHECKED(ReadWeightsAs<double>(pg, name, &weights));
+    break;
+  default:
+    return KATANA_ERROR(
+        katana::ErrorCode::TypeError, "weights must be numeric, not {}",
+        property->type()->ToString());
+  }
+  return katana::NUMAArray<double>(std::move(weights));
+}
+
+/// The minimum spanning forest of a topology whose edges are taken as
+/// undirected. Edges are ordered by weight and then by ID, so the forest is
+/// unique and does not depend on the algorithm.
+class SpanningForest {
+public:
+  SpanningForest(
+      const katana::GraphTopology& topology,
+      const katana::NUMAArray<double>& weights)
+      : topology_(topology), weights_(weights) {
+    components_.allocateInterleaved(topology.num_nodes());
+    katana::do_all(
+        katana::iterate(uint64_t{0}, topology.num_nodes()),
+        [&](Node n) { components_.constructAt(n); }, katana::no_stats());
+
+    sources_.allocateInterleaved(topology.num_edges());
+    in_forest_.allocateInterleaved(topology.num_edges());
+    katana::do_all(
+        katana::iterate(topology),
+        [&](Node n) {
+          for (Edge e : topology.edges(n)) {
+            sources_[e] = n;
+            in_forest_[e] = 0;
+          }
+        },
+        katana::steal(), katana::no_stats());
+  }
+
+  void RunBoruvka() {
+    katana::InsertBag<Edge> current;
+    katana::do_all(
+        katana::iterate(uint64_t{0}, topology_.num_edges()),
+        [&](Edge e) {
+          if (sources_[e] != topology_.edge_dest(e)) {
+            current.push(e);
+          }
+        },
+        katana::no_stats());
+
+    katana::InsertBag<Edge> next;
+    katana::InsertBag<Edge> chosen;
+    while (!current.empty()) {
+      // Find the lightest outgoing edge of every component, and drop the
+      // edges inside components for good.
+      katana::do_all(
+          katana::iterate(current),
+          [&](Edge e) {
+            Component* src = components_[sources_[e]].findAndCompress();
+            Component* dest =
+                components_[topology_.edge_dest(e)].findAndCompress();
+            if (src == dest) {
+              return;
+            }
+            next.push(e);
+            UpdateLightest(src, e);
+            UpdateLightest(dest, e);
+          },
+          katana::steal(), katana::no_stats(),
+          katana::loopname("Boruvka-FindLightest"));
+
+      // The representatives do not change before all the lightest edges are
+      // collected, and the lightest edges form a forest over the components
+      // except for the edges found by both of their endpoints, which are
+      // merged only once.
+      katana::do_all(
+          katana::iterate(uint64_t{0}, topology_.num_nodes()),
+          [&](Node n) {
+            Component& component = components_[n];
+            if (!component.isRep()) {
+              return;
+            }
+            const Edge e = component.lightest.load(std::memory_order_relaxed);
+            if (e != kNoEdge) {
+              chosen.push(e);
+              component.lightest.store(kNoEdge, std::memory_order_relaxed);
+            }
+          },
+          katana::no_stats());
+      katana::do_all(
+          katana::iterate(chosen), [&](Edge e) { AddEdge(e); },
+          katana::no_stats(), katana::loopname("Boruvka-Merge"));
+
+      chosen.clear();
+      current.clear();
+      current.swap(next);
+    }
+  }
+
+  void RunFilterKruskal() {
+    edges_.allocateInterleaved(topology_.num_edges());
+    scratch_.allocateInterleaved(topology_.num_edges());
+    katana::ParallelSTL::iota(edges_.begin(), edges_.end(), Edge{0});
+    Edge* last = Partition(edges_.begin(), edges_.end(), [&](Edge e) {
+      return sources_[e] != topology_.edge_dest(e);
+    });
+    FilterKruskal(edges_.begin(), last);
+  }
+
+  /// Kruskal's algorithm over all the edges
+  void RunKruskal() {
+    std::vector<Edge> edges(topology_.num_edges());
+    std::iota(edges.begin(), edges.end(), Edge{0});
+    Kruskal(edges.data(), edges.data() + edges.size());
+  }
+
+  bool InForest(Edge e) const { return in_forest_[e]; }
+
+  double TotalWeight() { return total_weight_.reduce(); }
+
+private:
+  bool Lighter(Edge a, Edge b) const {
+    return weights_[a] < weights_[b] || (weights_[a] == weights_[b] && a < b);
+  }
+
+  void UpdateLightest(Component* component, Edge e) {
+    Edge old = component->lightest.load(std::memory_order_relaxed);
+    while ((old == kNoEdge || Lighter(e, old)) &&
+           !component->lightest.compare_exchange_weak(old, e)) {
+    }
+  }
+
+  void AddEdge(Edge e) {
+    if (components_[sources_[e]].merge(
+            &components_[topology_.edge_dest(e)])) {
+      in_forest_[e] = 1;
+      total_weight_ += weights_[e];
+    }
+  }
+
+  bool Connected(Edge e) {
+    return components_[sources_[e]].findAndCompress() ==
+           components_[topology_.edge_dest(e)].findAndCompress();
+  }
+
+  void Kruskal(Edge* first, Edge* last) {
+    std::sort(first, last, [&](Edge a, Edge b) { return Lighter(a, b); });
+    for (Edge* e = first; e != last; ++e) {
+      AddEdge(*e);
+    }
+  }
+
+  void FilterKruskal(Edge* first, Edge* last) {
+    if (last - first <= kKruskalBaseCase) {
+      Kruskal(first, last);
+      return;
+    }
+
+    // Edges are distinct in the order, so the median of three edges is
+    // lighter than one of them and neither side of the partition is empty.
+    Edge pivot[3] = {*first, first[(last - first) / 2], *(last - 1)};
+    std::sort(pivot, pivot + 3, [&](Edge a, Edge b) { return Lighter(a, b); });
+    Edge* middle = Partition(
+        first, last, [&](Edge e) { return !Lighter(pivot[1], e); });
+    FilterKruskal(first, middle);
+
+    last = Partition(middle, last, [&](Edge e) { return !Connected(e); });
+    FilterKruskal(middle, last);
+  }
+
+  /// Move the edges of [first, last) for which pred holds before the others
+  /// in parallel, going through the same range of scratch_ as of edges_, and
+  /// return the end of the edges for which it holds. pred must not change
+  /// in between.
+  template <typename Predicate>
+  Edge* Partition(Edge* first, Edge* last, Predicate pred) {
+    if (last - first <= kKruskalBaseCase) {
+      return std::partition(first, last, pred);
+    }
+
+    const unsigned num_threads = katana::getActiveThreads();
+    std::vector<ptrdiff_t> kept(num_threads + 1, 0);
+    std::vector<ptrdiff_t> dropped(num_threads + 1, 0);
+    katana::on_each([&](unsigned tid, unsigned total) {
+      auto [begin, end] = katana::block_range(first, last, tid, total);
+      kept[tid + 1] = std::count_if(begin, end, pred);
+      dropped[tid + 1] = (end - begin) - kept[tid + 1];
+    });
+    std::partial_sum(kept.begin(), kept.end(), kept.begin());
+    std::partial_sum(dropped.begin(), dropped.end(), dropped.begin());
+
+    Edge* scratch = scratch_.data() + (first - edges_.data());
+    katana::on_each([&](unsigned tid, unsigned total) {
+      auto [begin, end] = katana::block_range(first, last, tid, total);
+      Edge* kept_out = scratch + kept[tid];
+      Edge* dropped_out = scratch + kept[num_threads] + dropped[tid];
+      for (Edge* e = begin; e != end; ++e) {
+        if (pred(*e)) {
+          *kept_out++ = *e;
+        } else {
+          *dropped_out++ = *e;
+        }
+      }
+    });
+    katana::ParallelSTL::copy(scratch, scratch + (last - first), first);
+    return first + kept[num_threads];
+  }
+
+  const katana::GraphTopology& topology_;
+  const katana::NUMAArray<double>& weights_;
+  katana::NUMAArray<Component> components_;
+  katana::NUMAArray<Node> sources_;
+  katana::NUMAArray<uint8_t> in_forest_;
+  katana::NUMAArray<Edge> edges_;
+  katana::NUMAArray<Edge> scratch_;
+  katana::GAccumulator<double> total_weight_;
+};
+
+}  // namespace
+
+katana::Result<double>
+katana::analytics::MinimumSpanningForest(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& output_property_name, MinimumSpanningForestPlan plan) {
+  katana::NUMAArray<double> weights =
+      KATANA_CHECKED(ReadWeights(pg, edge_weight_property_name));
+
+  KATANA_CHECKED(
+      ConstructEdgeProperties<EdgeData>(pg, {output_property_name}));
+  auto graph = KATANA_CHECKED(Graph::Make(pg, {}, {output_property_name}));
+
+  SpanningForest forest(pg->topology(), weights);
+  switch (plan.algorithm()) {
+  case MinimumSpanningForestPlan::kBoruvka:
+    forest.RunBoruvka();
+    break;
+  case MinimumSpanningForestPlan::kFilterKruskal:
+    forest.RunFilterKruskal();
+    break;
+  default:
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, pg->num_edges()),
+      [&](Edge e) { graph.GetEdgeData<EdgeInForest>(e) = forest.InForest(e); },
+      katana::no_stats());
+  return forest.TotalWeight();
+}
+
+katana::Result<void>
+katana::analytics::MinimumSpanningForestAssertValid(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& property_name) {
+  katana::NUMAArray<double> weights =
+      KATANA_CHECKED(ReadWeights(pg, edge_weight_property_name));
+  auto graph = KATANA_CHECKED(Graph::Make(pg, {}, {property_name}));
+
+  // Merging the edges of a forest always joins two different trees, whatever
+  // the order.
+  katana::NUMAArray<Component> components;
+  components.allocateInterleaved(pg->num_nodes());
+  katana::do_all(
+      katana::iterate(uint64_t{0}, pg->num_nodes()),
+      [&](Node n) { components.constructAt(n); }, katana::no_stats());
+
+  katana::GReduceLogicalOr cycle;
+  katana::GAccumulator<double> total_weight;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](Node n) {
+        for (Edge e : graph.edges(n)) {
+          if (!graph.GetEdgeData<EdgeInForest>(e)) {
+            continue;
+          }
+          const Node dest = *graph.GetEdgeDest(e);
+          if (!components[n].merge(&components[dest])) {
+            cycle.update(true);
+          }
+          total_weight += weights[e];
+        }
+      },
+      katana::steal(), katana::no_stats());
+  if (cycle.reduce()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AssertionFailed, "the forest has a cycle");
+  }
+
+  katana::GReduceLogicalOr not_spanning;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](Node n) {
+        for (Edge e : graph.edges(n)) {
+          const Node dest = *graph.GetEdgeDest(e);
+          if (components[n].findAndCompress() !=
+              components[dest].findAndCompress()) {
+            not_spanning.update(true);
+          }
+        }
+      },
+      katana::steal(), katana::no_stats());
+  if (not_spanning.reduce()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AssertionFailed,
+        "the forest does not connect the endpoints of every edge");
+  }
+
+  SpanningForest reference(pg->topology(), weights);
+  reference.RunKruskal();
+  const double expected = reference.TotalWeight();
+  const double actual = total_weight.reduce();
+  if (std::abs(actual - expected) >
+      1e-9 * std::max({1.0, std::abs(actual), std::abs(expected)})) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AssertionFailed,
+        "the forest weighs {} but the minimum is {}", actual, expected);
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<MinimumSpanningForestStatistics>
+katana::analytics::MinimumSpanningForestStatistics::Compute(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::string& property_name) {
+  katana::NUMAArray<double> weights =
+      KATANA_CHECKED(ReadWeights(pg, edge_weight_property_name));
+  auto graph = KATANA_CHECKED(Graph::Make(pg, {}, {property_name}));
+
+  katana::GAccumulator<uint64_t> num_forest_edges;
+  katana::GAccumulator<double> total_weight;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, pg->num_edges()),
+      [&](Edge e) {
+        if (graph.GetEdgeData<EdgeInForest>(e)) {
+          num_forest_edges += 1;
+          total_weight += weights[e];
+        }
+      },
+      katana::no_stats());
+
+  const uint64_t num_edges = num_forest_edges.reduce();
+  return MinimumSpanningForestStatistics{
+      num_edges, pg->num_nodes() - num_edges, total_weight.reduce()};
+}
+
+void
+katana::analytics::MinimumSpanningForestStatistics::Print(
+    std::ostream& os) const {
+  os << "Number of forest edges = " << num_forest_edges << std::endl;
+  os << "Number of trees = " << num_trees << std::endl;
+  os << "Total weight = " << total_weight << std::endl;
+}
@@ -0,0 +1,106 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <cmath>
+
+#include "katana/NUMAArray.h"
+#include "katana/PropagationBlocking.h"
+#include "katana/TypedPropertyGraph.h"
+#include "pagerank-impl.h"
+
+namespace {
+
+using NodeData = std::tuple<NodeValue>;
+using EdgeData = std::tuple<>;
+typedef katana::TypedPropertyGraph<NodeData, EdgeData> Graph;
+typedef typename Graph::Node GNode;
+
+/// Topological PageRank where each iteration is a propagation blocked SpMV
+/// over the out-edges.
+void
+ComputePRPropagationBlocking(
+    const katana::GraphTopology& topology, katana::analytics::PagerankPlan plan,
+    katana::NUMAArray<PRTy>* ranks) {
+  const uint64_t num_nodes = topology.num_nodes();
+  katana::PropagationBlocking<PRTy> blocking(topology, plan.block_size());
+
+  katana::NUMAArray<PRTy> sums;
+  sums.allocateInterleaved(num_nodes);
+
+  PRTy base_score = (1.0f - plan.alpha()) / num_nodes;
+  unsigned int iteration = 0;
+  katana::GAccumulator<float> accum;
+  while (true) {
+    katana::ParallelSTL::fill(sums.begin(), sums.end(), PRTy{0});
+    blocking.Propagate(
+        [&](GNode src) { return (*ranks)[src] / topology.edges(src).size(); },
+        [&](GNode dest, PRTy contribution) { sums[dest] += contribution; });
+
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes),
+        [&](uint64_t n) {
+          PRTy value = sums[n] * plan.alpha() + base_score;
+          accum += std::fabs(value - (*ranks)[n]);
+          (*ranks)[n] = value;
+        },
+        katana::loopname("PagerankPropagationBlockingUpdate"));
+
+    iteration += 1;
+    if (accum.reduce() <= plan.tolerance() ||
+        iteration >= plan.max_iterations()) {
+      break;
+    }
+    accum.reset();
+  }
+
+  katana::ReportStatSingle("PageRank", "Iterations", iteration);
+}
+
+}  // namespace
+
+katana::Result<void>
+PagerankPropagationBlocking(
+    katana::PropertyGraph* pg, const std::string& output_property_name,
+    katana::analytics::PagerankPlan plan) {
+  katana::ReportPageAllocGuard page_alloc;
+
+  KATANA_CHECKED(katana::analytics::ConstructNodeProperties<NodeData>(
+      pg, {output_property_name}));
+  auto graph = KATANA_CHECKED(Graph::Make(pg, {output_property_name}, {}));
+  if (pg->num_nodes() == 0) {
+    return katana::ResultSuccess();
+  }
+
+  katana::NUMAArray<PRTy> ranks;
+  ranks.allocateInterleaved(pg->num_nodes());
+  katana::ParallelSTL::fill(
+      ranks.begin(), ranks.end(), PRTy{1.0f / pg->num_nodes()});
+
+  katana::StatTimer exec_time("PagerankPropagationBlocking");
+  exec_time.start();
+  ComputePRPropagationBlocking(pg->topology(), plan, &ranks);
+  exec_time.stop();
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) { graph.GetData<NodeValue>(n) = ranks[n]; },
+      katana::loopname("Extract pagerank"), katana::no_stats());
+
+  return katana::ResultSuccess();
+}
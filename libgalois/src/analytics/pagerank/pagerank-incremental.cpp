@@ -0,0 +1,186 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#include "katana/AtomicHelpers.h"
+#include "katana/NUMAArray.h"
+#include "katana/TypedPropertyGraph.h"
+#include "pagerank-impl.h"
+
+using katana::atomicAdd;
+using katana::analytics::PagerankPlan;
+
+namespace {
+
+using NodeData = std::tuple<NodeValue>;
+using EdgeData = std::tuple<>;
+typedef katana::TypedPropertyGraph<NodeData, EdgeData> Graph;
+typedef typename Graph::Node GNode;
+
+/// The inserted out-edges of a node
+struct InsertedEdges {
+  GNode src;
+  uint32_t num_inserted;
+  /// The rank src gave each out-neighbor before the insertion
+  PRTy old_share;
+};
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::IncrementalPagerank(
+    PropertyGraph* pg, const std::string& property_name,
+    const std::vector<uint32_t>& srcs, const std::vector<uint32_t>& dsts,
+    PagerankPlan plan) {
+  if (plan.algorithm() == PagerankPlan::kPullTopological ||
+      plan.algorithm() == PagerankPlan::kPropagationBlocking) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "normalized ranks of the topological algorithms cannot be updated");
+  }
+  if (srcs.size() != dsts.size()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "{} sources but {} destinations",
+        srcs.size(), dsts.size());
+  }
+  katana::GReduceMax<uint32_t> max_endpoint;
+  katana::do_all(
+      katana::iterate(size_t{0}, srcs.size()),
+      [&](size_t i) {
+        max_endpoint.update(srcs[i]);
+        max_endpoint.update(dsts[i]);
+      },
+      katana::no_stats());
+  if (!srcs.empty() && max_endpoint.reduce() >= pg->num_nodes()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "node {} does not exist",
+        max_endpoint.reduce());
+  }
+
+  katana::NUMAArray<std::atomic<PRTy>> residual;
+  residual.allocateInterleaved(pg->num_nodes());
+  katana::do_all(
+      katana::iterate(uint64_t{0}, pg->num_nodes()),
+      [&](uint64_t n) { residual[n] = 0; }, katana::no_stats());
+
+  katana::InsertBag<GNode> active;
+
+  // New nodes have rank 0, so all of their base rank is residual.
+  auto ranks = KATANA_CHECKED(pg->GetNodePropertyTyped<PRTy>(property_name));
+  if (ranks->null_count() > 0) {
+    katana::do_all(
+        katana::iterate(int64_t{0}, ranks->length()),
+        [&](int64_t n) {
+          if (ranks->IsNull(n)) {
+            residual[n] = plan.initial_residual();
+            active.push(n);
+          }
+        },
+        katana::no_stats());
+    KATANA_CHECKED(FillNullNodeProperty<PRTy>(
+        pg, property_name, [](int64_t) { return PRTy{0}; }));
+  }
+
+  auto graph = KATANA_CHECKED(Graph::Make(pg, {property_name}, {}));
+
+  std::vector<GNode> sorted_srcs(srcs.begin(), srcs.end());
+  katana::ParallelSTL::sort(sorted_srcs.begin(), sorted_srcs.end());
+  std::vector<InsertedEdges> inserted;
+  for (size_t i = 0; i < sorted_srcs.size();) {
+    size_t end = i;
+    while (end < sorted_srcs.size() && sorted_srcs[end] == sorted_srcs[i]) {
+      ++end;
+    }
+    inserted.emplace_back(
+        InsertedEdges{sorted_srcs[i], static_cast<uint32_t>(end - i), 0});
+    i = end;
+  }
+
+  // A source that gained edges now splits its rank among more neighbors:
+  // each out-neighbor gets the difference of the new and old shares, and the
+  // new neighbors, which got no old share, get it back.
+  katana::GAccumulator<uint64_t> num_missing;
+  katana::do_all(
+      katana::iterate(inserted),
+      [&](InsertedEdges& item) {
+        uint64_t new_degree = graph.edges(item.src).size();
+        if (new_degree < item.num_inserted) {
+          num_missing += item.num_inserted - new_degree;
+          return;
+        }
+        uint64_t old_degree = new_degree - item.num_inserted;
+        PRTy value = graph.GetData<NodeValue>(item.src);
+        PRTy new_share = value * plan.alpha() / new_degree;
+        item.old_share = old_degree > 0 ? value * plan.alpha() / old_degree : 0;
+        for (const auto& e : graph.edges(item.src)) {
+          auto dest = *graph.GetEdgeDest(e);
+          atomicAdd(residual[dest], new_share - item.old_share);
+          active.push(dest);
+        }
+      },
+      katana::steal(), katana::no_stats());
+  if (num_missing.reduce() > 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "{} inserted edges are not in the graph", num_missing.reduce());
+  }
+
+  katana::do_all(
+      katana::iterate(size_t{0}, srcs.size()),
+      [&](size_t i) {
+        auto it = std::lower_bound(
+            inserted.begin(), inserted.end(), srcs[i],
+            [](const InsertedEdges& item, GNode n) { return item.src < n; });
+        atomicAdd(residual[dsts[i]], it->old_share);
+      },
+      katana::no_stats());
+
+  typedef katana::PerSocketChunkFIFO<PagerankPlan::kChunkSize> WL;
+  katana::for_each(
+      katana::iterate(active),
+      [&](const GNode& src, auto& ctx) {
+        if (std::fabs(residual[src].load()) <= plan.tolerance()) {
+          return;
+        }
+        PRTy old_residual = residual[src].exchange(0.0);
+        graph.GetData<NodeValue>(src) += old_residual;
+        int src_nout = graph.edges(src).size();
+        if (src_nout == 0) {
+          return;
+        }
+        // Residuals may be negative where a source now gives less rank to a
+        // neighbor, so push whichever sign crosses the tolerance.
+        PRTy delta = old_residual * plan.alpha() / src_nout;
+        for (const auto& e : graph.edges(src)) {
+          auto dest = *graph.GetEdgeDest(e);
+          PRTy old = atomicAdd(residual[dest], delta);
+          if (std::fabs(old) <= plan.tolerance() &&
+              std::fabs(old + delta) > plan.tolerance()) {
+            ctx.push(dest);
+          }
+        }
+      },
+      katana::loopname("IncrementalPagerank"),
+      katana::disable_conflict_detection(), katana::wl<WL>());
+
+  return katana::ResultSuccess();
+}
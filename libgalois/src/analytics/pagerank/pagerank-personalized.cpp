@@ -0,0 +1,421 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <unordered_map>
+
+#include "katana/AtomicHelpers.h"
+#include "katana/NUMAArray.h"
+#include "pagerank-impl.h"
+
+using katana::atomicAdd;
+using katana::analytics::kBatchedPersonalizedPagerankLanes;
+using katana::analytics::PersonalizedPagerankPlan;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+
+/// The residual that n may keep without pushing it to its neighbors
+PRTy
+PushThreshold(
+    const katana::GraphTopology& topology, Node n,
+    const PersonalizedPagerankPlan& plan) {
+  return plan.epsilon() * std::max<size_t>(topology.edges(n).size(), 1);
+}
+
+struct LocalMass {
+  PRTy score{0};
+  PRTy residual{0};
+};
+
+/// Push the residual of seeds forward with a FIFO queue, keeping state only
+/// for the nodes that the push reaches.
+std::unordered_map<Node, LocalMass>
+LocalForwardPush(
+    const katana::GraphTopology& topology, const std::vector<uint32_t>& seeds,
+    const PersonalizedPagerankPlan& plan) {
+  std::unordered_map<Node, LocalMass> mass;
+  std::deque<Node> queue;
+
+  // A node is queued when its residual rises above its threshold and stays
+  // queued until it is pushed, so it is never in the queue twice.
+  auto add_residual = [&](Node n, PRTy delta) {
+    auto& n_mass = mass[n];
+    PRTy threshold = PushThreshold(topology, n, plan);
+    PRTy old = n_mass.residual;
+    n_mass.residual += delta;
+    if (old <= threshold && n_mass.residual > threshold) {
+      queue.push_back(n);
+    }
+  };
+
+  for (auto seed : seeds) {
+    add_residual(seed, PRTy{1} / seeds.size());
+  }
+
+  while (!queue.empty()) {
+    Node src = queue.front();
+    queue.pop_front();
+
+    auto& src_mass = mass[src];
+    PRTy residual = src_mass.residual;
+    src_mass.residual = 0;
+    src_mass.score += (1 - plan.alpha()) * residual;
+
+    auto edges = topology.edges(src);
+    if (edges.size() == 0) {
+      continue;
+    }
+    PRTy delta = plan.alpha() * residual / edges.size();
+    for (auto e : edges) {
+      add_residual(topology.edge_dest(e), delta);
+    }
+  }
+
+  return mass;
+}
+
+/// Allocate a rank for every node, initialized to 0
+katana::Result<std::shared_ptr<arrow::Buffer>>
+MakeRankBuffer(size_t num_nodes) {
+  std::shared_ptr<arrow::Buffer> buf =
+      KATANA_CHECKED(arrow::AllocateBuffer(num_nodes * sizeof(PRTy)));
+  PRTy* data = reinterpret_cast<PRTy*>(buf->mutable_data());
+  katana::do_all(
+      katana::iterate(size_t{0}, num_nodes), [&](size_t n) { data[n] = 0; },
+      katana::no_stats());
+  return buf;
+}
+
+PRTy*
+RankData(const std::shared_ptr<arrow::Buffer>& buf) {
+  return reinterpret_cast<PRTy*>(buf->mutable_data());
+}
+
+katana::Result<void>
+AddRankProperties(
+    katana::PropertyGraph* pg, const std::vector<std::string>& names,
+    const std::vector<std::shared_ptr<arrow::Buffer>>& buffers) {
+  int64_t num_nodes = pg->num_nodes();
+  std::vector<std::shared_ptr<arrow::Field>> fields;
+  std::vector<std::shared_ptr<arrow::Array>> columns;
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    fields.emplace_back(arrow::field(names[i], arrow::float32()));
+    columns.emplace_back(
+        std::make_shared<arrow::FloatArray>(num_nodes, buffers[i]));
+  }
+  auto table = arrow::Table::Make(arrow::schema(fields), columns, num_nodes);
+  KATANA_CHECKED(pg->AddNodeProperties(table));
+  return katana::ResultSuccess();
+}
+
+std::vector<Node>
+DistinctSeeds(const std::vector<uint32_t>& seeds) {
+  std::vector<Node> distinct(seeds.begin(), seeds.end());
+  std::sort(distinct.begin(), distinct.end());
+  distinct.erase(
+      std::unique(distinct.begin(), distinct.end()), distinct.end());
+  return distinct;
+}
+
+using WL =
+    katana::PerSocketChunkFIFO<katana::analytics::PagerankPlan::kChunkSize>;
+
+katana::Result<void>
+PersonalizedPagerankPushAsynchronous(
+    katana::PropertyGraph* pg, const std::vector<uint32_t>& seeds,
+    const std::string& output_property_name, PersonalizedPagerankPlan plan) {
+  const katana::GraphTopology& topology = pg->topology();
+  size_t num_nodes = topology.num_nodes();
+
+  katana::NUMAArray<std::atomic<PRTy>> residual;
+  katana::NUMAArray<std::atomic<PRTy>> score;
+  residual.allocateInterleaved(num_nodes);
+  score.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(size_t{0}, num_nodes),
+      [&](size_t n) {
+        residual[n] = 0;
+        score[n] = 0;
+      },
+      katana::no_stats(), katana::loopname("Initialize"));
+  for (auto seed : seeds) {
+    residual[seed] = residual[seed] + PRTy{1} / seeds.size();
+  }
+
+  std::vector<Node> initial = DistinctSeeds(seeds);
+  katana::for_each(
+      katana::iterate(initial),
+      [&](const Node& src, auto& ctx) {
+        if (residual[src] <= PushThreshold(topology, src, plan)) {
+          return;
+        }
+        PRTy old_residual = residual[src].exchange(0.0);
+        atomicAdd(score[src], (1 - plan.alpha()) * old_residual);
+
+        auto edges = topology.edges(src);
+        if (edges.size() == 0) {
+          return;
+        }
+        PRTy delta = plan.alpha() * old_residual / edges.size();
+        if (delta <= 0) {
+          return;
+        }
+        for (auto e : edges) {
+          auto dest = topology.edge_dest(e);
+          PRTy threshold = PushThreshold(topology, dest, plan);
+          auto old = atomicAdd(residual[dest], delta);
+          if (old <= threshold && old + delta > threshold) {
+            ctx.push(dest);
+          }
+        }
+      },
+      katana::loopname("PersonalizedPushAsynchronous"),
+      katana::disable_conflict_detection(), katana::wl<WL>());
+
+  auto buf = KATANA_CHECKED(MakeRankBuffer(num_nodes));
+  PRTy* data = RankData(buf);
+  katana::do_all(
+      katana::iterate(size_t{0}, num_nodes),
+      [&](size_t n) { data[n] = score[n]; }, katana::no_stats());
+  return AddRankProperties(pg, {output_property_name}, {buf});
+}
+
+/// The residuals and scores of one node for each seed of a batch
+struct alignas(64) LaneMass {
+  std::array<std::atomic<PRTy>, kBatchedPersonalizedPagerankLanes> residual;
+  std::array<std::atomic<PRTy>, kBatchedPersonalizedPagerankLanes> score;
+};
+
+/// Compute the personalized Page Rank of up to
+/// kBatchedPersonalizedPagerankLanes seeds with one worklist. A node is
+/// pushed once for all seeds whose residual at it is above the threshold.
+katana::Result<void>
+BatchedPushAsynchronous(
+    katana::PropertyGraph* pg, const std::vector<uint32_t>& seeds,
+    const std::vector<std::string>& output_property_names,
+    katana::NUMAArray<LaneMass>* node_mass, PersonalizedPagerankPlan plan) {
+  const katana::GraphTopology& topology = pg->topology();
+  size_t num_nodes = topology.num_nodes();
+  size_t num_lanes = seeds.size();
+  auto& mass = *node_mass;
+
+  katana::do_all(
+      katana::iterate(size_t{0}, num_nodes),
+      [&](size_t n) {
+        for (size_t lane = 0; lane < num_lanes; ++lane) {
+          mass[n].residual[lane] = 0;
+          mass[n].score[lane] = 0;
+        }
+      },
+      katana::no_stats(), katana::loopname("Initialize"));
+  for (size_t lane = 0; lane < num_lanes; ++lane) {
+    mass[seeds[lane]].residual[lane] = 1;
+  }
+
+  std::vector<Node> initial = DistinctSeeds(seeds);
+  katana::for_each(
+      katana::iterate(initial),
+      [&](const Node& src, auto& ctx) {
+        PRTy threshold = PushThreshold(topology, src, plan);
+        auto edges = topology.edges(src);
+
+        std::array<PRTy, kBatchedPersonalizedPagerankLanes> deltas{};
+        bool any_delta = false;
+        for (size_t lane = 0; lane < num_lanes; ++lane) {
+          auto& src_residual = mass[src].residual[lane];
+          if (src_residual <= threshold) {
+            continue;
+          }
+          PRTy old_residual = src_residual.exchange(0.0);
+          atomicAdd(mass[src].score[lane], (1 - plan.alpha()) * old_residual);
+          if (edges.size() > 0) {
+            deltas[lane] = plan.alpha() * old_residual / edges.size();
+            any_delta |= deltas[lane] > 0;
+          }
+        }
+        if (!any_delta) {
+          return;
+        }
+
+        for (auto e : edges) {
+          auto dest = topology.edge_dest(e);
+          PRTy dest_threshold = PushThreshold(topology, dest, plan);
+          bool activated = false;
+          for (size_t lane = 0; lane < num_lanes; ++lane) {
+            if (deltas[lane] <= 0) {
+              continue;
+            }
+            auto old = atomicAdd(mass[dest].residual[lane], deltas[lane]);
+            activated |=
+                old <= dest_threshold && old + deltas[lane] > dest_threshold;
+          }
+          if (activated) {
+            ctx.push(dest);
+          }
+        }
+      },
+      katana::loopname("BatchedPersonalizedPushAsynchronous"),
+      katana::disable_conflict_detection(), katana::wl<WL>());
+
+  std::vector<std::shared_ptr<arrow::Buffer>> buffers;
+  for (size_t lane = 0; lane < num_lanes; ++lane) {
+    auto buf = KATANA_CHECKED(MakeRankBuffer(num_nodes));
+    PRTy* data = RankData(buf);
+    katana::do_all(
+        katana::iterate(size_t{0}, num_nodes),
+        [&](size_t n) { data[n] = mass[n].score[lane]; }, katana::no_stats());
+    buffers.emplace_back(std::move(buf));
+  }
+  return AddRankProperties(pg, output_property_names, buffers);
+}
+
+katana::Result<void>
+CheckSeeds(
+    katana::PropertyGraph* pg, const std::vector<uint32_t>& seeds,
+    const PersonalizedPagerankPlan& plan) {
+  for (auto seed : seeds) {
+    if (seed >= pg->num_nodes()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument, "seed {} is not a node", seed);
+    }
+  }
+  if (!(plan.epsilon() > 0)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "epsilon must be positive");
+  }
+  if (!(plan.alpha() >= 0 && plan.alpha() < 1)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "alpha must be in [0, 1)");
+  }
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+katana::Result<std::vector<std::pair<uint32_t, float>>>
+katana::analytics::LocalPersonalizedPagerank(
+    katana::PropertyGraph* pg, const std::vector<uint32_t>& seeds,
+    PersonalizedPagerankPlan plan) {
+  if (seeds.empty()) {
+    return KATANA_ERROR(katana::ErrorCode::InvalidArgument, "no seeds");
+  }
+  KATANA_CHECKED(CheckSeeds(pg, seeds, plan));
+
+  auto mass = LocalForwardPush(pg->topology(), seeds, plan);
+
+  std::vector<std::pair<uint32_t, float>> ranks;
+  for (const auto& [n, n_mass] : mass) {
+    if (n_mass.score > 0) {
+      ranks.emplace_back(n, n_mass.score);
+    }
+  }
+  std::sort(ranks.begin(), ranks.end(), [](const auto& a, const auto& b) {
+    return a.second > b.second || (a.second == b.second && a.first < b.first);
+  });
+  return ranks;
+}
+
+katana::Result<void>
+katana::analytics::PersonalizedPagerank(
+    katana::PropertyGraph* pg, const std::vector<uint32_t>& seeds,
+    const std::string& output_property_name, PersonalizedPagerankPlan plan) {
+  if (seeds.empty()) {
+    return KATANA_ERROR(katana::ErrorCode::InvalidArgument, "no seeds");
+  }
+  KATANA_CHECKED(CheckSeeds(pg, seeds, plan));
+
+  switch (plan.algorithm()) {
+  case PersonalizedPagerankPlan::kForwardPush: {
+    auto mass = LocalForwardPush(pg->topology(), seeds, plan);
+    auto buf = KATANA_CHECKED(MakeRankBuffer(pg->num_nodes()));
+    PRTy* data = RankData(buf);
+    for (const auto& [n, n_mass] : mass) {
+      data[n] = n_mass.score;
+    }
+    return AddRankProperties(pg, {output_property_name}, {buf});
+  }
+  case PersonalizedPagerankPlan::kPushAsynchronous:
+    return PersonalizedPagerankPushAsynchronous(
+        pg, seeds, output_property_name, plan);
+  default:
+    return katana::ErrorCode::InvalidArgument;
+  }
+}
+
+katana::Result<void>
+katana::analytics::BatchedPersonalizedPagerank(
+    katana::PropertyGraph* pg, const std::vector<uint32_t>& seeds,
+    const std::vector<std::string>& output_property_names,
+    PersonalizedPagerankPlan plan) {
+  if (seeds.size() != output_property_names.size()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "{} seeds but {} output property names", seeds.size(),
+        output_property_names.size());
+  }
+  KATANA_CHECKED(CheckSeeds(pg, seeds, plan));
+  if (seeds.empty()) {
+    return katana::ResultSuccess();
+  }
+
+  switch (plan.algorithm()) {
+  case PersonalizedPagerankPlan::kForwardPush: {
+    std::vector<std::shared_ptr<arrow::Buffer>> buffers;
+    for (size_t i = 0; i < seeds.size(); ++i) {
+      buffers.emplace_back(KATANA_CHECKED(MakeRankBuffer(pg->num_nodes())));
+    }
+    // Each seed is an independent local push; the pushes of different seeds
+    // write to different columns.
+    katana::do_all(
+        katana::iterate(size_t{0}, seeds.size()),
+        [&](size_t i) {
+          auto mass = LocalForwardPush(pg->topology(), {seeds[i]}, plan);
+          PRTy* data = RankData(buffers[i]);
+          for (const auto& [n, n_mass] : mass) {
+            data[n] = n_mass.score;
+          }
+        },
+        katana::steal(), katana::chunk_size<1>(),
+        katana::loopname("BatchedForwardPush"));
+    return AddRankProperties(pg, output_property_names, buffers);
+  }
+  case PersonalizedPagerankPlan::kPushAsynchronous: {
+    katana::NUMAArray<LaneMass> node_mass;
+    node_mass.allocateInterleaved(pg->num_nodes());
+    for (size_t begin = 0; begin < seeds.size();
+         begin += kBatchedPersonalizedPagerankLanes) {
+      size_t end = std::min<size_t>(
+          begin + kBatchedPersonalizedPagerankLanes, seeds.size());
+      KATANA_CHECKED(BatchedPushAsynchronous(
+          pg, {seeds.begin() + begin, seeds.begin() + end},
+          {output_property_names.begin() + begin,
+           output_property_names.begin() + end},
+          &node_mass, plan));
+    }
+    return katana::ResultSuccess();
+  }
+  default:
+    return katana::ErrorCode::InvalidArgument;
+  }
+}
@@ -33,6 +33,8 @@ katana::analytics::Pagerank(
     return PagerankPushAsynchronous(pg, output_property_name, plan);
   case PagerankPlan::kPushSynchronous:
     return PagerankPushSynchronous(pg, output_property_name, plan);
+  case PagerankPlan::kPropagationBlocking:
+    return PagerankPropagationBlocking(pg, output_property_name, plan);
   default:
     return katana::ErrorCode::InvalidArgument;
   }
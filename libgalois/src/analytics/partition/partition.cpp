@@ -0,0 +1,568 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/analytics/partition/partition.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "katana/AtomicHelpers.h"
+#include "katana/Galois.h"
+#include "katana/NUMAArray.h"
+#include "katana/ParallelSTL.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/Reduction.h"
+#include "katana/TypedPropertyGraph.h"
+#include "katana/analytics/Utils.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+
+struct NodePartition : public katana::PODProperty<uint32_t> {};
+
+using NodeData = std::tuple<NodePartition>;
+using EdgeData = std::tuple<>;
+typedef katana::TypedPropertyGraph<NodeData, EdgeData> Graph;
+
+constexpr Node kUnmatched = std::numeric_limits<Node>::max();
+constexpr uint32_t kNoPartition = std::numeric_limits<uint32_t>::max();
+/// The number of handshake rounds used to find a matching
+constexpr int kMatchingRounds = 4;
+/// Stop coarsening when a level has more than this fraction of the nodes of
+/// the previous level.
+constexpr double kMinCoarseningRatio = 0.9;
+
+/// A graph with node and edge weights, one per level of the coarsening.
+struct WeightedGraph {
+  /// The end of the edges of each node
+  katana::NUMAArray<uint64_t> indices;
+  katana::NUMAArray<Node> dests;
+  katana::NUMAArray<uint64_t> edge_weights;
+  katana::NUMAArray<uint64_t> node_weights;
+
+  uint64_t num_nodes() const { return indices.size(); }
+  uint64_t edge_begin(Node n) const { return n > 0 ? indices[n - 1] : 0; }
+  uint64_t edge_end(Node n) const { return indices[n]; }
+};
+
+WeightedGraph
+MakeFinestGraph(const katana::GraphTopology& topology) {
+  WeightedGraph g;
+  g.indices.allocateInterleaved(topology.num_nodes());
+  g.node_weights.allocateInterleaved(topology.num_nodes());
+  katana::do_all(
+      katana::iterate(uint64_t{0}, topology.num_nodes()),
+      [&](uint64_t n) {
+        g.indices[n] = *topology.edge_end(n);
+        g.node_weights[n] = 1;
+      },
+      katana::no_stats());
+  g.dests.allocateInterleaved(topology.num_edges());
+  g.edge_weights.allocateInterleaved(topology.num_edges());
+  katana::do_all(
+      katana::iterate(uint64_t{0}, topology.num_edges()),
+      [&](uint64_t e) {
+        g.dests[e] = topology.edge_dest(e);
+        g.edge_weights[e] = 1;
+      },
+      katana::no_stats());
+  return g;
+}
+
+/// Find a heavy edge matching: in each round, every unmatched node proposes
+/// to its unmatched neighbor with the heaviest edge, and nodes that propose
+/// to each other are matched. Nodes left over are matched with themselves.
+katana::NUMAArray<Node>
+HeavyEdgeMatching(const WeightedGraph& g, uint64_t max_node_weight) {
+  katana::NUMAArray<Node> match;
+  match.allocateInterleaved(g.num_nodes());
+  katana::NUMAArray<Node> proposal;
+  proposal.allocateInterleaved(g.num_nodes());
+  katana::ParallelSTL::fill(match.begin(), match.end(), kUnmatched);
+
+  for (int round = 0; round < kMatchingRounds; ++round) {
+    katana::do_all(
+        katana::iterate(uint64_t{0}, g.num_nodes()),
+        [&](uint64_t n) {
+          proposal[n] = kUnmatched;
+          if (match[n] != kUnmatched) {
+            return;
+          }
+          uint64_t best_weight = 0;
+          for (uint64_t e = g.edge_begin(n); e < g.edge_end(n); ++e) {
+            Node v = g.dests[e];
+            if (v == n || match[v] != kUnmatched ||
+                g.node_weights[n] + g.node_weights[v] > max_node_weight) {
+              continue;
+            }
+            // Break ties by ID so that proposals are more likely mutual
+            if (g.edge_weights[e] > best_weight ||
+                (g.edge_weights[e] == best_weight && v < proposal[n])) {
+              best_weight = g.edge_weights[e];
+              proposal[n] = v;
+            }
+          }
+        },
+        katana::steal(), katana::no_stats(),
+        katana::loopname("PartitionMatchingPropose"));
+
+    katana::GAccumulator<uint64_t> num_matched;
+    katana::do_all(
+        katana::iterate(uint64_t{0}, g.num_nodes()),
+        [&](uint64_t n) {
+          Node v = proposal[n];
+          if (v != kUnmatched && proposal[v] == n) {
+            match[n] = v;
+            num_matched += 1;
+          }
+        },
+        katana::no_stats());
+    if (num_matched.reduce() == 0) {
+      break;
+    }
+  }
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, g.num_nodes()),
+      [&](uint64_t n) {
+        if (match[n] == kUnmatched) {
+          match[n] = n;
+        }
+      },
+      katana::no_stats());
+  return match;
+}
+
+/// Contract each matched pair of fine into one node of a coarser graph,
+/// merging parallel edges and dropping the edges inside a pair.
+///
+/// \param coarse_ids is set to the node of the coarse graph each node of the
+///     fine graph was contracted into
+WeightedGraph
+Contract(
+    const WeightedGraph& fine, const katana::NUMAArray<Node>& match,
+    katana::NUMAArray<Node>* coarse_ids) {
+  const uint64_t num_fine = fine.num_nodes();
+
+  // The smaller node of each pair leads it
+  katana::NUMAArray<uint64_t> num_leaders;
+  num_leaders.allocateInterleaved(num_fine);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_fine),
+      [&](uint64_t n) { num_leaders[n] = match[n] >= n ? 1 : 0; },
+      katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      num_leaders.begin(), num_leaders.end(), num_leaders.begin());
+  const uint64_t num_coarse = num_leaders[num_fine - 1];
+
+  katana::NUMAArray<Node> leaders;
+  leaders.allocateInterleaved(num_coarse);
+  coarse_ids->allocateInterleaved(num_fine);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_fine),
+      [&](uint64_t n) {
+        Node leader = std::min<Node>(n, match[n]);
+        (*coarse_ids)[n] = num_leaders[leader] - 1;
+        if (leader == n) {
+          leaders[num_leaders[n] - 1] = n;
+        }
+      },
+      katana::no_stats());
+
+  WeightedGraph coarse;
+  coarse.indices.allocateInterleaved(num_coarse);
+  coarse.node_weights.allocateInterleaved(num_coarse);
+
+  // Gather the edges of each pair into a scratch buffer with room for all of
+  // them, then sort and merge them in place.
+  katana::NUMAArray<uint64_t> scratch_end;
+  scratch_end.allocateInterleaved(num_coarse);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_coarse),
+      [&](uint64_t c) {
+        Node a = leaders[c];
+        Node b = match[a];
+        uint64_t degree = fine.edge_end(a) - fine.edge_begin(a);
+        uint64_t weight = fine.node_weights[a];
+        if (b != a) {
+          degree += fine.edge_end(b) - fine.edge_begin(b);
+          weight += fine.node_weights[b];
+        }
+        scratch_end[c] = degree;
+        coarse.node_weights[c] = weight;
+      },
+      katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      scratch_end.begin(), scratch_end.end(), scratch_end.begin());
+
+  using WeightedEdge = std::pair<Node, uint64_t>;
+  katana::NUMAArray<WeightedEdge> scratch;
+  scratch.allocateInterleaved(scratch_end[num_coarse - 1]);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_coarse),
+      [&](uint64_t c) {
+        const uint64_t begin = c > 0 ? scratch_end[c - 1] : 0;
+        uint64_t end = begin;
+        auto gather = [&](Node n) {
+          for (uint64_t e = fine.edge_begin(n); e < fine.edge_end(n); ++e) {
+            Node dest = (*coarse_ids)[fine.dests[e]];
+            if (dest != c) {
+              scratch[end++] = WeightedEdge{dest, fine.edge_weights[e]};
+            }
+          }
+        };
+        gather(leaders[c]);
+        if (match[leaders[c]] != leaders[c]) {
+          gather(match[leaders[c]]);
+        }
+        std::sort(scratch.begin() + begin, scratch.begin() + end);
+
+        uint64_t out = begin;
+        for (uint64_t i = begin; i < end; ++i) {
+          if (out > begin && scratch[out - 1].first == scratch[i].first) {
+            scratch[out - 1].second += scratch[i].second;
+          } else {
+            scratch[out++] = scratch[i];
+          }
+        }
+        coarse.indices[c] = out - begin;
+      },
+      katana::steal(), katana::no_stats(),
+      katana::loopname("PartitionContract"));
+  katana::ParallelSTL::partial_sum(
+      coarse.indices.begin(), coarse.indices.end(), coarse.indices.begin());
+
+  const uint64_t num_coarse_edges = coarse.indices[num_coarse - 1];
+  coarse.dests.allocateInterleaved(num_coarse_edges);
+  coarse.edge_weights.allocateInterleaved(num_coarse_edges);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_coarse),
+      [&](uint64_t c) {
+        uint64_t from = c > 0 ? scratch_end[c - 1] : 0;
+        for (uint64_t e = coarse.edge_begin(c); e < coarse.edge_end(c); ++e) {
+          coarse.dests[e] = scratch[from].first;
+          coarse.edge_weights[e] = scratch[from].second;
+          ++from;
+        }
+      },
+      katana::no_stats());
+  return coarse;
+}
+
+/// Partition a (small) graph by growing each partition breadth first from an
+/// unassigned node until it reaches its share of the total weight.
+std::vector<uint32_t>
+GreedyGrowing(const WeightedGraph& g, uint32_t num_partitions) {
+  uint64_t total_weight = 0;
+  for (uint64_t n = 0; n < g.num_nodes(); ++n) {
+    total_weight += g.node_weights[n];
+  }
+
+  std::vector<uint32_t> part(g.num_nodes(), kNoPartition);
+  uint64_t next_seed = 0;
+  uint64_t assigned_weight = 0;
+  for (uint32_t p = 0; p + 1 < num_partitions; ++p) {
+    // Aim for an equal share of what is left so that errors do not pile up
+    // in the last partition.
+    const uint64_t target =
+        (total_weight - assigned_weight) / (num_partitions - p);
+    uint64_t weight = 0;
+    std::deque<Node> frontier;
+    while (weight < target) {
+      if (frontier.empty()) {
+        while (next_seed < g.num_nodes() && part[next_seed] != kNoPartition) {
+          ++next_seed;
+        }
+        if (next_seed == g.num_nodes()) {
+          break;
+        }
+        frontier.emplace_back(next_seed);
+      }
+      Node n = frontier.front();
+      frontier.pop_front();
+      if (part[n] != kNoPartition) {
+        continue;
+      }
+      part[n] = p;
+      weight += g.node_weights[n];
+      for (uint64_t e = g.edge_begin(n); e < g.edge_end(n); ++e) {
+        if (part[g.dests[e]] == kNoPartition) {
+          frontier.emplace_back(g.dests[e]);
+        }
+      }
+    }
+    assigned_weight += weight;
+  }
+  for (uint32_t& p : part) {
+    if (p == kNoPartition) {
+      p = num_partitions - 1;
+    }
+  }
+  return part;
+}
+
+/// Greedily move boundary nodes to the neighboring partition that reduces
+/// the edge cut the most, as long as the partitions stay balanced. Nodes of
+/// overweight partitions may also move to lighter partitions at a loss.
+/// Moves alternate between going to partitions with larger and smaller IDs
+/// so that neighbors do not swap back and forth.
+void
+Refine(
+    const WeightedGraph& g, uint32_t num_partitions, uint64_t max_weight,
+    uint32_t iterations, katana::NUMAArray<std::atomic<uint32_t>>* part) {
+  katana::NUMAArray<std::atomic<uint64_t>> part_weight;
+  part_weight.allocateInterleaved(num_partitions);
+  for (uint32_t p = 0; p < num_partitions; ++p) {
+    part_weight[p] = 0;
+  }
+  katana::do_all(
+      katana::iterate(uint64_t{0}, g.num_nodes()),
+      [&](uint64_t n) {
+        katana::atomicAdd(part_weight[(*part)[n].load()], g.node_weights[n]);
+      },
+      katana::no_stats());
+
+  using Connection = std::pair<uint32_t, uint64_t>;
+  katana::PerThreadStorage<std::vector<Connection>> connections;
+
+  for (uint32_t iter = 0; iter < 2 * iterations; ++iter) {
+    const bool upward = iter % 2 == 0;
+    katana::GAccumulator<uint64_t> num_moved;
+    katana::do_all(
+        katana::iterate(uint64_t{0}, g.num_nodes()),
+        [&](uint64_t n) {
+          const uint32_t from = (*part)[n].load(std::memory_order_relaxed);
+          std::vector<Connection>& local = *connections.getLocal();
+          local.clear();
+          uint64_t internal = 0;
+          for (uint64_t e = g.edge_begin(n); e < g.edge_end(n); ++e) {
+            uint32_t p = (*part)[g.dests[e]].load(std::memory_order_relaxed);
+            if (p == from) {
+              internal += g.edge_weights[e];
+            } else if (upward == (p > from)) {
+              local.emplace_back(p, g.edge_weights[e]);
+            }
+          }
+          const bool overweight = part_weight[from] > max_weight;
+          if (local.empty() && !overweight) {
+            return;
+          }
+
+          std::sort(local.begin(), local.end());
+          uint32_t best = kNoPartition;
+          int64_t best_gain = std::numeric_limits<int64_t>::min();
+          for (size_t i = 0; i < local.size();) {
+            uint32_t p = local[i].first;
+            uint64_t external = 0;
+            for (; i < local.size() && local[i].first == p; ++i) {
+              external += local[i].second;
+            }
+            int64_t gain = static_cast<int64_t>(external) - internal;
+            if (gain > best_gain &&
+                part_weight[p] + g.node_weights[n] <= max_weight) {
+              best_gain = gain;
+              best = p;
+            }
+          }
+          if (overweight && best == kNoPartition) {
+            // Any partition with room will do for a disconnected node
+            uint32_t p = (from + 1) % num_partitions;
+            if (upward == (p > from) &&
+                part_weight[p] + g.node_weights[n] <= max_weight) {
+              best = p;
+              best_gain = -static_cast<int64_t>(internal);
+            }
+          }
+          if (best == kNoPartition || (best_gain <= 0 && !overweight)) {
+            return;
+          }
+
+          uint64_t w = g.node_weights[n];
+          if (katana::atomicAdd(part_weight[best], w) + w > max_weight) {
+            katana::atomicSub(part_weight[best], w);
+            return;
+          }
+          katana::atomicSub(part_weight[from], w);
+          (*part)[n].store(best, std::memory_order_relaxed);
+          num_moved += 1;
+        },
+        katana::steal(), katana::no_stats(),
+        katana::loopname("PartitionRefine"));
+
+    // Stop after a round trip without moves
+    if (num_moved.reduce() == 0 && !upward) {
+      break;
+    }
+  }
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::Partition(
+    katana::PropertyGraph* pg, uint32_t num_partitions,
+    const std::string& output_property_name, PartitionPlan plan) {
+  if (num_partitions == 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "number of partitions must be positive");
+  }
+  if (plan.imbalance() < 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "imbalance must not be negative");
+  }
+
+  KATANA_CHECKED(
+      ConstructNodeProperties<NodeData>(pg, {output_property_name}));
+  auto graph = KATANA_CHECKED(Graph::Make(pg, {output_property_name}, {}));
+  const uint64_t num_nodes = pg->num_nodes();
+  if (num_nodes == 0) {
+    return katana::ResultSuccess();
+  }
+
+  const double average_weight = static_cast<double>(num_nodes) / num_partitions;
+  const auto max_weight = static_cast<uint64_t>(
+      std::ceil(average_weight * (1 + plan.imbalance())));
+  // Coarse nodes heavier than a fraction of a partition could not be moved
+  // during refinement without upsetting the balance.
+  const uint64_t max_node_weight =
+      std::max<uint64_t>(1, average_weight * plan.imbalance() + 1);
+  const uint64_t coarsen_to =
+      std::max<uint64_t>(num_partitions, 1) * plan.coarsening_threshold();
+
+  std::vector<WeightedGraph> levels;
+  std::vector<katana::NUMAArray<Node>> coarse_ids;
+  levels.emplace_back(MakeFinestGraph(pg->topology()));
+  while (levels.back().num_nodes() > coarsen_to) {
+    const WeightedGraph& fine = levels.back();
+    katana::NUMAArray<Node> match = HeavyEdgeMatching(fine, max_node_weight);
+    katana::NUMAArray<Node> ids;
+    WeightedGraph coarse = Contract(fine, match, &ids);
+    if (coarse.num_nodes() > kMinCoarseningRatio * fine.num_nodes()) {
+      break;
+    }
+    coarse_ids.emplace_back(std::move(ids));
+    levels.emplace_back(std::move(coarse));
+  }
+
+  std::vector<uint32_t> initial = GreedyGrowing(levels.back(), num_partitions);
+  katana::NUMAArray<std::atomic<uint32_t>> part;
+  part.allocateInterleaved(levels.back().num_nodes());
+  katana::do_all(
+      katana::iterate(uint64_t{0}, levels.back().num_nodes()),
+      [&](uint64_t n) { part[n] = initial[n]; }, katana::no_stats());
+
+  for (size_t level = levels.size(); level-- > 0;) {
+    Refine(
+        levels[level], num_partitions, max_weight,
+        plan.refinement_iterations(), &part);
+    if (level == 0) {
+      break;
+    }
+    const katana::NUMAArray<Node>& ids = coarse_ids[level - 1];
+    katana::NUMAArray<std::atomic<uint32_t>> finer;
+    finer.allocateInterleaved(ids.size());
+    katana::do_all(
+        katana::iterate(uint64_t{0}, ids.size()),
+        [&](uint64_t n) { finer[n] = part[ids[n]].load(); },
+        katana::no_stats());
+    part = std::move(finer);
+  }
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](auto n) { graph.GetData<NodePartition>(n) = part[n].load(); },
+      katana::no_stats());
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+katana::analytics::PartitionAssertValid(
+    katana::PropertyGraph* pg, uint32_t num_partitions,
+    const std::string& property_name) {
+  auto graph = KATANA_CHECKED(Graph::Make(pg, {property_name}, {}));
+
+  katana::GReduceLogicalOr invalid;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](auto n) {
+        if (graph.GetData<NodePartition>(n) >= num_partitions) {
+          invalid.update(true);
+        }
+      },
+      katana::no_stats());
+
+  if (invalid.reduce()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AssertionFailed,
+        "partition IDs must be less than {}", num_partitions);
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<PartitionStatistics>
+katana::analytics::PartitionStatistics::Compute(
+    katana::PropertyGraph* pg, uint32_t num_partitions,
+    const std::string& property_name) {
+  KATANA_CHECKED(PartitionAssertValid(pg, num_partitions, property_name));
+  auto graph = KATANA_CHECKED(Graph::Make(pg, {property_name}, {}));
+
+  katana::NUMAArray<std::atomic<uint64_t>> sizes;
+  sizes.allocateInterleaved(num_partitions);
+  for (uint32_t p = 0; p < num_partitions; ++p) {
+    sizes[p] = 0;
+  }
+
+  katana::GAccumulator<uint64_t> edge_cut;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](auto n) {
+        uint32_t p = graph.GetData<NodePartition>(n);
+        katana::atomicAdd(sizes[p], uint64_t{1});
+        for (auto e : graph.edges(n)) {
+          if (graph.GetData<NodePartition>(graph.GetEdgeDest(e)) != p) {
+            edge_cut += 1;
+          }
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  uint64_t max_size = 0;
+  for (uint32_t p = 0; p < num_partitions; ++p) {
+    max_size = std::max<uint64_t>(max_size, sizes[p]);
+  }
+  double average_size = static_cast<double>(graph.size()) / num_partitions;
+  double imbalance = graph.size() > 0 ? max_size / average_size : 0;
+  return PartitionStatistics{edge_cut.reduce(), max_size, imbalance};
+}
+
+void
+katana::analytics::PartitionStatistics::Print(std::ostream& os) const {
+  os << "Edge cut = " << edge_cut << std::endl;
+  os << "Largest partition size = " << max_partition_size << std::endl;
+  os << "Imbalance = " << imbalance << std::endl;
+}
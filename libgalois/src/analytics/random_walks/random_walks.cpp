@@ -19,6 +19,8 @@
 
 #include "katana/analytics/random_walks/random_walks.h"
 
+#include <algorithm>
+
 #include "katana/TypedPropertyGraph.h"
 
 using namespace katana::analytics;
@@ -27,6 +29,53 @@ const int RandomWalksPlan::kChunkSize = 1;
 
 namespace {
 
+/// A row of the flat walk output. The walk is appended to it like to a vector
+/// and the rest of the row is padded when the walk is finished.
+class WalkRow {
+public:
+  WalkRow(uint32_t* begin, uint32_t width)
+      : begin_(begin), end_(begin), width_(width) {}
+
+  void push_back(uint32_t n) {
+    KATANA_LOG_DEBUG_ASSERT(size() < width_);
+    *end_++ = n;
+  }
+
+  size_t size() const { return end_ - begin_; }
+
+  uint32_t operator[](size_t i) const { return begin_[i]; }
+
+  void Finish() { std::fill(end_, begin_ + width_, kRandomWalksPadding); }
+
+  /// Discard the walk, leaving a row of only padding
+  void Drop() {
+    end_ = begin_;
+    Finish();
+  }
+
+private:
+  uint32_t* begin_;
+  uint32_t* end_;
+  uint32_t width_;
+};
+
+/// The number of nodes in a walk, and so the width of a row of the output
+uint32_t
+RowWidth(const RandomWalksPlan& plan) {
+  return plan.walk_length() + 1;
+}
+
+/// The number of rows of the output. Edge2vec keeps the walks of every
+/// iteration.
+uint64_t
+NumRows(const RandomWalksPlan& plan, uint64_t num_nodes) {
+  uint64_t num_walks = num_nodes * plan.number_of_walks();
+  if (plan.algorithm() == RandomWalksPlan::kEdge2Vec) {
+    return num_walks * plan.max_iterations();
+  }
+  return num_walks;
+}
+
 struct Node2VecAlgo {
   using NodeData = std::tuple<>;
   using EdgeData = std::tuple<>;
@@ -37,6 +86,11 @@ struct Node2VecAlgo {
   const RandomWalksPlan& plan_;
   Node2VecAlgo(const RandomWalksPlan& plan) : plan_(plan) {}
 
+  /// Node2vec ignores all properties.
+  static katana::Result<Graph> MakeGraph(katana::PropertyGraph* pg) {
+    return Graph::Make(pg, {}, {});
+  }
+
   GNode FindSampleNeighbor(
       const Graph& graph, const GNode& n,
       const katana::NUMAArray<uint64_t>& degree, double prob) {
@@ -51,7 +105,7 @@ struct Node2VecAlgo {
   }
 
   void GraphRandomWalk(
-      const Graph& graph, katana::InsertBag<std::vector<uint32_t>>* walks,
+      const Graph& graph, uint32_t* walks,
       const katana::NUMAArray<uint64_t>& degree) {
     katana::PerThreadStorage<std::mt19937> generator;
     katana::PerThreadStorage<std::uniform_real_distribution<double>*>
@@ -82,17 +136,18 @@ struct Node2VecAlgo {
         [&](uint64_t idx) {
           GNode n = idx % graph.size();
 
+          WalkRow walk(&walks[idx * RowWidth(plan_)], RowWidth(plan_));
+          walk.push_back(n);
+
           //check if n has no neighbor
           if (degree[n] == 0) {
+            walk.Finish();
             return;
           }
 
           std::uniform_real_distribution<double>* dist =
               *distribution.getLocal();
 
-          std::vector<uint32_t> walk;
-          walk.push_back(n);
-
           //random value between 0 and 1
           double prob = (*dist)(*generator.getLocal());
 
@@ -152,7 +207,7 @@ struct Node2VecAlgo {
             }
           }
 
-          walks->push(std::move(walk));
+          walk.Finish();
         },
         katana::steal(), katana::chunk_size<RandomWalksPlan::kChunkSize>(),
         katana::loopname("Node2vec walks"), katana::no_stats());
@@ -163,7 +218,7 @@ struct Node2VecAlgo {
   }
 
   void operator()(
-      const Graph& graph, katana::InsertBag<std::vector<uint32_t>>* walks,
+      const Graph& graph, uint32_t* walks,
       const katana::NUMAArray<uint64_t>& degree) {
     GraphRandomWalk(graph, walks, degree);
   }
@@ -181,6 +236,14 @@ struct Edge2VecAlgo {
   const RandomWalksPlan& plan_;
   Edge2VecAlgo(const RandomWalksPlan& plan) : plan_(plan) {}
 
+  // TODO(amp): This is incorrect. This needs to be:
+  //    Graph::Make(pg, {}, {edge_type_property_name})
+  //  The current version requires the input to have exactly the properties
+  //  expected by the algorithm implementation.
+  static katana::Result<Graph> MakeGraph(katana::PropertyGraph* pg) {
+    return Graph::Make(pg);
+  }
+
   //transition matrix
   std::vector<std::vector<double>> transition_matrix_;
 
@@ -210,7 +273,7 @@ struct Edge2VecAlgo {
   }
 
   void GraphRandomWalk(
-      const Graph& graph, katana::InsertBag<std::vector<uint32_t>>* walks,
+      const Graph& graph, uint32_t* walks,
       katana::InsertBag<std::vector<uint32_t>>* types_walks,
       const katana::NUMAArray<uint64_t>& degree) {
     katana::PerThreadStorage<std::mt19937> generator;
@@ -237,19 +300,20 @@ struct Edge2VecAlgo {
         [&](uint64_t idx) {
           GNode n = idx % graph.size();
 
+          WalkRow walk(&walks[idx * RowWidth(plan_)], RowWidth(plan_));
+          walk.push_back(n);
+
           //check if n has no neighbor
           if (degree[n] == 0) {
+            walk.Finish();
             return;
           }
 
           std::uniform_real_distribution<double>* dist =
               *distribution.getLocal();
 
-          std::vector<uint32_t> walk;
           std::vector<uint32_t> types_vec;
 
-          walk.push_back(n);
-
           //random value between 0 and 1
           double prob = (*dist)(*generator.getLocal());
 
@@ -263,8 +327,9 @@ struct Edge2VecAlgo {
           for (uint32_t current_walk = 2; current_walk <= plan_.walk_length();
                current_walk++) {
             uint32_t curr = walk[walk.size() - 1];
-            //check if n has no neighbor
+            //walks that reach a node without neighbors are discarded
             if (degree[curr] == 0) {
+              walk.Drop();
               return;
             }
             uint32_t prev = walk[walk.size() - 2];
@@ -313,7 +378,7 @@ struct Edge2VecAlgo {
 
           }  //end for
 
-          (*walks).push(std::move(walk));
+          walk.Finish();
           (*types_walks).push(std::move(types_vec));
         },
         katana::steal(), katana::chunk_size<RandomWalksPlan::kChunkSize>(),
@@ -436,8 +501,10 @@ struct Edge2VecAlgo {
         });
   }
 
+  /// The walks of each iteration are written after those of the previous
+  /// one.
   void operator()(
-      const Graph& graph, katana::InsertBag<std::vector<uint32_t>>* walks,
+      const Graph& graph, uint32_t* walks,
       const katana::NUMAArray<uint64_t>& degree) {
     uint32_t iterations = plan_.max_iterations();
 
@@ -447,7 +514,9 @@ struct Edge2VecAlgo {
       //E step; generate walks
       katana::InsertBag<std::vector<uint32_t>> types_walks;
 
-      GraphRandomWalk(graph, walks, &types_walks, degree);
+      uint64_t iter_offset =
+          iter * graph.size() * plan_.number_of_walks() * RowWidth(plan_);
+      GraphRandomWalk(graph, walks + iter_offset, &types_walks, degree);
 
       //Update transition matrix
       std::vector<std::vector<uint32_t>> num_edge_types_walks =
@@ -477,21 +546,16 @@ InitializeDegrees(const Graph& graph, katana::NUMAArray<uint64_t>* degree) {
 }  //namespace
 
 template <typename Algorithm>
-static katana::Result<std::vector<std::vector<uint32_t>>>
-RandomWalksWithWrap(katana::PropertyGraph* pg, RandomWalksPlan plan) {
+static katana::Result<void>
+RandomWalksWithWrap(
+    katana::PropertyGraph* pg, RandomWalksPlan plan, uint32_t* walks) {
   katana::ReportPageAllocGuard page_alloc;
 
   if (auto res = katana::SortAllEdgesByDest(pg); !res) {
     return res.error();
   }
 
-  // TODO(amp): This is incorrect. For Node2vec this needs to be:
-  //    Algorithm::Graph::Make(pg, {}, {}) // Ignoring all properties.
-  //  For Edge2vec this needs to be:
-  //    Algorithm::Graph::Make(pg, {}, {edge_type_property_name})
-  //  The current version requires the input to have exactly the properties
-  //  expected by the algorithm implementation.
-  auto pg_result = Algorithm::Graph::Make(pg);
+  auto pg_result = Algorithm::MakeGraph(pg);
   if (!pg_result) {
     return pg_result.error();
   }
@@ -506,29 +570,64 @@ RandomWalksWithWrap(katana::PropertyGraph* pg, RandomWalksPlan plan) {
 
   katana::StatTimer execTime("RandomWalks");
   execTime.start();
-  katana::InsertBag<std::vector<uint32_t>> walks;
-  algo(graph, &walks, degree);
+  algo(graph, walks, degree);
   execTime.stop();
 
   degree.destroy();
   degree.deallocate();
 
-  std::vector<std::vector<uint32_t>> walks_in_vector;
-  walks_in_vector.reserve(plan.number_of_walks());
-  std::move(walks.begin(), walks.end(), std::back_inserter(walks_in_vector));
-  return walks_in_vector;
+  return katana::ResultSuccess();
 }
 
-katana::Result<std::vector<std::vector<uint32_t>>>
-katana::analytics::RandomWalks(PropertyGraph* pg, RandomWalksPlan plan) {
+katana::Result<std::shared_ptr<arrow::FixedSizeListArray>>
+katana::analytics::RandomWalksArray(PropertyGraph* pg, RandomWalksPlan plan) {
+  if (plan.walk_length() == 0) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "walk length must be at least 1");
+  }
+
+  uint64_t num_walks = NumRows(plan, pg->num_nodes());
+  uint64_t num_values = num_walks * RowWidth(plan);
+  std::shared_ptr<arrow::Buffer> buf =
+      KATANA_CHECKED(arrow::AllocateBuffer(num_values * sizeof(uint32_t)));
+  uint32_t* walks = reinterpret_cast<uint32_t*>(buf->mutable_data());
+
   switch (plan.algorithm()) {
   case RandomWalksPlan::kNode2Vec:
-    return RandomWalksWithWrap<Node2VecAlgo>(pg, plan);
+    KATANA_CHECKED(RandomWalksWithWrap<Node2VecAlgo>(pg, plan, walks));
+    break;
   case RandomWalksPlan::kEdge2Vec:
-    return RandomWalksWithWrap<Edge2VecAlgo>(pg, plan);
+    KATANA_CHECKED(RandomWalksWithWrap<Edge2VecAlgo>(pg, plan, walks));
+    break;
   default:
     return ErrorCode::InvalidArgument;
   }
+
+  auto values = std::make_shared<arrow::UInt32Array>(num_values, buf);
+  return std::make_shared<arrow::FixedSizeListArray>(
+      arrow::fixed_size_list(arrow::uint32(), RowWidth(plan)), num_walks,
+      values);
+}
+
+katana::Result<std::vector<std::vector<uint32_t>>>
+katana::analytics::RandomWalks(PropertyGraph* pg, RandomWalksPlan plan) {
+  auto walks_array = KATANA_CHECKED(RandomWalksArray(pg, plan));
+  const uint32_t* walks =
+      std::static_pointer_cast<arrow::UInt32Array>(walks_array->values())
+          ->raw_values();
+  uint32_t width = RowWidth(plan);
+
+  // Walks from nodes without neighbors are only the start node and dropped
+  // walks are empty; leave them out.
+  std::vector<std::vector<uint32_t>> walks_in_vector;
+  for (int64_t i = 0; i < walks_array->length(); ++i) {
+    const uint32_t* begin = walks + i * width;
+    const uint32_t* end = std::find(begin, begin + width, kRandomWalksPadding);
+    if (end - begin > 1) {
+      walks_in_vector.emplace_back(begin, end);
+    }
+  }
+  return walks_in_vector;
 }
 
 /// \cond DO_NOT_DOCUMENT
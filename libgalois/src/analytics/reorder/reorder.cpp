@@ -0,0 +1,591 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/analytics/reorder/reorder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <queue>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <arrow/compute/api.h>
+
+#include "katana/AtomicHelpers.h"
+#include "katana/Bag.h"
+#include "katana/DynamicBitset.h"
+#include "katana/Galois.h"
+#include "katana/NUMAArray.h"
+#include "katana/ParallelSTL.h"
+#include "katana/Reduction.h"
+#include "katana/TypedPropertyGraph.h"
+#include "katana/analytics/Utils.h"
+#include "katana/analytics/partition/partition.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+using Edge = katana::GraphTopology::Edge;
+
+struct NodeOriginalId : public katana::PODProperty<uint32_t> {};
+
+using NodeData = std::tuple<NodeOriginalId>;
+using EdgeData = std::tuple<>;
+typedef katana::TypedPropertyGraph<NodeData, EdgeData> Graph;
+
+/// An order of the nodes of a graph: the node at each new position
+using Order = katana::NUMAArray<Node>;
+
+uint64_t
+Degree(const katana::GraphTopology& topology, Node n) {
+  return topology.edges(n).size();
+}
+
+/// \returns the nodes sorted by ascending degree
+Order
+NodesByDegree(const katana::GraphTopology& topology) {
+  Order nodes;
+  nodes.allocateInterleaved(topology.num_nodes());
+  katana::ParallelSTL::iota(nodes.begin(), nodes.end(), Node{0});
+  katana::ParallelSTL::sort(nodes.begin(), nodes.end(), [&](Node a, Node b) {
+    return std::make_pair(Degree(topology, a), a) <
+           std::make_pair(Degree(topology, b), b);
+  });
+  return nodes;
+}
+
+Order
+HubOrder(const katana::GraphTopology& topology, bool sort_hubs) {
+  const uint64_t num_nodes = topology.num_nodes();
+  const double average_degree =
+      static_cast<double>(topology.num_edges()) / num_nodes;
+  auto is_hub = [&](Node n) { return Degree(topology, n) > average_degree; };
+
+  katana::NUMAArray<uint64_t> num_hubs;
+  num_hubs.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) { num_hubs[n] = is_hub(n) ? 1 : 0; },
+      katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      num_hubs.begin(), num_hubs.end(), num_hubs.begin());
+  const uint64_t total_hubs = num_hubs[num_nodes - 1];
+
+  Order order;
+  order.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        if (is_hub(n)) {
+          order[num_hubs[n] - 1] = n;
+        } else {
+          order[total_hubs + n - num_hubs[n]] = n;
+        }
+      },
+      katana::no_stats());
+
+  // Sort by descending degree and then by ascending ID
+  if (sort_hubs) {
+    katana::ParallelSTL::sort(
+        order.begin(), order.begin() + total_hubs, [&](Node a, Node b) {
+          return std::make_pair(Degree(topology, a), b) >
+                 std::make_pair(Degree(topology, b), a);
+        });
+  }
+  return order;
+}
+
+Order
+ReverseCuthillMcKeeOrder(const katana::GraphTopology& topology) {
+  const uint64_t num_nodes = topology.num_nodes();
+  constexpr uint64_t kUnvisited = std::numeric_limits<uint64_t>::max();
+
+  // The position of the parent of each visited node, or of the node itself
+  // for the first node of a component. Parents race to claim a child and the
+  // earliest parent wins, so the order does not depend on scheduling.
+  katana::NUMAArray<std::atomic<uint64_t>> parent;
+  parent.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) { parent[n] = kUnvisited; }, katana::no_stats());
+
+  Order by_degree = NodesByDegree(topology);
+  Order order;
+  order.allocateInterleaved(num_nodes);
+
+  using Child = std::tuple<uint64_t, uint64_t, Node>;
+  std::vector<Child> children;
+  uint64_t num_placed = 0;
+  uint64_t next_start = 0;
+  while (num_placed < num_nodes) {
+    while (parent[by_degree[next_start]] != kUnvisited) {
+      ++next_start;
+    }
+    Node start = by_degree[next_start];
+    parent[start] = num_placed;
+    order[num_placed++] = start;
+
+    uint64_t level_begin = num_placed - 1;
+    while (level_begin < num_placed) {
+      const uint64_t level_end = num_placed;
+      // Nodes placed in earlier levels have a parent before level_begin, so
+      // only unvisited nodes can be claimed.
+      katana::do_all(
+          katana::iterate(level_begin, level_end),
+          [&](uint64_t pos) {
+            for (Edge e : topology.edges(order[pos])) {
+              katana::atomicMin(parent[topology.edge_dest(e)], pos);
+            }
+          },
+          katana::steal(), katana::no_stats(),
+          katana::loopname("ReverseCuthillMcKeeClaim"));
+
+      katana::InsertBag<Child> claimed;
+      katana::do_all(
+          katana::iterate(level_begin, level_end),
+          [&](uint64_t pos) {
+            for (Edge e : topology.edges(order[pos])) {
+              Node dest = topology.edge_dest(e);
+              // The first node of a component is its own parent
+              if (parent[dest] == pos && dest != order[pos]) {
+                claimed.push(Child{pos, Degree(topology, dest), dest});
+              }
+            }
+          },
+          katana::steal(), katana::no_stats(),
+          katana::loopname("ReverseCuthillMcKeeCollect"));
+
+      // A parent with several edges to a child claims it more than once
+      children.assign(claimed.begin(), claimed.end());
+      katana::ParallelSTL::sort(children.begin(), children.end());
+      children.erase(
+          std::unique(children.begin(), children.end()), children.end());
+      for (const Child& child : children) {
+        order[num_placed++] = std::get<2>(child);
+      }
+      level_begin = level_end;
+    }
+  }
+
+  std::reverse(order.begin(), order.end());
+  return order;
+}
+
+Order
+RabbitOrder(const katana::GraphTopology& topology) {
+  const uint64_t num_nodes = topology.num_nodes();
+  // Twice the total edge weight of a symmetric graph
+  const double total_weight = topology.num_edges();
+
+  // Union-find over the nodes, where the root of each set is the node all of
+  // its members were merged into.
+  std::vector<Node> community(num_nodes);
+  std::vector<uint64_t> degree(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        community[n] = n;
+        degree[n] = Degree(topology, n);
+      },
+      katana::no_stats());
+  auto find = [&](Node n) {
+    Node root = n;
+    while (community[root] != root) {
+      root = community[root];
+    }
+    while (community[n] != root) {
+      Node next = community[n];
+      community[n] = root;
+      n = next;
+    }
+    return root;
+  };
+
+  // The dendrogram as lists of children; merged nodes pass their aggregated
+  // edges on to the node they were merged into.
+  constexpr Node kNoChild = std::numeric_limits<Node>::max();
+  std::vector<Node> first_child(num_nodes, kNoChild);
+  std::vector<Node> next_sibling(num_nodes, kNoChild);
+  std::vector<std::vector<std::pair<Node, uint64_t>>> absorbed(num_nodes);
+  std::vector<Node> roots;
+
+  std::vector<std::pair<Node, uint64_t>> neighbors;
+  for (Node u : NodesByDegree(topology)) {
+    neighbors.clear();
+    for (Edge e : topology.edges(u)) {
+      neighbors.emplace_back(find(topology.edge_dest(e)), 1);
+    }
+    for (const auto& [v, weight] : absorbed[u]) {
+      neighbors.emplace_back(find(v), weight);
+    }
+    std::vector<std::pair<Node, uint64_t>>().swap(absorbed[u]);
+    std::sort(neighbors.begin(), neighbors.end());
+
+    // Aggregate the weight to each neighboring community and pick the one
+    // with the largest modularity gain.
+    std::vector<std::pair<Node, uint64_t>> aggregated;
+    Node best = u;
+    double best_gain = 0;
+    for (size_t i = 0; i < neighbors.size();) {
+      Node v = neighbors[i].first;
+      uint64_t weight = 0;
+      for (; i < neighbors.size() && neighbors[i].first == v; ++i) {
+        weight += neighbors[i].second;
+      }
+      if (v == u) {
+        continue;
+      }
+      aggregated.emplace_back(v, weight);
+      double gain = weight / total_weight - static_cast<double>(degree[u]) *
+                                                degree[v] /
+                                                (total_weight * total_weight);
+      if (gain > best_gain) {
+        best_gain = gain;
+        best = v;
+      }
+    }
+
+    if (best == u) {
+      roots.emplace_back(u);
+      continue;
+    }
+    community[u] = best;
+    degree[best] += degree[u];
+    next_sibling[u] = first_child[best];
+    first_child[best] = u;
+    absorbed[best].insert(
+        absorbed[best].end(), aggregated.begin(), aggregated.end());
+  }
+
+  // Each community of the dendrogram is placed in one contiguous range.
+  Order order;
+  order.allocateInterleaved(num_nodes);
+  uint64_t num_placed = 0;
+  std::vector<Node> stack;
+  for (Node root : roots) {
+    stack.emplace_back(root);
+    while (!stack.empty()) {
+      Node n = stack.back();
+      stack.pop_back();
+      order[num_placed++] = n;
+      for (Node c = first_child[n]; c != kNoChild; c = next_sibling[c]) {
+        stack.emplace_back(c);
+      }
+    }
+  }
+  KATANA_LOG_DEBUG_ASSERT(num_placed == num_nodes);
+  return order;
+}
+
+Order
+GorderOrder(const katana::GraphTopology& topology, uint32_t window) {
+  const uint64_t num_nodes = topology.num_nodes();
+  const uint64_t max_shared_degree = std::sqrt(num_nodes);
+
+  katana::DynamicBitset placed;
+  placed.resize(num_nodes);
+  std::vector<int64_t> score(num_nodes, 0);
+  // A max-heap of candidates that is updated lazily: entries whose score is
+  // out of date are fixed up when they reach the top.
+  std::priority_queue<std::pair<int64_t, Node>> candidates;
+
+  // Add delta to the score of every unplaced node that is a neighbor of n or
+  // shares a neighbor with n.
+  auto update = [&](Node n, int64_t delta) {
+    auto add = [&](Node v) {
+      if (placed.test(v)) {
+        return;
+      }
+      score[v] += delta;
+      if (delta > 0) {
+        candidates.emplace(score[v], v);
+      }
+    };
+    for (Edge e : topology.edges(n)) {
+      Node shared = topology.edge_dest(e);
+      add(shared);
+      if (Degree(topology, shared) > max_shared_degree) {
+        continue;
+      }
+      for (Edge e2 : topology.edges(shared)) {
+        if (Node v = topology.edge_dest(e2); v != n) {
+          add(v);
+        }
+      }
+    }
+  };
+
+  Order by_degree = NodesByDegree(topology);
+  uint64_t next_start = num_nodes;
+  Order order;
+  order.allocateInterleaved(num_nodes);
+  for (uint64_t i = 0; i < num_nodes; ++i) {
+    Node next = num_nodes;
+    while (!candidates.empty()) {
+      auto [key, v] = candidates.top();
+      candidates.pop();
+      if (placed.test(v)) {
+        continue;
+      }
+      if (key != score[v]) {
+        if (score[v] > 0) {
+          candidates.emplace(score[v], v);
+        }
+        continue;
+      }
+      next = v;
+      break;
+    }
+    // Start over from the unplaced node with the largest degree
+    while (next == num_nodes) {
+      --next_start;
+      if (!placed.test(by_degree[next_start])) {
+        next = by_degree[next_start];
+      }
+    }
+
+    placed.set(next);
+    order[i] = next;
+    update(next, 1);
+    if (i >= window) {
+      update(order[i - window], -1);
+    }
+  }
+  return order;
+}
+
+katana::Result<Order>
+PartitionedOrder(katana::PropertyGraph* pg, uint32_t num_partitions) {
+  TemporaryPropertyGuard partition{pg};
+  KATANA_CHECKED(Partition(pg, num_partitions, partition.name()));
+  auto parts =
+      KATANA_CHECKED(pg->GetNodePropertyTyped<uint32_t>(partition.name()));
+
+  Order order;
+  order.allocateInterleaved(pg->num_nodes());
+  katana::ParallelSTL::iota(order.begin(), order.end(), Node{0});
+  katana::ParallelSTL::sort(order.begin(), order.end(), [&](Node a, Node b) {
+    return std::make_pair(parts->Value(a), a) <
+           std::make_pair(parts->Value(b), b);
+  });
+  return Order(std::move(order));
+}
+
+/// Gather the rows of the properties in view in the order given by rows.
+katana::Result<std::shared_ptr<arrow::Table>>
+TakeProperties(
+    const katana::PropertyGraph::ReadOnlyPropertyView& view,
+    const katana::NUMAArray<int64_t>& rows) {
+  std::shared_ptr<arrow::Schema> schema = view.schema();
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+  if (schema->num_fields() == 0) {
+    return arrow::Table::Make(schema, columns, rows.size());
+  }
+
+  auto indices = katana::ProjectAsArrowArray(rows.data(), rows.size());
+  for (int i = 0, n = schema->num_fields(); i < n; ++i) {
+    arrow::Datum taken =
+        KATANA_CHECKED(arrow::compute::Take(view.GetProperty(i), indices));
+    columns.emplace_back(taken.chunked_array());
+  }
+  return arrow::Table::Make(schema, columns, rows.size());
+}
+
+/// Relabel the nodes of pg so that order[i] becomes node i.
+katana::Result<void>
+ApplyOrder(
+    katana::PropertyGraph* pg, const Order& order,
+    const std::string& original_id_property_name) {
+  const katana::GraphTopology& topology = pg->topology();
+  const uint64_t num_nodes = topology.num_nodes();
+  const uint64_t num_edges = topology.num_edges();
+
+  katana::NUMAArray<Node> new_ids;
+  new_ids.allocateInterleaved(num_nodes);
+  katana::NUMAArray<int64_t> node_rows;
+  node_rows.allocateInterleaved(num_nodes);
+  katana::NUMAArray<Edge> new_indices;
+  new_indices.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t pos) {
+        new_ids[order[pos]] = pos;
+        node_rows[pos] = order[pos];
+        new_indices[pos] = Degree(topology, order[pos]);
+      },
+      katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      new_indices.begin(), new_indices.end(), new_indices.begin());
+
+  katana::NUMAArray<Node> new_dests;
+  new_dests.allocateInterleaved(num_edges);
+  katana::NUMAArray<int64_t> edge_rows;
+  edge_rows.allocateInterleaved(num_edges);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t pos) {
+        Edge out = pos > 0 ? new_indices[pos - 1] : 0;
+        for (Edge e : topology.edges(order[pos])) {
+          new_dests[out] = new_ids[topology.edge_dest(e)];
+          edge_rows[out] = e;
+          ++out;
+        }
+      },
+      katana::steal(), katana::no_stats(), katana::loopname("ReorderEdges"));
+
+  std::shared_ptr<arrow::Table> node_props =
+      KATANA_CHECKED(TakeProperties(pg->NodeReadOnlyPropertyView(), node_rows));
+  std::shared_ptr<arrow::Table> edge_props =
+      KATANA_CHECKED(TakeProperties(pg->EdgeReadOnlyPropertyView(), edge_rows));
+
+  KATANA_CHECKED(pg->ReplaceTopology(
+      katana::GraphTopology(std::move(new_indices), std::move(new_dests)),
+      node_props, edge_props));
+
+  KATANA_CHECKED(
+      ConstructNodeProperties<NodeData>(pg, {original_id_property_name}));
+  auto graph = KATANA_CHECKED(Graph::Make(pg, {original_id_property_name}, {}));
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t pos) { graph.GetData<NodeOriginalId>(pos) = order[pos]; },
+      katana::no_stats());
+
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::Reorder(
+    katana::PropertyGraph* pg, const std::string& original_id_property_name,
+    ReorderPlan plan) {
+  if (pg->HasNodeProperty(original_id_property_name)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "property {} already exists",
+        original_id_property_name);
+  }
+  if (plan.algorithm() == ReorderPlan::kGorder && plan.gorder_window() == 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "Gorder window must be positive");
+  }
+  if (plan.algorithm() == ReorderPlan::kPartitioned &&
+      plan.num_partitions() == 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "number of partitions must be positive");
+  }
+  KATANA_CHECKED_CONTEXT(pg->CheckPropertiesLoaded(), "reordering");
+
+  const katana::GraphTopology& topology = pg->topology();
+  if (topology.num_nodes() == 0) {
+    return ConstructNodeProperties<NodeData>(pg, {original_id_property_name});
+  }
+
+  Order order;
+  switch (plan.algorithm()) {
+  case ReorderPlan::kReverseCuthillMcKee:
+    order = ReverseCuthillMcKeeOrder(topology);
+    break;
+  case ReorderPlan::kHubSort:
+    order = HubOrder(topology, true);
+    break;
+  case ReorderPlan::kHubCluster:
+    order = HubOrder(topology, false);
+    break;
+  case ReorderPlan::kRabbit:
+    order = RabbitOrder(topology);
+    break;
+  case ReorderPlan::kGorder:
+    order = GorderOrder(topology, plan.gorder_window());
+    break;
+  case ReorderPlan::kPartitioned:
+    order = KATANA_CHECKED(PartitionedOrder(pg, plan.num_partitions()));
+    break;
+  default:
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  return ApplyOrder(pg, order, original_id_property_name);
+}
+
+katana::Result<void>
+katana::analytics::ReorderAssertValid(
+    katana::PropertyGraph* pg, const std::string& original_id_property_name) {
+  auto graph = KATANA_CHECKED(Graph::Make(pg, {original_id_property_name}, {}));
+
+  katana::NUMAArray<std::atomic<uint8_t>> seen;
+  seen.allocateInterleaved(graph.size());
+  katana::do_all(
+      katana::iterate(graph), [&](auto n) { seen[n] = 0; },
+      katana::no_stats());
+
+  katana::GReduceLogicalOr invalid;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](auto n) {
+        uint32_t original = graph.GetData<NodeOriginalId>(n);
+        if (original >= graph.size() || seen[original].exchange(1) != 0) {
+          invalid.update(true);
+        }
+      },
+      katana::no_stats());
+
+  if (invalid.reduce()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AssertionFailed,
+        "original IDs are not a permutation of the nodes");
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<ReorderStatistics>
+katana::analytics::ReorderStatistics::Compute(katana::PropertyGraph* pg) {
+  const katana::GraphTopology& topology = pg->topology();
+
+  katana::GAccumulator<uint64_t> total_span;
+  katana::GReduceMax<uint64_t> max_span;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, topology.num_nodes()),
+      [&](uint64_t n) {
+        for (Edge e : topology.edges(n)) {
+          Node dest = topology.edge_dest(e);
+          uint64_t span = dest > n ? dest - n : n - dest;
+          total_span += span;
+          max_span.update(span);
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  double average = topology.num_edges() > 0
+                       ? static_cast<double>(total_span.reduce()) /
+                             topology.num_edges()
+                       : 0;
+  return ReorderStatistics{average, max_span.reduce()};
+}
+
+void
+katana::analytics::ReorderStatistics::Print(std::ostream& os) const {
+  os << "Average edge span = " << average_edge_span << std::endl;
+  os << "Maximum edge span = " << max_edge_span << std::endl;
+}
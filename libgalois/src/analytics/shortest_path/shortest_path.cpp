@@ -0,0 +1,598 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/analytics/shortest_path/shortest_path.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <queue>
+#include <set>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "katana/ParallelSTL.h"
+#include "katana/Reduction.h"
+#include "katana/TypedPropertyGraph.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+using Edge = katana::GraphTopology::Edge;
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+/// Copy the numeric node property column into dimension dim of coordinates,
+/// which holds num_dims values per node
+template <typename ArrowType>
+void
+CopyCoordinates(
+    const arrow::ChunkedArray& column, size_t dim, size_t num_dims,
+    katana::NUMAArray<double>* coordinates) {
+  size_t offset = 0;
+  for (const auto& chunk : column.chunks()) {
+    const auto& array =
+        static_cast<const arrow::NumericArray<ArrowType>&>(*chunk);
+    katana::do_all(
+        katana::iterate(int64_t{0}, array.length()),
+        [&](int64_t i) {
+          (*coordinates)[(offset + i) * num_dims + dim] = array.Value(i);
+        },
+        katana::no_stats());
+    offset += array.length();
+  }
+}
+
+katana::Result<void>
+LoadCoordinates(
+    const katana::PropertyGraph& pg, const std::vector<std::string>& names,
+    katana::NUMAArray<double>* coordinates) {
+  coordinates->allocateInterleaved(pg.num_nodes() * names.size());
+  for (size_t dim = 0; dim < names.size(); ++dim) {
+    auto column = pg.GetNodeProperty(names[dim]);
+    if (!column) {
+      return KATANA_ERROR(
+          katana::ErrorCode::PropertyNotFound, "no node property {}",
+          names[dim]);
+    }
+    if (column->null_count() != 0) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "coordinate property {} has null values", names[dim]);
+    }
+    switch (column->type()->id()) {
+    case arrow::UInt32Type::type_id:
+      CopyCoordinates<arrow::UInt32Type>(
+          *column, dim, names.size(), coordinates);
+      break;
+    case arrow::Int32Type::type_id:
+      CopyCoordinates<arrow::Int32Type>(
+          *column, dim, names.size(), coordinates);
+      break;
+    case arrow::UInt64Type::type_id:
+      CopyCoordinates<arrow::UInt64Type>(
+          *column, dim, names.size(), coordinates);
+      break;
+    case arrow::Int64Type::type_id:
+      CopyCoordinates<arrow::Int64Type>(
+          *column, dim, names.size(), coordinates);
+      break;
+    case arrow::FloatType::type_id:
+      CopyCoordinates<arrow::FloatType>(
+          *column, dim, names.size(), coordinates);
+      break;
+    case arrow::DoubleType::type_id:
+      CopyCoordinates<arrow::DoubleType>(
+          *column, dim, names.size(), coordinates);
+      break;
+    default:
+      return KATANA_ERROR(
+          katana::ErrorCode::TypeError,
+          "coordinate property {} is not numeric", names[dim]);
+    }
+  }
+  return katana::ResultSuccess();
+}
+
+template <typename Weight>
+class ShortestPathQueryImpl final : public ShortestPathQuery {
+  using EdgeWeight = katana::PODProperty<Weight>;
+  using Graph =
+      katana::TypedPropertyGraph<std::tuple<>, std::tuple<EdgeWeight>>;
+
+  /// One direction of the bidirectional search. Labels are kept in a hash
+  /// map rather than a per-node array so that a query costs time in the
+  /// number of nodes it reaches, not in the size of the graph.
+  struct Side {
+    struct Label {
+      Weight dist;
+      Node parent;
+      bool settled;
+    };
+    using QueueEntry = std::pair<double, Node>;
+
+    std::unordered_map<Node, Label> labels;
+    std::priority_queue<
+        QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>>
+        queue;
+
+    double MinKey() const {
+      return queue.empty() ? kInfinity : queue.top().first;
+    }
+
+    const Label* Find(Node n) const {
+      auto it = labels.find(n);
+      return it == labels.end() ? nullptr : &it->second;
+    }
+  };
+
+  /// A path with the distance from its first node to each of its nodes
+  struct LabeledPath {
+    std::vector<Node> nodes;
+    std::vector<Weight> prefix;
+
+    bool Found() const { return !nodes.empty(); }
+  };
+
+  /// Parts of the graph a search may not use: the nodes in nodes and the
+  /// edges from spur to any node in spur_dests
+  struct SearchMask {
+    std::unordered_set<Node> nodes;
+    Node spur;
+    std::unordered_set<Node> spur_dests;
+
+    bool Allows(Node src, Node dst) const {
+      if (nodes.count(dst) != 0 || nodes.count(src) != 0) {
+        return false;
+      }
+      return src != spur || spur_dests.count(dst) == 0;
+    }
+  };
+
+public:
+  static katana::Result<std::unique_ptr<ShortestPathQuery>> Make(
+      katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+      const std::vector<std::string>& coordinate_property_names) {
+    auto graph =
+        KATANA_CHECKED(Graph::Make(pg, {}, {edge_weight_property_name}));
+
+    std::unique_ptr<ShortestPathQueryImpl> query(
+        new ShortestPathQueryImpl(pg->topology()));
+    KATANA_CHECKED(query->IndexEdges(graph));
+    if (!coordinate_property_names.empty()) {
+      query->num_dims_ = coordinate_property_names.size();
+      KATANA_CHECKED(LoadCoordinates(
+          *pg, coordinate_property_names, &query->coordinates_));
+    }
+    return std::unique_ptr<ShortestPathQuery>(std::move(query));
+  }
+
+  katana::Result<ShortestPath> Find(Node source, Node target) override {
+    if (source >= topology_.num_nodes() || target >= topology_.num_nodes()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "source {} or target {} is not a node", source, target);
+    }
+
+    LabeledPath path;
+    uint64_t settled = Search(source, target, nullptr, &path);
+    return ToShortestPath(path, settled);
+  }
+
+  katana::Result<std::vector<ShortestPath>> FindKShortestSimplePaths(
+      Node source, Node target, uint32_t k,
+      KShortestSimplePathsPlan plan) override {
+    if (source >= topology_.num_nodes() || target >= topology_.num_nodes()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "source {} or target {} is not a node", source, target);
+    }
+    if (plan.algorithm() != KShortestSimplePathsPlan::kYen) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument, "unknown algorithm {}",
+          plan.algorithm());
+    }
+
+    if (k == 0) {
+      return std::vector<ShortestPath>{};
+    }
+
+    katana::GAccumulator<uint64_t> settled;
+    std::vector<LabeledPath> accepted;
+
+    LabeledPath first;
+    settled += Search(source, target, nullptr, &first);
+    if (!first.Found()) {
+      return std::vector<ShortestPath>{};
+    }
+    accepted.emplace_back(std::move(first));
+
+    // Candidates ordered by length and then by nodes, which also removes
+    // duplicate spur results
+    std::set<std::pair<Weight, std::vector<Node>>> candidates;
+    std::map<std::vector<Node>, std::vector<Weight>> candidate_prefixes;
+
+    while (accepted.size() < k) {
+      const LabeledPath& last = accepted.back();
+      size_t num_spurs = last.nodes.size() - 1;
+      std::vector<LabeledPath> spurs(num_spurs);
+
+      // Each spur search masks the root path and the edges leaving the spur
+      // node along accepted paths with the same root; all spur searches of
+      // a path are independent
+      katana::do_all(
+          katana::iterate(size_t{0}, num_spurs),
+          [&](size_t i) {
+            SearchMask mask;
+            mask.spur = last.nodes[i];
+            mask.nodes.insert(last.nodes.begin(), last.nodes.begin() + i);
+            for (const auto& path : accepted) {
+              if (path.nodes.size() > i + 1 &&
+                  std::equal(
+                      last.nodes.begin(), last.nodes.begin() + i + 1,
+                      path.nodes.begin())) {
+                mask.spur_dests.insert(path.nodes[i + 1]);
+              }
+            }
+
+            LabeledPath spur;
+            settled += Search(last.nodes[i], target, &mask, &spur);
+            if (!spur.Found()) {
+              return;
+            }
+
+            LabeledPath& candidate = spurs[i];
+            candidate.nodes.assign(
+                last.nodes.begin(), last.nodes.begin() + i);
+            candidate.prefix.assign(
+                last.prefix.begin(), last.prefix.begin() + i);
+            for (size_t j = 0; j < spur.nodes.size(); ++j) {
+              candidate.nodes.emplace_back(spur.nodes[j]);
+              candidate.prefix.emplace_back(last.prefix[i] + spur.prefix[j]);
+            }
+          },
+          katana::steal(), katana::chunk_size<1>(),
+          katana::loopname("YenSpurPaths"));
+
+      for (auto& spur : spurs) {
+        if (!spur.Found()) {
+          continue;
+        }
+        auto [it, inserted] = candidate_prefixes.emplace(
+            std::move(spur.nodes), std::move(spur.prefix));
+        if (inserted) {
+          candidates.emplace(it->second.back(), it->first);
+        }
+      }
+
+      if (candidates.empty()) {
+        break;
+      }
+
+      auto best = candidates.begin();
+      LabeledPath next;
+      next.nodes = best->second;
+      next.prefix = candidate_prefixes.at(next.nodes);
+      candidates.erase(best);
+      accepted.emplace_back(std::move(next));
+    }
+
+    std::vector<ShortestPath> ret;
+    ret.reserve(accepted.size());
+    for (const auto& path : accepted) {
+      ret.emplace_back(ToShortestPath(path, settled.reduce()));
+    }
+    return ret;
+  }
+
+private:
+  explicit ShortestPathQueryImpl(const katana::GraphTopology& topology)
+      : topology_(topology) {}
+
+  static ShortestPath ToShortestPath(
+      const LabeledPath& path, uint64_t settled) {
+    if (!path.Found()) {
+      return ShortestPath{kInfinity, {}, settled};
+    }
+    return ShortestPath{double(path.prefix.back()), path.nodes, settled};
+  }
+
+  /// Bidirectional search from source to target that avoids everything
+  /// excluded by mask, if any. Stores the path found, if any, in path and
+  /// returns the number of settled nodes.
+  uint64_t Search(
+      Node source, Node target, const SearchMask* mask,
+      LabeledPath* path) const {
+    Side forward;
+    Side backward;
+    forward.labels[source] = {0, source, false};
+    forward.queue.emplace(Potential(source, source, target), source);
+    backward.labels[target] = {0, target, false};
+    backward.queue.emplace(-Potential(target, source, target), target);
+
+    // The best path found so far goes through meeting_node
+    double best = source == target ? 0 : kInfinity;
+    Node meeting_node = source;
+    uint64_t settled = 0;
+
+    // With the average potential of both directions the sum of the smallest
+    // keys is a lower bound on the length of any path not found yet
+    while (!forward.queue.empty() && !backward.queue.empty() &&
+           forward.MinKey() + backward.MinKey() < best) {
+      bool go_forward = forward.queue.size() <= backward.queue.size();
+      Side& side = go_forward ? forward : backward;
+      Side& other = go_forward ? backward : forward;
+
+      Node n = side.queue.top().second;
+      side.queue.pop();
+      auto& label = side.labels[n];
+      if (label.settled) {
+        continue;
+      }
+      label.settled = true;
+      ++settled;
+      Weight dist = label.dist;
+
+      auto relax = [&](Node dst, Weight weight) {
+        Weight new_dist = dist + weight;
+        auto [it, inserted] = side.labels.try_emplace(dst);
+        auto& dst_label = it->second;
+        if (!inserted && dst_label.dist <= new_dist) {
+          return;
+        }
+        dst_label = {new_dist, n, false};
+        double potential = Potential(dst, source, target);
+        side.queue.emplace(
+            new_dist + (go_forward ? potential : -potential), dst);
+
+        if (const auto* other_label = other.Find(dst); other_label) {
+          double length = double(new_dist) + double(other_label->dist);
+          if (length < best) {
+            best = length;
+            meeting_node = dst;
+          }
+        }
+      };
+
+      if (go_forward) {
+        for (Edge e : topology_.edges(n)) {
+          Node dst = topology_.edge_dest(e);
+          if (!mask || mask->Allows(n, dst)) {
+            relax(dst, out_weights_[e]);
+          }
+        }
+      } else {
+        for (Edge e = n == 0 ? 0 : in_indices_[n - 1]; e < in_indices_[n];
+             ++e) {
+          Node src = in_sources_[e];
+          if (!mask || mask->Allows(src, n)) {
+            relax(src, in_weights_[e]);
+          }
+        }
+      }
+    }
+
+    path->nodes.clear();
+    path->prefix.clear();
+    if (best == kInfinity) {
+      return settled;
+    }
+
+    for (Node n = meeting_node; n != source;
+         n = forward.labels.at(n).parent) {
+      path->nodes.emplace_back(n);
+      path->prefix.emplace_back(forward.labels.at(n).dist);
+    }
+    path->nodes.emplace_back(source);
+    path->prefix.emplace_back(0);
+    std::reverse(path->nodes.begin(), path->nodes.end());
+    std::reverse(path->prefix.begin(), path->prefix.end());
+
+    Weight total = path->prefix.back() + backward.labels.at(meeting_node).dist;
+    for (Node n = meeting_node; n != target;) {
+      n = backward.labels.at(n).parent;
+      path->nodes.emplace_back(n);
+      path->prefix.emplace_back(total - backward.labels.at(n).dist);
+    }
+    return settled;
+  }
+
+  /// Copy the edge weights and build the incoming edges of every node, with
+  /// their weights, in CSR form
+  katana::Result<void> IndexEdges(Graph& graph) {
+    uint64_t num_nodes = topology_.num_nodes();
+    uint64_t num_edges = topology_.num_edges();
+
+    out_weights_.allocateInterleaved(num_edges);
+    in_indices_.allocateInterleaved(num_nodes);
+    in_sources_.allocateInterleaved(num_edges);
+    in_weights_.allocateInterleaved(num_edges);
+
+    katana::GReduceLogicalOr negative;
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes),
+        [&](Node n) { in_indices_[n] = 0; }, katana::no_stats());
+    katana::do_all(
+        katana::iterate(graph),
+        [&](Node n) {
+          for (auto e : graph.edges(n)) {
+            Weight weight = graph.template GetEdgeData<EdgeWeight>(e);
+            if constexpr (std::is_signed_v<Weight>) {
+              negative.update(weight < 0);
+            }
+            out_weights_[e] = weight;
+            __sync_add_and_fetch(&in_indices_[topology_.edge_dest(e)], 1);
+          }
+        },
+        katana::steal(), katana::no_stats());
+    if (negative.reduce()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "edge weights must not be negative");
+    }
+
+    katana::ParallelSTL::partial_sum(
+        in_indices_.begin(), in_indices_.end(), in_indices_.begin());
+
+    katana::NUMAArray<Edge> offsets;
+    offsets.allocateInterleaved(num_nodes);
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes),
+        [&](Node n) { offsets[n] = n == 0 ? 0 : in_indices_[n - 1]; },
+        katana::no_stats());
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes),
+        [&](Node n) {
+          for (Edge e : topology_.edges(n)) {
+            Edge slot =
+                __sync_fetch_and_add(&offsets[topology_.edge_dest(e)], 1);
+            in_sources_[slot] = n;
+            in_weights_[slot] = out_weights_[e];
+          }
+        },
+        katana::steal(), katana::no_stats());
+
+    return katana::ResultSuccess();
+  }
+
+  /// Half the difference of the straight line distances from n to the target
+  /// and to the source. Unlike either distance alone, this is a feasible
+  /// potential for both directions at once.
+  double Potential(Node n, Node source, Node target) const {
+    if (num_dims_ == 0) {
+      return 0;
+    }
+    return (StraightLineDistance(n, target) -
+            StraightLineDistance(n, source)) /
+           2;
+  }
+
+  double StraightLineDistance(Node a, Node b) const {
+    double sum = 0;
+    for (size_t dim = 0; dim < num_dims_; ++dim) {
+      double diff =
+          coordinates_[a * num_dims_ + dim] - coordinates_[b * num_dims_ + dim];
+      sum += diff * diff;
+    }
+    return std::sqrt(sum);
+  }
+
+  const katana::GraphTopology& topology_;
+  katana::NUMAArray<Weight> out_weights_;
+  katana::NUMAArray<Edge> in_indices_;
+  katana::NUMAArray<Node> in_sources_;
+  katana::NUMAArray<Weight> in_weights_;
+
+  size_t num_dims_{0};
+  katana::NUMAArray<double> coordinates_;
+};
+
+}  // namespace
+
+katana::analytics::ShortestPathQuery::~ShortestPathQuery() = default;
+
+katana::Result<std::unique_ptr<ShortestPathQuery>>
+katana::analytics::ShortestPathQuery::Make(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    const std::vector<std::string>& coordinate_property_names,
+    ShortestPathPlan plan) {
+  std::vector<std::string> coordinates = coordinate_property_names;
+  switch (plan.algorithm()) {
+  case ShortestPathPlan::kAutomatic:
+    break;
+  case ShortestPathPlan::kBidirectionalDijkstra:
+    coordinates.clear();
+    break;
+  case ShortestPathPlan::kBidirectionalAStar:
+    if (coordinates.empty()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "A* requires coordinate properties");
+    }
+    break;
+  default:
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "unknown algorithm {}",
+        plan.algorithm());
+  }
+
+  auto weights = pg->GetEdgeProperty(edge_weight_property_name);
+  if (!weights) {
+    return KATANA_ERROR(
+        katana::ErrorCode::PropertyNotFound, "no edge property {}",
+        edge_weight_property_name);
+  }
+
+  switch (weights->type()->id()) {
+  case arrow::UInt32Type::type_id:
+    return ShortestPathQueryImpl<uint32_t>::Make(
+        pg, edge_weight_property_name, coordinates);
+  case arrow::Int32Type::type_id:
+    return ShortestPathQueryImpl<int32_t>::Make(
+        pg, edge_weight_property_name, coordinates);
+  case arrow::UInt64Type::type_id:
+    return ShortestPathQueryImpl<uint64_t>::Make(
+        pg, edge_weight_property_name, coordinates);
+  case arrow::Int64Type::type_id:
+    return ShortestPathQueryImpl<int64_t>::Make(
+        pg, edge_weight_property_name, coordinates);
+  case arrow::FloatType::type_id:
+    return ShortestPathQueryImpl<float>::Make(
+        pg, edge_weight_property_name, coordinates);
+  case arrow::DoubleType::type_id:
+    return ShortestPathQueryImpl<double>::Make(
+        pg, edge_weight_property_name, coordinates);
+  default:
+    return katana::ErrorCode::TypeError;
+  }
+}
+
+katana::Result<std::vector<ShortestPath>>
+katana::analytics::KShortestSimplePaths(
+    PropertyGraph* pg, uint32_t source, uint32_t target, uint32_t k,
+    const std::string& edge_weight_property_name,
+    const std::vector<std::string>& coordinate_property_names,
+    KShortestSimplePathsPlan plan) {
+  auto query = KATANA_CHECKED(ShortestPathQuery::Make(
+      pg, edge_weight_property_name, coordinate_property_names,
+      plan.search_plan()));
+  return query->FindKShortestSimplePaths(source, target, k, plan);
+}
+
+katana::Result<ShortestPath>
+katana::analytics::FindShortestPath(
+    PropertyGraph* pg, uint32_t source, uint32_t target,
+    const std::string& edge_weight_property_name,
+    const std::vector<std::string>& coordinate_property_names,
+    ShortestPathPlan plan) {
+  auto query = KATANA_CHECKED(ShortestPathQuery::Make(
+      pg, edge_weight_property_name, coordinate_property_names, plan));
+  return query->Find(source, target);
+}
+
+void
+katana::analytics::ShortestPath::Print(std::ostream& os) const {
+  os << "Distance = " << distance << std::endl;
+  os << "Path length = " << path.size() << std::endl;
+  os << "Number of settled nodes = " << n_settled_nodes << std::endl;
+}
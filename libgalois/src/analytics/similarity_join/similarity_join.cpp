@@ -0,0 +1,311 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2019, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/analytics/similarity_join/similarity_join.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "katana/NUMAArray.h"
+#include "katana/ParallelSTL.h"
+#include "katana/Statistics.h"
+#include "katana/analytics/Utils.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+
+/// The finalizer of SplitMix64; a bijection that mixes all bits of x
+uint64_t
+Mix(uint64_t x) {
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+/// The distinct out-neighbors of each node, sorted. The neighbors of n are
+/// stored where its edges are in the topology.
+class NeighborSets {
+public:
+  explicit NeighborSets(const katana::GraphTopology& topology) {
+    neighbors_.allocateInterleaved(topology.num_edges());
+    begins_.allocateInterleaved(topology.num_nodes());
+    sizes_.allocateInterleaved(topology.num_nodes());
+    katana::do_all(
+        katana::iterate(topology),
+        [&](Node n) {
+          auto edges = topology.edges(n);
+          uint64_t begin = *edges.begin();
+          Node* first = &neighbors_[begin];
+          Node* last = first;
+          for (auto e : edges) {
+            *last++ = topology.edge_dest(e);
+          }
+          std::sort(first, last);
+          begins_[n] = begin;
+          sizes_[n] = std::unique(first, last) - first;
+        },
+        katana::steal(), katana::no_stats(),
+        katana::loopname("SortNeighbors"));
+  }
+
+  const Node* begin(Node n) const { return &neighbors_[begins_[n]]; }
+  const Node* end(Node n) const { return begin(n) + sizes_[n]; }
+  uint32_t size(Node n) const { return sizes_[n]; }
+
+  uint32_t IntersectionSize(Node a, Node b) const {
+    uint32_t intersection_size = 0;
+    const Node* a_iter = begin(a);
+    const Node* b_iter = begin(b);
+    while (a_iter != end(a) && b_iter != end(b)) {
+      if (*a_iter == *b_iter) {
+        ++intersection_size;
+        ++a_iter;
+        ++b_iter;
+      } else if (*a_iter < *b_iter) {
+        ++a_iter;
+      } else {
+        ++b_iter;
+      }
+    }
+    return intersection_size;
+  }
+
+private:
+  katana::NUMAArray<Node> neighbors_;
+  katana::NUMAArray<uint64_t> begins_;
+  katana::NUMAArray<uint32_t> sizes_;
+};
+
+/// A directed similarity of the result
+struct Neighbor {
+  Node source;
+  Node destination;
+  double similarity;
+};
+
+/// The key of the band of the MinHash signature of n; nodes agree on all rows
+/// of the band if (and, up to hash collisions, only if) their keys are equal.
+/// The signature itself is never stored, since it is num_bands *
+/// rows_per_band words per node.
+uint64_t
+BandKey(
+    const NeighborSets& sets, Node n, size_t band,
+    const SimilarityJoinPlan& plan) {
+  uint64_t key = Mix(band);
+  for (size_t row = band * plan.rows_per_band();
+       row < (band + 1) * plan.rows_per_band(); ++row) {
+    uint64_t row_seed = Mix(row);
+    uint64_t min_hash = std::numeric_limits<uint64_t>::max();
+    for (const Node* it = sets.begin(n); it != sets.end(n); ++it) {
+      min_hash = std::min(min_hash, Mix(*it ^ row_seed));
+    }
+    key = Mix(key ^ min_hash);
+  }
+  return key;
+}
+
+/// Collect the distinct candidate pairs of all bands, each as
+/// (smaller node << 32) | larger node
+std::vector<uint64_t>
+GenerateCandidates(
+    const NeighborSets& sets, size_t num_nodes,
+    const SimilarityJoinPlan& plan) {
+  katana::InsertBag<uint64_t> candidates;
+  std::vector<std::pair<uint64_t, Node>> buckets(num_nodes);
+
+  for (size_t band = 0; band < plan.num_bands(); ++band) {
+    // Nodes without neighbors get the largest key and are never paired.
+    katana::do_all(
+        katana::iterate(size_t{0}, num_nodes),
+        [&](Node n) {
+          uint64_t key = std::numeric_limits<uint64_t>::max();
+          if (sets.size(n) > 0) {
+            key = std::min(
+                BandKey(sets, n, band, plan),
+                std::numeric_limits<uint64_t>::max() - 1);
+          }
+          buckets[n] = {key, n};
+        },
+        katana::steal(), katana::no_stats(), katana::loopname("HashBand"));
+    katana::ParallelSTL::sort(buckets.begin(), buckets.end());
+
+    katana::do_all(
+        katana::iterate(size_t{0}, num_nodes),
+        [&](size_t i) {
+          uint64_t key = buckets[i].first;
+          if (key == std::numeric_limits<uint64_t>::max()) {
+            return;
+          }
+          // Pair with the next max_bucket_size nodes of the bucket
+          size_t end =
+              std::min<size_t>(i + 1 + plan.max_bucket_size(), num_nodes);
+          for (size_t j = i + 1; j < end && buckets[j].first == key; ++j) {
+            Node a = std::min(buckets[i].second, buckets[j].second);
+            Node b = std::max(buckets[i].second, buckets[j].second);
+            candidates.push((uint64_t{a} << 32) | b);
+          }
+        },
+        katana::steal(), katana::no_stats(),
+        katana::loopname("GenerateCandidates"));
+  }
+
+  std::vector<uint64_t> pairs(candidates.begin(), candidates.end());
+  katana::ParallelSTL::sort(pairs.begin(), pairs.end());
+  pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+  return pairs;
+}
+
+katana::Result<std::shared_ptr<arrow::Table>>
+MakeNeighborTable(const std::vector<Neighbor>& neighbors) {
+  int64_t num_rows = neighbors.size();
+  std::shared_ptr<arrow::Buffer> sources =
+      KATANA_CHECKED(arrow::AllocateBuffer(num_rows * sizeof(Node)));
+  std::shared_ptr<arrow::Buffer> destinations =
+      KATANA_CHECKED(arrow::AllocateBuffer(num_rows * sizeof(Node)));
+  std::shared_ptr<arrow::Buffer> similarities =
+      KATANA_CHECKED(arrow::AllocateBuffer(num_rows * sizeof(double)));
+  Node* source_data = reinterpret_cast<Node*>(sources->mutable_data());
+  Node* destination_data =
+      reinterpret_cast<Node*>(destinations->mutable_data());
+  double* similarity_data =
+      reinterpret_cast<double*>(similarities->mutable_data());
+  katana::do_all(
+      katana::iterate(int64_t{0}, num_rows),
+      [&](int64_t i) {
+        source_data[i] = neighbors[i].source;
+        destination_data[i] = neighbors[i].destination;
+        similarity_data[i] = neighbors[i].similarity;
+      },
+      katana::no_stats());
+
+  auto schema = arrow::schema({
+      arrow::field("source", arrow::uint32()),
+      arrow::field("destination", arrow::uint32()),
+      arrow::field("similarity", arrow::float64()),
+  });
+  return arrow::Table::Make(
+      schema,
+      {
+          std::make_shared<arrow::UInt32Array>(num_rows, sources),
+          std::make_shared<arrow::UInt32Array>(num_rows, destinations),
+          std::make_shared<arrow::DoubleArray>(num_rows, similarities),
+      },
+      num_rows);
+}
+
+katana::Result<std::shared_ptr<arrow::Table>>
+SimilarityJoinMinHashLsh(
+    katana::PropertyGraph* pg, uint32_t k, const SimilarityJoinPlan& plan) {
+  const katana::GraphTopology& topology = pg->topology();
+  size_t num_nodes = topology.num_nodes();
+
+  katana::StatTimer exec_time("SimilarityJoin");
+  exec_time.start();
+
+  NeighborSets sets(topology);
+  std::vector<uint64_t> candidates = GenerateCandidates(sets, num_nodes, plan);
+  katana::ReportStatSingle(
+      "SimilarityJoin", "NumCandidates", candidates.size());
+
+  // Verify each candidate once and record it in both directions.
+  std::vector<Neighbor> neighbors(2 * candidates.size());
+  katana::do_all(
+      katana::iterate(size_t{0}, candidates.size()),
+      [&](size_t i) {
+        Node a = candidates[i] >> 32;
+        Node b = candidates[i] & std::numeric_limits<uint32_t>::max();
+        double intersection_size = sets.IntersectionSize(a, b);
+        double a_size = sets.size(a);
+        double b_size = sets.size(b);
+        double similarity;
+        if (plan.measure() == SimilarityJoinPlan::kCosine) {
+          similarity = intersection_size / std::sqrt(a_size * b_size);
+        } else {
+          similarity =
+              intersection_size / (a_size + b_size - intersection_size);
+        }
+        neighbors[2 * i] = Neighbor{a, b, similarity};
+        neighbors[2 * i + 1] = Neighbor{b, a, similarity};
+      },
+      katana::steal(), katana::loopname("VerifyCandidates"));
+
+  katana::ParallelSTL::sort(
+      neighbors.begin(), neighbors.end(),
+      [](const Neighbor& x, const Neighbor& y) {
+        if (x.source != y.source) {
+          return x.source < y.source;
+        }
+        if (x.similarity != y.similarity) {
+          return x.similarity > y.similarity;
+        }
+        return x.destination < y.destination;
+      });
+
+  // Keep the first k positive similarities of each source.
+  std::vector<uint64_t> kept(neighbors.size() + 1);
+  katana::do_all(
+      katana::iterate(size_t{0}, neighbors.size()),
+      [&](size_t i) {
+        kept[i + 1] = neighbors[i].similarity > 0 &&
+                      (i < k || neighbors[i - k].source != neighbors[i].source);
+      },
+      katana::no_stats());
+  katana::ParallelSTL::partial_sum(kept.begin(), kept.end(), kept.begin());
+  std::vector<Neighbor> nearest(kept.back());
+  katana::do_all(
+      katana::iterate(size_t{0}, neighbors.size()),
+      [&](size_t i) {
+        if (kept[i + 1] != kept[i]) {
+          nearest[kept[i]] = neighbors[i];
+        }
+      },
+      katana::no_stats());
+
+  exec_time.stop();
+
+  return MakeNeighborTable(nearest);
+}
+
+}  // namespace
+
+katana::Result<std::shared_ptr<arrow::Table>>
+katana::analytics::SimilarityJoin(
+    katana::PropertyGraph* pg, uint32_t k, SimilarityJoinPlan plan) {
+  if (plan.num_bands() == 0 || plan.rows_per_band() == 0 ||
+      plan.max_bucket_size() < 2) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "bands, rows per band and max bucket size must be at least 1, 1 and "
+        "2");
+  }
+
+  switch (plan.algorithm()) {
+  case SimilarityJoinPlan::kMinHashLsh:
+    return SimilarityJoinMinHashLsh(pg, k, plan);
+  default:
+    return katana::ErrorCode::InvalidArgument;
+  }
+}
@@ -19,6 +19,10 @@
 
 #include "katana/analytics/sssp/sssp.h"
 
+#include <array>
+
+#include <arrow/api.h>
+
 #include "katana/Reduction.h"
 #include "katana/Statistics.h"
 #include "katana/TypedPropertyGraph.h"
@@ -571,6 +575,240 @@ katana::analytics::Sssp(
 
 namespace {
 
+/// Delta-stepping from up to kBatchedSsspLanes sources at once. Distances are
+/// stored node-major with one lane per source so that relaxing an edge for
+/// several sources touches only the adjacent lanes of the destination.
+template <typename Weight>
+struct BatchedSsspImplementation {
+  using Impl = SsspImplementation<Weight>;
+  using Dist = typename Impl::Dist;
+  using EdgeWeight = SsspEdgeWeight<Weight>;
+  using Graph =
+      katana::TypedPropertyGraph<std::tuple<>, std::tuple<EdgeWeight>>;
+  using Node = typename Graph::Node;
+  using LaneMask = uint32_t;
+
+  static_assert(kBatchedSsspLanes <= sizeof(LaneMask) * 8);
+
+  static constexpr Dist kDistanceInfinity = Impl::kDistanceInfinity;
+
+  struct alignas(64) LaneDistances {
+    std::array<std::atomic<Dist>, kBatchedSsspLanes> lanes;
+  };
+
+  /// A node together with the lanes whose distance at the node improved
+  struct LaneRequest {
+    Node src;
+    Dist dist;
+    LaneMask lanes;
+  };
+
+  template <typename OBIMTy>
+  static void DeltaStepAlgo(
+      Graph* graph, const katana::NUMAArray<Weight>& edge_data,
+      katana::NUMAArray<LaneDistances>* node_data,
+      const std::vector<Node>& sources, unsigned step_shift) {
+    katana::InsertBag<LaneRequest> init_bag;
+    for (size_t i = 0; i < sources.size(); ++i) {
+      (*node_data)[sources[i]].lanes[i] = 0;
+      init_bag.push(LaneRequest{sources[i], 0, LaneMask{1} << i});
+    }
+
+    katana::for_each(
+        katana::iterate(init_bag),
+        [&](const LaneRequest& item, auto& ctx) {
+          const auto& sdata = (*node_data)[item.src];
+
+          std::array<Dist, kBatchedSsspLanes> sdist;
+          for (LaneMask m = item.lanes; m != 0; m &= m - 1) {
+            unsigned lane = __builtin_ctz(m);
+            sdist[lane] = sdata.lanes[lane].load(std::memory_order_relaxed);
+          }
+
+          for (auto ii : graph->edges(item.src)) {
+            auto dest = graph->GetEdgeDest(ii);
+            auto& ddata = (*node_data)[*dest];
+            Dist ew = edge_data[ii];
+
+            LaneMask improved = 0;
+            Dist min_dist = kDistanceInfinity;
+            for (LaneMask m = item.lanes; m != 0; m &= m - 1) {
+              unsigned lane = __builtin_ctz(m);
+              Dist new_dist = sdist[lane] + ew;
+              Dist old_dist = katana::atomicMin(ddata.lanes[lane], new_dist);
+              if (new_dist < old_dist) {
+                improved |= LaneMask{1} << lane;
+                min_dist = std::min(min_dist, new_dist);
+              }
+            }
+
+            if (improved != 0) {
+              ctx.push(LaneRequest{*dest, min_dist, improved});
+            }
+          }
+        },
+        katana::wl<OBIMTy>(
+            typename Impl::UpdateRequestIndexer{step_shift}),
+        katana::disable_conflict_detection(),
+        katana::loopname("BatchedSSSP"));
+  }
+
+  static katana::Result<void> Run(
+      katana::PropertyGraph* pg, Graph* graph,
+      const std::vector<uint32_t>& sources,
+      const std::vector<std::string>& output_property_names, SsspPlan plan) {
+    if (plan.algorithm() == SsspPlan::kAutomatic) {
+      plan = SsspPlan(pg);
+    }
+    if (plan.algorithm() != SsspPlan::kDeltaStep &&
+        plan.algorithm() != SsspPlan::kDeltaStepBarrier) {
+      return KATANA_ERROR(
+          katana::ErrorCode::NotImplemented, "Unsupported algorithm: {}",
+          plan.algorithm());
+    }
+
+    size_t approxNodeData = graph->size() * sizeof(LaneDistances);
+    katana::EnsurePreallocated(1, approxNodeData);
+    katana::ReportPageAllocGuard page_alloc;
+
+    katana::NUMAArray<LaneDistances> node_data;
+    katana::NUMAArray<Weight> edge_data;
+    node_data.allocateInterleaved(graph->size());
+    edge_data.allocateInterleaved(graph->num_edges());
+
+    katana::do_all(katana::iterate(*graph), [&](const Node& n) {
+      for (auto e : graph->edges(n)) {
+        edge_data[e] = graph->template GetEdgeData<EdgeWeight>(e);
+      }
+    });
+
+    katana::StatTimer exec_time("BatchedSSSP");
+
+    for (size_t begin = 0; begin < sources.size();
+         begin += kBatchedSsspLanes) {
+      size_t end = std::min<size_t>(sources.size(), begin + kBatchedSsspLanes);
+      std::vector<Node> batch(sources.begin() + begin, sources.begin() + end);
+
+      katana::do_all(
+          katana::iterate(*graph),
+          [&](const Node& n) {
+            for (auto& lane : node_data[n].lanes) {
+              lane.store(kDistanceInfinity, std::memory_order_relaxed);
+            }
+          },
+          katana::no_stats());
+
+      exec_time.start();
+      if (plan.algorithm() == SsspPlan::kDeltaStep) {
+        DeltaStepAlgo<typename Impl::OBIM>(
+            graph, edge_data, &node_data, batch, plan.delta());
+      } else {
+        DeltaStepAlgo<typename Impl::OBIMBarrier>(
+            graph, edge_data, &node_data, batch, plan.delta());
+      }
+      exec_time.stop();
+
+      KATANA_CHECKED(ExtractLanes(
+          pg, node_data, batch.size(),
+          {output_property_names.begin() + begin,
+           output_property_names.begin() + end}));
+    }
+
+    return katana::ResultSuccess();
+  }
+
+  /// Add the first num_lanes lanes of node_data to pg as one column per lane
+  static katana::Result<void> ExtractLanes(
+      katana::PropertyGraph* pg,
+      const katana::NUMAArray<LaneDistances>& node_data, size_t num_lanes,
+      const std::vector<std::string>& names) {
+    using ArrowType = typename arrow::CTypeTraits<Weight>::ArrowType;
+    int64_t num_nodes = node_data.size();
+
+    std::vector<std::shared_ptr<arrow::Field>> fields;
+    std::vector<std::shared_ptr<arrow::Array>> columns;
+    for (size_t lane = 0; lane < num_lanes; ++lane) {
+      std::shared_ptr<arrow::Buffer> buf =
+          KATANA_CHECKED(arrow::AllocateBuffer(num_nodes * sizeof(Weight)));
+      Weight* data = reinterpret_cast<Weight*>(buf->mutable_data());
+      katana::do_all(
+          katana::iterate(int64_t{0}, num_nodes),
+          [&](int64_t n) { data[n] = node_data[n].lanes[lane].load(); },
+          katana::no_stats());
+      fields.emplace_back(arrow::field(
+          names[lane], arrow::TypeTraits<ArrowType>::type_singleton()));
+      columns.emplace_back(
+          std::make_shared<arrow::NumericArray<ArrowType>>(num_nodes, buf));
+    }
+
+    auto table = arrow::Table::Make(arrow::schema(fields), columns, num_nodes);
+    KATANA_CHECKED(pg->AddNodeProperties(table));
+    return katana::ResultSuccess();
+  }
+};
+
+template <typename Weight>
+static katana::Result<void>
+BatchedSsspWithWrap(
+    katana::PropertyGraph* pg, const std::vector<uint32_t>& sources,
+    const std::string& edge_weight_property_name,
+    const std::vector<std::string>& output_property_names, SsspPlan plan) {
+  using Impl = BatchedSsspImplementation<Weight>;
+  auto graph =
+      KATANA_CHECKED(Impl::Graph::Make(pg, {}, {edge_weight_property_name}));
+  return Impl::Run(pg, &graph, sources, output_property_names, plan);
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::BatchedSssp(
+    PropertyGraph* pg, const std::vector<uint32_t>& sources,
+    const std::string& edge_weight_property_name,
+    const std::vector<std::string>& output_property_names, SsspPlan plan) {
+  if (sources.size() != output_property_names.size()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "{} sources but {} output property names", sources.size(),
+        output_property_names.size());
+  }
+  for (auto source : sources) {
+    if (source >= pg->num_nodes()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument, "source {} is not a node",
+          source);
+    }
+  }
+  if (sources.empty()) {
+    return katana::ResultSuccess();
+  }
+
+  switch (pg->GetEdgeProperty(edge_weight_property_name)->type()->id()) {
+  case arrow::UInt32Type::type_id:
+    return BatchedSsspWithWrap<uint32_t>(
+        pg, sources, edge_weight_property_name, output_property_names, plan);
+  case arrow::Int32Type::type_id:
+    return BatchedSsspWithWrap<int32_t>(
+        pg, sources, edge_weight_property_name, output_property_names, plan);
+  case arrow::UInt64Type::type_id:
+    return BatchedSsspWithWrap<uint64_t>(
+        pg, sources, edge_weight_property_name, output_property_names, plan);
+  case arrow::Int64Type::type_id:
+    return BatchedSsspWithWrap<int64_t>(
+        pg, sources, edge_weight_property_name, output_property_names, plan);
+  case arrow::FloatType::type_id:
+    return BatchedSsspWithWrap<float>(
+        pg, sources, edge_weight_property_name, output_property_names, plan);
+  case arrow::DoubleType::type_id:
+    return BatchedSsspWithWrap<double>(
+        pg, sources, edge_weight_property_name, output_property_names, plan);
+  default:
+    return katana::ErrorCode::TypeError;
+  }
+}
+
+namespace {
+
 template <typename Weight>
 static katana::Result<void>
 SsspValidateImpl(
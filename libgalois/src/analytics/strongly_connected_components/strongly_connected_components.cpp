@@ -0,0 +1,596 @@
+/*
+ * This file belongs to the Galois project, a C++ library for exploiting
+ * parallelism. The code is being released under the terms of the 3-Clause BSD
+ * License (a copy is located in LICENSE.txt at the top-level directory).
+ *
+ * Copyright (C) 2018, The University of Texas at Austin. All rights reserved.
+ * UNIVERSITY EXPRESSLY DISCLAIMS ANY AND ALL WARRANTIES CONCERNING THIS
+ * SOFTWARE AND DOCUMENTATION, INCLUDING ANY WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR ANY PARTICULAR PURPOSE, NON-INFRINGEMENT AND WARRANTIES OF
+ * PERFORMANCE, AND ANY WARRANTY THAT MIGHT OTHERWISE ARISE FROM COURSE OF
+ * DEALING OR USAGE OF TRADE.  NO WARRANTY IS EITHER EXPRESS OR IMPLIED WITH
+ * RESPECT TO THE USE OF THE SOFTWARE OR DOCUMENTATION. Under no circumstances
+ * shall University be liable for incidental, special, indirect, direct or
+ * consequential damages or loss of profits, interruption of business, or
+ * related expenses which may arise from use of Software or Documentation,
+ * including but not limited to those resulting from defects in Software and/or
+ * Documentation, or loss or inaccuracy of data of any kind.
+ */
+
+#include "katana/analytics/strongly_connected_components/strongly_connected_components.h"
+
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include "katana/AtomicHelpers.h"
+#include "katana/Bag.h"
+#include "katana/DynamicBitset.h"
+#include "katana/Galois.h"
+#include "katana/NUMAArray.h"
+#include "katana/ParallelSTL.h"
+#include "katana/Reduction.h"
+#include "katana/TypedPropertyGraph.h"
+#include "katana/analytics/Utils.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+using Edge = katana::GraphTopology::Edge;
+
+struct NodeComponent : public katana::PODProperty<uint64_t> {};
+
+using NodeData = std::tuple<NodeComponent>;
+using EdgeData = std::tuple<>;
+using Graph = katana::TypedPropertyGraph<NodeData, EdgeData>;
+
+/// The component of a node that has not been assigned one yet
+constexpr uint64_t kUnassigned = std::numeric_limits<uint64_t>::max();
+
+/// Assigns the nodes of a graph to their strongly connected components. Every
+/// phase only looks at the subgraph induced by the unassigned nodes, and
+/// labels each component it finds with the ID of one of its nodes.
+class SccFinder {
+public:
+  SccFinder(
+      const katana::GraphTopology& topology,
+      const katana::GraphTopology& transpose)
+      : topology_(topology),
+        transpose_(transpose),
+        num_nodes_(topology.num_nodes()) {
+    component_.allocateInterleaved(num_nodes_);
+    colors_.allocateInterleaved(num_nodes_);
+    in_degrees_.allocateInterleaved(num_nodes_);
+    out_degrees_.allocateInterleaved(num_nodes_);
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes_),
+        [&](Node n) {
+          component_[n] = kUnassigned;
+          colors_[n] = 0;
+        },
+        katana::no_stats());
+  }
+
+  void RunMultistep() {
+    Trim();
+    ForwardBackward();
+    Trim();
+    while (ColorRound()) {
+      Trim();
+    }
+  }
+
+  void RunColoring() {
+    Trim();
+    while (ColorRound()) {
+      Trim();
+    }
+  }
+
+  /// Relabel every component with the smallest ID of its nodes.
+  void Normalize() {
+    katana::NUMAArray<std::atomic<Node>> smallest;
+    smallest.allocateInterleaved(num_nodes_);
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes_),
+        [&](Node n) { smallest[n] = std::numeric_limits<Node>::max(); },
+        katana::no_stats());
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes_),
+        [&](Node n) { katana::atomicMin(smallest[component_[n]], n); },
+        katana::no_stats());
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes_),
+        [&](Node n) { component_[n] = smallest[component_[n]]; },
+        katana::no_stats());
+  }
+
+  uint64_t Component(Node n) const { return component_[n]; }
+
+private:
+  bool Assigned(Node n) const { return component_[n] != kUnassigned; }
+
+  /// Make n a component of its own unless it already has one.
+  bool Claim(Node n, uint64_t component) {
+    uint64_t expected = kUnassigned;
+    return component_[n].compare_exchange_strong(expected, component);
+  }
+
+  /// Repeatedly assign the nodes with no incoming or no outgoing edges from
+  /// other unassigned nodes to components of their own. The degrees are
+  /// counted once and decremented as the neighbors are trimmed, so that
+  /// chains are trimmed in time linear in their length.
+  void Trim() {
+    katana::InsertBag<Node> trimmed;
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes_),
+        [&](Node n) {
+          if (Assigned(n)) {
+            return;
+          }
+          in_degrees_[n] = Degree(transpose_, n);
+          out_degrees_[n] = Degree(topology_, n);
+          if (in_degrees_[n] == 0 || out_degrees_[n] == 0) {
+            trimmed.push(n);
+          }
+        },
+        katana::steal(), katana::no_stats());
+
+    katana::for_each(
+        katana::iterate(trimmed),
+        [&](Node n, auto& ctx) {
+          if (!Claim(n, n)) {
+            return;
+          }
+          for (Edge e : topology_.edges(n)) {
+            const Node dest = topology_.edge_dest(e);
+            if (dest != n && !Assigned(dest) &&
+                katana::atomicSub(in_degrees_[dest], int64_t{1}) == 1) {
+              ctx.push(dest);
+            }
+          }
+          for (Edge e : transpose_.edges(n)) {
+            const Node src = transpose_.edge_dest(e);
+            if (src != n && !Assigned(src) &&
+                katana::atomicSub(out_degrees_[src], int64_t{1}) == 1) {
+              ctx.push(src);
+            }
+          }
+        },
+        katana::wl<katana::PerSocketChunkFIFO<64>>(),
+        katana::disable_conflict_detection(), katana::no_stats(),
+        katana::loopname("SCC-Trim"));
+  }
+
+  /// The number of edges of n in topology to other unassigned nodes
+  int64_t Degree(const katana::GraphTopology& topology, Node n) const {
+    int64_t degree = 0;
+    for (Edge e : topology.edges(n)) {
+      const Node neighbor = topology.edge_dest(e);
+      if (neighbor != n && !Assigned(neighbor)) {
+        ++degree;
+      }
+    }
+    return degree;
+  }
+
+  /// Assign the component of the unassigned node with the largest product of
+  /// degrees (as counted by the last trim), which is the nodes reached by
+  /// both a forward and a backward search from it.
+  void ForwardBackward() {
+    katana::GReduceMax<int64_t> max_product;
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes_),
+        [&](Node n) {
+          if (!Assigned(n)) {
+            max_product.update(in_degrees_[n] * out_degrees_[n]);
+          }
+        },
+        katana::no_stats());
+    const int64_t product = max_product.reduce();
+    katana::GReduceMin<Node> pivots;
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes_),
+        [&](Node n) {
+          if (!Assigned(n) && in_degrees_[n] * out_degrees_[n] == product) {
+            pivots.update(n);
+          }
+        },
+        katana::no_stats());
+    const Node pivot = pivots.reduce();
+    if (pivot >= num_nodes_) {
+      return;
+    }
+
+    katana::DynamicBitset forward;
+    katana::DynamicBitset backward;
+    Search(topology_, pivot, &forward);
+    Search(transpose_, pivot, &backward);
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes_),
+        [&](Node n) {
+          if (forward.test(n) && backward.test(n)) {
+            component_[n] = pivot;
+          }
+        },
+        katana::no_stats());
+  }
+
+  /// Mark the unassigned nodes reachable from source in topology.
+  void Search(
+      const katana::GraphTopology& topology, Node source,
+      katana::DynamicBitset* reached) const {
+    reached->resize(num_nodes_);
+    reached->reset();
+    reached->set(source);
+    katana::InsertBag<Node> sources;
+    sources.push(source);
+    katana::for_each(
+        katana::iterate(sources),
+        [&](Node n, auto& ctx) {
+          for (Edge e : topology.edges(n)) {
+            const Node dest = topology.edge_dest(e);
+            if (!Assigned(dest) && !reached->set(dest)) {
+              ctx.push(dest);
+            }
+          }
+        },
+        katana::wl<katana::PerSocketChunkFIFO<64>>(),
+        katana::disable_conflict_detection(), katana::no_stats(),
+        katana::loopname("SCC-Search"));
+  }
+
+  /// Propagate the largest node ID forward until the colors stop changing,
+  /// and assign the components of the nodes that keep their own ID (the
+  /// roots) with a backward search from all roots at once, which does not
+  /// leave the color of its root. Returns false if every node was already
+  /// assigned.
+  bool ColorRound() {
+    katana::InsertBag<Node> changed;
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes_),
+        [&](Node n) {
+          if (!Assigned(n)) {
+            colors_[n] = n;
+            changed.push(n);
+          }
+        },
+        katana::no_stats());
+    if (changed.empty()) {
+      return false;
+    }
+
+    katana::for_each(
+        katana::iterate(changed),
+        [&](Node n, auto& ctx) {
+          const Node color = colors_[n];
+          for (Edge e : topology_.edges(n)) {
+            const Node dest = topology_.edge_dest(e);
+            if (!Assigned(dest) &&
+                katana::atomicMax(colors_[dest], color) < color) {
+              ctx.push(dest);
+            }
+          }
+        },
+        katana::wl<katana::PerSocketChunkFIFO<64>>(),
+        katana::disable_conflict_detection(), katana::no_stats(),
+        katana::loopname("SCC-Color"));
+
+    katana::InsertBag<Node> roots;
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes_),
+        [&](Node n) {
+          if (!Assigned(n) && colors_[n] == n) {
+            component_[n] = n;
+            roots.push(n);
+          }
+        },
+        katana::no_stats());
+
+    // Assigned nodes may have stale colors, so a node joins a component only
+    // if it is unassigned.
+    katana::for_each(
+        katana::iterate(roots),
+        [&](Node n, auto& ctx) {
+          const Node color = colors_[n];
+          for (Edge e : transpose_.edges(n)) {
+            const Node src = transpose_.edge_dest(e);
+            if (colors_[src] == color && Claim(src, color)) {
+              ctx.push(src);
+            }
+          }
+        },
+        katana::wl<katana::PerSocketChunkFIFO<64>>(),
+        katana::disable_conflict_detection(), katana::no_stats(),
+        katana::loopname("SCC-Backward"));
+    return true;
+  }
+
+  const katana::GraphTopology& topology_;
+  const katana::GraphTopology& transpose_;
+  const uint64_t num_nodes_;
+  katana::NUMAArray<std::atomic<uint64_t>> component_;
+  katana::NUMAArray<std::atomic<Node>> colors_;
+  katana::NUMAArray<std::atomic<int64_t>> in_degrees_;
+  katana::NUMAArray<std::atomic<int64_t>> out_degrees_;
+};
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::StronglyConnectedComponents(
+    katana::PropertyGraph* pg, const std::string& output_property_name,
+    StronglyConnectedComponentsPlan plan) {
+  KATANA_CHECKED(
+      ConstructNodeProperties<NodeData>(pg, {output_property_name}));
+  auto graph = KATANA_CHECKED(Graph::Make(pg, {output_property_name}, {}));
+
+  std::unique_ptr<katana::PropertyGraph> transpose =
+      KATANA_CHECKED(katana::CreateTransposeGraphTopology(pg->topology()));
+  SccFinder finder(pg->topology(), transpose->topology());
+  switch (plan.algorithm()) {
+  case StronglyConnectedComponentsPlan::kMultistep:
+    finder.RunMultistep();
+    break;
+  case StronglyConnectedComponentsPlan::kColoring:
+    finder.RunColoring();
+    break;
+  default:
+    return katana::ErrorCode::InvalidArgument;
+  }
+  finder.Normalize();
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](Node n) { graph.GetData<NodeComponent>(n) = finder.Component(n); },
+      katana::no_stats());
+  return katana::ResultSuccess();
+}
+
+namespace {
+
+/// Check that the nodes of every component reach its smallest node, and are
+/// reached from it, through edges of topology inside the component.
+bool
+ComponentsAreConnected(
+    const katana::GraphTopology& topology,
+    const katana::NUMAArray<uint64_t>& components) {
+  katana::DynamicBitset reached;
+  reached.resize(topology.num_nodes());
+  katana::InsertBag<Node> roots;
+  katana::do_all(
+      katana::iterate(topology),
+      [&](Node n) {
+        if (components[n] == n) {
+          reached.set(n);
+          roots.push(n);
+        }
+      },
+      katana::no_stats());
+
+  katana::for_each(
+      katana::iterate(roots),
+      [&](Node n, auto& ctx) {
+        for (Edge e : topology.edges(n)) {
+          const Node dest = topology.edge_dest(e);
+          if (components[dest] == components[n] && !reached.set(dest)) {
+            ctx.push(dest);
+          }
+        }
+      },
+      katana::wl<katana::PerSocketChunkFIFO<64>>(),
+      katana::disable_conflict_detection(), katana::no_stats());
+
+  katana::GReduceLogicalOr unreached;
+  katana::do_all(
+      katana::iterate(topology),
+      [&](Node n) {
+        if (!reached.test(n)) {
+          unreached.update(true);
+        }
+      },
+      katana::no_stats());
+  return !unreached.reduce();
+}
+
+/// Check that the graph of the components, with an edge between two
+/// components if an edge of topology goes from one to the other, has no
+/// cycle, by removing the components without incoming edges repeatedly.
+bool
+ComponentsAreMaximal(
+    const katana::GraphTopology& topology,
+    const katana::NUMAArray<uint64_t>& components) {
+  const uint64_t num_nodes = topology.num_nodes();
+
+  // Group the nodes by component
+  katana::NUMAArray<Edge> member_ends;
+  member_ends.allocateInterleaved(num_nodes);
+  katana::NUMAArray<std::atomic<int64_t>> in_degrees;
+  in_degrees.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](Node n) {
+        member_ends[n] = 0;
+        in_degrees[n] = 0;
+      },
+      katana::no_stats());
+  katana::do_all(
+      katana::iterate(topology),
+      [&](Node n) {
+        __sync_fetch_and_add(&member_ends[components[n]], 1);
+        for (Edge e : topology.edges(n)) {
+          const Node dest = topology.edge_dest(e);
+          if (components[dest] != components[n]) {
+            katana::atomicAdd(in_degrees[components[dest]], int64_t{1});
+          }
+        }
+      },
+      katana::steal(), katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      member_ends.begin(), member_ends.end(), member_ends.begin());
+
+  katana::NUMAArray<Edge> cursors;
+  cursors.allocateInterleaved(num_nodes);
+  katana::NUMAArray<Node> members;
+  members.allocateInterleaved(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](Node n) { cursors[n] = n == 0 ? 0 : member_ends[n - 1]; },
+      katana::no_stats());
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](Node n) {
+        members[__sync_fetch_and_add(&cursors[components[n]], 1)] = n;
+      },
+      katana::no_stats());
+
+  katana::InsertBag<Node> sources;
+  katana::GAccumulator<uint64_t> num_components;
+  katana::do_all(
+      katana::iterate(topology),
+      [&](Node n) {
+        if (components[n] == n) {
+          num_components += 1;
+          if (in_degrees[n] == 0) {
+            sources.push(n);
+          }
+        }
+      },
+      katana::no_stats());
+
+  katana::GAccumulator<uint64_t> num_removed;
+  katana::for_each(
+      katana::iterate(sources),
+      [&](Node component, auto& ctx) {
+        num_removed += 1;
+        const Edge begin = component == 0 ? 0 : member_ends[component - 1];
+        for (Edge i = begin; i < member_ends[component]; ++i) {
+          const Node n = members[i];
+          for (Edge e : topology.edges(n)) {
+            const uint64_t dest = components[topology.edge_dest(e)];
+            if (dest != component &&
+                katana::atomicSub(in_degrees[dest], int64_t{1}) == 1) {
+              ctx.push(dest);
+            }
+          }
+        }
+      },
+      katana::wl<katana::PerSocketChunkFIFO<16>>(),
+      katana::disable_conflict_detection(), katana::no_stats());
+  return num_removed.reduce() == num_components.reduce();
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::StronglyConnectedComponentsAssertValid(
+    katana::PropertyGraph* pg, const std::string& property_name) {
+  auto graph = KATANA_CHECKED(Graph::Make(pg, {property_name}, {}));
+
+  katana::NUMAArray<uint64_t> components;
+  components.allocateInterleaved(pg->num_nodes());
+  katana::do_all(
+      katana::iterate(graph),
+      [&](Node n) { components[n] = graph.GetData<NodeComponent>(n); },
+      katana::no_stats());
+
+  katana::GReduceLogicalOr bad_id;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](Node n) {
+        if (components[n] > n || components[components[n]] != components[n]) {
+          bad_id.update(true);
+        }
+      },
+      katana::no_stats());
+  if (bad_id.reduce()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AssertionFailed,
+        "the ID of a component must be the smallest ID of its nodes");
+  }
+
+  std::unique_ptr<katana::PropertyGraph> transpose =
+      KATANA_CHECKED(katana::CreateTransposeGraphTopology(pg->topology()));
+  if (!ComponentsAreConnected(pg->topology(), components) ||
+      !ComponentsAreConnected(transpose->topology(), components)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AssertionFailed,
+        "a component is not strongly connected");
+  }
+  if (!ComponentsAreMaximal(pg->topology(), components)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AssertionFailed,
+        "some components are strongly connected to each other");
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<StronglyConnectedComponentsStatistics>
+katana::analytics::StronglyConnectedComponentsStatistics::Compute(
+    katana::PropertyGraph* pg, const std::string& property_name) {
+  auto graph = KATANA_CHECKED(Graph::Make(pg, {property_name}, {}));
+
+  katana::NUMAArray<std::atomic<uint64_t>> sizes;
+  sizes.allocateInterleaved(pg->num_nodes());
+  katana::do_all(
+      katana::iterate(graph), [&](Node n) { sizes[n] = 0; },
+      katana::no_stats());
+
+  katana::GReduceLogicalOr bad_id;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](Node n) {
+        const uint64_t component = graph.GetData<NodeComponent>(n);
+        if (component >= pg->num_nodes()) {
+          bad_id.update(true);
+          return;
+        }
+        katana::atomicAdd(sizes[component], uint64_t{1});
+      },
+      katana::no_stats());
+  if (bad_id.reduce()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "component IDs must be node IDs");
+  }
+
+  katana::GAccumulator<uint64_t> total_components;
+  katana::GAccumulator<uint64_t> total_non_trivial_components;
+  katana::GReduceMax<uint64_t> largest_component_size;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](Node n) {
+        const uint64_t size = sizes[n];
+        if (size > 0) {
+          total_components += 1;
+        }
+        if (size > 1) {
+          total_non_trivial_components += 1;
+        }
+        largest_component_size.update(size);
+      },
+      katana::no_stats());
+
+  const uint64_t largest = largest_component_size.reduce();
+  return StronglyConnectedComponentsStatistics{
+      total_components.reduce(), total_non_trivial_components.reduce(),
+      largest,
+      pg->num_nodes() == 0
+          ? 0.0
+          : static_cast<double>(largest) / pg->num_nodes()};
+}
+
+void
+katana::analytics::StronglyConnectedComponentsStatistics::Print(
+    std::ostream& os) const {
+  os << "Total number of components = " << total_components << std::endl;
+  os << "Total non-trivial components = " << total_non_trivial_components
+     << std::endl;
+  os << "Number of nodes in the largest component = "
+     << largest_component_size << std::endl;
+  os << "Ratio of nodes in the largest component = "
+     << largest_component_ratio << std::endl;
+}
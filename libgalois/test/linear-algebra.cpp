@@ -0,0 +1,175 @@
+#include "katana/LinearAlgebra.h"
+
+#include <limits>
+#include <vector>
+
+#include "katana/Galois.h"
+#include "katana/Logging.h"
+#include "katana/SharedMemSys.h"
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+using Edge = katana::GraphTopology::Edge;
+
+template <typename T>
+katana::NUMAArray<T>
+MakeArray(const std::vector<T>& values) {
+  katana::NUMAArray<T> array;
+  array.allocateInterleaved(values.size());
+  std::copy(values.begin(), values.end(), array.begin());
+  return array;
+}
+
+template <typename T>
+std::vector<T>
+ToVector(const katana::NUMAArray<T>& array) {
+  return std::vector<T>(array.begin(), array.end());
+}
+
+/// Make the graph 0 -> {1, 2}, 1 -> 3, 2 -> 3, 3 -> 4 with an isolated
+/// node 5
+katana::GraphTopology
+MakeDiamond() {
+  return katana::GraphTopology(
+      MakeArray<Edge>({2, 3, 4, 5, 5, 5}), MakeArray<Node>({1, 2, 3, 3, 4}));
+}
+
+void
+TestMxV() {
+  auto A = MakeDiamond();
+  auto x = MakeArray<int>({1, 2, 3, 4, 5, 6});
+  auto y = MakeArray<int>({0, 0, 0, 0, 0, 0});
+
+  katana::MxV<katana::PlusTimesSemiring<int>>(A, x, &y);
+  KATANA_LOG_ASSERT(ToVector(y) == std::vector<int>({5, 4, 4, 5, 0, 0}));
+
+  katana::DynamicBitset bits;
+  bits.resize(A.num_nodes());
+  bits.set(0);
+  katana::MxV<katana::MinSecondSemiring<int>>(
+      A, x, &y, katana::Mask::Complement(bits));
+  constexpr int kZero = katana::MinSecondSemiring<int>::Zero();
+  KATANA_LOG_ASSERT(
+      ToVector(y) == std::vector<int>({5, 4, 4, 5, kZero, kZero}));
+}
+
+/// The reduction of a row only stops early at the lowest value of the type,
+/// which for floating point types is not min()
+void
+TestMinSecondFloat() {
+  using Semiring = katana::MinSecondSemiring<float>;
+
+  auto A = MakeDiamond();
+  constexpr float kMin = std::numeric_limits<float>::min();
+  auto x = MakeArray<float>({0, kMin, -2.5, -1, 3, 0});
+  auto y = MakeArray<float>({0, 0, 0, 0, 0, 0});
+
+  katana::MxV<Semiring>(A, x, &y);
+  constexpr float kZero = Semiring::Zero();
+  KATANA_LOG_ASSERT(
+      ToVector(y) == std::vector<float>({-2.5, -1, -1, 3, kZero, kZero}));
+}
+
+void
+TestVxMDense() {
+  auto A = MakeDiamond();
+  auto x = MakeArray<int>({1, 1, 1, 1, 1, 1});
+  auto y = MakeArray<int>({7, 7, 7, 7, 7, 7});
+
+  katana::DynamicBitset bits;
+  bits.resize(A.num_nodes());
+  bits.set(3);
+  katana::VxM<katana::PlusTimesSemiring<int>>(
+      x, A, &y, katana::Mask::Of(bits));
+  KATANA_LOG_ASSERT(ToVector(y) == std::vector<int>({7, 7, 7, 2, 7, 7}));
+
+  katana::VxM<katana::PlusTimesSemiring<int>>(x, A, &y);
+  KATANA_LOG_ASSERT(ToVector(y) == std::vector<int>({0, 1, 1, 2, 1, 0}));
+
+  using MinPlus = katana::MinPlusSemiring<uint32_t>;
+  std::vector<uint32_t> weights{1, 5, 1, 1, 1};
+  auto distances = MakeArray<uint32_t>(
+      {0, MinPlus::Zero(), MinPlus::Zero(), MinPlus::Zero(), MinPlus::Zero(),
+       MinPlus::Zero()});
+  auto next = MakeArray<uint32_t>({0, 0, 0, 0, 0, 0});
+  katana::VxM<MinPlus>(
+      distances, A, &next, katana::Mask(),
+      katana::ArrayValues<uint32_t>(weights.data()));
+  KATANA_LOG_ASSERT(
+      ToVector(next) ==
+      std::vector<uint32_t>(
+          {MinPlus::Zero(), 1, 5, MinPlus::Zero(), MinPlus::Zero(),
+           MinPlus::Zero()}));
+}
+
+/// Check the levels of a BFS from 0 computed with sparse products
+void
+TestVxMSparse() {
+  using Semiring = katana::LogicalOrAndSemiring;
+
+  auto A = MakeDiamond();
+  katana::DynamicBitset visited;
+  visited.resize(A.num_nodes());
+  visited.set(0);
+
+  katana::SparseVector<uint8_t> frontier;
+  frontier.push_back(0, 1);
+  std::vector<std::vector<Node>> levels;
+  while (!frontier.empty()) {
+    katana::SparseVector<uint8_t> next;
+    katana::VxM<Semiring>(
+        frontier, A, &next, katana::Mask::Complement(visited));
+    for (Node n : next.indices) {
+      visited.set(n);
+    }
+    if (!next.empty()) {
+      levels.emplace_back(next.indices);
+      KATANA_LOG_ASSERT(katana::Reduce<Semiring>(next) == 1);
+    }
+    frontier = std::move(next);
+  }
+
+  KATANA_LOG_ASSERT(levels.size() == 3);
+  KATANA_LOG_ASSERT(levels[0] == std::vector<Node>({1, 2}));
+  KATANA_LOG_ASSERT(levels[1] == std::vector<Node>({3}));
+  KATANA_LOG_ASSERT(levels[2] == std::vector<Node>({4}));
+}
+
+void
+TestConversions() {
+  using Semiring = katana::PlusTimesSemiring<int>;
+
+  auto x = MakeArray<int>({0, 3, 0, 0, 4, 0});
+  katana::SparseVector<int> sparse;
+  katana::ToSparse<Semiring>(x, &sparse);
+  KATANA_LOG_ASSERT(sparse.indices == std::vector<Node>({1, 4}));
+  KATANA_LOG_ASSERT(sparse.values == std::vector<int>({3, 4}));
+  KATANA_LOG_ASSERT(katana::Reduce<Semiring>(sparse) == 7);
+
+  auto y = MakeArray<int>({1, 1, 1, 1, 1, 1});
+  katana::ToDense<Semiring>(sparse, &y);
+  KATANA_LOG_ASSERT(ToVector(y) == ToVector(x));
+
+  katana::DynamicBitset bits;
+  bits.resize(x.size());
+  bits.set(1);
+  KATANA_LOG_ASSERT(katana::Reduce<Semiring>(x) == 7);
+  KATANA_LOG_ASSERT(katana::Reduce<Semiring>(x, katana::Mask::Of(bits)) == 3);
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+  katana::setActiveThreads(2);
+
+  TestMxV();
+  TestMinSecondFloat();
+  TestVxMDense();
+  TestVxMSparse();
+  TestConversions();
+
+  return 0;
+}
@@ -0,0 +1,241 @@
+#include <arrow/api.h>
+#include <arrow/array/concatenate.h>
+#include <boost/filesystem.hpp>
+
+#include "katana/Logging.h"
+#include "katana/PropertyExport.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/URI.h"
+#include "tsuba/ArrowIPC.h"
+#include "tsuba/ParquetReader.h"
+
+namespace {
+
+namespace fs = boost::filesystem;
+
+constexpr uint32_t kNumNodes = 10;
+
+// Node n has edges to n + 1 and n + 2, modulo kNumNodes, except the last node,
+// which has none
+std::unique_ptr<katana::PropertyGraph>
+MakeGraph() {
+  std::vector<uint64_t> indices;
+  std::vector<uint32_t> dests;
+  for (uint32_t n = 0; n < kNumNodes; ++n) {
+    if (n + 1 < kNumNodes) {
+      dests.emplace_back((n + 1) % kNumNodes);
+      dests.emplace_back((n + 2) % kNumNodes);
+    }
+    indices.emplace_back(dests.size());
+  }
+  katana::GraphTopology topo{
+      indices.data(), indices.size(), dests.data(), dests.size()};
+  auto g_res = katana::PropertyGraph::Make(std::move(topo));
+  KATANA_LOG_ASSERT(g_res);
+  std::unique_ptr<katana::PropertyGraph> g = std::move(g_res.value());
+
+  arrow::Int64Builder values;
+  for (uint32_t n = 0; n < kNumNodes; ++n) {
+    KATANA_LOG_ASSERT(values.Append(n * 10).ok());
+  }
+  arrow::UInt32Builder weights;
+  for (uint64_t e = 0; e < g->num_edges(); ++e) {
+    KATANA_LOG_ASSERT(weights.Append(e * 3).ok());
+  }
+  auto node_table = arrow::Table::Make(
+      arrow::schema({arrow::field("value", arrow::int64())}),
+      {values.Finish().ValueOrDie()});
+  auto edge_table = arrow::Table::Make(
+      arrow::schema({arrow::field("weight", arrow::uint32())}),
+      {weights.Finish().ValueOrDie()});
+  KATANA_LOG_ASSERT(g->AddNodeProperties(node_table));
+  KATANA_LOG_ASSERT(g->AddEdgeProperties(edge_table));
+  return g;
+}
+
+/// Read back the files of an export and concatenate them
+std::shared_ptr<arrow::Table>
+ReadExport(
+    const std::string& prefix, katana::ExportOptions::Format format,
+    size_t expected_files) {
+  std::vector<std::shared_ptr<arrow::Table>> tables;
+  for (size_t i = 0; i < expected_files; ++i) {
+    auto uri_res = katana::Uri::Make(prefix + fmt::format(".{:06}", i));
+    KATANA_LOG_ASSERT(uri_res);
+    std::shared_ptr<arrow::Table> table;
+    if (format == katana::ExportOptions::Format::kParquet) {
+      auto reader_res = tsuba::ParquetReader::Make();
+      KATANA_LOG_ASSERT(reader_res);
+      auto table_res = reader_res.value()->ReadTable(uri_res.value());
+      KATANA_LOG_VASSERT(table_res, "reading {}", uri_res.value());
+      table = table_res.value();
+    } else {
+      auto table_res = tsuba::ReadArrowIPC(uri_res.value());
+      KATANA_LOG_VASSERT(table_res, "reading {}", uri_res.value());
+      table = table_res.value();
+    }
+    tables.emplace_back(table);
+  }
+  KATANA_LOG_ASSERT(
+      !fs::exists(prefix + fmt::format(".{:06}", expected_files)));
+  return arrow::ConcatenateTables(tables).ValueOrDie();
+}
+
+std::string
+FormatSuffix(katana::ExportOptions::Format format) {
+  return format == katana::ExportOptions::Format::kParquet ? ".parquet"
+                                                           : ".arrow";
+}
+
+template <typename ArrayType>
+std::shared_ptr<ArrayType>
+Column(const std::shared_ptr<arrow::Table>& table, const std::string& name) {
+  auto column = table->GetColumnByName(name);
+  KATANA_LOG_VASSERT(column, "no column {}", name);
+  auto flat = arrow::Concatenate(column->chunks()).ValueOrDie();
+  return std::static_pointer_cast<ArrayType>(flat);
+}
+
+void
+TestExportNodes(const std::string& dir, katana::ExportOptions::Format format) {
+  auto g = MakeGraph();
+  std::string prefix = dir + "/nodes" + FormatSuffix(format);
+
+  katana::ExportOptions opts;
+  opts.format = format;
+  opts.rows_per_file = 3;
+  auto res = katana::ExportNodeProperties(*g, {"value"}, prefix, opts);
+  KATANA_LOG_VASSERT(res, "exporting nodes: {}", res.error());
+
+  auto table = ReadExport(prefix, format, 4);
+  KATANA_LOG_ASSERT(table->num_rows() == kNumNodes);
+  KATANA_LOG_ASSERT(table->schema()->field(0)->name() == "id");
+  auto ids = Column<arrow::UInt32Array>(table, "id");
+  auto values = Column<arrow::Int64Array>(table, "value");
+  for (uint32_t n = 0; n < kNumNodes; ++n) {
+    KATANA_LOG_ASSERT(ids->Value(n) == n);
+    KATANA_LOG_ASSERT(values->Value(n) == n * 10);
+  }
+}
+
+void
+TestExportEdges(const std::string& dir, katana::ExportOptions::Format format) {
+  auto g = MakeGraph();
+  std::string prefix = dir + "/edges" + FormatSuffix(format);
+
+  // Import ids are written instead of local ids when the graph has them
+  arrow::UInt64Builder user_ids;
+  for (uint32_t n = 0; n < kNumNodes; ++n) {
+    KATANA_LOG_ASSERT(user_ids.Append(1000 + n).ok());
+  }
+  g->set_local_to_user_id(
+      std::make_shared<arrow::ChunkedArray>(user_ids.Finish().ValueOrDie()));
+
+  katana::ExportOptions opts;
+  opts.format = format;
+  opts.rows_per_file = 4;
+  opts.max_concurrent_files = 2;
+  auto res = katana::ExportEdgeProperties(*g, {"weight"}, prefix, opts);
+  KATANA_LOG_VASSERT(res, "exporting edges: {}", res.error());
+
+  uint64_t num_edges = g->num_edges();
+  auto table = ReadExport(prefix, format, (num_edges + 3) / 4);
+  KATANA_LOG_ASSERT(table->num_rows() == static_cast<int64_t>(num_edges));
+  auto sources = Column<arrow::UInt64Array>(table, "source");
+  auto dests = Column<arrow::UInt64Array>(table, "destination");
+  auto weights = Column<arrow::UInt32Array>(table, "weight");
+  for (uint32_t n = 0; n < kNumNodes; ++n) {
+    for (auto e : g->topology().edges(n)) {
+      KATANA_LOG_ASSERT(sources->Value(e) == 1000 + n);
+      KATANA_LOG_ASSERT(dests->Value(e) == 1000 + g->topology().edge_dest(e));
+      KATANA_LOG_ASSERT(weights->Value(e) == e * 3);
+    }
+  }
+}
+
+void
+TestExportWithoutIDs(const std::string& dir) {
+  auto g = MakeGraph();
+  std::string prefix = dir + "/no-ids";
+
+  katana::ExportOptions opts;
+  opts.include_ids = false;
+  auto res = katana::ExportNodeProperties(*g, {"value"}, prefix, opts);
+  KATANA_LOG_ASSERT(res);
+
+  auto table = ReadExport(prefix, opts.format, 1);
+  KATANA_LOG_ASSERT(table->num_columns() == 1);
+  KATANA_LOG_ASSERT(table->num_rows() == kNumNodes);
+}
+
+/// A graph without nodes still exports one file of each kind, including when
+/// its import ids are stored in no chunks at all
+void
+TestExportEmpty(const std::string& dir) {
+  auto g_res = katana::PropertyGraph::Make(katana::GraphTopology{});
+  KATANA_LOG_ASSERT(g_res);
+  std::unique_ptr<katana::PropertyGraph> g = std::move(g_res.value());
+  KATANA_LOG_ASSERT(g->AddNodeProperties(arrow::Table::Make(
+      arrow::schema({arrow::field("value", arrow::int64())}),
+      {arrow::Int64Builder().Finish().ValueOrDie()})));
+  KATANA_LOG_ASSERT(g->AddEdgeProperties(arrow::Table::Make(
+      arrow::schema({arrow::field("weight", arrow::uint32())}),
+      {arrow::UInt32Builder().Finish().ValueOrDie()})));
+  g->set_local_to_user_id(std::make_shared<arrow::ChunkedArray>(
+      arrow::ArrayVector{}, arrow::uint64()));
+
+  std::string node_prefix = dir + "/empty-nodes";
+  auto node_res = katana::ExportNodeProperties(*g, {"value"}, node_prefix);
+  KATANA_LOG_VASSERT(node_res, "exporting nodes: {}", node_res.error());
+  auto format = katana::ExportOptions::Defaults().format;
+  auto nodes = ReadExport(node_prefix, format, 1);
+  KATANA_LOG_ASSERT(nodes->num_rows() == 0);
+  KATANA_LOG_ASSERT(
+      nodes->schema()->GetFieldByName("id")->type()->Equals(arrow::uint64()));
+
+  std::string edge_prefix = dir + "/empty-edges";
+  auto edge_res = katana::ExportEdgeProperties(*g, {"weight"}, edge_prefix);
+  KATANA_LOG_VASSERT(edge_res, "exporting edges: {}", edge_res.error());
+  auto edges = ReadExport(edge_prefix, format, 1);
+  KATANA_LOG_ASSERT(edges->num_rows() == 0);
+  KATANA_LOG_ASSERT(edges->num_columns() == 3);
+}
+
+void
+TestBadArguments(const std::string& dir) {
+  auto g = MakeGraph();
+
+  KATANA_LOG_ASSERT(
+      !katana::ExportNodeProperties(*g, {"missing"}, dir + "/missing"));
+
+  katana::ExportOptions opts;
+  opts.rows_per_file = 0;
+  KATANA_LOG_ASSERT(
+      !katana::ExportNodeProperties(*g, {"value"}, dir + "/zero", opts));
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+
+  auto uri_res = katana::Uri::MakeRand("/tmp/propertyexport");
+  KATANA_LOG_ASSERT(uri_res);
+  std::string dir(uri_res.value().path());
+  fs::create_directories(dir);
+
+  for (auto format :
+       {katana::ExportOptions::Format::kParquet,
+        katana::ExportOptions::Format::kArrowIPC}) {
+    TestExportNodes(dir, format);
+    TestExportEdges(dir, format);
+  }
+  TestExportWithoutIDs(dir);
+  TestExportEmpty(dir);
+  TestBadArguments(dir);
+
+  fs::remove_all(dir);
+  return 0;
+}
@@ -6,6 +6,8 @@
 #include "katana/PropertyGraph.h"
 #include "katana/SharedMemSys.h"
 #include "katana/URI.h"
+#include "katana/analytics/sssp/sssp.h"
+#include "tsuba/ArrowIPC.h"
 
 namespace {
 
@@ -126,6 +128,68 @@ TestRoundTrip() {
   }
 }
 
+/// Properties stored as Arrow IPC are loaded into mutable buffers, so
+/// algorithms can use them like any other property, and writes to them do not
+/// reach the stored files
+void
+TestArrowIPCRoundTrip() {
+  constexpr size_t test_length = 20;
+
+  RandomPolicy policy{2};
+  auto g = MakeFileGraph<uint32_t>(test_length, 0, &policy);
+  KATANA_LOG_ASSERT(
+      g->AddNodeProperties(MakeProps<int32_t>("value", test_length)));
+  KATANA_LOG_ASSERT(
+      g->AddEdgeProperties(MakeProps<uint32_t>("weight", g->num_edges())));
+  KATANA_LOG_ASSERT(g->MarkNodePropertiesPersistent({"value"}));
+  KATANA_LOG_ASSERT(g->MarkEdgePropertiesPersistent({"weight"}));
+  KATANA_LOG_ASSERT(
+      g->SetNodePropertyFormat("value", tsuba::PropertyFormat::kArrowIPC));
+  KATANA_LOG_ASSERT(
+      g->SetEdgePropertyFormat("weight", tsuba::PropertyFormat::kArrowIPC));
+
+  auto uri_res = katana::Uri::MakeRand("/tmp/propertyfilegraph");
+  KATANA_LOG_ASSERT(uri_res);
+  std::string rdg_dir(uri_res.value().path());  // path() because local
+  if (auto res = g->Write(rdg_dir, command_line); !res) {
+    fs::remove_all(rdg_dir);
+    KATANA_LOG_FATAL("writing result: {}", res.error());
+  }
+
+  auto make_result =
+      katana::PropertyGraph::Make(rdg_dir, tsuba::RDGLoadOptions());
+  KATANA_LOG_VASSERT(make_result, "making result: {}", make_result.error());
+  std::unique_ptr<katana::PropertyGraph> g2 = std::move(make_result.value());
+  KATANA_LOG_ASSERT(g2->GetEdgeProperty("weight")->Equals(
+      *g->GetEdgeProperty("weight")));
+
+  auto sssp_res = katana::analytics::Sssp(g.get(), 0, "weight", "dist");
+  KATANA_LOG_VASSERT(sssp_res, "sssp: {}", sssp_res.error());
+  sssp_res = katana::analytics::Sssp(g2.get(), 0, "weight", "dist");
+  KATANA_LOG_VASSERT(sssp_res, "sssp on loaded graph: {}", sssp_res.error());
+  KATANA_LOG_ASSERT(
+      g2->GetNodeProperty("dist")->Equals(*g->GetNodeProperty("dist")));
+
+  // Write to a loaded property in place
+  auto values_res = g2->GetNodePropertyTyped<int32_t>("value");
+  KATANA_LOG_ASSERT(values_res);
+  auto view_res = katana::PODPropertyView<int32_t>::Make(*values_res.value());
+  KATANA_LOG_ASSERT(view_res);
+  katana::PODPropertyView<int32_t> view = std::move(view_res.value());
+  view.GetValue(0) = -1;
+  KATANA_LOG_ASSERT(values_res.value()->Value(0) == -1);
+
+  // The stored file is unchanged
+  auto reload_result =
+      katana::PropertyGraph::Make(rdg_dir, tsuba::RDGLoadOptions());
+  fs::remove_all(rdg_dir);
+  KATANA_LOG_ASSERT(reload_result);
+  auto reloaded_res =
+      reload_result.value()->GetNodePropertyTyped<int32_t>("value");
+  KATANA_LOG_ASSERT(reloaded_res);
+  KATANA_LOG_ASSERT(reloaded_res.value()->Value(0) == 0);
+}
+
 void
 TestGarbageMetadata() {
   auto uri_res = katana::Uri::MakeRand("/tmp/propertyfilegraph");
@@ -252,6 +316,7 @@ main(int argc, char** argv) {
   command_line = cmdout.str();
 
   TestRoundTrip();
+  TestArrowIPCRoundTrip();
   TestGarbageMetadata();
   TestSimplePGs();
   TestTopologyAccess();
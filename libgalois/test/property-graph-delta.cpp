@@ -0,0 +1,275 @@
+#include <arrow/api.h>
+#include <boost/filesystem.hpp>
+
+#include "TestTypedPropertyGraph.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/PropertyGraphDelta.h"
+#include "katana/SharedMemSys.h"
+#include "katana/URI.h"
+
+namespace {
+
+namespace fs = boost::filesystem;
+
+using Node = katana::PropertyGraphDelta::Node;
+
+std::shared_ptr<arrow::Table>
+MakeProps(const std::string& name, const std::vector<int64_t>& values) {
+  arrow::Int64Builder builder;
+  KATANA_LOG_ASSERT(builder.AppendValues(values).ok());
+  std::shared_ptr<arrow::Array> array;
+  KATANA_LOG_ASSERT(builder.Finish(&array).ok());
+  return arrow::Table::Make(
+      arrow::schema({arrow::field(name, arrow::int64())}), {array});
+}
+
+std::vector<int64_t>
+PropValues(const std::shared_ptr<arrow::ChunkedArray>& property) {
+  KATANA_LOG_ASSERT(property->num_chunks() == 1);
+  auto data = std::static_pointer_cast<arrow::Int64Array>(property->chunk(0));
+  std::vector<int64_t> values;
+  for (int64_t i = 0; i < data->length(); ++i) {
+    values.emplace_back(data->IsNull(i) ? -1 : data->Value(i));
+  }
+  return values;
+}
+
+std::vector<std::vector<Node>>
+Adjacency(const katana::PropertyGraph& g) {
+  std::vector<std::vector<Node>> adjacency(g.num_nodes());
+  for (Node n : g) {
+    for (auto e : g.edges(n)) {
+      adjacency[n].emplace_back(g.topology().edge_dest(e));
+    }
+  }
+  return adjacency;
+}
+
+/// Make the graph 0 -> 1 -> 2 -> 3 -> 4 -> 0 where node n and edge n have
+/// the property value n.
+std::unique_ptr<katana::PropertyGraph>
+MakeCycle() {
+  constexpr size_t num_nodes = 5;
+  LinePolicy policy{1};
+  auto g = MakeFileGraph<int64_t>(num_nodes, 0, &policy);
+
+  std::vector<int64_t> values{0, 1, 2, 3, 4};
+  KATANA_LOG_ASSERT(g->AddNodeProperties(MakeProps("value", values)));
+  KATANA_LOG_ASSERT(g->AddEdgeProperties(MakeProps("weight", values)));
+  return g;
+}
+
+void
+TestMerge() {
+  auto g = MakeCycle();
+  katana::PropertyGraphDelta delta(g.get());
+
+  auto add_nodes_res = delta.AddNodes(1, MakeProps("value", {10}));
+  KATANA_LOG_ASSERT(add_nodes_res);
+  Node new_node = add_nodes_res.value();
+  KATANA_LOG_ASSERT(new_node == 5);
+
+  KATANA_LOG_ASSERT(delta.AddEdges(
+      {new_node, 0}, {0, new_node}, MakeProps("weight", {50, 51})));
+  KATANA_LOG_ASSERT(delta.AddEdges({new_node}, {1}));
+  KATANA_LOG_ASSERT(delta.RemoveEdges(std::vector<uint64_t>{2}));
+  KATANA_LOG_ASSERT(delta.RemoveNodes({4}));
+
+  // Nothing is visible until the merge
+  KATANA_LOG_ASSERT(g->num_nodes() == 5 && g->num_edges() == 5);
+  KATANA_LOG_ASSERT(delta.HasUpdates());
+  KATANA_LOG_ASSERT(delta.IsEdgeRemoved(2));
+  KATANA_LOG_ASSERT(delta.IsEdgeRemoved(3));
+  KATANA_LOG_ASSERT(!delta.IsEdgeRemoved(0));
+
+  // Out neighbors combine the graph and the pending updates
+  auto out_neighbors = [&delta](Node n) {
+    std::vector<Node> neighbors;
+    delta.ForEachOutNeighbor(n, [&](Node dst) { neighbors.emplace_back(dst); });
+    return neighbors;
+  };
+  KATANA_LOG_ASSERT(out_neighbors(0) == std::vector<Node>({1, new_node}));
+  KATANA_LOG_ASSERT(out_neighbors(2).empty());
+  KATANA_LOG_ASSERT(out_neighbors(3).empty());
+  KATANA_LOG_ASSERT(out_neighbors(4).empty());
+  KATANA_LOG_ASSERT(out_neighbors(new_node) == std::vector<Node>({0, 1}));
+
+  // Inserting more edges regroups the inserted edges on the next query
+  KATANA_LOG_ASSERT(delta.AddEdges({0}, {2}));
+  KATANA_LOG_ASSERT(out_neighbors(0) == std::vector<Node>({1, new_node, 2}));
+
+  auto merge_res = delta.Merge();
+  if (!merge_res) {
+    KATANA_LOG_FATAL("merging: {}", merge_res.error());
+  }
+  const auto& new_ids = merge_res.value();
+  KATANA_LOG_ASSERT(new_ids.size() == 6);
+  KATANA_LOG_ASSERT(new_ids[4] == katana::PropertyGraphDelta::kRemovedNode);
+  KATANA_LOG_ASSERT(new_ids[5] == 4);
+  KATANA_LOG_ASSERT(!delta.HasUpdates());
+
+  std::vector<std::vector<Node>> expected_adjacency{
+      {1, 4, 2}, {2}, {}, {}, {0, 1}};
+  KATANA_LOG_ASSERT(Adjacency(*g) == expected_adjacency);
+
+  std::vector<int64_t> expected_values{0, 1, 2, 3, 10};
+  KATANA_LOG_ASSERT(PropValues(g->GetNodeProperty("value")) == expected_values);
+  std::vector<int64_t> expected_weights{0, 51, -1, 1, 50, -1};
+  KATANA_LOG_ASSERT(
+      PropValues(g->GetEdgeProperty("weight")) == expected_weights);
+}
+
+void
+TestErrors() {
+  auto g = MakeCycle();
+  katana::PropertyGraphDelta delta(g.get());
+
+  KATANA_LOG_ASSERT(!delta.AddEdges({0}, {5}));
+  KATANA_LOG_ASSERT(!delta.AddEdges({0, 1}, {2}));
+  KATANA_LOG_ASSERT(!delta.AddEdges({0}, {1}, MakeProps("noexist", {1})));
+  KATANA_LOG_ASSERT(!delta.AddNodes(2, MakeProps("value", {1})));
+  KATANA_LOG_ASSERT(!delta.RemoveEdges(std::vector<uint64_t>{5}));
+  KATANA_LOG_ASSERT(!delta.HasUpdates());
+}
+
+/// A failed ReplaceTopology leaves the topology and properties unchanged
+void
+TestReplaceTopologyFails() {
+  auto g = MakeCycle();
+  auto expected_adjacency = Adjacency(*g);
+
+  std::vector<uint64_t> indices{1, 1};
+  std::vector<Node> dests{1};
+  katana::GraphTopology topology{
+      indices.data(), indices.size(), dests.data(), dests.size()};
+  auto weights = MakeProps("weight", {1});
+  auto duplicate_weights = arrow::Table::Make(
+      arrow::schema(
+          {arrow::field("weight", arrow::int64()),
+           arrow::field("weight", arrow::int64())}),
+      {weights->column(0), weights->column(0)});
+  KATANA_LOG_ASSERT(!g->ReplaceTopology(
+      std::move(topology), MakeProps("value", {7, 8}), duplicate_weights));
+
+  KATANA_LOG_ASSERT(Adjacency(*g) == expected_adjacency);
+  std::vector<int64_t> expected_values{0, 1, 2, 3, 4};
+  KATANA_LOG_ASSERT(PropValues(g->GetNodeProperty("value")) == expected_values);
+  KATANA_LOG_ASSERT(
+      PropValues(g->GetEdgeProperty("weight")) == expected_values);
+}
+
+void
+TestCommit() {
+  auto g = MakeCycle();
+  g->MarkAllPropertiesPersistent();
+
+  auto uri_res = katana::Uri::MakeRand("/tmp/propertygraphdelta");
+  KATANA_LOG_ASSERT(uri_res);
+  std::string rdg_dir(uri_res.value().path());  // path() because local
+
+  if (auto res = g->Write(rdg_dir, ""); !res) {
+    fs::remove_all(rdg_dir);
+    KATANA_LOG_FATAL("writing result: {}", res.error());
+  }
+
+  katana::PropertyGraphDelta delta(g.get());
+  KATANA_LOG_ASSERT(delta.AddEdges({0, 3}, {3, 0}));
+  KATANA_LOG_ASSERT(delta.RemoveEdges({1}, {2}));
+  if (auto res = delta.Commit(""); !res) {
+    fs::remove_all(rdg_dir);
+    KATANA_LOG_FATAL("committing result: {}", res.error());
+  }
+
+  auto make_res = katana::PropertyGraph::Make(rdg_dir, tsuba::RDGLoadOptions());
+  fs::remove_all(rdg_dir);
+  if (!make_res) {
+    KATANA_LOG_FATAL("making result: {}", make_res.error());
+  }
+  std::unique_ptr<katana::PropertyGraph> g2 = std::move(make_res.value());
+
+  KATANA_LOG_ASSERT(g2->num_edges() == 6);
+  KATANA_LOG_ASSERT(g2->topology().Equals(g->topology()));
+  KATANA_LOG_ASSERT(
+      PropValues(g2->GetEdgeProperty("weight")) ==
+      PropValues(g->GetEdgeProperty("weight")));
+}
+
+/// Unloaded properties cannot be rebuilt for a new topology, so merging
+/// fails without changing the graph or dropping the updates
+void
+TestUnloadedProperty() {
+  auto g = MakeCycle();
+  g->MarkAllPropertiesPersistent();
+
+  auto uri_res = katana::Uri::MakeRand("/tmp/propertygraphdelta");
+  KATANA_LOG_ASSERT(uri_res);
+  std::string rdg_dir(uri_res.value().path());  // path() because local
+
+  if (auto res = g->Write(rdg_dir, ""); !res) {
+    fs::remove_all(rdg_dir);
+    KATANA_LOG_FATAL("writing result: {}", res.error());
+  }
+  auto unload_res = g->UnloadEdgeProperty("weight");
+  if (!unload_res) {
+    fs::remove_all(rdg_dir);
+    KATANA_LOG_FATAL("unloading: {}", unload_res.error());
+  }
+
+  katana::PropertyGraphDelta delta(g.get());
+  KATANA_LOG_ASSERT(delta.AddEdges({0}, {3}));
+  auto merge_res = delta.Merge();
+  fs::remove_all(rdg_dir);
+  KATANA_LOG_ASSERT(!merge_res);
+  KATANA_LOG_ASSERT(delta.HasUpdates());
+  KATANA_LOG_ASSERT(g->num_nodes() == 5 && g->num_edges() == 5);
+  KATANA_LOG_ASSERT(g->GetNodeProperty("value")->length() == 5);
+}
+
+/// Dropped properties are not committed, even ones that were stored before
+void
+TestDropProperties() {
+  auto g = MakeCycle();
+  g->MarkAllPropertiesPersistent();
+
+  auto uri_res = katana::Uri::MakeRand("/tmp/propertygraphdelta");
+  KATANA_LOG_ASSERT(uri_res);
+  std::string rdg_dir(uri_res.value().path());  // path() because local
+
+  if (auto res = g->Write(rdg_dir, ""); !res) {
+    fs::remove_all(rdg_dir);
+    KATANA_LOG_FATAL("writing result: {}", res.error());
+  }
+  g->DropNodeProperties();
+  if (auto res = g->Commit(""); !res) {
+    fs::remove_all(rdg_dir);
+    KATANA_LOG_FATAL("committing result: {}", res.error());
+  }
+
+  auto make_res = katana::PropertyGraph::Make(rdg_dir, tsuba::RDGLoadOptions());
+  fs::remove_all(rdg_dir);
+  if (!make_res) {
+    KATANA_LOG_FATAL("making result: {}", make_res.error());
+  }
+  std::unique_ptr<katana::PropertyGraph> g2 = std::move(make_res.value());
+  KATANA_LOG_ASSERT(g2->GetNumNodeProperties() == 0);
+  KATANA_LOG_ASSERT(
+      PropValues(g2->GetEdgeProperty("weight")) ==
+      std::vector<int64_t>({0, 1, 2, 3, 4}));
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  TestMerge();
+  TestErrors();
+  TestReplaceTopologyFails();
+  TestCommit();
+  TestUnloadedProperty();
+  TestDropProperties();
+
+  return 0;
+}
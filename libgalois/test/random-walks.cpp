@@ -0,0 +1,171 @@
+#include <algorithm>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/analytics/random_walks/random_walks.h"
+
+namespace {
+
+using katana::analytics::kRandomWalksPadding;
+using katana::analytics::RandomWalksPlan;
+
+// A symmetric ring of kRingSize nodes, plus an edge from node 0 to kDeadEnd,
+// which has no neighbors, and an isolated node kIsolated
+constexpr uint32_t kRingSize = 20;
+constexpr uint32_t kDeadEnd = kRingSize;
+constexpr uint32_t kIsolated = kRingSize + 1;
+constexpr uint32_t kNumNodes = kRingSize + 2;
+
+constexpr uint32_t kWalkLength = 4;
+constexpr uint32_t kNumberOfWalks = 10;
+constexpr uint32_t kMaxIterations = 3;
+constexpr uint32_t kNumberOfEdgeTypes = 2;
+
+std::set<std::pair<uint32_t, uint32_t>>
+MakeEdges() {
+  std::set<std::pair<uint32_t, uint32_t>> edges;
+  for (uint32_t n = 0; n < kRingSize; ++n) {
+    edges.emplace(n, (n + 1) % kRingSize);
+    edges.emplace((n + 1) % kRingSize, n);
+  }
+  edges.emplace(0, kDeadEnd);
+  return edges;
+}
+
+/// Edge2vec expects exactly one edge property, the uint32 type of each edge,
+/// in [1, number_of_edge_types]
+std::unique_ptr<katana::PropertyGraph>
+MakeGraph(const std::set<std::pair<uint32_t, uint32_t>>& edges) {
+  std::vector<uint64_t> indices;
+  std::vector<uint32_t> dests;
+  arrow::UInt32Builder types;
+  auto it = edges.begin();
+  for (uint32_t n = 0; n < kNumNodes; ++n) {
+    for (; it != edges.end() && it->first == n; ++it) {
+      dests.emplace_back(it->second);
+      uint32_t lower = std::min(it->first, it->second);
+      KATANA_LOG_ASSERT(types.Append(lower % 3 == 0 ? 2 : 1).ok());
+    }
+    indices.emplace_back(dests.size());
+  }
+
+  katana::GraphTopology topo{
+      indices.data(), indices.size(), dests.data(), dests.size()};
+  auto g_res = katana::PropertyGraph::Make(std::move(topo));
+  KATANA_LOG_ASSERT(g_res);
+  std::unique_ptr<katana::PropertyGraph> g = std::move(g_res.value());
+
+  auto edge_table = arrow::Table::Make(
+      arrow::schema({arrow::field("type", arrow::uint32())}),
+      {types.Finish().ValueOrDie()});
+  KATANA_LOG_ASSERT(g->AddEdgeProperties(edge_table));
+  return g;
+}
+
+RandomWalksPlan
+Edge2VecPlan() {
+  return RandomWalksPlan::Edge2Vec(
+      kWalkLength, kNumberOfWalks, RandomWalksPlan::kDefaultBackwardProbability,
+      RandomWalksPlan::kDefaultForwardProbability, kMaxIterations,
+      kNumberOfEdgeTypes);
+}
+
+/// Every step of walk follows an edge and the walk never continues from a
+/// node without neighbors
+void
+AssertWalkValid(
+    const std::set<std::pair<uint32_t, uint32_t>>& edges,
+    const std::vector<uint32_t>& walk) {
+  KATANA_LOG_ASSERT(!walk.empty());
+  for (size_t i = 1; i < walk.size(); ++i) {
+    KATANA_LOG_VASSERT(
+        edges.count({walk[i - 1], walk[i]}) == 1, "no edge {} -> {}",
+        walk[i - 1], walk[i]);
+  }
+}
+
+void
+TestEdge2VecArray() {
+  auto edges = MakeEdges();
+  auto g = MakeGraph(edges);
+
+  auto walks_res = katana::analytics::RandomWalksArray(g.get(), Edge2VecPlan());
+  KATANA_LOG_VASSERT(walks_res, "edge2vec: {}", walks_res.error());
+  auto walks = walks_res.value();
+
+  // The walks of every iteration are kept
+  uint64_t rows_per_iteration = kNumNodes * kNumberOfWalks;
+  KATANA_LOG_ASSERT(
+      static_cast<uint64_t>(walks->length()) ==
+      rows_per_iteration * kMaxIterations);
+  KATANA_LOG_ASSERT(walks->value_length() == kWalkLength + 1);
+
+  auto values = std::static_pointer_cast<arrow::UInt32Array>(walks->values());
+  uint64_t dropped = 0;
+  for (int64_t i = 0; i < walks->length(); ++i) {
+    const uint32_t* begin = values->raw_values() + i * (kWalkLength + 1);
+    const uint32_t* end = begin + kWalkLength + 1;
+    const uint32_t* walk_end = std::find(begin, end, kRandomWalksPadding);
+    KATANA_LOG_ASSERT(
+        std::all_of(walk_end, end, [](uint32_t n) {
+          return n == kRandomWalksPadding;
+        }));
+
+    // Walks that reach the dead end after their start are dropped entirely
+    if (walk_end == begin) {
+      ++dropped;
+      continue;
+    }
+    std::vector<uint32_t> walk(begin, walk_end);
+    KATANA_LOG_ASSERT(walk[0] == i % kNumNodes);
+    AssertWalkValid(edges, walk);
+    if (walk[0] == kDeadEnd || walk[0] == kIsolated) {
+      KATANA_LOG_ASSERT(walk.size() == 1);
+    } else {
+      KATANA_LOG_ASSERT(walk.size() == kWalkLength + 1);
+      KATANA_LOG_ASSERT(
+          std::find(walk.begin(), walk.end(), kDeadEnd) == walk.end());
+    }
+  }
+  // A third of the first steps from node 0 alone lead to the dead end
+  KATANA_LOG_ASSERT(dropped > 0);
+}
+
+void
+TestEdge2VecVectors() {
+  auto edges = MakeEdges();
+  auto g = MakeGraph(edges);
+
+  auto walks_res = katana::analytics::RandomWalks(g.get(), Edge2VecPlan());
+  KATANA_LOG_VASSERT(walks_res, "edge2vec: {}", walks_res.error());
+  const auto& walks = walks_res.value();
+
+  // More walks than one iteration can produce from the nodes of the ring
+  KATANA_LOG_ASSERT(walks.size() > kRingSize * kNumberOfWalks);
+  KATANA_LOG_ASSERT(
+      walks.size() <= kRingSize * kNumberOfWalks * kMaxIterations);
+  for (const auto& walk : walks) {
+    KATANA_LOG_ASSERT(walk.size() == kWalkLength + 1);
+    KATANA_LOG_ASSERT(
+        std::find(walk.begin(), walk.end(), kDeadEnd) == walk.end());
+    AssertWalkValid(edges, walk);
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+
+  TestEdge2VecArray();
+  TestEdge2VecVectors();
+
+  return 0;
+}
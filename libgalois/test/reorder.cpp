@@ -0,0 +1,119 @@
+#include <arrow/api.h>
+#include <boost/filesystem.hpp>
+
+#include "TestTypedPropertyGraph.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/URI.h"
+#include "katana/analytics/reorder/reorder.h"
+
+namespace {
+
+namespace fs = boost::filesystem;
+
+using katana::analytics::ReorderPlan;
+
+constexpr size_t kNumNodes = 20;
+
+/// A graph where node n has the property value n and each edge has the
+/// property weight equal to its destination
+std::unique_ptr<katana::PropertyGraph>
+MakeGraph() {
+  LinePolicy policy{3};
+  auto g = MakeFileGraph<int64_t>(kNumNodes, 0, &policy);
+
+  arrow::Int64Builder values;
+  for (size_t n = 0; n < kNumNodes; ++n) {
+    KATANA_LOG_ASSERT(values.Append(n).ok());
+  }
+  arrow::Int64Builder weights;
+  for (uint64_t e = 0; e < g->num_edges(); ++e) {
+    KATANA_LOG_ASSERT(weights.Append(g->topology().edge_dest(e)).ok());
+  }
+  KATANA_LOG_ASSERT(g->AddNodeProperties(arrow::Table::Make(
+      arrow::schema({arrow::field("value", arrow::int64())}),
+      {values.Finish().ValueOrDie()})));
+  KATANA_LOG_ASSERT(g->AddEdgeProperties(arrow::Table::Make(
+      arrow::schema({arrow::field("weight", arrow::int64())}),
+      {weights.Finish().ValueOrDie()})));
+  return g;
+}
+
+template <typename ArrayType>
+std::shared_ptr<ArrayType>
+Chunk(const std::shared_ptr<arrow::ChunkedArray>& property) {
+  KATANA_LOG_ASSERT(property->num_chunks() == 1);
+  return std::static_pointer_cast<ArrayType>(property->chunk(0));
+}
+
+/// Properties are permuted along with the nodes and edges
+void
+TestPermutesProperties() {
+  for (const auto& plan :
+       {ReorderPlan::ReverseCuthillMcKee(), ReorderPlan::HubSort()}) {
+    auto g = MakeGraph();
+    auto res = katana::analytics::Reorder(g.get(), "original_id", plan);
+    KATANA_LOG_VASSERT(res, "reordering: {}", res.error());
+    KATANA_LOG_ASSERT(
+        katana::analytics::ReorderAssertValid(g.get(), "original_id"));
+
+    auto original_ids =
+        Chunk<arrow::UInt32Array>(g->GetNodeProperty("original_id"));
+    auto values = Chunk<arrow::Int64Array>(g->GetNodeProperty("value"));
+    auto weights = Chunk<arrow::Int64Array>(g->GetEdgeProperty("weight"));
+    for (size_t n = 0; n < kNumNodes; ++n) {
+      KATANA_LOG_ASSERT(values->Value(n) == original_ids->Value(n));
+      for (auto e : g->topology().edges(n)) {
+        KATANA_LOG_ASSERT(
+            weights->Value(e) ==
+            original_ids->Value(g->topology().edge_dest(e)));
+      }
+    }
+  }
+}
+
+/// An unloaded property cannot be permuted, so reordering fails without
+/// changing the graph
+void
+TestUnloadedProperty() {
+  auto g = MakeGraph();
+  g->MarkAllPropertiesPersistent();
+
+  auto uri_res = katana::Uri::MakeRand("/tmp/reorder");
+  KATANA_LOG_ASSERT(uri_res);
+  std::string rdg_dir(uri_res.value().path());  // path() because local
+
+  if (auto res = g->Write(rdg_dir, ""); !res) {
+    fs::remove_all(rdg_dir);
+    KATANA_LOG_FATAL("writing result: {}", res.error());
+  }
+  auto unload_res = g->UnloadNodeProperty("value");
+  if (!unload_res) {
+    fs::remove_all(rdg_dir);
+    KATANA_LOG_FATAL("unloading: {}", unload_res.error());
+  }
+
+  std::vector<uint32_t> dests(
+      g->topology().dest_data(),
+      g->topology().dest_data() + g->num_edges());
+  auto res = katana::analytics::Reorder(
+      g.get(), "original_id", ReorderPlan::ReverseCuthillMcKee());
+  fs::remove_all(rdg_dir);
+  KATANA_LOG_ASSERT(!res);
+  KATANA_LOG_ASSERT(!g->HasNodeProperty("original_id"));
+  KATANA_LOG_ASSERT(
+      std::equal(dests.begin(), dests.end(), g->topology().dest_data()));
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+
+  TestPermutesProperties();
+  TestUnloadedProperty();
+
+  return 0;
+}
@@ -0,0 +1,48 @@
+#ifndef KATANA_LIBTSUBA_TSUBA_ARROWIPC_H_
+#define KATANA_LIBTSUBA_TSUBA_ARROWIPC_H_
+
+#include <memory>
+#include <string_view>
+
+#include <arrow/api.h>
+
+#include "katana/Result.h"
+#include "katana/URI.h"
+#include "katana/config.h"
+#include "tsuba/WriteGroup.h"
+
+namespace tsuba {
+
+/// Storage format of a property file
+enum class PropertyFormat {
+  /// Compressed and encoded; smallest on storage but decoded on every load
+  kParquet,
+  /// Uncompressed Arrow IPC file format (Feather V2). Column buffers are used
+  /// in place after loading: local files are memory mapped and other files
+  /// are read without decoding.
+  kArrowIPC,
+};
+
+/// File name extension of Arrow IPC files. The format of a property file is
+/// detected from its name, so files in this format must use this extension.
+constexpr std::string_view kArrowIPCExtension = ".arrow";
+
+/// \returns true if the file at path is named like an Arrow IPC file
+KATANA_EXPORT bool IsArrowIPCFile(std::string_view path);
+
+/// Write table to uri as an uncompressed Arrow IPC file. If `group` is null
+/// the write is synchronous, otherwise an asynchronous write is started and
+/// managed by group.
+KATANA_EXPORT katana::Result<void> WriteArrowIPC(
+    std::shared_ptr<arrow::Table> table, const katana::Uri& uri,
+    WriteGroup* group = nullptr);
+
+/// Read the Arrow IPC file at uri. The returned table references the file
+/// contents without copying them. Its buffers are mutable: local files are
+/// mapped privately, so writes to the table never reach the file.
+KATANA_EXPORT katana::Result<std::shared_ptr<arrow::Table>> ReadArrowIPC(
+    const katana::Uri& uri);
+
+}  // namespace tsuba
+
+#endif
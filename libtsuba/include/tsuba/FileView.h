@@ -11,9 +11,20 @@
 #include "katana/Logging.h"
 #include "katana/Result.h"
 #include "katana/config.h"
+#include "tsuba/file.h"
 
 namespace tsuba {
 
+/// Controls how far a FileView reads ahead of the data requested from it
+struct KATANA_EXPORT ReadAheadPolicy {
+  AccessPattern pattern{AccessPattern::kAdaptive};
+  /// Read-ahead window used once a sequential run is detected; the window
+  /// doubles with each further sequential read
+  uint64_t min_window{UINT64_C(1) << 20};  // 1 MB
+  /// Largest read-ahead window
+  uint64_t max_window{UINT64_C(64) << 20};  // 64 MB
+};
+
 class KATANA_EXPORT FileView : public arrow::io::RandomAccessFile {
   struct FillingRange {
     uint64_t first_page;
@@ -30,6 +41,10 @@ class KATANA_EXPORT FileView : public arrow::io::RandomAccessFile {
   bool valid_{false};
   std::vector<uint64_t> filling_;
   std::unique_ptr<std::vector<FillingRange>> fetches_;
+  ReadAheadPolicy read_ahead_;
+  // end of the previous read, used to detect sequential access
+  int64_t last_read_end_{-1};
+  uint64_t window_{0};
 
 public:
   FileView() = default;
@@ -45,7 +60,10 @@ public:
         filename_(std::move(other.filename_)),
         valid_(other.valid_),
         filling_(std::move(other.filling_)),
-        fetches_(std::move(other.fetches_)) {
+        fetches_(std::move(other.fetches_)),
+        read_ahead_(other.read_ahead_),
+        last_read_end_(other.last_read_end_),
+        window_(other.window_) {
     other.valid_ = false;
   }
 
@@ -64,6 +82,9 @@ public:
       filling_ = std::move(other.filling_);
       fetches_ =
           std::unique_ptr<std::vector<FillingRange>>(std::move(other.fetches_));
+      read_ahead_ = other.read_ahead_;
+      last_read_end_ = other.last_read_end_;
+      window_ = other.window_;
       other.valid_ = false;
     }
     return *this;
@@ -80,7 +101,9 @@ public:
   /// \param end last byte of file to load at this time
   /// Calls to Read will handle asynchronous
   /// reads internally, but if you intend to use ptr(), you should pass
-  /// resolve=true.
+  /// resolve=true (or call Resolve before using ptr()).
+  /// If the read-ahead policy is kWillNeed and resolve is false, the region
+  /// is fetched in the background.
   katana::Result<void> Bind(
       std::string_view filename, uint64_t begin, uint64_t end, bool resolve);
   katana::Result<void> Bind(
@@ -93,6 +116,18 @@ public:
 
   katana::Result<void> Fill(uint64_t begin, uint64_t end, bool resolve);
 
+  /// Wait for all outstanding reads that overlap with the range
+  /// [start, start + size)
+  katana::Result<void> Resolve(int64_t start, int64_t size);
+
+  /// Set how this view reads ahead of its callers. The policy may be set
+  /// before Bind so that it applies to the initial fill.
+  void set_read_ahead_policy(const ReadAheadPolicy& policy) {
+    read_ahead_ = policy;
+    window_ = 0;
+  }
+  const ReadAheadPolicy& read_ahead_policy() const { return read_ahead_; }
+
   bool Valid() const { return valid_; }
 
   katana::Result<void> Unbind();
@@ -164,8 +199,11 @@ private:
   katana::Result<void> MarkFilled(
       uint64_t* bitmap, uint64_t begin, uint64_t end);
 
-  // Resolve all outstanding reads that overlap with the range [cursor_, nbytes]
-  katana::Result<void> Resolve(int64_t start, int64_t size);
+  // Fetch any missing pages in [begin, end). If background is true the fetch
+  // is issued from the tsuba I/O pool so that storage backends whose async
+  // operations complete synchronously do not block the caller.
+  katana::Result<void> DoFill(
+      uint64_t begin, uint64_t end, bool resolve, bool background);
 
   // Start asynchronously fetching data that we think we might need from storage
   // @start and @size give the location and range of the previous read
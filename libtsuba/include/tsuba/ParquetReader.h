@@ -7,6 +7,7 @@
 
 #include "katana/Result.h"
 #include "katana/URI.h"
+#include "tsuba/file.h"
 
 namespace parquet::arrow {
 
@@ -32,6 +33,9 @@ public:
     /// Slice.length rows starting from Slice.offset
     std::optional<Slice> slice{std::nullopt};
 
+    /// how the file will be read; controls read-ahead (see AccessPattern)
+    AccessPattern access_pattern{AccessPattern::kAdaptive};
+
     static ReadOpts Defaults() { return ReadOpts{}; }
   };
 
@@ -73,8 +77,12 @@ public:
   katana::Result<int64_t> NumRows(const katana::Uri& uri);
 
 private:
-  ParquetReader(std::optional<Slice> slice, bool make_cannonical)
-      : slice_(slice), make_cannonical_{make_cannonical} {}
+  ParquetReader(
+      std::optional<Slice> slice, bool make_cannonical,
+      AccessPattern access_pattern)
+      : slice_(slice),
+        make_cannonical_{make_cannonical},
+        access_pattern_(access_pattern) {}
 
   katana::Result<std::shared_ptr<arrow::Table>> ReadFromUriSliced(
       const katana::Uri& uri);
@@ -88,6 +96,7 @@ private:
 
   std::optional<Slice> slice_;
   bool make_cannonical_;
+  AccessPattern access_pattern_;
 };
 
 }  // namespace tsuba
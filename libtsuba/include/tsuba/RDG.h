@@ -12,6 +12,7 @@
 #include "katana/Result.h"
 #include "katana/URI.h"
 #include "katana/config.h"
+#include "tsuba/ArrowIPC.h"
 #include "tsuba/Errors.h"
 #include "tsuba/FileFrame.h"
 #include "tsuba/FileView.h"
@@ -117,6 +118,19 @@ public:
   katana::Result<void> UnloadNodeProperty(uint32_t i);
   katana::Result<void> UnloadEdgeProperty(uint32_t i);
 
+  /// Fail if any node or edge property has been unloaded, so that its data
+  /// is only in storage
+  katana::Result<void> CheckPropertiesLoaded() const;
+
+  /// Replace all node and edge properties, which may change the number of
+  /// rows. Properties that keep their name keep their persistence and
+  /// format, and are rewritten by the next Store. Fails without changing
+  /// anything if a property has been unloaded or if the columns of either
+  /// table are not distinct.
+  katana::Result<void> ReplaceProperties(
+      const std::shared_ptr<arrow::Table>& node_props,
+      const std::shared_ptr<arrow::Table>& edge_props);
+
   void MarkAllPropertiesPersistent();
 
   katana::Result<void> MarkNodePropertiesPersistent(
@@ -124,6 +138,18 @@ public:
   katana::Result<void> MarkEdgePropertiesPersistent(
       const std::vector<std::string>& persist_edge_props);
 
+  /// Choose the format the named property is stored in the next time this
+  /// RDG is stored. Properties are loaded in whatever format they were stored.
+  katana::Result<void> SetNodePropertyFormat(
+      const std::string& name, PropertyFormat format);
+  katana::Result<void> SetEdgePropertyFormat(
+      const std::string& name, PropertyFormat format);
+
+  /// Statistics of the writes done by the most recent Store
+  const WriteGroup::Stats& last_store_stats() const {
+    return last_store_stats_;
+  }
+
   /// Explain to graph how it is derived from previous version
   void AddLineage(const std::string& command_line);
 
@@ -161,10 +187,10 @@ public:
   /// The edge properties
   const std::shared_ptr<arrow::Table>& edge_properties() const;
 
-  /// Remove all node properties
+  /// Remove all node properties, including unloaded ones
   void DropNodeProperties();
 
-  /// Remove all edge properties
+  /// Remove all edge properties, including unloaded ones
   void DropEdgeProperties();
 
   const std::vector<std::shared_ptr<arrow::ChunkedArray>>& master_nodes()
@@ -264,6 +290,7 @@ private:
   uint32_t partition_id_{std::numeric_limits<uint32_t>::max()};
   // How this graph was derived from the previous version
   RDGLineage lineage_;
+  WriteGroup::Stats last_store_stats_;
 };
 
 }  // namespace tsuba
@@ -10,6 +10,7 @@
 #include "katana/URI.h"
 #include "katana/config.h"
 #include "tsuba/FileView.h"
+#include "tsuba/file.h"
 #include "tsuba/tsuba.h"
 
 namespace tsuba {
@@ -34,15 +35,22 @@ public:
     uint64_t topo_size;
   };
 
+  /// Load a slice of the RDG referred to by handle
+  ///
+  /// \param access_pattern how the slice's files will be read; kWillNeed
+  ///    fetches the topology and all property row groups of the slice in the
+  ///    background at once, which lets many slices load concurrently
   static katana::Result<RDGSlice> Make(
       RDGHandle handle, const SliceArg& slice,
       const std::vector<std::string>* node_props = nullptr,
-      const std::vector<std::string>* edge_props = nullptr);
+      const std::vector<std::string>* edge_props = nullptr,
+      AccessPattern access_pattern = AccessPattern::kAdaptive);
 
   static katana::Result<RDGSlice> Make(
       const std::string& rdg_manifest_path, const SliceArg& slice,
       const std::vector<std::string>* node_props = nullptr,
-      const std::vector<std::string>* edge_props = nullptr);
+      const std::vector<std::string>* edge_props = nullptr,
+      AccessPattern access_pattern = AccessPattern::kAdaptive);
 
   const std::shared_ptr<arrow::Table>& node_properties() const;
   const std::shared_ptr<arrow::Table>& edge_properties() const;
@@ -56,7 +64,8 @@ private:
   RDGSlice(std::unique_ptr<RDGCore>&& core);
 
   katana::Result<void> DoMake(
-      const katana::Uri& metadata_dir, const SliceArg& slice);
+      const katana::Uri& metadata_dir, const SliceArg& slice,
+      AccessPattern access_pattern);
 
   //
   // Data
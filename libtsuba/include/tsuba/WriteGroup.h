@@ -1,11 +1,15 @@
 #ifndef KATANA_LIBTSUBA_TSUBA_WRITEGROUP_H_
 #define KATANA_LIBTSUBA_TSUBA_WRITEGROUP_H_
 
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <future>
 #include <list>
 #include <memory>
 
 #include "katana/Result.h"
+#include "katana/config.h"
 #include "tsuba/AsyncOpGroup.h"
 #include "tsuba/FileFrame.h"
 #include "tsuba/file.h"
@@ -14,25 +18,59 @@ namespace tsuba {
 
 /// Track multiple, outstanding async writes and provide a mechanism to ensure
 /// that they have all completed
-class WriteGroup {
-  struct AsyncOp {
-    std::future<katana::CopyableResult<void>> result;
-    std::string location;
-    uint64_t accounted_size;
-  };
+class KATANA_EXPORT WriteGroup {
+public:
+  static constexpr uint64_t kMaxOutstandingSize = 10ULL << 30;  // 10 GB
 
-  std::string tag_;
-  std::atomic<uint64_t> outstanding_size_{0};
-  AsyncOpGroup async_op_group_;
+  struct Options {
+    /// What to do when starting an op would exceed a limit
+    enum class FlushPolicy {
+      /// Wait for the oldest outstanding ops, one at a time, until the new op
+      /// fits
+      kWaitOldest,
+      /// Wait for all outstanding ops
+      kWaitAll,
+    };
+
+    /// Upper bound on the bytes held by ops that have not completed
+    uint64_t max_outstanding_bytes{kMaxOutstandingSize};
+    /// Upper bound on the number of ops that have not completed; 0 means no
+    /// limit
+    uint32_t max_concurrent_ops{0};
+    FlushPolicy flush_policy{FlushPolicy::kWaitOldest};
+
+    /// Options with defaults overridden by the KATANA_TSUBA_WRITE_*
+    /// environment variables
+    static Options Defaults();
+  };
 
-  WriteGroup(std::string tag) : tag_(std::move(tag)){};
+  struct Stats {
+    uint64_t ops{0};
+    /// Bytes stored by StartStore and StartEncodeAndStore
+    uint64_t bytes_written{0};
+    /// Time spent encoding buffers, summed over ops
+    uint64_t encode_ns{0};
+    /// Time spent persisting buffers, summed over ops
+    uint64_t io_ns{0};
+    /// Time the thread starting ops was blocked waiting for budget
+    uint64_t stall_ns{0};
+    /// Time from the creation of the group to the end of Finish
+    uint64_t elapsed_ns{0};
+
+    /// bytes written per second of elapsed time
+    double Throughput() const {
+      return elapsed_ns == 0 ? 0.0 : bytes_written * 1e9 / elapsed_ns;
+    }
+  };
 
-public:
-  static constexpr uint64_t kMaxOutstandingSize = 10ULL << 30;  // 10 GB
+  /// Function filling a FileFrame with the contents of a file
+  using EncodeFn = std::function<katana::CopyableResult<void>(
+      const std::shared_ptr<FileFrame>& ff)>;
 
   /// Build a descriptor with a tag. If running with multiple hosts, Make should
   /// be Called BSP style and all hosts will have the same tag
-  static katana::Result<std::unique_ptr<WriteGroup>> Make();
+  static katana::Result<std::unique_ptr<WriteGroup>> Make(
+      const Options& opts = Options::Defaults());
 
   /// Return a random tag that uniquely identifies this op
   const std::string& tag() const { return tag_; }
@@ -44,18 +82,48 @@ public:
   void StartStore(std::shared_ptr<FileFrame> ff);
 
   /// Start async store op, caller responsible for keeping buffer live
-  void StartStore(const std::string& file, const uint8_t* buf, uint64_t size) {
-    AddOp(FileStoreAsync(file, buf, size), file);
-  }
+  void StartStore(const std::string& file, const uint8_t* buf, uint64_t size);
 
-  void AddToOutstanding(uint64_t size) { outstanding_size_ += size; }
+  /// Start an async op that fills ff by calling encode and then persists it.
+  /// Encoding overlaps with the I/O of earlier ops. size_hint bytes are
+  /// reserved against the budget until encoding finishes and the real size
+  /// of the frame is known. ff must be bound to its destination.
+  void StartEncodeAndStore(
+      std::shared_ptr<FileFrame> ff, EncodeFn encode, uint64_t size_hint = 0);
 
   /// Add future to the list of futures this descriptor will wait for, note
   /// the file name for debugging. If the operation is associated with a file
-  /// frame that we are responsible for, note the size
+  /// frame that we are responsible for, note the size. accounted_size is
+  /// held against the budget only; the op counts towards Stats::ops but not
+  /// towards Stats::bytes_written
   void AddOp(
       std::future<katana::CopyableResult<void>> future, std::string file,
       uint64_t accounted_size = 0);
+
+  const Options& options() const { return opts_; }
+
+  /// Statistics of the ops that have completed so far
+  Stats stats() const;
+
+private:
+  WriteGroup(std::string tag, const Options& opts);
+
+  /// Block until an op of size bytes can start without exceeding the limits
+  void WaitForBudget(uint64_t size);
+
+  std::string tag_;
+  Options opts_;
+  std::atomic<uint64_t> outstanding_size_{0};
+  std::atomic<uint32_t> outstanding_ops_{0};
+  AsyncOpGroup async_op_group_;
+
+  std::chrono::steady_clock::time_point start_;
+  std::atomic<uint64_t> ops_{0};
+  std::atomic<uint64_t> bytes_written_{0};
+  std::atomic<uint64_t> encode_ns_{0};
+  std::atomic<uint64_t> io_ns_{0};
+  uint64_t stall_ns_{0};
+  uint64_t elapsed_ns_{0};
 };
 
 }  // namespace tsuba
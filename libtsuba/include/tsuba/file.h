@@ -28,6 +28,21 @@ RoundUpToBlock(T val) {
   return RoundDownToBlock(val + kBlockOffsetMask);
 }
 
+/// Hints describing how the contents of a file will be read. Readers use them
+/// to decide how much to fetch ahead of the caller.
+enum class AccessPattern {
+  /// Detect runs of sequential reads and read further ahead the longer they
+  /// continue
+  kAdaptive,
+  /// Reads will mostly be sequential; always read ahead as far as allowed
+  kSequential,
+  /// Reads will be scattered; do not read ahead
+  kRandom,
+  /// All of the requested data will be needed soon; start fetching it in the
+  /// background immediately
+  kWillNeed,
+};
+
 struct StatBuf {
   uint64_t size{UINT64_C(0)};
 };
@@ -6,6 +6,7 @@
 #include <arrow/chunked_array.h>
 
 #include "katana/Result.h"
+#include "tsuba/ArrowIPC.h"
 #include "tsuba/Errors.h"
 #include "tsuba/FileView.h"
 #include "tsuba/ParquetReader.h"
@@ -13,18 +14,54 @@
 namespace {
 
 katana::Result<std::shared_ptr<arrow::Table>>
-DoLoadProperties(
-    const std::string& expected_name, const katana::Uri& file_path,
-    std::optional<tsuba::ParquetReader::Slice> slice = std::nullopt) {
+ReadParquet(
+    const katana::Uri& file_path,
+    std::optional<tsuba::ParquetReader::Slice> slice,
+    tsuba::AccessPattern access_pattern) {
   auto read_opts = tsuba::ParquetReader::ReadOpts::Defaults();
   read_opts.slice = slice;
+  read_opts.access_pattern = access_pattern;
   auto reader_res = tsuba::ParquetReader::Make(read_opts);
   if (!reader_res) {
-    return reader_res.error().WithContext("loading property");
+    return reader_res.error();
   }
   std::unique_ptr<tsuba::ParquetReader> reader = std::move(reader_res.value());
 
-  auto out_res = reader->ReadTable(file_path);
+  return reader->ReadTable(file_path);
+}
+
+katana::Result<std::shared_ptr<arrow::Table>>
+ReadArrowIPC(
+    const katana::Uri& file_path,
+    std::optional<tsuba::ParquetReader::Slice> slice) {
+  auto table_res = tsuba::ReadArrowIPC(file_path);
+  if (!table_res) {
+    return table_res.error();
+  }
+  std::shared_ptr<arrow::Table> table = std::move(table_res.value());
+  if (!slice) {
+    return table;
+  }
+  if (slice->offset < 0 || slice->length < 0 ||
+      slice->offset + slice->length > table->num_rows()) {
+    return KATANA_ERROR(
+        tsuba::ErrorCode::InvalidArgument,
+        "slice [{}, {}) out of range of {} rows", slice->offset,
+        slice->offset + slice->length, table->num_rows());
+  }
+  // zero-copy; the slice shares the mapped buffers
+  return table->Slice(slice->offset, slice->length);
+}
+
+katana::Result<std::shared_ptr<arrow::Table>>
+DoLoadProperties(
+    const std::string& expected_name, const katana::Uri& file_path,
+    std::optional<tsuba::ParquetReader::Slice> slice = std::nullopt,
+    tsuba::AccessPattern access_pattern = tsuba::AccessPattern::kAdaptive) {
+  // The storage format of a property is recorded in the name of its file
+  auto out_res = tsuba::IsArrowIPCFile(file_path.BaseName())
+                     ? ReadArrowIPC(file_path, slice)
+                     : ReadParquet(file_path, slice, access_pattern);
   if (!out_res) {
     return out_res.error().WithContext("loading property");
   }
@@ -62,11 +99,12 @@ tsuba::LoadProperties(
 katana::Result<std::shared_ptr<arrow::Table>>
 tsuba::LoadPropertySlice(
     const std::string& expected_name, const katana::Uri& file_path,
-    int64_t offset, int64_t length) {
+    int64_t offset, int64_t length, AccessPattern access_pattern) {
   try {
     return DoLoadProperties(
         expected_name, file_path,
-        tsuba::ParquetReader::Slice{.offset = offset, .length = length});
+        tsuba::ParquetReader::Slice{.offset = offset, .length = length},
+        access_pattern);
   } catch (const std::exception& exp) {
     return KATANA_ERROR(
         tsuba::ErrorCode::ArrowError, "arrow exception: {}", exp.what());
@@ -127,7 +165,8 @@ tsuba::AddPropertySlice(
     const std::vector<tsuba::PropStorageInfo>& properties,
     std::pair<uint64_t, uint64_t> range, ReadGroup* grp,
     const std::function<katana::Result<void>(std::shared_ptr<arrow::Table>)>&
-        add_fn) {
+        add_fn,
+    AccessPattern access_pattern) {
   uint64_t begin = range.first;
   uint64_t size = range.second - range.first;
   for (const tsuba::PropStorageInfo& prop : properties) {
@@ -136,9 +175,10 @@ tsuba::AddPropertySlice(
     std::future<katana::CopyableResult<std::shared_ptr<arrow::Table>>> future =
         std::async(
             std::launch::async,
-            [name, path, begin,
-             size]() -> katana::CopyableResult<std::shared_ptr<arrow::Table>> {
-              auto load_result = LoadPropertySlice(name, path, begin, size);
+            [name, path, begin, size, access_pattern]()
+                -> katana::CopyableResult<std::shared_ptr<arrow::Table>> {
+              auto load_result =
+                  LoadPropertySlice(name, path, begin, size, access_pattern);
               if (!load_result) {
                 return load_result.error().WithContext(
                     "error loading {}", path);
@@ -7,6 +7,7 @@
 #include "katana/Result.h"
 #include "katana/URI.h"
 #include "tsuba/ReadGroup.h"
+#include "tsuba/file.h"
 
 namespace tsuba {
 
@@ -15,7 +16,8 @@ KATANA_EXPORT katana::Result<std::shared_ptr<arrow::Table>> LoadProperties(
 
 KATANA_EXPORT katana::Result<std::shared_ptr<arrow::Table>> LoadPropertySlice(
     const std::string& expected_name, const katana::Uri& file_path,
-    int64_t offset, int64_t length);
+    int64_t offset, int64_t length,
+    AccessPattern access_pattern = AccessPattern::kAdaptive);
 
 KATANA_EXPORT katana::Result<void> AddProperties(
     const katana::Uri& uri,
@@ -28,7 +30,8 @@ KATANA_EXPORT katana::Result<void> AddPropertySlice(
     const std::vector<tsuba::PropStorageInfo>& properties,
     std::pair<uint64_t, uint64_t> range, ReadGroup* grp,
     const std::function<katana::Result<void>(std::shared_ptr<arrow::Table>)>&
-        add_fn);
+        add_fn,
+    AccessPattern access_pattern = AccessPattern::kAdaptive);
 
 }  // namespace tsuba
 
@@ -0,0 +1,193 @@
+#include "tsuba/ArrowIPC.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <arrow/io/memory.h>
+#include <arrow/ipc/api.h>
+
+#include "katana/ArrowInterchange.h"
+#include "katana/Logging.h"
+#include "katana/Result.h"
+#include "tsuba/Errors.h"
+#include "tsuba/FaultTest.h"
+#include "tsuba/FileFrame.h"
+#include "tsuba/FileView.h"
+
+namespace {
+
+/// A buffer over the whole contents of a FileView that keeps the view, and so
+/// its mapping, alive for as long as any slice of the buffer is referenced.
+/// The view's memory is private to this process, so the buffer is mutable.
+class FileViewBuffer : public arrow::MutableBuffer {
+public:
+  explicit FileViewBuffer(std::shared_ptr<tsuba::FileView> fv)
+      : arrow::MutableBuffer(
+            const_cast<uint8_t*>(fv->ptr<uint8_t>()), fv->size()),
+        fv_(std::move(fv)) {}
+
+private:
+  std::shared_ptr<tsuba::FileView> fv_;
+};
+
+/// A private, writable mapping of a local file. Pages are copied when they
+/// are first written, so property values can be updated in place without
+/// changing the file.
+class PrivateFileMapping : public arrow::MutableBuffer {
+public:
+  static katana::Result<std::shared_ptr<arrow::Buffer>> Make(
+      const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return KATANA_ERROR(katana::ResultErrno(), "opening {}", path);
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+      std::error_code ec = katana::ResultErrno();
+      close(fd);
+      return KATANA_ERROR(ec, "stat {}", path);
+    }
+    void* data = nullptr;
+    if (st.st_size > 0) {
+      data = mmap(
+          nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    }
+    // The mapping stays valid after the descriptor is closed
+    std::error_code ec = katana::ResultErrno();
+    close(fd);
+    if (data == MAP_FAILED) {
+      return KATANA_ERROR(ec, "mapping {}", path);
+    }
+    return std::shared_ptr<arrow::Buffer>(
+        new PrivateFileMapping(static_cast<uint8_t*>(data), st.st_size));
+  }
+
+  ~PrivateFileMapping() override {
+    if (size_ > 0 && munmap(const_cast<uint8_t*>(data_), size_) != 0) {
+      KATANA_LOG_WARN("munmap: {}", katana::ResultErrno().message());
+    }
+  }
+
+private:
+  PrivateFileMapping(uint8_t* data, int64_t size)
+      : arrow::MutableBuffer(data, size) {}
+};
+
+katana::Result<std::shared_ptr<arrow::Buffer>>
+MapForRead(const katana::Uri& uri) {
+  if (uri.scheme() == katana::Uri::kFileScheme) {
+    return PrivateFileMapping::Make(uri.path());
+  }
+
+  auto fv = std::make_shared<tsuba::FileView>();
+  if (auto res = fv->Bind(uri.string(), true); !res) {
+    return res.error().WithContext("fetching {}", uri);
+  }
+  return std::make_shared<FileViewBuffer>(std::move(fv));
+}
+
+/// The IPC reader returns column buffers as immutable slices of the file
+/// contents, even when those are writable. Property views need to write to
+/// columns, so rewrap every buffer that lies in `contents` as a mutable
+/// slice of it. Buffers the reader allocated itself are left alone.
+std::shared_ptr<arrow::ArrayData>
+MakeMutable(
+    const std::shared_ptr<arrow::ArrayData>& data,
+    const std::shared_ptr<arrow::Buffer>& contents) {
+  auto out = data->Copy();
+  const uint8_t* begin = contents->data();
+  const uint8_t* end = begin + contents->size();
+  for (auto& buffer : out->buffers) {
+    if (!buffer || buffer->is_mutable() || buffer->data() < begin ||
+        buffer->data() + buffer->size() > end) {
+      continue;
+    }
+    buffer = arrow::SliceMutableBuffer(
+        contents, buffer->data() - begin, buffer->size());
+  }
+  for (auto& child : out->child_data) {
+    child = MakeMutable(child, contents);
+  }
+  if (out->dictionary) {
+    out->dictionary = MakeMutable(out->dictionary, contents);
+  }
+  return out;
+}
+
+katana::Result<std::shared_ptr<arrow::Table>>
+DoReadArrowIPC(const katana::Uri& uri) {
+  auto contents = KATANA_CHECKED(MapForRead(uri));
+  auto file = std::make_shared<arrow::io::BufferReader>(contents);
+  auto reader =
+      KATANA_CHECKED(arrow::ipc::RecordBatchFileReader::Open(file.get()));
+
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  batches.reserve(reader->num_record_batches());
+  for (int i = 0, n = reader->num_record_batches(); i < n; ++i) {
+    auto batch = KATANA_CHECKED(reader->ReadRecordBatch(i));
+    std::vector<std::shared_ptr<arrow::ArrayData>> columns;
+    for (const auto& column : batch->column_data()) {
+      columns.emplace_back(MakeMutable(column, contents));
+    }
+    batches.emplace_back(arrow::RecordBatch::Make(
+        batch->schema(), batch->num_rows(), std::move(columns)));
+  }
+  return KATANA_CHECKED(
+      arrow::Table::FromRecordBatches(reader->schema(), batches));
+}
+
+}  // namespace
+
+bool
+tsuba::IsArrowIPCFile(std::string_view path) {
+  return path.size() >= kArrowIPCExtension.size() &&
+         path.substr(path.size() - kArrowIPCExtension.size()) ==
+             kArrowIPCExtension;
+}
+
+katana::Result<void>
+tsuba::WriteArrowIPC(
+    std::shared_ptr<arrow::Table> table, const katana::Uri& uri,
+    WriteGroup* group) {
+  auto ff = std::make_shared<tsuba::FileFrame>();
+  if (auto res = ff->Init(); !res) {
+    return res.error().WithContext("creating output buffer");
+  }
+  ff->Bind(uri.string());
+  uint64_t size_hint = katana::ApproxTableMemUse(table);
+  auto encode = [table = std::move(table)](
+                    const std::shared_ptr<tsuba::FileFrame>& ff) mutable
+      -> katana::CopyableResult<void> {
+    // Column buffers are copied into the frame as they are; there is no
+    // encoding step
+    auto writer = KATANA_CHECKED_CONTEXT(
+        arrow::ipc::MakeFileWriter(ff, table->schema()), "opening ipc writer");
+    KATANA_CHECKED_CONTEXT(writer->WriteTable(*table), "writing table");
+    KATANA_CHECKED_CONTEXT(writer->Close(), "closing ipc writer");
+    table.reset();
+    return katana::CopyableResultSuccess();
+  };
+
+  if (group) {
+    group->StartEncodeAndStore(std::move(ff), std::move(encode), size_hint);
+    return katana::ResultSuccess();
+  }
+
+  if (auto res = encode(ff); !res) {
+    return res.error();
+  }
+  TSUBA_PTP(tsuba::internal::FaultSensitivity::Normal);
+  return ff->Persist();
+}
+
+katana::Result<std::shared_ptr<arrow::Table>>
+tsuba::ReadArrowIPC(const katana::Uri& uri) {
+  try {
+    return DoReadArrowIPC(uri);
+  } catch (const std::exception& exp) {
+    return KATANA_ERROR(
+        tsuba::ErrorCode::ArrowError, "arrow exception: {}", exp.what());
+  }
+}
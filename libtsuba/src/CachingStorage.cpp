@@ -0,0 +1,689 @@
+#include "CachingStorage.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <system_error>
+
+#include <boost/filesystem.hpp>
+
+#include "katana/JSON.h"
+#include "katana/Logging.h"
+#include "katana/Random.h"
+#include "katana/Result.h"
+#include "katana/URI.h"
+#include "tsuba/Errors.h"
+#include "tsuba/file.h"
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+constexpr uint64_t kHashChunkSize = UINT64_C(64) << 20;  // 64 MB
+constexpr const char* kDataSuffix = ".data";
+constexpr const char* kMetaSuffix = ".meta";
+constexpr const char* kTmpSuffix = ".tmp-";
+constexpr uint32_t kTmpRandLen = 8;
+constexpr std::time_t kStaleTmpSeconds = 24 * 60 * 60;
+
+constexpr uint64_t kHashSeed = UINT64_C(0xcbf29ce484222325);
+constexpr uint64_t kHashPrime = UINT64_C(0x100000001b3);
+
+/// FNV-1a style hash that consumes eight bytes at a time. The hash of a large
+/// buffer can be computed piecewise by passing the previous result as hash, as
+/// long as every piece but the last is a multiple of eight bytes.
+uint64_t
+HashBytes(const uint8_t* data, uint64_t size, uint64_t hash = kHashSeed) {
+  uint64_t i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t word{};
+    std::memcpy(&word, data + i, sizeof(word));
+    hash = (hash ^ word) * kHashPrime;
+  }
+  for (; i < size; ++i) {
+    hash = (hash ^ data[i]) * kHashPrime;
+  }
+  return hash;
+}
+
+std::string
+CacheKey(const std::string& uri) {
+  return fmt::format(
+      "{:016x}",
+      HashBytes(reinterpret_cast<const uint8_t*>(uri.data()), uri.size()));
+}
+
+struct CacheMeta {
+  std::string uri;
+  uint64_t size{0};
+  uint64_t hash{0};
+};
+
+void
+to_json(nlohmann::json& j, const CacheMeta& meta) {
+  j = nlohmann::json{
+      {"uri", meta.uri},
+      {"size", meta.size},
+      {"hash", meta.hash},
+  };
+}
+
+void
+from_json(const nlohmann::json& j, CacheMeta& meta) {
+  j.at("uri").get_to(meta.uri);
+  j.at("size").get_to(meta.size);
+  j.at("hash").get_to(meta.hash);
+}
+
+katana::Result<void>
+ReadFully(int fd, uint8_t* buf, uint64_t size, uint64_t offset) {
+  uint64_t done = 0;
+  while (done < size) {
+    ssize_t got = pread(fd, buf + done, size - done, offset + done);
+    if (got < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return KATANA_ERROR(katana::ResultErrno(), "reading cached file");
+    }
+    if (got == 0) {
+      return KATANA_ERROR(
+          tsuba::ErrorCode::LocalStorageError,
+          "cached file is shorter than expected");
+    }
+    done += got;
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+WriteFully(int fd, const uint8_t* buf, uint64_t size) {
+  uint64_t done = 0;
+  while (done < size) {
+    ssize_t put = write(fd, buf + done, size - done);
+    if (put < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return KATANA_ERROR(katana::ResultErrno(), "writing cached file");
+    }
+    done += put;
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<uint64_t>
+HashFile(const std::string& path, uint64_t size) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return KATANA_ERROR(katana::ResultErrno(), "opening {}", path);
+  }
+  std::vector<uint8_t> buf(std::min(size, kHashChunkSize));
+  uint64_t hash = kHashSeed;
+  for (uint64_t off = 0; off < size; off += buf.size()) {
+    uint64_t len = std::min<uint64_t>(size - off, buf.size());
+    if (auto res = ReadFully(fd, buf.data(), len, off); !res) {
+      close(fd);
+      return res.error().WithContext("hashing {}", path);
+    }
+    hash = HashBytes(buf.data(), len, hash);
+  }
+  close(fd);
+  return hash;
+}
+
+void
+Touch(const std::string& path) {
+  // Access times are what orders the cache when it is reloaded; failing to
+  // update them only makes eviction less accurate.
+  if (utimensat(AT_FDCWD, path.c_str(), nullptr, 0) != 0) {
+    KATANA_LOG_DEBUG(
+        "updating cache time of {}: {}", path,
+        katana::ResultErrno().message());
+  }
+}
+
+void
+RemoveFile(const std::string& path) {
+  if (unlink(path.c_str()) != 0 && errno != ENOENT) {
+    KATANA_LOG_DEBUG(
+        "removing cached file {}: {}", path, katana::ResultErrno().message());
+  }
+}
+
+}  // namespace
+
+std::string
+tsuba::CachingStorage::DataPath(const std::string& key) const {
+  return katana::Uri::JoinPath(cache_dir_, key + kDataSuffix);
+}
+
+std::string
+tsuba::CachingStorage::MetaPath(const std::string& key) const {
+  return katana::Uri::JoinPath(cache_dir_, key + kMetaSuffix);
+}
+
+katana::Result<void>
+tsuba::CachingStorage::Init() {
+  if (auto res = backing_->Init(); !res) {
+    return res.error();
+  }
+  boost::system::error_code err;
+  fs::create_directories(cache_dir_, err);
+  if (err) {
+    return KATANA_ERROR(
+        std::error_code(err.value(), err.category()),
+        "creating cache directory {}", cache_dir_);
+  }
+  return LoadIndex();
+}
+
+katana::Result<void>
+tsuba::CachingStorage::Fini() {
+  KATANA_LOG_DEBUG(
+      "cache {} for {}: {} hits {} misses {} of {} bytes used",
+      cache_dir_, uri_scheme(), hits_.load(), misses_.load(), used_,
+      capacity_);
+  return backing_->Fini();
+}
+
+katana::Result<void>
+tsuba::CachingStorage::LoadIndex() {
+  struct Found {
+    CacheMeta meta;
+    std::string key;
+    std::time_t last_use;
+  };
+  std::vector<Found> found;
+
+  boost::system::error_code err;
+  for (fs::directory_iterator it(cache_dir_, err), end; !err && it != end;
+       it.increment(err)) {
+    const fs::path& path = it->path();
+    std::string name = path.filename().string();
+
+    // Leftovers from a process that died while populating; recent ones may
+    // belong to another process sharing the cache directory
+    if (name.find(kTmpSuffix) != std::string::npos) {
+      boost::system::error_code time_err;
+      std::time_t modified = fs::last_write_time(path, time_err);
+      if (!time_err && modified + kStaleTmpSeconds < std::time(nullptr)) {
+        RemoveFile(path.string());
+      }
+      continue;
+    }
+    if (path.extension() != kMetaSuffix) {
+      continue;
+    }
+
+    std::string key = path.stem().string();
+    std::ifstream meta_file(path.string());
+    std::string contents(
+        (std::istreambuf_iterator<char>(meta_file)),
+        std::istreambuf_iterator<char>());
+    auto meta_res = katana::JsonParse<CacheMeta>(contents);
+
+    boost::system::error_code size_err;
+    uint64_t data_size = fs::file_size(DataPath(key), size_err);
+    if (!meta_res || size_err || data_size != meta_res.value().size ||
+        CacheKey(meta_res.value().uri) != key) {
+      KATANA_LOG_DEBUG("dropping unusable cache entry {}", key);
+      RemoveFile(DataPath(key));
+      RemoveFile(MetaPath(key));
+      continue;
+    }
+
+    boost::system::error_code time_err;
+    std::time_t last_use = fs::last_write_time(DataPath(key), time_err);
+    found.emplace_back(Found{
+        .meta = std::move(meta_res.value()),
+        .key = std::move(key),
+        .last_use = time_err ? 0 : last_use,
+    });
+  }
+  if (err) {
+    return KATANA_ERROR(
+        std::error_code(err.value(), err.category()),
+        "listing cache directory {}", cache_dir_);
+  }
+
+  std::sort(found.begin(), found.end(), [](const Found& a, const Found& b) {
+    return a.last_use > b.last_use;
+  });
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (Found& f : found) {
+    lru_.push_back(f.meta.uri);
+    Entry entry{
+        .uri = f.meta.uri,
+        .key = std::move(f.key),
+        .size = f.meta.size,
+        .hash = f.meta.hash,
+        .validated = false,
+        .lru_it = std::prev(lru_.end()),
+    };
+    used_ += entry.size;
+    entries_.emplace(std::move(f.meta.uri), std::move(entry));
+  }
+  // The capacity may have shrunk since the cache was written
+  EvictFor(0);
+
+  return katana::ResultSuccess();
+}
+
+void
+tsuba::CachingStorage::EvictFor(uint64_t size) {
+  while (used_ + size > capacity_ && !lru_.empty()) {
+    Erase(lru_.back());
+  }
+}
+
+void
+tsuba::CachingStorage::Erase(const std::string& uri) {
+  auto it = entries_.find(uri);
+  if (it == entries_.end()) {
+    return;
+  }
+  Entry& entry = it->second;
+  RemoveFile(DataPath(entry.key));
+  RemoveFile(MetaPath(entry.key));
+  used_ -= entry.size;
+  lru_.erase(entry.lru_it);
+  entries_.erase(it);
+}
+
+void
+tsuba::CachingStorage::Invalidate(const std::string& uri) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Erase(uri);
+  too_large_.erase(uri);
+}
+
+void
+tsuba::CachingStorage::InvalidatePrefix(const std::string& prefix) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<std::string> doomed;
+  for (const auto& [uri, entry] : entries_) {
+    if (uri.find(prefix) == 0) {
+      doomed.emplace_back(uri);
+    }
+  }
+  for (const std::string& uri : doomed) {
+    Erase(uri);
+  }
+  for (auto it = too_large_.begin(); it != too_large_.end();) {
+    it = it->first.find(prefix) == 0 ? too_large_.erase(it) : std::next(it);
+  }
+}
+
+uint64_t
+tsuba::CachingStorage::used() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return used_;
+}
+
+bool
+tsuba::CachingStorage::Contains(const std::string& uri) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.count(uri) > 0;
+}
+
+katana::Result<void>
+tsuba::CachingStorage::Validate(const Entry& entry) {
+  StatBuf buf;
+  if (auto res = backing_->Stat(entry.uri, &buf); !res) {
+    return res.error();
+  }
+  if (buf.size != entry.size) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument,
+        "cached copy of {} has size {} but stored file has size {}", entry.uri,
+        entry.size, buf.size);
+  }
+
+  auto hash_res = HashFile(DataPath(entry.key), entry.size);
+  if (!hash_res) {
+    return hash_res.error();
+  }
+  if (hash_res.value() != entry.hash) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "cached copy of {} is corrupt", entry.uri);
+  }
+  Touch(DataPath(entry.key));
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+tsuba::CachingStorage::Insert(
+    const std::string& uri, const std::string& key, const uint8_t* data,
+    uint64_t size) {
+  if (size > capacity_) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "{} ({} bytes) does not fit in the cache",
+        uri, size);
+  }
+
+  // Reserve space now so concurrent inserts cannot overcommit the cache
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    EvictFor(size);
+    used_ += size;
+  }
+
+  uint64_t hash = HashBytes(data, size);
+  std::string tmp_path = katana::Uri::JoinPath(
+      cache_dir_,
+      key + kTmpSuffix + katana::RandomAlphanumericString(kTmpRandLen));
+  auto write = [&]() -> katana::Result<void> {
+    int fd = open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+      return KATANA_ERROR(katana::ResultErrno(), "creating {}", tmp_path);
+    }
+    if (auto res = WriteFully(fd, data, size); !res) {
+      close(fd);
+      return res.error();
+    }
+    if (close(fd) != 0) {
+      return KATANA_ERROR(katana::ResultErrno(), "closing {}", tmp_path);
+    }
+
+    auto meta_res = katana::JsonDump(CacheMeta{
+        .uri = uri,
+        .size = size,
+        .hash = hash,
+    });
+    if (!meta_res) {
+      return meta_res.error();
+    }
+    std::string meta_tmp_path = tmp_path + kMetaSuffix;
+    std::ofstream meta_file(meta_tmp_path);
+    meta_file << meta_res.value() << "\n";
+    meta_file.close();
+    if (!meta_file.good()) {
+      RemoveFile(meta_tmp_path);
+      return KATANA_ERROR(
+          ErrorCode::LocalStorageError, "writing {}", meta_tmp_path);
+    }
+
+    // Publish the data before the metadata so that a metadata file always
+    // describes a complete data file
+    if (rename(tmp_path.c_str(), DataPath(key).c_str()) != 0 ||
+        rename(meta_tmp_path.c_str(), MetaPath(key).c_str()) != 0) {
+      RemoveFile(meta_tmp_path);
+      return KATANA_ERROR(katana::ResultErrno(), "publishing cached file");
+    }
+    return katana::ResultSuccess();
+  };
+
+  auto write_res = write();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!write_res) {
+    RemoveFile(tmp_path);
+    RemoveFile(DataPath(key));
+    used_ -= size;
+    return write_res.error().WithContext("caching {}", uri);
+  }
+
+  lru_.push_front(uri);
+  entries_.emplace(
+      uri, Entry{
+               .uri = uri,
+               .key = key,
+               .size = size,
+               .hash = hash,
+               .validated = true,
+               .lru_it = lru_.begin(),
+           });
+  too_large_.erase(uri);
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+tsuba::CachingStorage::Populate(
+    const std::string& uri, const std::string& key, uint64_t size) {
+  std::vector<uint8_t> contents(size);
+  if (auto res = backing_->GetMultiSync(uri, 0, size, contents.data()); !res) {
+    return res.error().WithContext("caching {}", uri);
+  }
+  return Insert(uri, key, contents.data(), size);
+}
+
+void
+tsuba::CachingStorage::CacheAfterRead(
+    const std::string& uri, uint64_t start, uint64_t size,
+    const uint8_t* data) {
+  std::promise<katana::CopyableResult<void>> done;
+  std::optional<uint64_t> known_size;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (entries_.count(uri) > 0 || in_flight_.count(uri) > 0) {
+      return;
+    }
+    if (auto it = too_large_.find(uri); it != too_large_.end()) {
+      // Only a read of the whole file can still be cached
+      if (start != 0 || size < it->second || it->second > capacity_) {
+        return;
+      }
+      known_size = it->second;
+    }
+    in_flight_.emplace(uri, done.get_future().share());
+  }
+
+  katana::Result<void> res = katana::ResultSuccess();
+  if (!known_size) {
+    StatBuf buf;
+    res = backing_->Stat(uri, &buf);
+    if (res) {
+      known_size = buf.size;
+    }
+  }
+  if (res) {
+    uint64_t file_size = known_size.value();
+    std::string key = CacheKey(uri);
+    if (start == 0 && size >= file_size) {
+      res = Insert(uri, key, data, file_size);
+    } else if (file_size <= whole_file_max_ && file_size <= capacity_) {
+      res = Populate(uri, key, file_size);
+    } else {
+      std::lock_guard<std::mutex> lock(mutex_);
+      too_large_[uri] = file_size;
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    in_flight_.erase(uri);
+  }
+  if (!res) {
+    KATANA_LOG_DEBUG("not caching {}: {}", uri, res.error());
+    done.set_value(katana::CopyableErrorInfo(res.error()));
+    return;
+  }
+  done.set_value(katana::CopyableResultSuccess());
+}
+
+katana::Result<std::string>
+tsuba::CachingStorage::Acquire(const std::string& uri) {
+  std::string key = CacheKey(uri);
+  std::promise<katana::CopyableResult<void>> done;
+  std::optional<Entry> to_validate;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto flight_it = in_flight_.find(uri);
+    if (flight_it != in_flight_.end()) {
+      // Someone else is already caching or validating this file
+      auto pending = flight_it->second;
+      lock.unlock();
+      auto res = pending.get();
+      lock.lock();
+      if (!res) {
+        return res.error();
+      }
+    }
+
+    auto it = entries_.find(uri);
+    if (it == entries_.end()) {
+      return KATANA_ERROR(ErrorCode::NotFound, "{} is not cached", uri);
+    }
+    Entry& entry = it->second;
+    lru_.splice(lru_.begin(), lru_, entry.lru_it);
+    if (entry.validated) {
+      ++hits_;
+      return DataPath(key);
+    }
+    to_validate = entry;
+    in_flight_.emplace(uri, done.get_future().share());
+  }
+
+  katana::Result<void> res = Validate(to_validate.value());
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    in_flight_.erase(uri);
+    if (!res) {
+      KATANA_LOG_DEBUG("dropping cached copy of {}: {}", uri, res.error());
+      Erase(uri);
+    } else if (auto it = entries_.find(uri); it != entries_.end()) {
+      it->second.validated = true;
+      ++hits_;
+    } else {
+      res = KATANA_ERROR(
+          ErrorCode::NotFound, "{} was evicted while being validated", uri);
+    }
+  }
+
+  if (!res) {
+    done.set_value(katana::CopyableErrorInfo(res.error()));
+    return res.error();
+  }
+  done.set_value(katana::CopyableResultSuccess());
+  return DataPath(key);
+}
+
+katana::Result<void>
+tsuba::CachingStorage::ReadLocal(
+    const std::string& path, uint64_t start, uint64_t size,
+    uint8_t* result_buf) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return KATANA_ERROR(katana::ResultErrno(), "opening {}", path);
+  }
+  struct stat s_buf;
+  if (fstat(fd, &s_buf) != 0) {
+    close(fd);
+    return KATANA_ERROR(katana::ResultErrno(), "stat {}", path);
+  }
+  uint64_t file_size = s_buf.st_size;
+  uint64_t len = start < file_size ? std::min(size, file_size - start) : 0;
+
+  // Like LocalStorage, tolerate reads that run off the end of the file by less
+  // than a block
+  if (size - len > kBlockSize) {
+    close(fd);
+    return KATANA_ERROR(
+        ErrorCode::LocalStorageError, "read past end of cached file {}", path);
+  }
+  auto res = ReadFully(fd, result_buf, len, start);
+  close(fd);
+  return res;
+}
+
+katana::Result<void>
+tsuba::CachingStorage::GetMultiSync(
+    const std::string& uri, uint64_t start, uint64_t size,
+    uint8_t* result_buf) {
+  if (auto path_res = Acquire(uri); path_res) {
+    auto read_res = ReadLocal(path_res.value(), start, size, result_buf);
+    if (read_res) {
+      return katana::ResultSuccess();
+    }
+    KATANA_LOG_DEBUG("reading cached copy of {}: {}", uri, read_res.error());
+  }
+  ++misses_;
+  if (auto res = backing_->GetMultiSync(uri, start, size, result_buf); !res) {
+    return res.error();
+  }
+  CacheAfterRead(uri, start, size, result_buf);
+  return katana::ResultSuccess();
+}
+
+std::future<katana::CopyableResult<void>>
+tsuba::CachingStorage::GetAsync(
+    const std::string& uri, uint64_t start, uint64_t size,
+    uint8_t* result_buf) {
+  bool cached = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cached = entries_.count(uri) > 0 || in_flight_.count(uri) > 0;
+  }
+  if (cached) {
+    // Like LocalStorage, serve local copies before returning
+    if (auto res = GetMultiSync(uri, start, size, result_buf); !res) {
+      katana::CopyableErrorInfo cei{res.error()};
+      return std::async(
+          std::launch::deferred,
+          [=]() -> katana::CopyableResult<void> { return cei; });
+    }
+    return std::async(
+        std::launch::deferred, []() -> katana::CopyableResult<void> {
+          return katana::CopyableResultSuccess();
+        });
+  }
+
+  // Leave the read to the wrapped storage and cache the file once it is done
+  ++misses_;
+  auto fut = backing_->GetAsync(uri, start, size, result_buf);
+  return std::async(
+      std::launch::deferred,
+      [this, uri, start, size, result_buf,
+       fut = std::move(fut)]() mutable -> katana::CopyableResult<void> {
+        auto res = fut.get();
+        if (res) {
+          CacheAfterRead(uri, start, size, result_buf);
+        }
+        return res;
+      });
+}
+
+katana::Result<void>
+tsuba::CachingStorage::PutMultiSync(
+    const std::string& uri, const uint8_t* data, uint64_t size) {
+  Invalidate(uri);
+  return backing_->PutMultiSync(uri, data, size);
+}
+
+std::future<katana::CopyableResult<void>>
+tsuba::CachingStorage::PutAsync(
+    const std::string& uri, const uint8_t* data, uint64_t size) {
+  Invalidate(uri);
+  return backing_->PutAsync(uri, data, size);
+}
+
+katana::Result<void>
+tsuba::CachingStorage::RemoteCopy(
+    const std::string& source_uri, const std::string& dest_uri, uint64_t begin,
+    uint64_t size) {
+  Invalidate(dest_uri);
+  return backing_->RemoteCopy(source_uri, dest_uri, begin, size);
+}
+
+katana::Result<void>
+tsuba::CachingStorage::Delete(
+    const std::string& directory,
+    const std::unordered_set<std::string>& files) {
+  if (files.empty()) {
+    InvalidatePrefix(directory);
+  } else {
+    for (const std::string& file : files) {
+      Invalidate(katana::Uri::JoinPath(directory, file));
+    }
+  }
+  return backing_->Delete(directory, files);
+}
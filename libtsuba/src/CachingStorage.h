@@ -0,0 +1,170 @@
+#ifndef KATANA_LIBTSUBA_CACHINGSTORAGE_H_
+#define KATANA_LIBTSUBA_CACHINGSTORAGE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "katana/Result.h"
+#include "katana/config.h"
+#include "tsuba/FileStorage.h"
+
+namespace tsuba {
+
+/// Wrap another FileStorage and keep whole copies of the files read through it
+/// in a directory on local storage. Subsequent reads of a cached file, from
+/// this process or a later one using the same cache directory, are served from
+/// the local copy.
+///
+/// Only files of at most whole_file_max bytes are fetched in full on a miss.
+/// Reads of larger files go straight to the wrapped storage, and are cached
+/// only when a read happens to cover the whole file.
+///
+/// The cache holds at most capacity bytes; when it is full the least recently
+/// used files are evicted. Every cached file is stored with a hash of its
+/// contents and its size on the backing store. The first time a process uses a
+/// cached file, the local copy is rehashed and the backing size is checked, so
+/// a corrupted or stale copy is refetched rather than returned.
+///
+/// Caching is best effort: any failure to use the cache falls back to the
+/// wrapped storage. Writes, copies and deletes go to the wrapped storage and
+/// invalidate the affected cache entries.
+class KATANA_EXPORT CachingStorage : public FileStorage {
+public:
+  static constexpr uint64_t kDefaultWholeFileMax = UINT64_C(64) << 20;
+
+  /// \param backing the storage being cached; CachingStorage does not own it
+  /// \param cache_dir local directory holding the cached files
+  /// \param capacity maximum number of bytes of cached file contents
+  /// \param whole_file_max largest file fetched in full on a miss
+  CachingStorage(
+      FileStorage* backing, std::string cache_dir, uint64_t capacity,
+      uint64_t whole_file_max = kDefaultWholeFileMax)
+      : FileStorage(backing->uri_scheme()),
+        backing_(backing),
+        cache_dir_(std::move(cache_dir)),
+        capacity_(capacity),
+        whole_file_max_(whole_file_max) {}
+
+  katana::Result<void> Init() override;
+  katana::Result<void> Fini() override;
+  katana::Result<void> Stat(const std::string& uri, StatBuf* size) override {
+    return backing_->Stat(uri, size);
+  }
+
+  uint32_t Priority() const override { return backing_->Priority(); }
+
+  katana::Result<void> GetMultiSync(
+      const std::string& uri, uint64_t start, uint64_t size,
+      uint8_t* result_buf) override;
+
+  katana::Result<void> PutMultiSync(
+      const std::string& uri, const uint8_t* data, uint64_t size) override;
+
+  katana::Result<void> RemoteCopy(
+      const std::string& source_uri, const std::string& dest_uri,
+      uint64_t begin, uint64_t size) override;
+
+  std::future<katana::CopyableResult<void>> PutAsync(
+      const std::string& uri, const uint8_t* data, uint64_t size) override;
+  std::future<katana::CopyableResult<void>> GetAsync(
+      const std::string& uri, uint64_t start, uint64_t size,
+      uint8_t* result_buf) override;
+  std::future<katana::CopyableResult<void>> ListAsync(
+      const std::string& directory, std::vector<std::string>* list,
+      std::vector<uint64_t>* size) override {
+    return backing_->ListAsync(directory, list, size);
+  }
+
+  katana::Result<void> Delete(
+      const std::string& directory,
+      const std::unordered_set<std::string>& files) override;
+
+  const std::string& cache_dir() const { return cache_dir_; }
+  uint64_t capacity() const { return capacity_; }
+  uint64_t whole_file_max() const { return whole_file_max_; }
+
+  /// Reads served from a valid local copy
+  uint64_t hits() const { return hits_; }
+  /// Reads that went to the wrapped storage
+  uint64_t misses() const { return misses_; }
+  /// Bytes of file contents in the cache
+  uint64_t used();
+  /// Whether a local copy of uri is in the cache; the copy is not validated
+  bool Contains(const std::string& uri);
+
+private:
+  struct Entry {
+    std::string uri;
+    std::string key;
+    uint64_t size{0};
+    uint64_t hash{0};
+    /// true once the local copy has been checked by this process
+    bool validated{false};
+    std::list<std::string>::iterator lru_it;
+  };
+
+  katana::Result<void> LoadIndex();
+
+  /// Return the path of a valid local copy of uri, or an error if there is
+  /// none. An unvalidated copy is validated and dropped if it is stale.
+  katana::Result<std::string> Acquire(const std::string& uri);
+  katana::Result<void> Validate(const Entry& entry);
+
+  /// Cache uri after [start, start + size) of it was read from the wrapped
+  /// storage into data. Files no larger than whole_file_max_ are fetched in
+  /// full unless the read already covered them.
+  void CacheAfterRead(
+      const std::string& uri, uint64_t start, uint64_t size,
+      const uint8_t* data);
+  katana::Result<void> Populate(
+      const std::string& uri, const std::string& key, uint64_t size);
+  /// Write the contents of uri to the cache and add an entry for it
+  katana::Result<void> Insert(
+      const std::string& uri, const std::string& key, const uint8_t* data,
+      uint64_t size);
+
+  katana::Result<void> ReadLocal(
+      const std::string& path, uint64_t start, uint64_t size,
+      uint8_t* result_buf);
+
+  /// Make room for size more bytes. Caller must hold mutex_.
+  void EvictFor(uint64_t size);
+  /// Drop an entry and its files. Caller must hold mutex_.
+  void Erase(const std::string& uri);
+  void Invalidate(const std::string& uri);
+  void InvalidatePrefix(const std::string& prefix);
+
+  std::string DataPath(const std::string& key) const;
+  std::string MetaPath(const std::string& key) const;
+
+  FileStorage* backing_;
+  std::string cache_dir_;
+  uint64_t capacity_;
+  uint64_t whole_file_max_;
+
+  std::mutex mutex_;
+  uint64_t used_{0};
+  /// uris ordered from most to least recently used
+  std::list<std::string> lru_;
+  std::unordered_map<std::string, Entry> entries_;
+  /// uris currently being fetched into the cache
+  std::unordered_map<
+      std::string, std::shared_future<katana::CopyableResult<void>>>
+      in_flight_;
+  /// sizes of uris too large to cache, so that reads of them skip Stat
+  std::unordered_map<std::string, uint64_t> too_large_;
+
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+};
+
+}  // namespace tsuba
+
+#endif
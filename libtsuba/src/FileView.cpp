@@ -3,10 +3,12 @@
 #include <sys/mman.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cstdio>
 #include <string>
 
+#include "GlobalState.h"
 #include "katana/Logging.h"
 #include "katana/Result.h"
 #include "tsuba/Errors.h"
@@ -53,6 +55,8 @@ FileView::Unbind() {
     }
     valid_ = false;
   }
+  last_read_end_ = -1;
+  window_ = 0;
   return katana::ResultSuccess();
 }
 
@@ -95,7 +99,9 @@ FileView::Bind(
   filling_.resize(page_number(buf.size) / 64 + 1, 0);
   file_size_ = buf.size;
   fetches_ = std::make_unique<std::vector<FillingRange>>();
-  if (auto res = Fill(begin, in_end, resolve); !res) {
+  bool background =
+      !resolve && read_ahead_.pattern == AccessPattern::kWillNeed;
+  if (auto res = DoFill(begin, in_end, resolve, background); !res) {
     return res.error().WithContext("reading content");
   }
 
@@ -106,6 +112,13 @@ FileView::Bind(
 
 katana::Result<void>
 FileView::Fill(uint64_t begin, uint64_t end, bool resolve) {
+  bool background =
+      !resolve && read_ahead_.pattern == AccessPattern::kWillNeed;
+  return DoFill(begin, end, resolve, background);
+}
+
+katana::Result<void>
+FileView::DoFill(uint64_t begin, uint64_t end, bool resolve, bool background) {
   uint64_t in_end = std::min<uint64_t>(end, file_size_);
   uint64_t in_begin = std::min<uint64_t>(begin, in_end);
   uint64_t first_page = 0;
@@ -139,8 +152,19 @@ FileView::Fill(uint64_t begin, uint64_t end, bool resolve) {
         return KATANA_ERROR(katana::ResultErrno(), "mprotecting buffer");
       }
 
-      auto peek_fut =
-          FileGetAsync(filename_, map_start_ + file_off, file_off, map_size);
+      std::future<katana::CopyableResult<void>> peek_fut;
+      if (background) {
+        peek_fut = IO()->Submit(
+            [filename = filename_, dest = map_start_ + file_off, file_off,
+             map_size]() -> katana::CopyableResult<void> {
+              auto fut = FileGetAsync(filename, dest, file_off, map_size);
+              KATANA_LOG_ASSERT(fut.valid());
+              return fut.get();
+            });
+      } else {
+        peek_fut =
+            FileGetAsync(filename_, map_start_ + file_off, file_off, map_size);
+      }
       KATANA_LOG_ASSERT(peek_fut.valid());
       FillingRange fetch = {first_page, last_page, std::move(peek_fut)};
       fetches_->push_back(std::move(fetch));
@@ -404,7 +428,7 @@ FileView::MustFill(uint64_t* bitmap, uint64_t begin, uint64_t end) {
   // searching backward
   if (found_first && !found_last) {
     // search backward for last page, skip end_block
-    for (uint64_t i = end_block - 1; i > begin_block && !found_last; ++i) {
+    for (uint64_t i = end_block - 1; i > begin_block && !found_last; --i) {
       if (~bitmap[i]) {
         last_page = LastPage(bitmap, i, 0, 63);
         found_last = true;
@@ -458,7 +482,7 @@ FileView::Resolve(int64_t start, int64_t size) {
   // bottleneck
   for (auto it = fetches_->begin(); it != fetches_->end();) {
     auto fetch = it;
-    if (fetch->first_page <= page_number(start + size) ||
+    if (fetch->first_page <= page_number(start + size) &&
         fetch->last_page >= page_number(start)) {
       // Complete the remaining work if there is some
       if (fetch->work.valid()) {
@@ -478,16 +502,40 @@ FileView::Resolve(int64_t start, int64_t size) {
 
 katana::Result<void>
 FileView::PreFetch(int64_t start, int64_t size) {
-  // Our highly sophisticated prefetching algorithm is to crudely approximate
-  // the size of the last read plus 10%. This is largely motivated by parquet
-  // files, which consecutively read row groups that are (in theory)
-  // approximately the same size.
-  int64_t fetch_size = (size / 10) * 11;
-  // Make sure we haven't overflown
-  KATANA_LOG_DEBUG_ASSERT(fetch_size >= 0);
+  // Reads that pick up where the last one stopped (give or take a block of
+  // parquet page padding) are treated as part of a sequential run
+  bool sequential = last_read_end_ >= 0 && start >= last_read_end_ &&
+                    start - last_read_end_ <= static_cast<int64_t>(kBlockSize);
+  last_read_end_ = start + size;
+
+  uint64_t fetch_size = 0;
+  switch (read_ahead_.pattern) {
+  case AccessPattern::kRandom:
+    return katana::ResultSuccess();
+  case AccessPattern::kSequential:
+  case AccessPattern::kWillNeed:
+    fetch_size = read_ahead_.max_window;
+    break;
+  case AccessPattern::kAdaptive:
+    if (sequential) {
+      window_ = window_ == 0 ? read_ahead_.min_window
+                             : std::min(window_ * 2, read_ahead_.max_window);
+      fetch_size = window_;
+    } else {
+      // Outside of a sequential run, crudely approximate the size of the last
+      // read plus 10%. This is largely motivated by parquet files, which
+      // consecutively read row groups that are (in theory) approximately the
+      // same size.
+      window_ = 0;
+      fetch_size = std::min<uint64_t>(
+          (static_cast<uint64_t>(size) / 10) * 11, read_ahead_.max_window);
+    }
+    break;
+  }
+
   uint64_t begin = static_cast<uint64_t>(start + size);
-  uint64_t end = static_cast<uint64_t>(start + size + fetch_size);
-  if (auto res = Fill(begin, end, false); !res) {
+  uint64_t end = begin + fetch_size;
+  if (auto res = DoFill(begin, end, false, true); !res) {
     return res.error();
   }
   return katana::ResultSuccess();
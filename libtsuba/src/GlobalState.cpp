@@ -4,12 +4,22 @@
 #include <cassert>
 
 #include "FileStorage_internal.h"
+#include "katana/Env.h"
 #include "katana/Logging.h"
 #include "katana/Result.h"
+#include "katana/URI.h"
 #include "tsuba/Errors.h"
 
 std::unique_ptr<tsuba::GlobalState> tsuba::GlobalState::ref_ = nullptr;
 
+namespace {
+
+constexpr int kDefaultCacheSizeMB = 16 << 10;  // 16 GB
+constexpr int kDefaultCacheWholeFileMB = 64;
+constexpr int kDefaultIOThreads = 16;
+
+}  // namespace
+
 katana::CommBackend*
 tsuba::GlobalState::Comm() const {
   KATANA_LOG_DEBUG_ASSERT(comm_ != nullptr);
@@ -32,6 +42,48 @@ tsuba::GlobalState::FS(std::string_view uri) const {
   return GetDefaultFS();
 }
 
+tsuba::GlobalState::GlobalState(katana::CommBackend* comm) : comm_(comm) {
+  file_stores_.emplace_back(&local_storage_);
+
+  int io_threads = kDefaultIOThreads;
+  katana::GetEnv("KATANA_TSUBA_IO_THREADS", &io_threads);
+  io_pool_ = std::make_unique<IOPool>(std::max(io_threads, 1));
+}
+
+void
+tsuba::GlobalState::WrapWithCache() {
+  std::string cache_dir;
+  if (!katana::GetEnv("KATANA_TSUBA_CACHE_DIR", &cache_dir) ||
+      cache_dir.empty()) {
+    return;
+  }
+  int cache_size_mb = kDefaultCacheSizeMB;
+  katana::GetEnv("KATANA_TSUBA_CACHE_SIZE_MB", &cache_size_mb);
+  if (cache_size_mb <= 0) {
+    return;
+  }
+  bool cache_local = false;
+  katana::GetEnv("KATANA_TSUBA_CACHE_LOCAL", &cache_local);
+  int whole_file_mb = kDefaultCacheWholeFileMB;
+  katana::GetEnv("KATANA_TSUBA_CACHE_WHOLE_FILE_MB", &whole_file_mb);
+  whole_file_mb = std::max(whole_file_mb, 0);
+
+  for (FileStorage*& fs : file_stores_) {
+    if (fs == &local_storage_ && !cache_local) {
+      continue;
+    }
+    // Give each backend its own directory so that their indexes and
+    // capacities are independent
+    std::string scheme(fs->uri_scheme());
+    scheme = scheme.substr(0, scheme.find(':'));
+    caching_stores_.emplace_back(std::make_unique<CachingStorage>(
+        fs, katana::Uri::JoinPath(cache_dir, scheme),
+        static_cast<uint64_t>(cache_size_mb) << 20,
+        static_cast<uint64_t>(whole_file_mb) << 20));
+    fs = caching_stores_.back().get();
+  }
+}
+
 katana::Result<void>
 tsuba::GlobalState::Init(katana::CommBackend* comm) {
   KATANA_LOG_DEBUG_ASSERT(ref_ == nullptr);
@@ -51,6 +103,8 @@ tsuba::GlobalState::Init(katana::CommBackend* comm) {
         return lhs->Priority() > rhs->Priority();
       });
 
+  global_state->WrapWithCache();
+
   for (FileStorage* fs : global_state->file_stores_) {
     if (auto res = fs->Init(); !res) {
       return res.error().WithContext("initializing backends");
@@ -63,6 +117,8 @@ tsuba::GlobalState::Init(katana::CommBackend* comm) {
 
 katana::Result<void>
 tsuba::GlobalState::Fini() {
+  // Let queued storage calls finish while the backends are still up
+  ref_->io_pool_.reset();
   for (FileStorage* fs : ref_->file_stores_) {
     if (auto res = fs->Fini(); !res) {
       return res.error().WithContext(
@@ -91,6 +147,11 @@ tsuba::FS(std::string_view uri) {
   return GlobalState::Get().FS(uri);
 }
 
+tsuba::IOPool*
+tsuba::IO() {
+  return GlobalState::Get().io_pool();
+}
+
 katana::Result<void>
 tsuba::OneHostOnly(const std::function<katana::Result<void>()>& cb) {
   // Prevent a race when the callback affects a condition guarding the
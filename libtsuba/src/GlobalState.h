@@ -4,6 +4,8 @@
 #include <memory>
 #include <vector>
 
+#include "CachingStorage.h"
+#include "IOPool.h"
 #include "LocalStorage.h"
 #include "katana/CommBackend.h"
 #include "katana/Logging.h"
@@ -19,13 +21,17 @@ class GlobalState {
   katana::CommBackend* comm_;
 
   tsuba::LocalStorage local_storage_;
+  std::vector<std::unique_ptr<CachingStorage>> caching_stores_;
+  std::unique_ptr<IOPool> io_pool_;
 
-  GlobalState(katana::CommBackend* comm) : comm_(comm) {
-    file_stores_.emplace_back(&local_storage_);
-  }
+  GlobalState(katana::CommBackend* comm);
 
   FileStorage* GetDefaultFS() const;
 
+  /// If KATANA_TSUBA_CACHE_DIR is set, replace file stores with
+  /// CachingStorage wrappers (see docs/doxygen/env.md)
+  void WrapWithCache();
+
 public:
   GlobalState(const GlobalState& no_copy) = delete;
   GlobalState(const GlobalState&& no_move) = delete;
@@ -46,6 +52,9 @@ public:
   /// {no scheme} -> LocalStore
   FileStorage* FS(std::string_view uri) const;
 
+  /// Threads for blocking storage calls that should overlap with the caller
+  IOPool* io_pool() const { return io_pool_.get(); }
+
   static katana::Result<void> Init(katana::CommBackend* comm);
   static katana::Result<void> Fini();
   static const GlobalState& Get();
@@ -53,6 +62,7 @@ public:
 
 katana::CommBackend* Comm();
 FileStorage* FS(std::string_view uri);
+IOPool* IO();
 
 /// Execute cb on one host, if it succeeds return success if not print
 /// the error and return MpiError
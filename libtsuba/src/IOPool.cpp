@@ -0,0 +1,55 @@
+#include "IOPool.h"
+
+#include "katana/Logging.h"
+
+tsuba::IOPool::~IOPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  for (std::thread& thread : threads_) {
+    thread.join();
+  }
+}
+
+std::future<katana::CopyableResult<void>>
+tsuba::IOPool::Submit(Task task) {
+  std::packaged_task<katana::CopyableResult<void>()> packaged(std::move(task));
+  auto future = packaged.get_future();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    KATANA_LOG_DEBUG_ASSERT(!stopping_);
+    queue_.emplace_back(std::move(packaged));
+    // Only start a thread when none is free to take the task
+    if (idle_ < queue_.size() && threads_.size() < max_threads_) {
+      threads_.emplace_back([this]() { Run(); });
+    }
+  }
+  cv_.notify_one();
+  return future;
+}
+
+uint32_t
+tsuba::IOPool::num_threads() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return threads_.size();
+}
+
+void
+tsuba::IOPool::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    ++idle_;
+    cv_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+    --idle_;
+    if (queue_.empty()) {
+      return;
+    }
+    auto task = std::move(queue_.front());
+    queue_.pop_front();
+    lock.unlock();
+    task();
+    lock.lock();
+  }
+}
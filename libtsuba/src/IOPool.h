@@ -0,0 +1,59 @@
+#ifndef KATANA_LIBTSUBA_IOPOOL_H_
+#define KATANA_LIBTSUBA_IOPOOL_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "katana/Result.h"
+#include "katana/config.h"
+
+namespace tsuba {
+
+/// A bounded set of threads for blocking storage calls. Work that needs its own
+/// thread to overlap with the caller, like reading ahead from a backend whose
+/// async calls complete synchronously, is queued here so that the number of
+/// threads and concurrent requests stays bounded. Threads are started as work
+/// arrives, up to max_threads.
+class KATANA_EXPORT IOPool {
+public:
+  using Task = std::function<katana::CopyableResult<void>()>;
+
+  explicit IOPool(uint32_t max_threads) : max_threads_(max_threads) {}
+  IOPool(const IOPool&) = delete;
+  IOPool& operator=(const IOPool&) = delete;
+  IOPool(IOPool&&) = delete;
+  IOPool& operator=(IOPool&&) = delete;
+
+  /// Runs the tasks that are still queued before returning
+  ~IOPool();
+
+  /// Queue task and return a future for its result
+  std::future<katana::CopyableResult<void>> Submit(Task task);
+
+  uint32_t max_threads() const { return max_threads_; }
+
+  /// Number of threads started so far
+  uint32_t num_threads();
+
+private:
+  void Run();
+
+  uint32_t max_threads_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::packaged_task<katana::CopyableResult<void>()>> queue_;
+  std::vector<std::thread> threads_;
+  uint32_t idle_{0};
+  bool stopping_{false};
+};
+
+}  // namespace tsuba
+
+#endif
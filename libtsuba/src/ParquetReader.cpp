@@ -73,8 +73,12 @@ HandleBadParquetTypes(std::shared_ptr<arrow::ChunkedArray> old_array) {
 Result<std::unique_ptr<parquet::arrow::FileReader>>
 MakeFileReader(
     const katana::Uri& uri, uint64_t preload_start, uint64_t preload_end,
+    tsuba::AccessPattern access_pattern,
     std::shared_ptr<tsuba::FileView>* fv_ptr = nullptr) {
   auto fv = std::make_shared<tsuba::FileView>(tsuba::FileView());
+  tsuba::ReadAheadPolicy policy;
+  policy.pattern = access_pattern;
+  fv->set_read_ahead_policy(policy);
   if (auto res = fv->Bind(uri.string(), preload_start, preload_end, false);
       !res) {
     return res.error().WithContext("opening {}", uri);
@@ -99,8 +103,8 @@ MakeFileReader(
 
 Result<std::unique_ptr<tsuba::ParquetReader>>
 tsuba::ParquetReader::Make(ReadOpts opts) {
-  return std::unique_ptr<ParquetReader>(
-      new ParquetReader(opts.slice, opts.make_cannonical));
+  return std::unique_ptr<ParquetReader>(new ParquetReader(
+      opts.slice, opts.make_cannonical, opts.access_pattern));
 }
 
 // Internal use only, invoke iff slice_ has a value
@@ -114,7 +118,7 @@ tsuba::ParquetReader::ReadFromUriSliced(const katana::Uri& uri) {
   }
 
   std::shared_ptr<FileView> fv;
-  auto reader_res = MakeFileReader(uri, 0, 0, &fv);
+  auto reader_res = MakeFileReader(uri, 0, 0, access_pattern_, &fv);
   if (!reader_res) {
     return reader_res.error();
   }
@@ -166,8 +170,8 @@ tsuba::ParquetReader::ReadTable(const katana::Uri& uri) {
     return ReadFromUriSliced(uri);
   }
 
-  auto reader_res =
-      MakeFileReader(uri, 0, std::numeric_limits<uint64_t>::max());
+  auto reader_res = MakeFileReader(
+      uri, 0, std::numeric_limits<uint64_t>::max(), access_pattern_);
   if (!reader_res) {
     return reader_res.error();
   }
@@ -226,7 +230,7 @@ tsuba::ParquetReader::DoFilteredTableRead(
 
 Result<std::shared_ptr<arrow::Table>>
 tsuba::ParquetReader::ReadColumn(const katana::Uri& uri, int32_t column_idx) {
-  auto reader_res = MakeFileReader(uri, 0, 0);
+  auto reader_res = MakeFileReader(uri, 0, 0, access_pattern_);
   if (!reader_res) {
     return reader_res.error();
   }
@@ -246,7 +250,7 @@ tsuba::ParquetReader::ReadColumn(const katana::Uri& uri, int32_t column_idx) {
 Result<std::shared_ptr<arrow::Table>>
 tsuba::ParquetReader::ReadTable(
     const katana::Uri& uri, const std::vector<int32_t>& column_indexes) {
-  auto reader_res = MakeFileReader(uri, 0, 0);
+  auto reader_res = MakeFileReader(uri, 0, 0, access_pattern_);
   if (!reader_res) {
     return reader_res.error();
   }
@@ -264,7 +268,7 @@ tsuba::ParquetReader::ReadTable(
 
 Result<int32_t>
 tsuba::ParquetReader::NumColumns(const katana::Uri& uri) {
-  auto reader_res = MakeFileReader(uri, 0, 0);
+  auto reader_res = MakeFileReader(uri, 0, 0, access_pattern_);
   if (!reader_res) {
     return reader_res.error();
   }
@@ -275,7 +279,7 @@ tsuba::ParquetReader::NumColumns(const katana::Uri& uri) {
 
 Result<int64_t>
 tsuba::ParquetReader::NumRows(const katana::Uri& uri) {
-  auto reader_res = MakeFileReader(uri, 0, 0);
+  auto reader_res = MakeFileReader(uri, 0, 0, access_pattern_);
   if (!reader_res) {
     return reader_res.error();
   }
@@ -213,48 +213,42 @@ tsuba::ParquetWriter::StoreParquet(
     return res.error().WithContext("creating output buffer");
   }
   ff->Bind(uri.string());
-  auto future = std::async(
-      std::launch::async,
-      [table = std::move(table), ff = std::move(ff), desc,
-       writer_props = StandardWriterProperties(),
-       arrow_props = StandardArrowProperties()]() mutable
+  // encoded size is usually no more than the in-memory size
+  uint64_t size_hint = katana::ApproxTableMemUse(table);
+  auto encode = [table = std::move(table),
+                 writer_props = StandardWriterProperties(),
+                 arrow_props = StandardArrowProperties()](
+                    const std::shared_ptr<tsuba::FileFrame>& ff) mutable
       -> katana::CopyableResult<void> {
-        auto res = HandleBadParquetTypes(table);
-        if (!res) {
-          return res.error().WithContext(
-              "conversion from arrow to parquet mismatch");
-        }
-        table = std::move(res.value());
-        auto write_result = parquet::arrow::WriteTable(
-            *table, arrow::default_memory_pool(), ff,
-            std::numeric_limits<int64_t>::max(), writer_props, arrow_props);
-        table.reset();
-
-        if (!write_result.ok()) {
-          return KATANA_ERROR(
-              tsuba::ErrorCode::ArrowError, "arrow error: {}", write_result);
-        }
-        if (desc) {
-          desc->AddToOutstanding(ff->map_size());
-        }
-
-        TSUBA_PTP(tsuba::internal::FaultSensitivity::Normal);
-        if (auto res = ff->Persist(); !res) {
-          return res.error();
-        }
-        return katana::CopyableResultSuccess();
-      });
-
-  if (!desc) {
-    auto res = future.get();
+    auto res = HandleBadParquetTypes(table);
     if (!res) {
-      return res.error();
+      return res.error().WithContext(
+          "conversion from arrow to parquet mismatch");
     }
+    table = std::move(res.value());
+    auto write_result = parquet::arrow::WriteTable(
+        *table, arrow::default_memory_pool(), ff,
+        std::numeric_limits<int64_t>::max(), writer_props, arrow_props);
+    table.reset();
+
+    if (!write_result.ok()) {
+      return KATANA_ERROR(
+          tsuba::ErrorCode::ArrowError, "arrow error: {}", write_result);
+    }
+    return katana::CopyableResultSuccess();
+  };
+
+  if (desc) {
+    // encoding overlaps with the writes of earlier tables in the group
+    desc->StartEncodeAndStore(std::move(ff), std::move(encode), size_hint);
     return katana::ResultSuccess();
   }
 
-  desc->AddOp(std::move(future), uri.string());
-  return katana::ResultSuccess();
+  if (auto res = encode(ff); !res) {
+    return res.error();
+  }
+  TSUBA_PTP(tsuba::internal::FaultSensitivity::Normal);
+  return ff->Persist();
 }
 
 katana::Result<void>
@@ -65,7 +65,19 @@ MasterPropName(unsigned i) {
 katana::Result<std::string>
 StoreArrowArrayAtName(
     const std::shared_ptr<arrow::ChunkedArray>& array, const katana::Uri& dir,
-    const std::string& name, tsuba::WriteGroup* desc) {
+    const std::string& name, tsuba::WriteGroup* desc,
+    tsuba::PropertyFormat format = tsuba::PropertyFormat::kParquet) {
+  if (format == tsuba::PropertyFormat::kArrowIPC) {
+    katana::Uri new_path =
+        dir.RandFile(name) + std::string(tsuba::kArrowIPCExtension);
+    auto table = arrow::Table::Make(
+        arrow::schema({arrow::field(name, array->type())}), {array});
+    if (auto res = tsuba::WriteArrowIPC(table, new_path, desc); !res) {
+      return res.error().WithContext("writing property as arrow ipc");
+    }
+    return new_path.BaseName();
+  }
+
   auto writer_res = tsuba::ParquetWriter::Make(array, name);
   if (!writer_res) {
     return writer_res.error().WithContext("making property writer");
@@ -98,8 +110,8 @@ WriteProperties(
     }
     auto name = prop_info[i].name.empty() ? schema->field(col_idx)->name()
                                           : prop_info[i].name;
-    auto name_res =
-        StoreArrowArrayAtName(props.column(col_idx), dir, name, desc);
+    auto name_res = StoreArrowArrayAtName(
+        props.column(col_idx), dir, name, desc, prop_info[i].format);
     if (!name_res) {
       return name_res.error().WithContext("storing arrow array");
     }
@@ -126,7 +138,7 @@ katana::Result<void>
 CommitRDG(
     tsuba::RDGHandle handle, uint32_t policy_id, bool transposed,
     tsuba::RDG::RDGVersioningPolicy versioning_action,
-    const tsuba::RDGLineage& lineage, std::unique_ptr<tsuba::WriteGroup> desc) {
+    const tsuba::RDGLineage& lineage, tsuba::WriteGroup* desc) {
   katana::CommBackend* comm = tsuba::Comm();
   tsuba::RDGManifest new_manifest =
       (versioning_action == tsuba::RDG::RetainVersion)
@@ -409,12 +421,13 @@ tsuba::RDG::DoStore(
 
   // Update lineage and commit
   lineage_.AddCommandLine(command_line);
-  if (auto res = CommitRDG(
-          handle, core_->part_header().metadata().policy_id_,
-          core_->part_header().metadata().transposed_, versioning_action,
-          lineage_, std::move(write_group));
-      !res) {
-    return res.error().WithContext("failed to finalize RDG");
+  auto commit_res = CommitRDG(
+      handle, core_->part_header().metadata().policy_id_,
+      core_->part_header().metadata().transposed_, versioning_action, lineage_,
+      write_group.get());
+  last_store_stats_ = write_group->stats();
+  if (!commit_res) {
+    return commit_res.error().WithContext("failed to finalize RDG");
   }
   return katana::ResultSuccess();
 }
@@ -683,8 +696,8 @@ UnloadProperty(
 
   tsuba::PropStorageInfo& prop_info = *psi_it;
 
-  prop_info.path = KATANA_CHECKED(
-      StoreArrowArrayAtName(props->column(i), dir, name, nullptr));
+  prop_info.path = KATANA_CHECKED(StoreArrowArrayAtName(
+      props->column(i), dir, name, nullptr, prop_info.format));
   prop_info.persist = true;
   prop_info.written_out = true;
 
@@ -711,6 +724,99 @@ tsuba::RDG::UnloadEdgeProperty(uint32_t i) {
   return katana::ResultSuccess();
 }
 
+namespace {
+
+katana::Result<void>
+CheckLoaded(const std::vector<tsuba::PropStorageInfo>& prop_info_list) {
+  for (const tsuba::PropStorageInfo& prop_info : prop_info_list) {
+    if (prop_info.written_out) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "property {} is unloaded; it must be in memory", prop_info.name);
+    }
+  }
+  return katana::ResultSuccess();
+}
+
+/// Storage records for the columns of props, in column order. Columns that
+/// already had a record keep its persistence and format, but clear its path
+/// so they are rewritten; records of other properties are dropped.
+katana::Result<std::vector<tsuba::PropStorageInfo>>
+ReplacedPropStorageInfo(
+    const std::shared_ptr<arrow::Table>& props,
+    const std::vector<tsuba::PropStorageInfo>& prop_info_list) {
+  KATANA_CHECKED(CheckLoaded(prop_info_list));
+  if (!props->schema()->HasDistinctFieldNames()) {
+    return KATANA_ERROR(
+        tsuba::ErrorCode::Exists, "column names are not distinct: {}",
+        fmt::join(props->schema()->field_names(), ", "));
+  }
+
+  std::vector<tsuba::PropStorageInfo> next_prop_info_list;
+  for (const auto& field : props->schema()->fields()) {
+    auto psi_it = std::find_if(
+        prop_info_list.begin(), prop_info_list.end(),
+        [&](const tsuba::PropStorageInfo& psi) {
+          return psi.name == field->name();
+        });
+    tsuba::PropStorageInfo prop_info{
+        .name = field->name(),
+        .path = "",
+    };
+    if (psi_it != prop_info_list.end()) {
+      prop_info.persist = psi_it->persist;
+      prop_info.format = psi_it->format;
+    }
+    next_prop_info_list.emplace_back(std::move(prop_info));
+  }
+  return next_prop_info_list;
+}
+
+}  // namespace
+
+katana::Result<void>
+tsuba::RDG::CheckPropertiesLoaded() const {
+  KATANA_CHECKED_CONTEXT(
+      CheckLoaded(core_->part_header().node_prop_info_list()),
+      "node properties");
+  KATANA_CHECKED_CONTEXT(
+      CheckLoaded(core_->part_header().edge_prop_info_list()),
+      "edge properties");
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+tsuba::RDG::ReplaceProperties(
+    const std::shared_ptr<arrow::Table>& node_props,
+    const std::shared_ptr<arrow::Table>& edge_props) {
+  // Build both sets of records before changing anything, so that a failure
+  // leaves the properties as they were
+  auto next_node_prop_info_list = KATANA_CHECKED_CONTEXT(
+      ReplacedPropStorageInfo(
+          node_props, core_->part_header().node_prop_info_list()),
+      "node properties");
+  auto next_edge_prop_info_list = KATANA_CHECKED_CONTEXT(
+      ReplacedPropStorageInfo(
+          edge_props, core_->part_header().edge_prop_info_list()),
+      "edge properties");
+
+  if (node_props->num_columns() > 0) {
+    core_->set_node_properties(std::shared_ptr<arrow::Table>(node_props));
+  } else {
+    core_->drop_node_properties();
+  }
+  if (edge_props->num_columns() > 0) {
+    core_->set_edge_properties(std::shared_ptr<arrow::Table>(edge_props));
+  } else {
+    core_->drop_edge_properties();
+  }
+  core_->part_header().set_node_prop_info_list(
+      std::move(next_node_prop_info_list));
+  core_->part_header().set_edge_prop_info_list(
+      std::move(next_edge_prop_info_list));
+  return katana::ResultSuccess();
+}
+
 void
 tsuba::RDG::MarkAllPropertiesPersistent() {
   core_->part_header().MarkAllPropertiesPersistent();
@@ -728,6 +834,18 @@ tsuba::RDG::MarkEdgePropertiesPersistent(
   return core_->part_header().MarkEdgePropertiesPersistent(persist_edge_props);
 }
 
+katana::Result<void>
+tsuba::RDG::SetNodePropertyFormat(
+    const std::string& name, PropertyFormat format) {
+  return core_->part_header().SetNodePropertyFormat(name, format);
+}
+
+katana::Result<void>
+tsuba::RDG::SetEdgePropertyFormat(
+    const std::string& name, PropertyFormat format) {
+  return core_->part_header().SetEdgePropertyFormat(name, format);
+}
+
 const tsuba::PartitionMetadata&
 tsuba::RDG::part_metadata() const {
   return core_->part_header().metadata();
@@ -751,11 +869,13 @@ tsuba::RDG::edge_properties() const {
 void
 tsuba::RDG::DropNodeProperties() {
   core_->drop_node_properties();
+  core_->part_header().set_node_prop_info_list({});
 }
 
 void
 tsuba::RDG::DropEdgeProperties() {
   core_->drop_edge_properties();
+  core_->part_header().set_edge_prop_info_list({});
 }
 
 const tsuba::FileView&
@@ -219,6 +219,48 @@ RDGPartHeader::MarkEdgePropertiesPersistent(
   return katana::ResultSuccess();
 }
 
+namespace {
+
+katana::Result<void>
+SetPropertyFormat(
+    std::vector<PropStorageInfo>* prop_info_list, const std::string& name,
+    PropertyFormat format) {
+  auto it = std::find_if(
+      prop_info_list->begin(), prop_info_list->end(),
+      [&](const PropStorageInfo& p) { return p.name == name; });
+  if (it == prop_info_list->end()) {
+    return KATANA_ERROR(
+        ErrorCode::PropertyNotFound, "property {} not found", name);
+  }
+  if (it->format == format) {
+    return katana::ResultSuccess();
+  }
+  if (it->written_out) {
+    // The data is only on storage; clearing the path would lose it
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument,
+        "property {} is unloaded; load it before changing its format", name);
+  }
+  it->format = format;
+  // Clear the path so that the property is rewritten in the new format
+  it->path = "";
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+katana::Result<void>
+RDGPartHeader::SetNodePropertyFormat(
+    const std::string& name, PropertyFormat format) {
+  return SetPropertyFormat(&node_prop_info_list_, name, format);
+}
+
+katana::Result<void>
+RDGPartHeader::SetEdgePropertyFormat(
+    const std::string& name, PropertyFormat format) {
+  return SetPropertyFormat(&edge_prop_info_list_, name, format);
+}
+
 void
 RDGPartHeader::UnbindFromStorage() {
   for (PropStorageInfo& prop : node_prop_info_list_) {
@@ -314,6 +356,8 @@ void
 tsuba::from_json(const nlohmann::json& j, tsuba::PropStorageInfo& propmd) {
   j.at(0).get_to(propmd.name);
   j.at(1).get_to(propmd.path);
+  propmd.format = IsArrowIPCFile(propmd.path) ? PropertyFormat::kArrowIPC
+                                              : PropertyFormat::kParquet;
 }
 
 void
@@ -9,6 +9,7 @@
 #include "katana/JSON.h"
 #include "katana/Result.h"
 #include "katana/URI.h"
+#include "tsuba/ArrowIPC.h"
 #include "tsuba/PartitionMetadata.h"
 #include "tsuba/RDG.h"
 #include "tsuba/WriteGroup.h"
@@ -21,6 +22,9 @@ struct PropStorageInfo {
   std::string path;
   bool persist{false};
   bool written_out{false};
+  /// Format used when the property is next written; for properties read from
+  /// storage, the format they were stored in
+  PropertyFormat format{PropertyFormat::kParquet};
 };
 
 class KATANA_EXPORT RDGPartHeader {
@@ -91,6 +95,12 @@ public:
   katana::Result<void> MarkEdgePropertiesPersistent(
       const std::vector<std::string>& persist_edge_props);
 
+  katana::Result<void> SetNodePropertyFormat(
+      const std::string& name, PropertyFormat format);
+
+  katana::Result<void> SetEdgePropertyFormat(
+      const std::string& name, PropertyFormat format);
+
   //
   // Accessors/Mutators
   //
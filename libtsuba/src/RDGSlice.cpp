@@ -8,13 +8,21 @@
 
 katana::Result<void>
 tsuba::RDGSlice::DoMake(
-    const katana::Uri& metadata_dir, const SliceArg& slice) {
+    const katana::Uri& metadata_dir, const SliceArg& slice,
+    AccessPattern access_pattern) {
   ReadGroup grp;
   katana::Uri t_path = metadata_dir.Join(core_->part_header().topology_path());
 
-  if (auto res = core_->topology_file_storage().Bind(
+  // With kWillNeed the topology is fetched in the background while the
+  // property slices load, and only waited for at the end
+  bool resolve_topology = access_pattern != AccessPattern::kWillNeed;
+  FileView& topology = core_->topology_file_storage();
+  ReadAheadPolicy policy;
+  policy.pattern = access_pattern;
+  topology.set_read_ahead_policy(policy);
+  if (auto res = topology.Bind(
           t_path.string(), slice.topo_off, slice.topo_off + slice.topo_size,
-          true);
+          resolve_topology);
       !res) {
     return res.error();
   }
@@ -24,7 +32,8 @@ tsuba::RDGSlice::DoMake(
       slice.node_range, &grp,
       [rdg = this](const std::shared_ptr<arrow::Table>& props) {
         return rdg->core_->AddNodeProperties(props);
-      });
+      },
+      access_pattern);
   if (!node_result) {
     return node_result.error();
   }
@@ -34,19 +43,27 @@ tsuba::RDGSlice::DoMake(
       slice.edge_range, &grp,
       [rdg = this](const std::shared_ptr<arrow::Table>& props) {
         return rdg->core_->AddEdgeProperties(props);
-      });
+      },
+      access_pattern);
   if (!edge_result) {
     return edge_result.error();
   }
 
-  return grp.Finish();
+  if (auto res = grp.Finish(); !res) {
+    return res.error();
+  }
+
+  if (!resolve_topology) {
+    return topology.Resolve(slice.topo_off, slice.topo_size);
+  }
+  return katana::ResultSuccess();
 }
 
 katana::Result<tsuba::RDGSlice>
 tsuba::RDGSlice::Make(
     RDGHandle handle, const SliceArg& slice,
     const std::vector<std::string>* node_props,
-    const std::vector<std::string>* edge_props) {
+    const std::vector<std::string>* edge_props, AccessPattern access_pattern) {
   const RDGManifest& manifest = handle.impl_->rdg_manifest();
   if (manifest.num_hosts() != 1) {
     return KATANA_ERROR(
@@ -70,7 +87,7 @@ tsuba::RDGSlice::Make(
     return res.error();
   }
 
-  if (auto res = rdg_slice.DoMake(manifest.dir(), slice); !res) {
+  if (auto res = rdg_slice.DoMake(manifest.dir(), slice, access_pattern); !res) {
     return res.error();
   }
 
@@ -1,8 +1,10 @@
 #include "tsuba/WriteGroup.h"
 
 #include "GlobalState.h"
+#include "katana/Env.h"
 #include "katana/Random.h"
 #include "katana/Result.h"
+#include "tsuba/FaultTest.h"
 
 template <typename T>
 using Result = katana::Result<T>;
@@ -11,46 +13,193 @@ namespace {
 
 constexpr uint32_t kTagLen = 12;
 
+uint64_t
+NanosSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
 }  // namespace
 
 namespace tsuba {
 
+WriteGroup::Options
+WriteGroup::Options::Defaults() {
+  Options opts;
+  int budget_mb = 0;
+  if (katana::GetEnv("KATANA_TSUBA_WRITE_BUDGET_MB", &budget_mb) &&
+      budget_mb > 0) {
+    opts.max_outstanding_bytes = static_cast<uint64_t>(budget_mb) << 20;
+  }
+  int concurrency = 0;
+  if (katana::GetEnv("KATANA_TSUBA_WRITE_CONCURRENCY", &concurrency) &&
+      concurrency > 0) {
+    opts.max_concurrent_ops = concurrency;
+  }
+  bool wait_all = false;
+  if (katana::GetEnv("KATANA_TSUBA_WRITE_FLUSH_ALL", &wait_all) && wait_all) {
+    opts.flush_policy = FlushPolicy::kWaitAll;
+  }
+  return opts;
+}
+
+WriteGroup::WriteGroup(std::string tag, const Options& opts)
+    : tag_(std::move(tag)),
+      opts_(opts),
+      start_(std::chrono::steady_clock::now()) {}
+
 Result<std::unique_ptr<WriteGroup>>
-WriteGroup::Make() {
+WriteGroup::Make(const Options& opts) {
   // Don't use `OneHostOnly` because we can skip its broadcast
   std::string tag;
   if (Comm()->ID == 0) {
     tag = katana::RandomAlphanumericString(kTagLen);
   }
   tag = Comm()->Broadcast(0, tag, kTagLen);
-  return std::unique_ptr<WriteGroup>(new WriteGroup(tag));
+  return std::unique_ptr<WriteGroup>(new WriteGroup(tag, opts));
 }
 
 Result<void>
 WriteGroup::Finish() {
-  return async_op_group_.Finish();
+  auto res = async_op_group_.Finish();
+  elapsed_ns_ = NanosSince(start_);
+
+  Stats s = stats();
+  KATANA_LOG_DEBUG(
+      "write group {}: {} ops, {} bytes in {} ms ({:.1f} MB/s); encode {} ms, "
+      "io {} ms, stalled {} ms",
+      tag_, s.ops, s.bytes_written, s.elapsed_ns / 1000000,
+      s.Throughput() / (1 << 20), s.encode_ns / 1000000, s.io_ns / 1000000,
+      s.stall_ns / 1000000);
+  return res;
+}
+
+WriteGroup::Stats
+WriteGroup::stats() const {
+  return Stats{
+      .ops = ops_,
+      .bytes_written = bytes_written_,
+      .encode_ns = encode_ns_,
+      .io_ns = io_ns_,
+      .stall_ns = stall_ns_,
+      .elapsed_ns = elapsed_ns_ == 0 ? NanosSince(start_) : elapsed_ns_,
+  };
 }
 
 void
-WriteGroup::AddOp(
-    std::future<katana::CopyableResult<void>> future, std::string file,
-    uint64_t accounted_size) {
-  if (accounted_size > kMaxOutstandingSize) {
-    accounted_size = kMaxOutstandingSize;
+WriteGroup::WaitForBudget(uint64_t size) {
+  auto over_limit = [&]() {
+    bool too_many = opts_.max_concurrent_ops > 0 &&
+                    outstanding_ops_ >= opts_.max_concurrent_ops;
+    bool too_big = size > 0 &&
+                   outstanding_size_ + size > opts_.max_outstanding_bytes;
+    return too_many || too_big;
+  };
+  if (!over_limit()) {
+    return;
   }
-  if (accounted_size > 0) {
-    while (outstanding_size_ + accounted_size > kMaxOutstandingSize) {
+
+  auto start = std::chrono::steady_clock::now();
+  switch (opts_.flush_policy) {
+  case Options::FlushPolicy::kWaitAll:
+    while (async_op_group_.FinishOne()) {
+    }
+    break;
+  case Options::FlushPolicy::kWaitOldest:
+    while (over_limit()) {
       if (!async_op_group_.FinishOne()) {
         KATANA_LOG_ERROR(
             "outstanding_size should be zero if we couldn't drain");
         break;
       }
     }
+    break;
   }
+  stall_ns_ += NanosSince(start);
+}
+
+void
+WriteGroup::AddOp(
+    std::future<katana::CopyableResult<void>> future, std::string file,
+    uint64_t accounted_size) {
+  accounted_size = std::min(accounted_size, opts_.max_outstanding_bytes);
+  WaitForBudget(accounted_size);
+  outstanding_size_ += accounted_size;
+  outstanding_ops_ += 1;
+
+  // Deferred so that the accounting is released when the op is waited on,
+  // whether or not it succeeded
+  auto tracked = std::async(
+      std::launch::deferred,
+      [wg = this, future = std::move(future),
+       accounted_size]() mutable -> katana::CopyableResult<void> {
+        auto res = future.get();
+        wg->outstanding_size_ -= accounted_size;
+        wg->outstanding_ops_ -= 1;
+        if (res) {
+          wg->ops_ += 1;
+        }
+        return res;
+      });
+  async_op_group_.AddOp(
+      std::move(tracked), std::move(file),
+      []() -> katana::CopyableResult<void> {
+        return katana::CopyableResultSuccess();
+      });
+}
+
+void
+WriteGroup::StartEncodeAndStore(
+    std::shared_ptr<FileFrame> ff, EncodeFn encode, uint64_t size_hint) {
+  size_hint = std::min(size_hint, opts_.max_outstanding_bytes);
+  WaitForBudget(size_hint);
+  outstanding_size_ += size_hint;
+  outstanding_ops_ += 1;
+
+  std::string file = ff->path();
+  auto future = std::async(
+      std::launch::async,
+      [wg = this, ff = std::move(ff), encode = std::move(encode),
+       size_hint]() mutable -> katana::CopyableResult<void> {
+        uint64_t accounted = size_hint;
+        auto release = [&]() {
+          ff.reset();
+          wg->outstanding_size_ -= accounted;
+          wg->outstanding_ops_ -= 1;
+        };
+
+        auto start = std::chrono::steady_clock::now();
+        auto res = encode(ff);
+        wg->encode_ns_ += NanosSince(start);
+        if (!res) {
+          release();
+          return res;
+        }
+
+        // Now that the real size is known, replace the estimate with the
+        // memory held by the frame
+        uint64_t size = ff->map_size();
+        uint64_t stored = ff->Tell().ValueOr(0);
+        wg->outstanding_size_ += size;
+        wg->outstanding_size_ -= accounted;
+        accounted = size;
+
+        TSUBA_PTP(tsuba::internal::FaultSensitivity::Normal);
+        start = std::chrono::steady_clock::now();
+        auto persist_res = ff->Persist();
+        wg->io_ns_ += NanosSince(start);
+        release();
+        if (!persist_res) {
+          return persist_res.error();
+        }
+        wg->ops_ += 1;
+        wg->bytes_written_ += stored;
+        return katana::CopyableResultSuccess();
+      });
   async_op_group_.AddOp(
       std::move(future), std::move(file),
-      [wg = this, accounted_size]() -> katana::CopyableResult<void> {
-        wg->outstanding_size_ -= accounted_size;
+      []() -> katana::CopyableResult<void> {
         return katana::CopyableResultSuccess();
       });
 }
@@ -61,12 +210,39 @@ void
 WriteGroup::StartStore(std::shared_ptr<FileFrame> ff) {
   std::string file = ff->path();
   uint64_t size = ff->map_size();
+  uint64_t stored = ff->Tell().ValueOr(0);
 
   // wrap future to hold onto FileFrame, but free it as soon as possible
-  auto future = std::async(std::launch::async, [ff = std::move(ff)]() mutable {
-    return ff->PersistAsync().get();
-  });
+  auto future = std::async(
+      std::launch::async, [wg = this, ff = std::move(ff), stored]() mutable {
+        auto start = std::chrono::steady_clock::now();
+        auto res = ff->PersistAsync().get();
+        wg->io_ns_ += NanosSince(start);
+        ff.reset();
+        if (res) {
+          wg->bytes_written_ += stored;
+        }
+        return res;
+      });
   AddOp(std::move(future), file, size);
 }
 
+void
+WriteGroup::StartStore(
+    const std::string& file, const uint8_t* buf, uint64_t size) {
+  auto future = std::async(
+      std::launch::async,
+      [wg = this, file, buf, size]() -> katana::CopyableResult<void> {
+        auto start = std::chrono::steady_clock::now();
+        auto res = FileStoreAsync(file, buf, size).get();
+        wg->io_ns_ += NanosSince(start);
+        if (res) {
+          // not accounted against the budget since the caller owns buf
+          wg->bytes_written_ += size;
+        }
+        return res;
+      });
+  AddOp(std::move(future), file);
+}
+
 }  // namespace tsuba
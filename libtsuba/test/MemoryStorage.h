@@ -0,0 +1,135 @@
+#ifndef KATANA_LIBTSUBA_TEST_MEMORYSTORAGE_H_
+#define KATANA_LIBTSUBA_TEST_MEMORYSTORAGE_H_
+
+#include <atomic>
+#include <cstring>
+#include <future>
+#include <map>
+#include <numeric>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "katana/Result.h"
+#include "katana/URI.h"
+#include "tsuba/Errors.h"
+#include "tsuba/FileStorage.h"
+#include "tsuba/file.h"
+
+/// Remote storage stand-in that keeps files in memory and counts the requests
+/// that reach it. Like LocalStorage, its async calls complete synchronously,
+/// here when their futures are waited on.
+class MemoryStorage : public tsuba::FileStorage {
+public:
+  MemoryStorage() : FileStorage("mem://") {}
+
+  katana::Result<void> Init() override { return katana::ResultSuccess(); }
+  katana::Result<void> Fini() override { return katana::ResultSuccess(); }
+
+  katana::Result<void> Stat(
+      const std::string& uri, tsuba::StatBuf* s_buf) override {
+    ++stats;
+    auto it = files.find(uri);
+    if (it == files.end()) {
+      return KATANA_ERROR(tsuba::ErrorCode::NotFound, "no file {}", uri);
+    }
+    s_buf->size = it->second.size();
+    return katana::ResultSuccess();
+  }
+
+  katana::Result<void> GetMultiSync(
+      const std::string& uri, uint64_t start, uint64_t size,
+      uint8_t* result_buf) override {
+    ++gets;
+    auto it = files.find(uri);
+    if (it == files.end()) {
+      return KATANA_ERROR(tsuba::ErrorCode::NotFound, "no file {}", uri);
+    }
+    const std::vector<uint8_t>& contents = it->second;
+    if (start + size > contents.size()) {
+      return KATANA_ERROR(
+          tsuba::ErrorCode::InvalidArgument, "read past end of {}", uri);
+    }
+    std::memcpy(result_buf, contents.data() + start, size);
+    bytes_read += size;
+    return katana::ResultSuccess();
+  }
+
+  katana::Result<void> PutMultiSync(
+      const std::string& uri, const uint8_t* data, uint64_t size) override {
+    files[uri].assign(data, data + size);
+    return katana::ResultSuccess();
+  }
+
+  katana::Result<void> RemoteCopy(
+      const std::string& source_uri, const std::string& dest_uri,
+      uint64_t begin, uint64_t size) override {
+    const std::vector<uint8_t>& source = files.at(source_uri);
+    files[dest_uri].assign(
+        source.begin() + begin, source.begin() + begin + size);
+    return katana::ResultSuccess();
+  }
+
+  std::future<katana::CopyableResult<void>> PutAsync(
+      const std::string& uri, const uint8_t* data, uint64_t size) override {
+    auto res = PutMultiSync(uri, data, size);
+    return std::async(
+        std::launch::deferred, [=]() -> katana::CopyableResult<void> {
+          if (!res) {
+            return res.error();
+          }
+          return katana::CopyableResultSuccess();
+        });
+  }
+
+  std::future<katana::CopyableResult<void>> GetAsync(
+      const std::string& uri, uint64_t start, uint64_t size,
+      uint8_t* result_buf) override {
+    return std::async(
+        std::launch::deferred,
+        [this, uri, start, size, result_buf]() -> katana::CopyableResult<void> {
+          if (auto res = GetMultiSync(uri, start, size, result_buf); !res) {
+            return res.error();
+          }
+          return katana::CopyableResultSuccess();
+        });
+  }
+
+  std::future<katana::CopyableResult<void>> ListAsync(
+      const std::string&, std::vector<std::string>*,
+      std::vector<uint64_t>*) override {
+    return std::async(
+        std::launch::deferred, []() -> katana::CopyableResult<void> {
+          return katana::CopyableResultSuccess();
+        });
+  }
+
+  katana::Result<void> Delete(
+      const std::string& directory,
+      const std::unordered_set<std::string>& to_delete) override {
+    for (const std::string& file : to_delete) {
+      files.erase(katana::Uri::JoinPath(directory, file));
+    }
+    return katana::ResultSuccess();
+  }
+
+  std::map<std::string, std::vector<uint8_t>> files;
+  std::atomic<uint64_t> gets{0};
+  std::atomic<uint64_t> bytes_read{0};
+  std::atomic<uint64_t> stats{0};
+};
+
+inline std::vector<uint8_t>
+MakeContents(uint64_t size, uint8_t seed) {
+  std::vector<uint8_t> contents(size);
+  std::iota(contents.begin(), contents.end(), seed);
+  return contents;
+}
+
+inline std::vector<uint8_t>
+Slice(const std::vector<uint8_t>& contents, uint64_t start, uint64_t size) {
+  return std::vector<uint8_t>(
+      contents.begin() + start, contents.begin() + start + size);
+}
+
+#endif
@@ -0,0 +1,244 @@
+#include "CachingStorage.h"
+
+#include <fstream>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "MemoryStorage.h"
+#include "katana/Logging.h"
+#include "katana/Result.h"
+#include "katana/URI.h"
+
+namespace {
+
+namespace fs = boost::filesystem;
+
+std::string
+MakeCacheDir() {
+  auto uri_res = katana::Uri::MakeRand("/tmp/cachingstorage");
+  KATANA_LOG_ASSERT(uri_res);
+  return uri_res.value().path();
+}
+
+std::vector<uint8_t>
+Read(
+    tsuba::CachingStorage* cache, const std::string& uri, uint64_t start,
+    uint64_t size) {
+  std::vector<uint8_t> buf(size);
+  auto res = cache->GetMultiSync(uri, start, size, buf.data());
+  KATANA_LOG_VASSERT(res, "reading {}: {}", uri, res.error());
+  return buf;
+}
+
+void
+TestHitMiss() {
+  std::string dir = MakeCacheDir();
+  MemoryStorage backing;
+  auto contents = MakeContents(1000, 1);
+  backing.files["mem://a"] = contents;
+
+  tsuba::CachingStorage cache(&backing, dir, 1 << 20);
+  KATANA_LOG_ASSERT(cache.Init());
+
+  // A small file is fetched in full on the first read, even a partial one
+  KATANA_LOG_ASSERT(
+      Read(&cache, "mem://a", 100, 50) == Slice(contents, 100, 50));
+  KATANA_LOG_ASSERT(cache.misses() == 1 && cache.hits() == 0);
+  KATANA_LOG_ASSERT(cache.Contains("mem://a"));
+  KATANA_LOG_ASSERT(cache.used() == contents.size());
+  KATANA_LOG_ASSERT(backing.gets == 2);
+
+  KATANA_LOG_ASSERT(Read(&cache, "mem://a", 0, 1000) == contents);
+  KATANA_LOG_ASSERT(
+      Read(&cache, "mem://a", 900, 100) == Slice(contents, 900, 100));
+  KATANA_LOG_ASSERT(cache.misses() == 1 && cache.hits() == 2);
+  KATANA_LOG_ASSERT(backing.gets == 2);
+
+  // Missing files are errors, not cache entries
+  std::vector<uint8_t> buf(10);
+  KATANA_LOG_ASSERT(!cache.GetMultiSync("mem://missing", 0, 10, buf.data()));
+  KATANA_LOG_ASSERT(!cache.Contains("mem://missing"));
+
+  KATANA_LOG_ASSERT(cache.Fini());
+  fs::remove_all(dir);
+}
+
+void
+TestReadThrough() {
+  std::string dir = MakeCacheDir();
+  MemoryStorage backing;
+  auto contents = MakeContents(1000, 2);
+  backing.files["mem://big"] = contents;
+
+  // Files over 100 bytes are too large to fetch in full
+  tsuba::CachingStorage cache(&backing, dir, 1 << 20, 100);
+  KATANA_LOG_ASSERT(cache.Init());
+
+  KATANA_LOG_ASSERT(
+      Read(&cache, "mem://big", 10, 20) == Slice(contents, 10, 20));
+  KATANA_LOG_ASSERT(!cache.Contains("mem://big"));
+  KATANA_LOG_ASSERT(backing.gets == 1 && backing.stats == 1);
+
+  // The size of a file too large to cache is remembered
+  KATANA_LOG_ASSERT(
+      Read(&cache, "mem://big", 30, 20) == Slice(contents, 30, 20));
+  KATANA_LOG_ASSERT(!cache.Contains("mem://big"));
+  KATANA_LOG_ASSERT(backing.gets == 2 && backing.stats == 1);
+  KATANA_LOG_ASSERT(cache.misses() == 2);
+
+  // A read of the whole file is cached without fetching it again
+  KATANA_LOG_ASSERT(Read(&cache, "mem://big", 0, 1000) == contents);
+  KATANA_LOG_ASSERT(cache.Contains("mem://big"));
+  KATANA_LOG_ASSERT(backing.gets == 3);
+
+  KATANA_LOG_ASSERT(
+      Read(&cache, "mem://big", 500, 20) == Slice(contents, 500, 20));
+  KATANA_LOG_ASSERT(backing.gets == 3);
+  KATANA_LOG_ASSERT(cache.hits() == 1 && cache.misses() == 3);
+
+  KATANA_LOG_ASSERT(cache.Fini());
+  fs::remove_all(dir);
+}
+
+void
+TestEviction() {
+  std::string dir = MakeCacheDir();
+  MemoryStorage backing;
+  for (const char* name : {"mem://a", "mem://b", "mem://c"}) {
+    backing.files[name] = MakeContents(1000, name[6]);
+  }
+
+  tsuba::CachingStorage cache(&backing, dir, 2000);
+  KATANA_LOG_ASSERT(cache.Init());
+
+  Read(&cache, "mem://a", 0, 10);
+  Read(&cache, "mem://b", 0, 10);
+  KATANA_LOG_ASSERT(cache.used() == 2000);
+
+  // a is now more recently used than b, so c takes the place of b
+  Read(&cache, "mem://a", 0, 10);
+  Read(&cache, "mem://c", 0, 10);
+  KATANA_LOG_ASSERT(cache.Contains("mem://a"));
+  KATANA_LOG_ASSERT(!cache.Contains("mem://b"));
+  KATANA_LOG_ASSERT(cache.Contains("mem://c"));
+  KATANA_LOG_ASSERT(cache.used() == 2000);
+  KATANA_LOG_ASSERT(cache.Fini());
+
+  // A smaller capacity evicts down to size when the cache is reopened
+  tsuba::CachingStorage reopened(&backing, dir, 1000);
+  KATANA_LOG_ASSERT(reopened.Init());
+  KATANA_LOG_ASSERT(!reopened.Contains("mem://b"));
+  KATANA_LOG_ASSERT(
+      reopened.Contains("mem://a") != reopened.Contains("mem://c"));
+  KATANA_LOG_ASSERT(reopened.used() == 1000);
+  KATANA_LOG_ASSERT(reopened.Fini());
+
+  fs::remove_all(dir);
+}
+
+void
+TestInvalidation() {
+  std::string dir = MakeCacheDir();
+  MemoryStorage backing;
+  auto contents = MakeContents(1000, 3);
+  backing.files["mem://a"] = contents;
+
+  {
+    tsuba::CachingStorage cache(&backing, dir, 1 << 20);
+    KATANA_LOG_ASSERT(cache.Init());
+    Read(&cache, "mem://a", 0, 1000);
+    KATANA_LOG_ASSERT(cache.Fini());
+  }
+
+  // Corrupt the local copy without changing its size
+  std::vector<fs::path> data_files;
+  for (fs::directory_iterator it(dir), end; it != end; ++it) {
+    if (it->path().extension() == ".data") {
+      data_files.emplace_back(it->path());
+    }
+  }
+  KATANA_LOG_ASSERT(data_files.size() == 1);
+  {
+    std::fstream data(
+        data_files[0].string(),
+        std::ios::in | std::ios::out | std::ios::binary);
+    data.seekp(500);
+    data.put(static_cast<char>(~contents[500]));
+  }
+
+  {
+    tsuba::CachingStorage cache(&backing, dir, 1 << 20);
+    KATANA_LOG_ASSERT(cache.Init());
+    KATANA_LOG_ASSERT(cache.Contains("mem://a"));
+    KATANA_LOG_ASSERT(Read(&cache, "mem://a", 0, 1000) == contents);
+    KATANA_LOG_ASSERT(cache.hits() == 0 && cache.misses() == 1);
+    KATANA_LOG_ASSERT(Read(&cache, "mem://a", 0, 1000) == contents);
+    KATANA_LOG_ASSERT(cache.hits() == 1);
+    KATANA_LOG_ASSERT(cache.Fini());
+  }
+
+  // Change the stored file behind the back of the cache
+  auto changed = MakeContents(1200, 4);
+  backing.files["mem://a"] = changed;
+  {
+    tsuba::CachingStorage cache(&backing, dir, 1 << 20);
+    KATANA_LOG_ASSERT(cache.Init());
+    KATANA_LOG_ASSERT(Read(&cache, "mem://a", 0, 1200) == changed);
+    KATANA_LOG_ASSERT(cache.hits() == 0 && cache.misses() == 1);
+    KATANA_LOG_ASSERT(cache.used() == changed.size());
+
+    // Writes through the cache drop the local copy
+    auto written = MakeContents(800, 5);
+    KATANA_LOG_ASSERT(
+        cache.PutMultiSync("mem://a", written.data(), written.size()));
+    KATANA_LOG_ASSERT(!cache.Contains("mem://a"));
+    KATANA_LOG_ASSERT(Read(&cache, "mem://a", 0, 800) == written);
+    KATANA_LOG_ASSERT(cache.Fini());
+  }
+
+  fs::remove_all(dir);
+}
+
+void
+TestAsync() {
+  std::string dir = MakeCacheDir();
+  MemoryStorage backing;
+  auto contents = MakeContents(1000, 6);
+  backing.files["mem://a"] = contents;
+
+  tsuba::CachingStorage cache(&backing, dir, 1 << 20);
+  KATANA_LOG_ASSERT(cache.Init());
+
+  std::vector<uint8_t> buf(100);
+  auto miss = cache.GetAsync("mem://a", 200, buf.size(), buf.data());
+  KATANA_LOG_ASSERT(miss.get());
+  KATANA_LOG_ASSERT(buf == Slice(contents, 200, 100));
+  KATANA_LOG_ASSERT(cache.Contains("mem://a"));
+
+  uint64_t gets = backing.gets;
+  auto hit = cache.GetAsync("mem://a", 300, buf.size(), buf.data());
+  KATANA_LOG_ASSERT(hit.get());
+  KATANA_LOG_ASSERT(buf == Slice(contents, 300, 100));
+  KATANA_LOG_ASSERT(backing.gets == gets);
+  KATANA_LOG_ASSERT(cache.hits() == 1 && cache.misses() == 1);
+
+  auto missing = cache.GetAsync("mem://missing", 0, buf.size(), buf.data());
+  KATANA_LOG_ASSERT(!missing.get());
+
+  KATANA_LOG_ASSERT(cache.Fini());
+  fs::remove_all(dir);
+}
+
+}  // namespace
+
+int
+main() {
+  TestHitMiss();
+  TestReadThrough();
+  TestEviction();
+  TestInvalidation();
+  TestAsync();
+
+  return 0;
+}
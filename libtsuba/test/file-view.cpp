@@ -0,0 +1,195 @@
+#include "tsuba/FileView.h"
+
+#include <vector>
+
+#include "MemoryStorage.h"
+#include "katana/Logging.h"
+#include "katana/Result.h"
+#include "tsuba/tsuba.h"
+
+namespace {
+
+// FileView fetches whole pages of this size
+constexpr uint64_t kPage = UINT64_C(1) << 20;
+
+MemoryStorage storage;
+
+std::vector<uint8_t>
+AddFile(const std::string& uri, uint64_t size) {
+  auto contents = MakeContents(size, uri.size());
+  storage.files[uri] = contents;
+  return contents;
+}
+
+std::vector<uint8_t>
+ReadAt(tsuba::FileView* fv, int64_t offset, int64_t size) {
+  KATANA_LOG_ASSERT(fv->Seek(offset).ok());
+  std::vector<uint8_t> buf(size);
+  auto res = fv->Read(size, buf.data());
+  KATANA_LOG_ASSERT(res.ok() && res.ValueUnsafe() == size);
+  return buf;
+}
+
+/// Resolving a range only waits for the fetches that overlap it
+void
+TestResolveOverlapping() {
+  auto contents = AddFile("mem://resolve", 16 * kPage);
+
+  tsuba::FileView fv;
+  fv.set_read_ahead_policy({.pattern = tsuba::AccessPattern::kRandom});
+  KATANA_LOG_ASSERT(fv.Bind("mem://resolve", 0, 0, false));
+  KATANA_LOG_ASSERT(fv.Fill(0, 100, false));
+  KATANA_LOG_ASSERT(fv.Fill(10 * kPage, 10 * kPage + 100, false));
+
+  // Fetches from MemoryStorage only run when they are waited on
+  uint64_t gets = storage.gets;
+  KATANA_LOG_ASSERT(fv.Resolve(0, 100));
+  KATANA_LOG_ASSERT(storage.gets == gets + 1);
+  KATANA_LOG_ASSERT(fv.Resolve(10 * kPage, 100));
+  KATANA_LOG_ASSERT(storage.gets == gets + 2);
+
+  KATANA_LOG_ASSERT(
+      std::vector<uint8_t>(fv.ptr<uint8_t>(), fv.ptr<uint8_t>() + 100) ==
+      Slice(contents, 0, 100));
+  KATANA_LOG_ASSERT(fv.Unbind());
+}
+
+/// Filling around pages that are already present only fetches the missing
+/// ones, including when the search for them has to scan backward over a
+/// block of 64 present pages
+void
+TestFillSkipsPresentPages() {
+  uint64_t size = 130 * kPage + 100;
+  auto contents = AddFile("mem://fill", size);
+
+  tsuba::FileView fv;
+  fv.set_read_ahead_policy({.pattern = tsuba::AccessPattern::kRandom});
+  uint64_t bytes = storage.bytes_read;
+  KATANA_LOG_ASSERT(fv.Bind("mem://fill", 64 * kPage, size, true));
+  KATANA_LOG_ASSERT(storage.bytes_read == bytes + size - 64 * kPage);
+
+  bytes = storage.bytes_read;
+  KATANA_LOG_ASSERT(fv.Fill(0, size, true));
+  KATANA_LOG_ASSERT(storage.bytes_read == bytes + 64 * kPage);
+
+  bytes = storage.bytes_read;
+  KATANA_LOG_ASSERT(fv.Fill(0, size, true));
+  KATANA_LOG_ASSERT(storage.bytes_read == bytes);
+
+  KATANA_LOG_ASSERT(ReadAt(&fv, 0, 100) == Slice(contents, 0, 100));
+  KATANA_LOG_ASSERT(
+      ReadAt(&fv, 64 * kPage - 50, 100) ==
+      Slice(contents, 64 * kPage - 50, 100));
+  KATANA_LOG_ASSERT(
+      ReadAt(&fv, size - 100, 100) == Slice(contents, size - 100, 100));
+  KATANA_LOG_ASSERT(fv.Unbind());
+}
+
+/// Bytes fetched after reading 100 bytes at a time from the start of a file
+/// with the given read-ahead policy
+uint64_t
+FetchedBySmallReads(const tsuba::ReadAheadPolicy& policy, int reads) {
+  auto contents = AddFile("mem://read-ahead", 32 * kPage);
+
+  tsuba::FileView fv;
+  fv.set_read_ahead_policy(policy);
+  KATANA_LOG_ASSERT(fv.Bind("mem://read-ahead", 0, 0, false));
+  uint64_t bytes = storage.bytes_read;
+  for (int i = 0; i < reads; ++i) {
+    KATANA_LOG_ASSERT(
+        ReadAt(&fv, i * 100, 100) == Slice(contents, i * 100, 100));
+  }
+  KATANA_LOG_ASSERT(fv.Resolve(0, fv.size()));
+  uint64_t fetched = storage.bytes_read - bytes;
+  KATANA_LOG_ASSERT(fv.Unbind());
+  return fetched;
+}
+
+void
+TestReadAheadPolicies() {
+  tsuba::ReadAheadPolicy policy{
+      .pattern = tsuba::AccessPattern::kRandom,
+      .min_window = kPage,
+      .max_window = 4 * kPage,
+  };
+  KATANA_LOG_ASSERT(FetchedBySmallReads(policy, 4) == kPage);
+
+  policy.pattern = tsuba::AccessPattern::kSequential;
+  KATANA_LOG_ASSERT(FetchedBySmallReads(policy, 1) == 5 * kPage);
+
+  // The window doubles with each sequential read: none for the first read,
+  // then 1, 2 and 4 pages
+  policy.pattern = tsuba::AccessPattern::kAdaptive;
+  KATANA_LOG_ASSERT(FetchedBySmallReads(policy, 1) == kPage);
+  KATANA_LOG_ASSERT(FetchedBySmallReads(policy, 2) == 2 * kPage);
+  KATANA_LOG_ASSERT(FetchedBySmallReads(policy, 3) == 3 * kPage);
+  KATANA_LOG_ASSERT(FetchedBySmallReads(policy, 4) == 5 * kPage);
+
+  // and stops growing at max_window
+  policy.max_window = 2 * kPage;
+  KATANA_LOG_ASSERT(FetchedBySmallReads(policy, 6) == 3 * kPage);
+}
+
+/// A read that does not follow the previous one ends the sequential run
+void
+TestSequentialRunReset() {
+  auto contents = AddFile("mem://reset", 32 * kPage);
+
+  tsuba::FileView fv;
+  fv.set_read_ahead_policy({
+      .pattern = tsuba::AccessPattern::kAdaptive,
+      .min_window = kPage,
+      .max_window = 4 * kPage,
+  });
+  KATANA_LOG_ASSERT(fv.Bind("mem://reset", 0, 0, false));
+  uint64_t bytes = storage.bytes_read;
+  for (int i = 0; i < 4; ++i) {
+    ReadAt(&fv, i * 100, 100);
+  }
+  KATANA_LOG_ASSERT(fv.Resolve(0, fv.size()));
+  KATANA_LOG_ASSERT(storage.bytes_read == bytes + 5 * kPage);
+
+  KATANA_LOG_ASSERT(
+      ReadAt(&fv, 20 * kPage, 100) == Slice(contents, 20 * kPage, 100));
+  KATANA_LOG_ASSERT(fv.Resolve(0, fv.size()));
+  KATANA_LOG_ASSERT(storage.bytes_read == bytes + 6 * kPage);
+
+  // The new run starts again from min_window
+  ReadAt(&fv, 20 * kPage + 100, 100);
+  KATANA_LOG_ASSERT(fv.Resolve(0, fv.size()));
+  KATANA_LOG_ASSERT(storage.bytes_read == bytes + 7 * kPage);
+  KATANA_LOG_ASSERT(fv.Unbind());
+}
+
+/// With kWillNeed, Bind fetches the bound region in the background
+void
+TestWillNeed() {
+  uint64_t size = 8 * kPage + 100;
+  auto contents = AddFile("mem://will-need", size);
+
+  tsuba::FileView fv;
+  fv.set_read_ahead_policy({.pattern = tsuba::AccessPattern::kWillNeed});
+  uint64_t bytes = storage.bytes_read;
+  KATANA_LOG_ASSERT(fv.Bind("mem://will-need", false));
+  KATANA_LOG_ASSERT(fv.Resolve(0, fv.size()));
+  KATANA_LOG_ASSERT(storage.bytes_read == bytes + size);
+  KATANA_LOG_ASSERT(std::vector<uint8_t>(fv.begin(), fv.end()) == contents);
+  KATANA_LOG_ASSERT(fv.Unbind());
+}
+
+}  // namespace
+
+int
+main() {
+  tsuba::RegisterFileStorage(&storage);
+  KATANA_LOG_ASSERT(tsuba::Init());
+
+  TestResolveOverlapping();
+  TestFillSkipsPresentPages();
+  TestReadAheadPolicies();
+  TestSequentialRunReset();
+  TestWillNeed();
+
+  KATANA_LOG_ASSERT(tsuba::Fini());
+  return 0;
+}
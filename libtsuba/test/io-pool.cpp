@@ -0,0 +1,82 @@
+#include "IOPool.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "katana/Logging.h"
+#include "katana/Result.h"
+#include "tsuba/Errors.h"
+
+namespace {
+
+void
+TestBounded() {
+  constexpr uint32_t kThreads = 3;
+  tsuba::IOPool pool(kThreads);
+
+  std::atomic<uint32_t> active{0};
+  std::atomic<uint32_t> max_active{0};
+  std::vector<std::future<katana::CopyableResult<void>>> futures;
+  for (int i = 0; i < 20; ++i) {
+    futures.emplace_back(
+        pool.Submit([&]() -> katana::CopyableResult<void> {
+          uint32_t now = ++active;
+          uint32_t seen = max_active;
+          while (now > seen && !max_active.compare_exchange_weak(seen, now)) {
+          }
+          std::this_thread::sleep_for(std::chrono::milliseconds(5));
+          --active;
+          return katana::CopyableResultSuccess();
+        }));
+  }
+  for (auto& future : futures) {
+    KATANA_LOG_ASSERT(future.get());
+  }
+  KATANA_LOG_VASSERT(
+      max_active <= kThreads, "{} tasks ran at once", max_active.load());
+  KATANA_LOG_ASSERT(pool.num_threads() <= kThreads);
+}
+
+void
+TestErrors() {
+  tsuba::IOPool pool(2);
+  auto failed = pool.Submit([]() -> katana::CopyableResult<void> {
+    return KATANA_ERROR(tsuba::ErrorCode::NotFound, "no such file");
+  });
+  auto succeeded = pool.Submit([]() -> katana::CopyableResult<void> {
+    return katana::CopyableResultSuccess();
+  });
+  auto res = failed.get();
+  KATANA_LOG_ASSERT(!res && res.error() == tsuba::ErrorCode::NotFound);
+  KATANA_LOG_ASSERT(succeeded.get());
+}
+
+void
+TestDrainOnDestroy() {
+  std::atomic<int> done{0};
+  {
+    tsuba::IOPool pool(1);
+    for (int i = 0; i < 5; ++i) {
+      // Dropping the future does not cancel the task
+      pool.Submit([&]() -> katana::CopyableResult<void> {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ++done;
+        return katana::CopyableResultSuccess();
+      });
+    }
+  }
+  KATANA_LOG_ASSERT(done == 5);
+}
+
+}  // namespace
+
+int
+main() {
+  TestBounded();
+  TestErrors();
+  TestDrainOnDestroy();
+
+  return 0;
+}
@@ -0,0 +1,213 @@
+#include "tsuba/WriteGroup.h"
+
+#include <stdlib.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "MemoryStorage.h"
+#include "katana/Logging.h"
+#include "katana/Result.h"
+#include "tsuba/Errors.h"
+#include "tsuba/tsuba.h"
+
+namespace {
+
+using FlushPolicy = tsuba::WriteGroup::Options::FlushPolicy;
+
+MemoryStorage storage;
+
+std::unique_ptr<tsuba::WriteGroup>
+MakeGroup(const tsuba::WriteGroup::Options& opts) {
+  auto res = tsuba::WriteGroup::Make(opts);
+  KATANA_LOG_ASSERT(res);
+  return std::move(res.value());
+}
+
+/// An op that only runs when the group waits for it, and then records that
+/// it completed
+std::future<katana::CopyableResult<void>>
+RecordingOp(std::vector<std::string>* completed, std::string name) {
+  return std::async(
+      std::launch::deferred,
+      [completed, name = std::move(name)]() -> katana::CopyableResult<void> {
+        completed->emplace_back(name);
+        return katana::CopyableResultSuccess();
+      });
+}
+
+void
+TestBackpressure() {
+  tsuba::WriteGroup::Options opts;
+  opts.max_outstanding_bytes = 100;
+  auto wg = MakeGroup(opts);
+
+  std::vector<std::string> completed;
+  wg->AddOp(RecordingOp(&completed, "a"), "a", 60);
+  wg->AddOp(RecordingOp(&completed, "b"), "b", 30);
+  KATANA_LOG_ASSERT(completed.empty());
+
+  // 90 bytes are outstanding, so c only fits once a has completed
+  wg->AddOp(RecordingOp(&completed, "c"), "c", 50);
+  KATANA_LOG_ASSERT(completed == std::vector<std::string>({"a"}));
+  KATANA_LOG_ASSERT(wg->stats().ops == 1);
+
+  // Ops larger than the whole budget are accounted as the budget, so they
+  // wait for every other op but do not block forever
+  wg->AddOp(RecordingOp(&completed, "d"), "d", 1000);
+  KATANA_LOG_ASSERT(completed == std::vector<std::string>({"a", "b", "c"}));
+
+  KATANA_LOG_ASSERT(wg->Finish());
+  KATANA_LOG_ASSERT(
+      completed == std::vector<std::string>({"a", "b", "c", "d"}));
+  KATANA_LOG_ASSERT(wg->stats().ops == 4);
+}
+
+void
+TestFlushPolicies() {
+  tsuba::WriteGroup::Options opts;
+  opts.max_outstanding_bytes = 100;
+
+  // Waiting for all ops drains the group, not just enough of it
+  opts.flush_policy = FlushPolicy::kWaitAll;
+  auto all = MakeGroup(opts);
+  std::vector<std::string> completed;
+  all->AddOp(RecordingOp(&completed, "a"), "a", 60);
+  all->AddOp(RecordingOp(&completed, "b"), "b", 30);
+  all->AddOp(RecordingOp(&completed, "c"), "c", 50);
+  KATANA_LOG_ASSERT(completed == std::vector<std::string>({"a", "b"}));
+  KATANA_LOG_ASSERT(all->Finish());
+
+  // The limit on concurrent ops applies regardless of size
+  opts.flush_policy = FlushPolicy::kWaitOldest;
+  opts.max_concurrent_ops = 2;
+  auto oldest = MakeGroup(opts);
+  completed.clear();
+  oldest->AddOp(RecordingOp(&completed, "a"), "a");
+  oldest->AddOp(RecordingOp(&completed, "b"), "b");
+  KATANA_LOG_ASSERT(completed.empty());
+  oldest->AddOp(RecordingOp(&completed, "c"), "c");
+  KATANA_LOG_ASSERT(completed == std::vector<std::string>({"a"}));
+  oldest->AddOp(RecordingOp(&completed, "d"), "d");
+  KATANA_LOG_ASSERT(completed == std::vector<std::string>({"a", "b"}));
+  KATANA_LOG_ASSERT(oldest->Finish());
+
+  opts.flush_policy = FlushPolicy::kWaitAll;
+  auto all_ops = MakeGroup(opts);
+  completed.clear();
+  all_ops->AddOp(RecordingOp(&completed, "a"), "a");
+  all_ops->AddOp(RecordingOp(&completed, "b"), "b");
+  all_ops->AddOp(RecordingOp(&completed, "c"), "c");
+  KATANA_LOG_ASSERT(completed == std::vector<std::string>({"a", "b"}));
+  KATANA_LOG_ASSERT(all_ops->Finish());
+}
+
+void
+TestEnvDefaults() {
+  unsetenv("KATANA_TSUBA_WRITE_BUDGET_MB");
+  unsetenv("KATANA_TSUBA_WRITE_CONCURRENCY");
+  unsetenv("KATANA_TSUBA_WRITE_FLUSH_ALL");
+  auto opts = tsuba::WriteGroup::Options::Defaults();
+  KATANA_LOG_ASSERT(
+      opts.max_outstanding_bytes == tsuba::WriteGroup::kMaxOutstandingSize);
+  KATANA_LOG_ASSERT(opts.max_concurrent_ops == 0);
+  KATANA_LOG_ASSERT(opts.flush_policy == FlushPolicy::kWaitOldest);
+
+  setenv("KATANA_TSUBA_WRITE_BUDGET_MB", "3", 1);
+  setenv("KATANA_TSUBA_WRITE_CONCURRENCY", "4", 1);
+  setenv("KATANA_TSUBA_WRITE_FLUSH_ALL", "true", 1);
+  opts = tsuba::WriteGroup::Options::Defaults();
+  KATANA_LOG_ASSERT(opts.max_outstanding_bytes == 3 << 20);
+  KATANA_LOG_ASSERT(opts.max_concurrent_ops == 4);
+  KATANA_LOG_ASSERT(opts.flush_policy == FlushPolicy::kWaitAll);
+
+  // Values that are not positive or do not parse leave the defaults
+  setenv("KATANA_TSUBA_WRITE_BUDGET_MB", "0", 1);
+  setenv("KATANA_TSUBA_WRITE_CONCURRENCY", "many", 1);
+  setenv("KATANA_TSUBA_WRITE_FLUSH_ALL", "0", 1);
+  opts = tsuba::WriteGroup::Options::Defaults();
+  KATANA_LOG_ASSERT(
+      opts.max_outstanding_bytes == tsuba::WriteGroup::kMaxOutstandingSize);
+  KATANA_LOG_ASSERT(opts.max_concurrent_ops == 0);
+  KATANA_LOG_ASSERT(opts.flush_policy == FlushPolicy::kWaitOldest);
+
+  unsetenv("KATANA_TSUBA_WRITE_BUDGET_MB");
+  unsetenv("KATANA_TSUBA_WRITE_CONCURRENCY");
+  unsetenv("KATANA_TSUBA_WRITE_FLUSH_ALL");
+}
+
+void
+TestStats() {
+  auto wg = MakeGroup({});
+  auto contents = MakeContents(1000, 7);
+
+  auto ff = std::make_shared<tsuba::FileFrame>();
+  KATANA_LOG_ASSERT(ff->Init());
+  ff->Bind("mem://encoded");
+  wg->StartEncodeAndStore(
+      ff,
+      [&contents](const std::shared_ptr<tsuba::FileFrame>& ff)
+          -> katana::CopyableResult<void> {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        if (!ff->Write(contents.data(), contents.size()).ok()) {
+          return KATANA_ERROR(tsuba::ErrorCode::ArrowError, "writing frame");
+        }
+        return katana::CopyableResultSuccess();
+      },
+      100);
+  ff.reset();
+
+  // Buffers stored on behalf of the caller count as written too. Only the
+  // bytes stored are counted, not the memory reserved by frames.
+  wg->StartStore("mem://stored", contents.data(), 500);
+  KATANA_LOG_ASSERT(wg->Finish());
+
+  auto stats = wg->stats();
+  KATANA_LOG_ASSERT(stats.ops == 2);
+  KATANA_LOG_ASSERT(stats.bytes_written == 1500);
+  KATANA_LOG_ASSERT(stats.encode_ns >= 2000000);
+  KATANA_LOG_ASSERT(stats.io_ns > 0);
+  KATANA_LOG_ASSERT(stats.elapsed_ns >= stats.encode_ns);
+  KATANA_LOG_ASSERT(stats.Throughput() > 0);
+  KATANA_LOG_ASSERT(storage.files["mem://encoded"] == contents);
+  KATANA_LOG_ASSERT(
+      storage.files["mem://stored"] == Slice(contents, 0, 500));
+
+  // The stats do not change once the group has finished
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  KATANA_LOG_ASSERT(wg->stats().elapsed_ns == stats.elapsed_ns);
+
+  // Failed ops are not counted
+  auto failing = MakeGroup({});
+  auto bad = std::make_shared<tsuba::FileFrame>();
+  KATANA_LOG_ASSERT(bad->Init());
+  bad->Bind("mem://failed");
+  failing->StartEncodeAndStore(
+      std::move(bad),
+      [](const std::shared_ptr<tsuba::FileFrame>&)
+          -> katana::CopyableResult<void> {
+        return KATANA_ERROR(tsuba::ErrorCode::InvalidArgument, "bad encode");
+      });
+  KATANA_LOG_ASSERT(!failing->Finish());
+  KATANA_LOG_ASSERT(failing->stats().ops == 0);
+  KATANA_LOG_ASSERT(failing->stats().bytes_written == 0);
+  KATANA_LOG_ASSERT(storage.files.count("mem://failed") == 0);
+}
+
+}  // namespace
+
+int
+main() {
+  tsuba::RegisterFileStorage(&storage);
+  KATANA_LOG_ASSERT(tsuba::Init());
+
+  TestBackpressure();
+  TestFlushPolicies();
+  TestEnvDefaults();
+  TestStats();
+
+  KATANA_LOG_ASSERT(tsuba::Fini());
+  return 0;
+}
@@ -47,7 +47,10 @@ static cll::opt<PagerankPlan::Algorithm> algo(
             "PullTopological"),
         clEnumValN(PagerankPlan::kPullResidual, "PullResidual", "PullResidual"),
         clEnumValN(PagerankPlan::kPushSynchronous, "PushSync", "PushSync"),
-        clEnumValN(PagerankPlan::kPushAsynchronous, "PushAsync", "PushAsync")),
+        clEnumValN(PagerankPlan::kPushAsynchronous, "PushAsync", "PushAsync"),
+        clEnumValN(
+            PagerankPlan::kPropagationBlocking, "PropagationBlocking",
+            "PropagationBlocking")),
     cll::init(PagerankPlan::kPushAsynchronous));
 
 //! Flag that forces user to be aware that they should be passing in a
@@ -30,6 +30,8 @@ Algorithms
 
 .. automodule:: katana.analytics._independent_set
 
+.. automodule:: katana.analytics._leiden_clustering
+
 .. automodule:: katana.analytics._louvain_clustering
 
 .. automodule:: katana.analytics._local_clustering_coefficient
@@ -42,10 +44,28 @@ Algorithms
 
 .. automodule:: katana.analytics._k_truss
 
+.. automodule:: katana.analytics._matrix_completion
+
+.. automodule:: katana.analytics._max_flow
+
+.. automodule:: katana.analytics._minimum_spanning_forest
+
 .. automodule:: katana.analytics._pagerank
 
+.. automodule:: katana.analytics._partition
+
+.. automodule:: katana.analytics._random_walks
+
+.. automodule:: katana.analytics._reorder
+
+.. automodule:: katana.analytics._shortest_path
+
+.. automodule:: katana.analytics._similarity_join
+
 .. automodule:: katana.analytics._sssp
 
+.. automodule:: katana.analytics._strongly_connected_components
+
 .. automodule:: katana.analytics._triangle_count
 
 .. automodule:: katana.analytics._wrappers
@@ -59,12 +79,13 @@ from katana.analytics._betweenness_centrality import (
     BetweennessCentralityStatistics,
     betweenness_centrality,
 )
-from katana.analytics._bfs import BfsPlan, BfsStatistics, bfs, bfs_assert_valid
+from katana.analytics._bfs import BfsPlan, BfsStatistics, bfs, bfs_assert_valid, multi_source_bfs
 from katana.analytics._connected_components import (
     ConnectedComponentsPlan,
     ConnectedComponentsStatistics,
     connected_components,
     connected_components_assert_valid,
+    incremental_connected_components,
 )
 from katana.analytics._independent_set import (
     IndependentSetPlan,
@@ -75,6 +96,12 @@ from katana.analytics._independent_set import (
 from katana.analytics._jaccard import JaccardPlan, JaccardStatistics, jaccard, jaccard_assert_valid
 from katana.analytics._k_core import KCorePlan, KCoreStatistics, k_core, k_core_assert_valid
 from katana.analytics._k_truss import KTrussPlan, KTrussStatistics, k_truss, k_truss_assert_valid
+from katana.analytics._leiden_clustering import (
+    LeidenClusteringPlan,
+    LeidenClusteringStatistics,
+    leiden_clustering,
+    leiden_clustering_assert_valid,
+)
 from katana.analytics._local_clustering_coefficient import LocalClusteringCoefficientPlan, local_clustering_coefficient
 from katana.analytics._louvain_clustering import (
     LouvainClusteringPlan,
@@ -82,8 +109,49 @@ from katana.analytics._louvain_clustering import (
     louvain_clustering,
     louvain_clustering_assert_valid,
 )
-from katana.analytics._pagerank import PagerankPlan, PagerankStatistics, pagerank, pagerank_assert_valid
-from katana.analytics._sssp import SsspPlan, SsspStatistics, sssp, sssp_assert_valid
+from katana.analytics._matrix_completion import (
+    MatrixCompletionPlan,
+    MatrixCompletionStatistics,
+    matrix_completion,
+    matrix_completion_assert_valid,
+)
+from katana.analytics._max_flow import MaxFlowPlan, MaxFlowStatistics, max_flow, max_flow_assert_valid
+from katana.analytics._minimum_spanning_forest import (
+    MinimumSpanningForestPlan,
+    MinimumSpanningForestStatistics,
+    minimum_spanning_forest,
+    minimum_spanning_forest_assert_valid,
+)
+from katana.analytics._pagerank import (
+    PagerankPlan,
+    PagerankStatistics,
+    PersonalizedPagerankPlan,
+    batched_personalized_pagerank,
+    incremental_pagerank,
+    local_personalized_pagerank,
+    pagerank,
+    pagerank_assert_valid,
+    personalized_pagerank,
+)
+from katana.analytics._partition import PartitionPlan, PartitionStatistics, partition, partition_assert_valid
+from katana.analytics._random_walks import RandomWalksPlan, random_walks
+from katana.analytics._reorder import ReorderPlan, ReorderStatistics, reorder, reorder_assert_valid
+from katana.analytics._shortest_path import (
+    KShortestSimplePathsPlan,
+    ShortestPath,
+    ShortestPathPlan,
+    ShortestPathQuery,
+    find_shortest_path,
+    k_shortest_simple_paths,
+)
+from katana.analytics._similarity_join import SimilarityJoinPlan, similarity_join
+from katana.analytics._sssp import SsspPlan, SsspStatistics, batched_sssp, sssp, sssp_assert_valid
+from katana.analytics._strongly_connected_components import (
+    StronglyConnectedComponentsPlan,
+    StronglyConnectedComponentsStatistics,
+    strongly_connected_components,
+    strongly_connected_components_assert_valid,
+)
 from katana.analytics._subgraph_extraction import SubGraphExtractionPlan, subgraph_extraction
 from katana.analytics._triangle_count import TriangleCountPlan, triangle_count
 from katana.analytics._wrappers import find_edge_sorted_by_dest, sort_all_edges_by_dest, sort_nodes_by_degree
@@ -7,6 +7,9 @@ Betweenness Centrality
     :special-members: __init__
     :undoc-members:
 
+.. [KADABRA] BORASSI, Michele, and NATALE, Emanuele. KADABRA is an ADaptive Algorithm for Betweenness via
+    Random Approximation. In: 24th Annual European Symposium on Algorithms (ESA 2016). 2016. p. 20:1-20:18.
+
 .. autoclass:: katana.analytics._betweenness_centrality._BetweennessCentralityAlgorithm
     :members:
     :undoc-members:
@@ -39,8 +42,11 @@ cdef extern from "katana/analytics/betweenness_centrality/betweenness_centrality
         enum Algorithm:
             kOuter "katana::analytics::BetweennessCentralityPlan::kOuter"
             kLevel "katana::analytics::BetweennessCentralityPlan::kLevel"
+            kAdaptiveSampling "katana::analytics::BetweennessCentralityPlan::kAdaptiveSampling"
 
         _BetweennessCentralityPlan.Algorithm algorithm() const
+        float epsilon() const
+        float delta() const
 
         BetweennessCentralityPlan()
 
@@ -49,8 +55,13 @@ cdef extern from "katana/analytics/betweenness_centrality/betweenness_centrality
         @staticmethod
         _BetweennessCentralityPlan Outer()
         @staticmethod
+        _BetweennessCentralityPlan AdaptiveSampling(float epsilon, float delta)
+        @staticmethod
         _BetweennessCentralityPlan FromAlgorithm(_BetweennessCentralityPlan.Algorithm algo)
 
+    double kDefaultEpsilon "katana::analytics::BetweennessCentralityPlan::kDefaultEpsilon"
+    double kDefaultDelta "katana::analytics::BetweennessCentralityPlan::kDefaultDelta"
+
     BetweennessCentralitySources kBetweennessCentralityAllNodes;
 
     Result[void] BetweennessCentrality(_PropertyGraph* pg, string output_property_name, const BetweennessCentralitySources& sources, _BetweennessCentralityPlan plan)
@@ -87,6 +98,7 @@ class _BetweennessCentralityAlgorithm(Enum):
     """
     Outer = _BetweennessCentralityPlan.Algorithm.kOuter
     Level = _BetweennessCentralityPlan.Algorithm.kLevel
+    AdaptiveSampling = _BetweennessCentralityPlan.Algorithm.kAdaptiveSampling
 
 
 cdef class BetweennessCentralityPlan(Plan):
@@ -113,6 +125,14 @@ cdef class BetweennessCentralityPlan(Plan):
     def algorithm(self) -> _BetweennessCentralityAlgorithm:
         return _BetweennessCentralityAlgorithm(self.underlying_.algorithm())
 
+    @property
+    def epsilon(self) -> float:
+        return self.underlying_.epsilon()
+
+    @property
+    def delta(self) -> float:
+        return self.underlying_.delta()
+
     @staticmethod
     def outer():
         """
@@ -127,6 +147,15 @@ cdef class BetweennessCentralityPlan(Plan):
         """
         return BetweennessCentralityPlan.make(_BetweennessCentralityPlan.Level())
 
+    @staticmethod
+    def adaptive_sampling(float epsilon = kDefaultEpsilon, float delta = kDefaultDelta):
+        """
+        Sample random shortest paths in parallel until, with probability at least `1 - delta`, every node's
+        normalized centrality is within `epsilon` of the exact one [KADABRA]_. The computed values are scaled by
+        `n(n-1)` to be comparable to exact centralities, and `sources` is ignored.
+        """
+        return BetweennessCentralityPlan.make(_BetweennessCentralityPlan.AdaptiveSampling(epsilon, delta))
+
 
 def betweenness_centrality(PropertyGraph pg, str output_property_name, sources = None,
              BetweennessCentralityPlan plan = BetweennessCentralityPlan()):
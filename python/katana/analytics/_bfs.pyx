@@ -18,11 +18,14 @@ Breadth-first Search
     :undoc-members:
 
 .. autofunction:: katana.analytics.bfs_assert_valid
+
+.. autofunction:: katana.analytics.multi_source_bfs
 """
 
 from libc.stddef cimport ptrdiff_t
 from libc.stdint cimport uint32_t, uint64_t
 from libcpp.string cimport string
+from libcpp.vector cimport vector
 
 from katana._property_graph cimport PropertyGraph
 from katana.analytics.plan cimport Plan, _Plan
@@ -71,6 +74,11 @@ cdef extern from "katana/Analytics.h" namespace "katana::analytics" nogil:
                      string output_property_name,
                      _BfsPlan algo)
 
+    Result[void] MultiSourceBfs(_PropertyGraph * pg,
+                                const vector[uint32_t]& sources,
+                                const vector[string]& output_property_names,
+                                _BfsPlan algo)
+
     Result[void] BfsAssertValid(_PropertyGraph* pg, uint32_t start_node,
                                 string property_name);
 
@@ -190,6 +198,30 @@ def bfs_assert_valid(PropertyGraph pg, uint32_t start_node, str property_name):
     with nogil:
         handle_result_assert(BfsAssertValid(pg.underlying_property_graph(), start_node, output_property_name_cstr))
 
+def multi_source_bfs(PropertyGraph pg, sources, output_property_names, BfsPlan plan = BfsPlan()):
+    """
+    Compute the Breadth-First Search distances on `pg` from each node in `sources`. The distances from `sources[i]`
+    are written to the uint32 property `output_property_names[i]`; unreachable nodes have the maximum uint32 value.
+    Sources are traversed together in batches of up to 512 so that each edge scan is shared by the whole batch.
+
+    :type pg: PropertyGraph
+    :param pg: The graph to analyze.
+    :type sources: list[int]
+    :param sources: The source nodes.
+    :type output_property_names: list[str]
+    :param output_property_names: The output properties to write distances into, one per source. These properties
+        must not already exist.
+    :type plan: BfsPlan
+    :param plan: The execution plan to use. Only :py:meth:`BfsPlan.synchronous_direction_opt` is supported.
+    """
+    cdef vector[uint32_t] sources_vec = sources
+    cdef vector[string] output_property_names_vec
+    for name in output_property_names:
+        output_property_names_vec.push_back(bytes(name, "utf-8"))
+    with nogil:
+        handle_result_void(MultiSourceBfs(pg.underlying_property_graph(), sources_vec, output_property_names_vec,
+                                          plan.underlying_))
+
 cdef _BfsStatistics handle_result_BfsStatistics(Result[_BfsStatistics] res) nogil except *:
     if not res.has_value():
         with gil:
@@ -26,6 +26,7 @@ Connected Components
 from libc.stddef cimport ptrdiff_t
 from libc.stdint cimport uint32_t, uint64_t
 from libcpp.string cimport string
+from libcpp.vector cimport vector
 
 from katana._property_graph cimport PropertyGraph
 from katana.analytics.plan cimport Plan, _Plan
@@ -97,6 +98,9 @@ cdef extern from "katana/analytics/connected_components/connected_components.h"
 
     Result[void] ConnectedComponentsAssertValid(_PropertyGraph*pg, string output_property_name)
 
+    Result[void] IncrementalConnectedComponents(_PropertyGraph*pg, const string& property_name,
+        const vector[uint32_t]& srcs, const vector[uint32_t]& dsts)
+
     cppclass _ConnectedComponentsStatistics "katana::analytics::ConnectedComponentsStatistics":
         uint64_t total_components
         uint64_t total_non_trivial_components
@@ -272,6 +276,28 @@ def connected_components_assert_valid(PropertyGraph pg, str output_property_name
     with nogil:
         handle_result_assert(ConnectedComponentsAssertValid(pg.underlying_property_graph(), output_property_name_str))
 
+def incremental_connected_components(PropertyGraph pg, str property_name, srcs, dsts):
+    """
+    Update the components in `property_name` after the edges `srcs[i]` -> `dsts[i]` have been inserted into `pg`.
+    Components can only merge, so the work is proportional to the batch plus a pass over the nodes to relabel them.
+    Nodes inserted along with the edges have a null component and are given new components.
+
+    :type pg: PropertyGraph
+    :param pg: The graph to analyze, which must already contain the new edges.
+    :type property_name: str
+    :param property_name: The property holding the components computed by `connected_components`.
+    :type srcs: list[int]
+    :param srcs: The sources of the inserted edges.
+    :type dsts: list[int]
+    :param dsts: The destinations of the inserted edges.
+    """
+    cdef string property_name_str = property_name.encode("utf-8")
+    cdef vector[uint32_t] srcs_vec = srcs
+    cdef vector[uint32_t] dsts_vec = dsts
+    with nogil:
+        handle_result_void(IncrementalConnectedComponents(pg.underlying_property_graph(), property_name_str, srcs_vec,
+                                                          dsts_vec))
+
 cdef _ConnectedComponentsStatistics handle_result_ConnectedComponentsStatistics(
         Result[_ConnectedComponentsStatistics] res) nogil except *:
     if not res.has_value():
@@ -0,0 +1,227 @@
+"""
+Matrix Completion
+-----------------
+
+.. autoclass:: katana.analytics.MatrixCompletionPlan
+    :members:
+    :special-members: __init__
+    :undoc-members:
+
+.. autoclass:: katana.analytics._matrix_completion._MatrixCompletionPlanAlgorithm
+    :members:
+    :undoc-members:
+
+.. autofunction:: katana.analytics.matrix_completion
+
+.. autoclass:: katana.analytics.MatrixCompletionStatistics
+    :members:
+    :undoc-members:
+
+.. autofunction:: katana.analytics.matrix_completion_assert_valid
+"""
+from libc.stdint cimport uint32_t
+from libcpp.string cimport string
+
+from katana._property_graph cimport PropertyGraph
+from katana.analytics.plan cimport Plan, _Plan
+from katana.cpp.libgalois.graphs.Graph cimport _PropertyGraph
+from katana.cpp.libstd.iostream cimport ostream, ostringstream
+from katana.cpp.libsupport.result cimport Result, handle_result_assert, handle_result_void, raise_error_code
+
+from enum import Enum
+
+
+cdef extern from "katana/analytics/matrix_completion/matrix_completion.h" namespace "katana::analytics" nogil:
+    cppclass _MatrixCompletionPlan "katana::analytics::MatrixCompletionPlan" (_Plan):
+        enum Algorithm:
+            kSGD "katana::analytics::MatrixCompletionPlan::kSGD"
+            kALS "katana::analytics::MatrixCompletionPlan::kALS"
+
+        _MatrixCompletionPlan.Algorithm algorithm() const
+        double learning_rate() const
+        double lambda_ "lambda"() const
+        uint32_t max_iterations() const
+        double tolerance() const
+
+        MatrixCompletionPlan()
+
+        @staticmethod
+        _MatrixCompletionPlan SGD(double learning_rate, double lambda_, uint32_t max_iterations, double tolerance)
+
+        @staticmethod
+        _MatrixCompletionPlan ALS(double lambda_, uint32_t max_iterations, double tolerance)
+
+    double kDefaultLearningRate "katana::analytics::MatrixCompletionPlan::kDefaultLearningRate"
+    double kDefaultLambda "katana::analytics::MatrixCompletionPlan::kDefaultLambda"
+    uint32_t kDefaultMaxIterations "katana::analytics::MatrixCompletionPlan::kDefaultMaxIterations"
+    double kDefaultTolerance "katana::analytics::MatrixCompletionPlan::kDefaultTolerance"
+
+    Result[void] MatrixCompletion(_PropertyGraph* pg, string edge_rating_property_name, string output_property_name,
+        uint32_t latent_dimension, _MatrixCompletionPlan plan)
+
+    Result[void] MatrixCompletionAssertValid(_PropertyGraph* pg, string property_name)
+
+    cppclass _MatrixCompletionStatistics "katana::analytics::MatrixCompletionStatistics":
+        uint32_t latent_dimension
+        double root_mean_square_error
+
+        void Print(ostream os)
+
+        @staticmethod
+        Result[_MatrixCompletionStatistics] Compute(_PropertyGraph* pg, string edge_rating_property_name,
+            string property_name)
+
+
+class _MatrixCompletionPlanAlgorithm(Enum):
+    """
+    :see: :py:class:`~katana.analytics.MatrixCompletionPlan` constructors for algorithm documentation.
+    """
+    SGD = _MatrixCompletionPlan.Algorithm.kSGD
+    ALS = _MatrixCompletionPlan.Algorithm.kALS
+
+
+cdef class MatrixCompletionPlan(Plan):
+    """
+    A computational :ref:`Plan` for Matrix Completion.
+
+    Static methods construct MatrixCompletionPlans.
+    """
+    cdef:
+        _MatrixCompletionPlan underlying_
+
+    cdef _Plan* underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _MatrixCompletionPlanAlgorithm
+
+    @staticmethod
+    cdef MatrixCompletionPlan make(_MatrixCompletionPlan u):
+        f = <MatrixCompletionPlan>MatrixCompletionPlan.__new__(MatrixCompletionPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _MatrixCompletionPlanAlgorithm:
+        return _MatrixCompletionPlanAlgorithm(self.underlying_.algorithm())
+
+    @property
+    def learning_rate(self) -> float:
+        return self.underlying_.learning_rate()
+
+    @property
+    def lambda_(self) -> float:
+        return self.underlying_.lambda_()
+
+    @property
+    def max_iterations(self) -> int:
+        return self.underlying_.max_iterations()
+
+    @property
+    def tolerance(self) -> float:
+        return self.underlying_.tolerance()
+
+    @staticmethod
+    def sgd(double learning_rate = kDefaultLearningRate, double lambda_ = kDefaultLambda,
+            uint32_t max_iterations = kDefaultMaxIterations, double tolerance = kDefaultTolerance):
+        """
+        Stochastic gradient descent over a 2D grid of blocks of ratings, in which the threads update blocks that share
+        no item or user, without locks. The step size is adapted after every pass with the bold driver heuristic.
+
+        :param learning_rate: The initial step size.
+        :param lambda_: The weight of the regularization of the latent vectors.
+        :param max_iterations: The maximum number of passes over the ratings.
+        :param tolerance: Stop once a pass changes the squared error by less than this fraction.
+        """
+        return MatrixCompletionPlan.make(_MatrixCompletionPlan.SGD(learning_rate, lambda_, max_iterations, tolerance))
+
+    @staticmethod
+    def als(double lambda_ = kDefaultLambda, uint32_t max_iterations = kDefaultMaxIterations,
+            double tolerance = kDefaultTolerance):
+        """
+        Alternating least squares: solve for the latent vectors of all items with the users fixed, and then the other
+        way around.
+
+        :param lambda_: The weight of the regularization of the latent vectors.
+        :param max_iterations: The maximum number of passes over the ratings.
+        :param tolerance: Stop once a pass changes the squared error by less than this fraction.
+        """
+        return MatrixCompletionPlan.make(_MatrixCompletionPlan.ALS(lambda_, max_iterations, tolerance))
+
+
+def matrix_completion(PropertyGraph pg, str edge_rating_property_name, str output_property_name,
+                      uint32_t latent_dimension, MatrixCompletionPlan plan = MatrixCompletionPlan()):
+    """
+    Factor the sparse matrix of ratings given by the edges of the graph into latent vectors, so that the dot product
+    of the latent vectors of the endpoints of an edge approximates its rating. The graph must be bipartite with edges
+    from items to users.
+
+    :type pg: PropertyGraph
+    :param pg: The graph of ratings.
+    :type edge_rating_property_name: str
+    :param edge_rating_property_name: The numeric edge property holding the ratings.
+    :type output_property_name: str
+    :param output_property_name: The output property to store the latent vector of each node in, as a fixed size list
+        of floats. This property must not already exist.
+    :type latent_dimension: int
+    :param latent_dimension: The number of values in each latent vector.
+    :type plan: MatrixCompletionPlan
+    :param plan: The execution plan to use.
+    """
+    cdef string edge_rating_property_name_str = bytes(edge_rating_property_name, "utf-8")
+    cdef string output_property_name_str = bytes(output_property_name, "utf-8")
+    with nogil:
+        handle_result_void(MatrixCompletion(pg.underlying_property_graph(), edge_rating_property_name_str,
+                                            output_property_name_str, latent_dimension, plan.underlying_))
+
+
+def matrix_completion_assert_valid(PropertyGraph pg, str property_name):
+    """
+    Raise an exception if the latent vectors in `pg` are missing or not finite. This is not an exhaustive check, just a
+    sanity check.
+
+    :raises: AssertionError
+    """
+    cdef string property_name_str = bytes(property_name, "utf-8")
+    with nogil:
+        handle_result_assert(MatrixCompletionAssertValid(pg.underlying_property_graph(), property_name_str))
+
+
+cdef _MatrixCompletionStatistics handle_result_MatrixCompletionStatistics(
+        Result[_MatrixCompletionStatistics] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+cdef class MatrixCompletionStatistics:
+    """
+    Compute the :ref:`statistics` of a matrix completion.
+    """
+    cdef _MatrixCompletionStatistics underlying
+
+    def __init__(self, PropertyGraph pg, str edge_rating_property_name, str property_name):
+        cdef string edge_rating_property_name_str = bytes(edge_rating_property_name, "utf-8")
+        cdef string property_name_str = bytes(property_name, "utf-8")
+        with nogil:
+            self.underlying = handle_result_MatrixCompletionStatistics(_MatrixCompletionStatistics.Compute(
+                pg.underlying_property_graph(), edge_rating_property_name_str, property_name_str))
+
+    @property
+    def latent_dimension(self) -> int:
+        """
+        The number of values in each latent vector.
+        """
+        return self.underlying.latent_dimension
+
+    @property
+    def root_mean_square_error(self) -> float:
+        """
+        The root mean square error of the predicted ratings.
+        """
+        return self.underlying.root_mean_square_error
+
+    def __str__(self) -> str:
+        cdef ostringstream ss
+        self.underlying.Print(ss)
+        return str(ss.str(), "ascii")
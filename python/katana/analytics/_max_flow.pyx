@@ -0,0 +1,214 @@
+"""
+Max Flow
+--------
+
+.. autoclass:: katana.analytics.MaxFlowPlan
+    :members:
+    :special-members: __init__
+    :undoc-members:
+
+.. autoclass:: katana.analytics._max_flow._MaxFlowPlanAlgorithm
+    :members:
+    :undoc-members:
+
+.. autofunction:: katana.analytics.max_flow
+
+.. autoclass:: katana.analytics.MaxFlowStatistics
+    :members:
+    :undoc-members:
+
+.. autofunction:: katana.analytics.max_flow_assert_valid
+"""
+from libc.stdint cimport uint32_t, uint64_t
+from libcpp.string cimport string
+
+from katana._property_graph cimport PropertyGraph
+from katana.analytics.plan cimport Plan, _Plan
+from katana.cpp.libgalois.graphs.Graph cimport _PropertyGraph
+from katana.cpp.libstd.iostream cimport ostream, ostringstream
+from katana.cpp.libsupport.result cimport Result, handle_result_assert, raise_error_code
+
+from enum import Enum
+
+
+cdef extern from "katana/analytics/max_flow/max_flow.h" namespace "katana::analytics" nogil:
+    cppclass _MaxFlowPlan "katana::analytics::MaxFlowPlan" (_Plan):
+        enum Algorithm:
+            kPushRelabel "katana::analytics::MaxFlowPlan::kPushRelabel"
+
+        _MaxFlowPlan.Algorithm algorithm() const
+        uint64_t global_relabel_interval() const
+
+        MaxFlowPlan()
+
+        @staticmethod
+        _MaxFlowPlan PushRelabel(uint64_t global_relabel_interval)
+
+    uint64_t kDefaultGlobalRelabelInterval "katana::analytics::MaxFlowPlan::kDefaultGlobalRelabelInterval"
+
+    Result[uint64_t] MaxFlow(_PropertyGraph* pg, uint32_t source, uint32_t sink, string edge_capacity_property_name,
+        string output_flow_property_name, string output_cut_property_name, _MaxFlowPlan plan)
+
+    Result[void] MaxFlowAssertValid(_PropertyGraph* pg, uint32_t source, uint32_t sink,
+        string edge_capacity_property_name, string flow_property_name, string cut_property_name)
+
+    cppclass _MaxFlowStatistics "katana::analytics::MaxFlowStatistics":
+        uint64_t flow_value
+        uint64_t cut_edges
+        uint64_t source_side_size
+
+        void Print(ostream os)
+
+        @staticmethod
+        Result[_MaxFlowStatistics] Compute(_PropertyGraph* pg, uint32_t source, string flow_property_name,
+            string cut_property_name)
+
+
+class _MaxFlowPlanAlgorithm(Enum):
+    """
+    :see: :py:class:`~katana.analytics.MaxFlowPlan` constructors for algorithm documentation.
+    """
+    PushRelabel = _MaxFlowPlan.Algorithm.kPushRelabel
+
+
+cdef class MaxFlowPlan(Plan):
+    """
+    A computational :ref:`Plan` for Max Flow.
+
+    Static methods construct MaxFlowPlans.
+    """
+    cdef:
+        _MaxFlowPlan underlying_
+
+    cdef _Plan* underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _MaxFlowPlanAlgorithm
+
+    @staticmethod
+    cdef MaxFlowPlan make(_MaxFlowPlan u):
+        f = <MaxFlowPlan>MaxFlowPlan.__new__(MaxFlowPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _MaxFlowPlanAlgorithm:
+        return _MaxFlowPlanAlgorithm(self.underlying_.algorithm())
+
+    @property
+    def global_relabel_interval(self) -> int:
+        return self.underlying_.global_relabel_interval()
+
+    @staticmethod
+    def push_relabel(uint64_t global_relabel_interval = kDefaultGlobalRelabelInterval):
+        """
+        Asynchronous lock-free push-relabel with parallel global relabeling and the gap heuristic.
+
+        :param global_relabel_interval: The amount of work, counting one per push and 12 per relabel, after which the
+            heights are recomputed from scratch. 0 picks an interval from the size of the graph.
+        """
+        return MaxFlowPlan.make(_MaxFlowPlan.PushRelabel(global_relabel_interval))
+
+
+cdef uint64_t handle_result_int(Result[uint64_t] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+def max_flow(PropertyGraph pg, uint32_t source, uint32_t sink, str edge_capacity_property_name,
+             str output_flow_property_name, str output_cut_property_name, MaxFlowPlan plan = MaxFlowPlan()) -> int:
+    """
+    Compute a maximum flow from `source` to `sink` and a minimum cut. The residual edges are paired with the edges of
+    the transpose of the graph, so the graph needs no reverse edges.
+
+    :type pg: PropertyGraph
+    :param pg: The flow network.
+    :type source: int
+    :param source: The node the flow leaves from.
+    :type sink: int
+    :param sink: The node the flow arrives to.
+    :type edge_capacity_property_name: str
+    :param edge_capacity_property_name: The edge property holding the capacities, which must be non-negative integers.
+    :type output_flow_property_name: str
+    :param output_flow_property_name: The output edge property to store the flow along each edge in. This property
+        must not already exist.
+    :type output_cut_property_name: str
+    :param output_cut_property_name: The output node property to store 1 in for the nodes on the source side of a
+        minimum cut, and 0 for the others. This property must not already exist.
+    :type plan: MaxFlowPlan
+    :param plan: The execution plan to use.
+    :return: The value of the flow.
+    """
+    cdef string edge_capacity_property_name_str = bytes(edge_capacity_property_name, "utf-8")
+    cdef string output_flow_property_name_str = bytes(output_flow_property_name, "utf-8")
+    cdef string output_cut_property_name_str = bytes(output_cut_property_name, "utf-8")
+    with nogil:
+        v = handle_result_int(MaxFlow(pg.underlying_property_graph(), source, sink, edge_capacity_property_name_str,
+                                      output_flow_property_name_str, output_cut_property_name_str, plan.underlying_))
+    return v
+
+
+def max_flow_assert_valid(PropertyGraph pg, uint32_t source, uint32_t sink, str edge_capacity_property_name,
+                          str flow_property_name, str cut_property_name):
+    """
+    Raise an exception if the flow exceeds a capacity or is not conserved, or if the cut does not prove that the flow
+    is maximum.
+
+    :raises: AssertionError
+    """
+    cdef string edge_capacity_property_name_str = bytes(edge_capacity_property_name, "utf-8")
+    cdef string flow_property_name_str = bytes(flow_property_name, "utf-8")
+    cdef string cut_property_name_str = bytes(cut_property_name, "utf-8")
+    with nogil:
+        handle_result_assert(MaxFlowAssertValid(pg.underlying_property_graph(), source, sink,
+                                                edge_capacity_property_name_str, flow_property_name_str,
+                                                cut_property_name_str))
+
+
+cdef _MaxFlowStatistics handle_result_MaxFlowStatistics(Result[_MaxFlowStatistics] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+cdef class MaxFlowStatistics:
+    """
+    Compute the :ref:`statistics` of a flow and cut.
+    """
+    cdef _MaxFlowStatistics underlying
+
+    def __init__(self, PropertyGraph pg, uint32_t source, str flow_property_name, str cut_property_name):
+        cdef string flow_property_name_str = bytes(flow_property_name, "utf-8")
+        cdef string cut_property_name_str = bytes(cut_property_name, "utf-8")
+        with nogil:
+            self.underlying = handle_result_MaxFlowStatistics(_MaxFlowStatistics.Compute(
+                pg.underlying_property_graph(), source, flow_property_name_str, cut_property_name_str))
+
+    @property
+    def flow_value(self) -> int:
+        """
+        The net flow out of the source.
+        """
+        return self.underlying.flow_value
+
+    @property
+    def cut_edges(self) -> int:
+        """
+        The number of edges from the source side to the sink side of the cut.
+        """
+        return self.underlying.cut_edges
+
+    @property
+    def source_side_size(self) -> int:
+        """
+        The number of nodes on the source side of the cut.
+        """
+        return self.underlying.source_side_size
+
+    def __str__(self) -> str:
+        cdef ostringstream ss
+        self.underlying.Print(ss)
+        return str(ss.str(), "ascii")
@@ -0,0 +1,209 @@
+"""
+Minimum Spanning Forest
+-----------------------
+
+.. autoclass:: katana.analytics.MinimumSpanningForestPlan
+    :members:
+    :special-members: __init__
+    :undoc-members:
+
+.. autoclass:: katana.analytics._minimum_spanning_forest._MinimumSpanningForestPlanAlgorithm
+    :members:
+    :undoc-members:
+
+.. autofunction:: katana.analytics.minimum_spanning_forest
+
+.. autoclass:: katana.analytics.MinimumSpanningForestStatistics
+    :members:
+    :undoc-members:
+
+.. autofunction:: katana.analytics.minimum_spanning_forest_assert_valid
+"""
+from libc.stdint cimport uint64_t
+from libcpp.string cimport string
+
+from katana._property_graph cimport PropertyGraph
+from katana.analytics.plan cimport Plan, _Plan
+from katana.cpp.libgalois.graphs.Graph cimport _PropertyGraph
+from katana.cpp.libstd.iostream cimport ostream, ostringstream
+from katana.cpp.libsupport.result cimport Result, handle_result_assert, raise_error_code
+
+from enum import Enum
+
+
+cdef extern from "katana/analytics/minimum_spanning_forest/minimum_spanning_forest.h" namespace "katana::analytics" nogil:
+    cppclass _MinimumSpanningForestPlan "katana::analytics::MinimumSpanningForestPlan" (_Plan):
+        enum Algorithm:
+            kBoruvka "katana::analytics::MinimumSpanningForestPlan::kBoruvka"
+            kFilterKruskal "katana::analytics::MinimumSpanningForestPlan::kFilterKruskal"
+
+        _MinimumSpanningForestPlan.Algorithm algorithm() const
+
+        MinimumSpanningForestPlan()
+
+        @staticmethod
+        _MinimumSpanningForestPlan Boruvka()
+
+        @staticmethod
+        _MinimumSpanningForestPlan FilterKruskal()
+
+    Result[double] MinimumSpanningForest(_PropertyGraph* pg, string edge_weight_property_name,
+        string output_property_name, _MinimumSpanningForestPlan plan)
+
+    Result[void] MinimumSpanningForestAssertValid(_PropertyGraph* pg, string edge_weight_property_name,
+        string property_name)
+
+    cppclass _MinimumSpanningForestStatistics "katana::analytics::MinimumSpanningForestStatistics":
+        uint64_t num_forest_edges
+        uint64_t num_trees
+        double total_weight
+
+        void Print(ostream os)
+
+        @staticmethod
+        Result[_MinimumSpanningForestStatistics] Compute(_PropertyGraph* pg, string edge_weight_property_name,
+            string property_name)
+
+
+class _MinimumSpanningForestPlanAlgorithm(Enum):
+    """
+    :see: :py:class:`~katana.analytics.MinimumSpanningForestPlan` constructors for algorithm documentation.
+    """
+    Boruvka = _MinimumSpanningForestPlan.Algorithm.kBoruvka
+    FilterKruskal = _MinimumSpanningForestPlan.Algorithm.kFilterKruskal
+
+
+cdef class MinimumSpanningForestPlan(Plan):
+    """
+    A computational :ref:`Plan` for Minimum Spanning Forest.
+
+    Static methods construct MinimumSpanningForestPlans.
+    """
+    cdef:
+        _MinimumSpanningForestPlan underlying_
+
+    cdef _Plan* underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _MinimumSpanningForestPlanAlgorithm
+
+    @staticmethod
+    cdef MinimumSpanningForestPlan make(_MinimumSpanningForestPlan u):
+        f = <MinimumSpanningForestPlan>MinimumSpanningForestPlan.__new__(MinimumSpanningForestPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _MinimumSpanningForestPlanAlgorithm:
+        return _MinimumSpanningForestPlanAlgorithm(self.underlying_.algorithm())
+
+    @staticmethod
+    def boruvka():
+        """
+        Bulk-synchronous Boruvka: every component finds its lightest outgoing edge in parallel, and all of these edges
+        are added at once with a lock-free union-find.
+        """
+        return MinimumSpanningForestPlan.make(_MinimumSpanningForestPlan.Boruvka())
+
+    @staticmethod
+    def filter_kruskal():
+        """
+        Filter-Kruskal: partition the edges around a pivot weight, recurse on the light edges, and drop the heavy edges
+        whose endpoints are already connected before recursing on the rest. Suited to sparse graphs.
+        """
+        return MinimumSpanningForestPlan.make(_MinimumSpanningForestPlan.FilterKruskal())
+
+
+cdef double handle_result_double(Result[double] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+def minimum_spanning_forest(PropertyGraph pg, str edge_weight_property_name, str output_property_name,
+                            MinimumSpanningForestPlan plan = MinimumSpanningForestPlan()) -> float:
+    """
+    Compute a minimum spanning forest of the graph, taking every edge as undirected. Ties between edges of equal weight
+    are broken by edge ID, so all plans find the same forest. For a symmetric graph, only one of the two copies of an
+    edge of the forest is part of it.
+
+    :type pg: PropertyGraph
+    :param pg: The graph to span.
+    :type edge_weight_property_name: str
+    :param edge_weight_property_name: The numeric edge property holding the weights.
+    :type output_property_name: str
+    :param output_property_name: The output edge property to store 1 in for the edges of the forest, and 0 for the
+        others. This property must not already exist.
+    :type plan: MinimumSpanningForestPlan
+    :param plan: The execution plan to use.
+    :return: The total weight of the forest.
+    """
+    cdef string edge_weight_property_name_str = bytes(edge_weight_property_name, "utf-8")
+    cdef string output_property_name_str = bytes(output_property_name, "utf-8")
+    with nogil:
+        v = handle_result_double(MinimumSpanningForest(pg.underlying_property_graph(), edge_weight_property_name_str,
+                                                       output_property_name_str, plan.underlying_))
+    return v
+
+
+def minimum_spanning_forest_assert_valid(PropertyGraph pg, str edge_weight_property_name, str property_name):
+    """
+    Raise an exception if the forest has a cycle, does not connect the endpoints of some edge, or is not of minimum
+    weight.
+
+    :raises: AssertionError
+    """
+    cdef string edge_weight_property_name_str = bytes(edge_weight_property_name, "utf-8")
+    cdef string property_name_str = bytes(property_name, "utf-8")
+    with nogil:
+        handle_result_assert(MinimumSpanningForestAssertValid(pg.underlying_property_graph(),
+                                                              edge_weight_property_name_str, property_name_str))
+
+
+cdef _MinimumSpanningForestStatistics handle_result_MinimumSpanningForestStatistics(
+        Result[_MinimumSpanningForestStatistics] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+cdef class MinimumSpanningForestStatistics:
+    """
+    Compute the :ref:`statistics` of a minimum spanning forest.
+    """
+    cdef _MinimumSpanningForestStatistics underlying
+
+    def __init__(self, PropertyGraph pg, str edge_weight_property_name, str property_name):
+        cdef string edge_weight_property_name_str = bytes(edge_weight_property_name, "utf-8")
+        cdef string property_name_str = bytes(property_name, "utf-8")
+        with nogil:
+            self.underlying = handle_result_MinimumSpanningForestStatistics(_MinimumSpanningForestStatistics.Compute(
+                pg.underlying_property_graph(), edge_weight_property_name_str, property_name_str))
+
+    @property
+    def num_forest_edges(self) -> int:
+        """
+        The number of edges in the forest.
+        """
+        return self.underlying.num_forest_edges
+
+    @property
+    def num_trees(self) -> int:
+        """
+        The number of trees in the forest, counting isolated nodes.
+        """
+        return self.underlying.num_trees
+
+    @property
+    def total_weight(self) -> float:
+        """
+        The sum of the weights of the edges in the forest.
+        """
+        return self.underlying.total_weight
+
+    def __str__(self) -> str:
+        cdef ostringstream ss
+        self.underlying.Print(ss)
+        return str(ss.str(), "ascii")
@@ -11,6 +11,10 @@ Page Rank
     system issues, and lessons learned. In: European Conference on Parallel
     Processing. Springer, Berlin, Heidelberg, 2015. p. 438-450.
 
+.. [BEAMER] BEAMER, Scott; ASANOVIC, Krste; PATTERSON, David. Reducing PageRank
+    communication via propagation blocking. In: 2017 IEEE International Parallel
+    and Distributed Processing Symposium. IEEE, 2017. p. 820-831.
+
 .. autoclass:: katana.analytics._pagerank._PagerankPlanAlgorithm
     :members:
     :undoc-members:
@@ -22,8 +26,31 @@ Page Rank
     :undoc-members:
 
 .. autofunction:: katana.analytics.pagerank_assert_valid
+
+.. autoclass:: katana.analytics.PersonalizedPagerankPlan
+    :members:
+    :special-members: __init__
+    :undoc-members:
+
+.. [ACL] ANDERSEN, Reid, CHUNG, Fan, and LANG, Kevin. Local graph partitioning using
+    PageRank vectors. In: 47th Annual IEEE Symposium on Foundations of Computer Science
+    (FOCS'06). IEEE, 2006. p. 475-486.
+
+.. autoclass:: katana.analytics._pagerank._PersonalizedPagerankPlanAlgorithm
+    :members:
+    :undoc-members:
+
+.. autofunction:: katana.analytics.personalized_pagerank
+
+.. autofunction:: katana.analytics.local_personalized_pagerank
+
+.. autofunction:: katana.analytics.batched_personalized_pagerank
 """
+from libc.stdint cimport uint32_t
+from libcpp.pair cimport pair
 from libcpp.string cimport string
+from libcpp.utility cimport move
+from libcpp.vector cimport vector
 
 from katana._property_graph cimport PropertyGraph
 from katana.analytics.plan cimport Plan, _Plan
@@ -41,6 +68,7 @@ cdef extern from "katana/analytics/pagerank/pagerank.h" namespace "katana::analy
             kPullResidual "katana::analytics::PagerankPlan::kPullResidual"
             kPushSynchronous "katana::analytics::PagerankPlan::kPushSynchronous"
             kPushAsynchronous "katana::analytics::PagerankPlan::kPushAsynchronous"
+            kPropagationBlocking "katana::analytics::PagerankPlan::kPropagationBlocking"
 
         # unsigned int kChunkSize
 
@@ -49,6 +77,7 @@ cdef extern from "katana/analytics/pagerank/pagerank.h" namespace "katana::analy
         unsigned int max_iterations() const
         float alpha() const
         float initial_residual() const
+        uint32_t block_size() const
 
         PagerankPlan()
 
@@ -60,15 +89,48 @@ cdef extern from "katana/analytics/pagerank/pagerank.h" namespace "katana::analy
         _PagerankPlan PushAsynchronous(float tolerance, float alpha)
         @staticmethod
         _PagerankPlan PushSynchronous(float tolerance, unsigned int max_iterations, float alpha)
+        @staticmethod
+        _PagerankPlan PropagationBlocking(float tolerance, unsigned int max_iterations, float alpha, uint32_t block_size)
 
     double kDefaultTolerance "katana::analytics::PagerankPlan::kDefaultTolerance"
     int kDefaultMaxIterations "katana::analytics::PagerankPlan::kDefaultMaxIterations"
     double kDefaultAlpha "katana::analytics::PagerankPlan::kDefaultAlpha"
+    uint32_t kDefaultBlockSize "katana::analytics::PagerankPlan::kDefaultBlockSize"
 
     Result[void] Pagerank(_PropertyGraph* pg, string output_property_name, _PagerankPlan plan)
 
     Result[void] PagerankAssertValid(_PropertyGraph* pg, string output_property_name)
 
+    Result[void] IncrementalPagerank(_PropertyGraph* pg, const string& property_name, const vector[uint32_t]& srcs,
+        const vector[uint32_t]& dsts, _PagerankPlan plan)
+
+    cppclass _PersonalizedPagerankPlan "katana::analytics::PersonalizedPagerankPlan" (_Plan):
+        enum Algorithm:
+            kForwardPush "katana::analytics::PersonalizedPagerankPlan::kForwardPush"
+            kPushAsynchronous "katana::analytics::PersonalizedPagerankPlan::kPushAsynchronous"
+
+        _PersonalizedPagerankPlan.Algorithm algorithm() const
+        float epsilon() const
+        float alpha() const
+
+        PersonalizedPagerankPlan()
+
+        @staticmethod
+        _PersonalizedPagerankPlan ForwardPush(float epsilon, float alpha)
+        @staticmethod
+        _PersonalizedPagerankPlan PushAsynchronous(float epsilon, float alpha)
+
+    double kDefaultEpsilon "katana::analytics::PersonalizedPagerankPlan::kDefaultEpsilon"
+
+    Result[void] PersonalizedPagerank(_PropertyGraph* pg, const vector[uint32_t]& seeds,
+        const string& output_property_name, _PersonalizedPagerankPlan plan)
+
+    Result[vector[pair[uint32_t, float]]] LocalPersonalizedPagerank(_PropertyGraph* pg,
+        const vector[uint32_t]& seeds, _PersonalizedPagerankPlan plan)
+
+    Result[void] BatchedPersonalizedPagerank(_PropertyGraph* pg, const vector[uint32_t]& seeds,
+        const vector[string]& output_property_names, _PersonalizedPagerankPlan plan)
+
     cppclass _PagerankStatistics "katana::analytics::PagerankStatistics":
         float max_rank
         float min_rank
@@ -85,6 +147,7 @@ class _PagerankPlanAlgorithm(Enum):
     PullResidual = _PagerankPlan.Algorithm.kPullResidual
     PushSynchronous = _PagerankPlan.Algorithm.kPushSynchronous
     PushAsynchronous = _PagerankPlan.Algorithm.kPushAsynchronous
+    PropagationBlocking = _PagerankPlan.Algorithm.kPropagationBlocking
 
 
 cdef class PagerankPlan(Plan):
@@ -127,6 +190,10 @@ cdef class PagerankPlan(Plan):
     def initial_residual(self) -> float:
         return self.underlying_.initial_residual()
 
+    @property
+    def block_size(self) -> int:
+        return self.underlying_.block_size()
+
     @staticmethod
     def pull_topological(float tolerance = kDefaultTolerance, unsigned int max_iterations = kDefaultMaxIterations, float alpha = kDefaultAlpha):
         """
@@ -166,6 +233,18 @@ cdef class PagerankPlan(Plan):
         """
         return PagerankPlan.make(_PagerankPlan.PushSynchronous(tolerance, max_iterations, alpha))
 
+    @staticmethod
+    def propagation_blocking(float tolerance = kDefaultTolerance, unsigned int max_iterations = kDefaultMaxIterations,
+                             float alpha = kDefaultAlpha, uint32_t block_size = kDefaultBlockSize):
+        """
+        Propagation blocking algorithm [BEAMER]_
+
+        Computes the same ranks as the topological algorithm but pushes along the edges of the graph, which must not be
+        transposed. Rank contributions are binned by blocks of `block_size` destination nodes so that the random
+        accesses to ranks stay in cache.
+        """
+        return PagerankPlan.make(_PagerankPlan.PropagationBlocking(tolerance, max_iterations, alpha, block_size))
+
 
 def pagerank(PropertyGraph pg, str output_property_name, PagerankPlan plan = PagerankPlan()):
     """
@@ -196,6 +275,31 @@ def pagerank_assert_valid(PropertyGraph pg, str output_property_name):
         handle_result_assert(PagerankAssertValid(pg.underlying_property_graph(), output_property_name_cstr))
 
 
+def incremental_pagerank(PropertyGraph pg, str property_name, srcs, dsts, PagerankPlan plan = PagerankPlan()):
+    """
+    Update the ranks in `property_name` after the edges `srcs[i]` -> `dsts[i]` have been inserted into `pg`. Only the
+    residuals the new edges cause are pushed, so the work is proportional to the part of the graph they change. Nodes
+    inserted along with the edges have a null rank and start from scratch.
+
+    :type pg: PropertyGraph
+    :param pg: The graph to analyze, which must already contain the new edges.
+    :type property_name: str
+    :param property_name: The property holding the ranks computed by `pagerank` with a residual algorithm.
+    :type srcs: list[int]
+    :param srcs: The sources of the inserted edges.
+    :type dsts: list[int]
+    :param dsts: The destinations of the inserted edges.
+    :type plan: PagerankPlan
+    :param plan: The plan the ranks were computed with. PullTopological is not supported.
+    """
+    cdef string property_name_str = bytes(property_name, "utf-8")
+    cdef vector[uint32_t] srcs_vec = srcs
+    cdef vector[uint32_t] dsts_vec = dsts
+    with nogil:
+        handle_result_void(IncrementalPagerank(pg.underlying_property_graph(), property_name_str, srcs_vec, dsts_vec,
+                                               plan.underlying_))
+
+
 cdef _PagerankStatistics handle_result_PagerankStatistics(Result[_PagerankStatistics] res) nogil except *:
     if not res.has_value():
         with gil:
@@ -234,3 +338,136 @@ cdef class PagerankStatistics:
         cdef ostringstream ss
         self.underlying.Print(ss)
         return str(ss.str(), "ascii")
+
+
+class _PersonalizedPagerankPlanAlgorithm(Enum):
+    ForwardPush = _PersonalizedPagerankPlan.Algorithm.kForwardPush
+    PushAsynchronous = _PersonalizedPagerankPlan.Algorithm.kPushAsynchronous
+
+
+cdef class PersonalizedPagerankPlan(Plan):
+    """
+    A computational :ref:`Plan` for personalized Page Rank.
+
+    Both algorithms push residual rank forward until no node `u` holds more than `epsilon * outdegree(u)` of it.
+
+    Static methods construct PersonalizedPagerankPlans.
+    """
+    cdef:
+        _PersonalizedPagerankPlan underlying_
+
+    cdef _Plan* underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _PersonalizedPagerankPlanAlgorithm
+
+    @staticmethod
+    cdef PersonalizedPagerankPlan make(_PersonalizedPagerankPlan u):
+        f = <PersonalizedPagerankPlan>PersonalizedPagerankPlan.__new__(PersonalizedPagerankPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _PersonalizedPagerankPlanAlgorithm:
+        return _PersonalizedPagerankPlanAlgorithm(self.underlying_.algorithm())
+
+    @property
+    def epsilon(self) -> float:
+        return self.underlying_.epsilon()
+
+    @property
+    def alpha(self) -> float:
+        return self.underlying_.alpha()
+
+    @staticmethod
+    def forward_push(float epsilon = kDefaultEpsilon, float alpha = kDefaultAlpha):
+        """
+        Local forward push [ACL]_
+
+        A single thread pushes residual from a FIFO queue and keeps scores only for the nodes the push reaches, so
+        the work does not depend on the size of the graph. Batched queries run one local push per seed in parallel.
+        """
+        return PersonalizedPagerankPlan.make(_PersonalizedPagerankPlan.ForwardPush(epsilon, alpha))
+
+    @staticmethod
+    def push_asynchronous(float epsilon = kDefaultEpsilon, float alpha = kDefaultAlpha):
+        """
+        Asynchronous push algorithm over residuals stored for every node. Batched queries push the residuals of 16
+        seeds together.
+        """
+        return PersonalizedPagerankPlan.make(_PersonalizedPagerankPlan.PushAsynchronous(epsilon, alpha))
+
+
+def personalized_pagerank(PropertyGraph pg, seeds, str output_property_name,
+                          PersonalizedPagerankPlan plan = PersonalizedPagerankPlan()):
+    """
+    Compute the Page Rank of each node personalized to `seeds`, which share the restart probability equally.
+
+    :type pg: PropertyGraph
+    :param pg: The graph to analyze.
+    :type seeds: list[int]
+    :param seeds: The seed nodes.
+    :type output_property_name: str
+    :param output_property_name: The output property to store the rank. This property must not already exist.
+    :type plan: PersonalizedPagerankPlan
+    :param plan: The execution plan to use.
+    """
+    cdef vector[uint32_t] seeds_vec = seeds
+    cdef string output_property_name_str = bytes(output_property_name, "utf-8")
+    with nogil:
+        handle_result_void(PersonalizedPagerank(pg.underlying_property_graph(), seeds_vec, output_property_name_str,
+                                                plan.underlying_))
+
+
+cdef vector[pair[uint32_t, float]] handle_result_ranks(Result[vector[pair[uint32_t, float]]] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return move(res.value())
+
+
+def local_personalized_pagerank(PropertyGraph pg, seeds,
+                                PersonalizedPagerankPlan plan = PersonalizedPagerankPlan()):
+    """
+    Compute the Page Rank personalized to `seeds` with the local forward push, touching only the nodes the walk
+    reaches.
+
+    :type pg: PropertyGraph
+    :param pg: The graph to analyze.
+    :type seeds: list[int]
+    :param seeds: The seed nodes.
+    :type plan: PersonalizedPagerankPlan
+    :param plan: The epsilon and alpha to use. The algorithm is always the forward push.
+    :returns: A list of `(node, rank)` pairs for the nodes with non-zero rank, in order of decreasing rank.
+    """
+    cdef vector[uint32_t] seeds_vec = seeds
+    cdef vector[pair[uint32_t, float]] ranks
+    with nogil:
+        ranks = handle_result_ranks(LocalPersonalizedPagerank(pg.underlying_property_graph(), seeds_vec,
+                                                              plan.underlying_))
+    return [(ranks[i].first, ranks[i].second) for i in range(ranks.size())]
+
+
+def batched_personalized_pagerank(PropertyGraph pg, seeds, output_property_names,
+                                  PersonalizedPagerankPlan plan = PersonalizedPagerankPlan()):
+    """
+    Compute the Page Rank personalized to each node in `seeds` separately. The ranks for `seeds[i]` are written to
+    the property `output_property_names[i]`.
+
+    :type pg: PropertyGraph
+    :param pg: The graph to analyze.
+    :type seeds: list[int]
+    :param seeds: The seed nodes.
+    :type output_property_names: list[str]
+    :param output_property_names: The output properties to store the ranks, one per seed. These properties must not
+        already exist.
+    :type plan: PersonalizedPagerankPlan
+    :param plan: The execution plan to use.
+    """
+    cdef vector[uint32_t] seeds_vec = seeds
+    cdef vector[string] output_property_names_vec
+    for name in output_property_names:
+        output_property_names_vec.push_back(bytes(name, "utf-8"))
+    with nogil:
+        handle_result_void(BatchedPersonalizedPagerank(pg.underlying_property_graph(), seeds_vec,
+                                                       output_property_names_vec, plan.underlying_))
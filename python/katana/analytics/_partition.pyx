@@ -0,0 +1,207 @@
+"""
+Partition
+---------
+
+.. autoclass:: katana.analytics.PartitionPlan
+    :members:
+    :special-members: __init__
+    :undoc-members:
+
+.. autoclass:: katana.analytics._partition._PartitionPlanAlgorithm
+    :members:
+    :undoc-members:
+
+.. autofunction:: katana.analytics.partition
+
+.. autoclass:: katana.analytics.PartitionStatistics
+    :members:
+    :undoc-members:
+
+.. autofunction:: katana.analytics.partition_assert_valid
+"""
+from libc.stdint cimport uint32_t, uint64_t
+from libcpp.string cimport string
+
+from katana._property_graph cimport PropertyGraph
+from katana.analytics.plan cimport Plan, _Plan
+from katana.cpp.libgalois.graphs.Graph cimport _PropertyGraph
+from katana.cpp.libstd.iostream cimport ostream, ostringstream
+from katana.cpp.libsupport.result cimport Result, handle_result_assert, handle_result_void, raise_error_code
+
+from enum import Enum
+
+
+cdef extern from "katana/analytics/partition/partition.h" namespace "katana::analytics" nogil:
+    cppclass _PartitionPlan "katana::analytics::PartitionPlan" (_Plan):
+        enum Algorithm:
+            kMultilevel "katana::analytics::PartitionPlan::kMultilevel"
+
+        _PartitionPlan.Algorithm algorithm() const
+        double imbalance() const
+        uint32_t coarsening_threshold() const
+        uint32_t refinement_iterations() const
+
+        PartitionPlan()
+
+        @staticmethod
+        _PartitionPlan Multilevel(double imbalance, uint32_t coarsening_threshold, uint32_t refinement_iterations)
+
+    double kDefaultImbalance "katana::analytics::PartitionPlan::kDefaultImbalance"
+    uint32_t kDefaultCoarseningThreshold "katana::analytics::PartitionPlan::kDefaultCoarseningThreshold"
+    uint32_t kDefaultRefinementIterations "katana::analytics::PartitionPlan::kDefaultRefinementIterations"
+
+    Result[void] Partition(_PropertyGraph* pg, uint32_t num_partitions, string output_property_name,
+        _PartitionPlan plan)
+
+    Result[void] PartitionAssertValid(_PropertyGraph* pg, uint32_t num_partitions, string property_name)
+
+    cppclass _PartitionStatistics "katana::analytics::PartitionStatistics":
+        uint64_t edge_cut
+        uint64_t max_partition_size
+        double imbalance
+
+        void Print(ostream os)
+
+        @staticmethod
+        Result[_PartitionStatistics] Compute(_PropertyGraph* pg, uint32_t num_partitions, string property_name)
+
+
+class _PartitionPlanAlgorithm(Enum):
+    """
+    :see: :py:class:`~katana.analytics.PartitionPlan` constructors for algorithm documentation.
+    """
+    Multilevel = _PartitionPlan.Algorithm.kMultilevel
+
+
+cdef class PartitionPlan(Plan):
+    """
+    A computational :ref:`Plan` for Partition.
+
+    Static methods construct PartitionPlans.
+    """
+    cdef:
+        _PartitionPlan underlying_
+
+    cdef _Plan* underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _PartitionPlanAlgorithm
+
+    @staticmethod
+    cdef PartitionPlan make(_PartitionPlan u):
+        f = <PartitionPlan>PartitionPlan.__new__(PartitionPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _PartitionPlanAlgorithm:
+        return _PartitionPlanAlgorithm(self.underlying_.algorithm())
+
+    @property
+    def imbalance(self) -> float:
+        return self.underlying_.imbalance()
+
+    @property
+    def coarsening_threshold(self) -> int:
+        return self.underlying_.coarsening_threshold()
+
+    @property
+    def refinement_iterations(self) -> int:
+        return self.underlying_.refinement_iterations()
+
+    @staticmethod
+    def multilevel(double imbalance = kDefaultImbalance, uint32_t coarsening_threshold = kDefaultCoarseningThreshold,
+                   uint32_t refinement_iterations = kDefaultRefinementIterations):
+        """
+        Multilevel k-way partitioning in the style of METIS: coarsen the graph by contracting heavy edge matchings,
+        partition the coarsest graph by greedy graph growing, and refine the partition while projecting it back.
+
+        :param imbalance: The fraction by which the size of a partition may exceed the average.
+        :param coarsening_threshold: Stop coarsening once there are at most this many nodes per partition.
+        :param refinement_iterations: The maximum number of refinement passes at each level.
+        """
+        return PartitionPlan.make(_PartitionPlan.Multilevel(imbalance, coarsening_threshold, refinement_iterations))
+
+
+def partition(PropertyGraph pg, uint32_t num_partitions, str output_property_name,
+              PartitionPlan plan = PartitionPlan()):
+    """
+    Partition the nodes of the graph into `num_partitions` parts of about equal size while keeping the number of edges
+    between parts small. The graph must be symmetric.
+
+    The partition IDs are only a node property, meant for grouping nodes in memory, e.g., with
+    :py:meth:`ReorderPlan.partitioned`. They do not make the graph a partitioned RDG: writing the graph still writes a
+    single RDG partition, and the IDs are not recorded in its partition metadata.
+
+    :type pg: PropertyGraph
+    :param pg: The graph to partition.
+    :type num_partitions: int
+    :param num_partitions: The number of partitions.
+    :type output_property_name: str
+    :param output_property_name: The output property to store the partition ID of each node in. This property must
+        not already exist.
+    :type plan: PartitionPlan
+    :param plan: The execution plan to use.
+    """
+    cdef string output_property_name_str = bytes(output_property_name, "utf-8")
+    with nogil:
+        handle_result_void(Partition(pg.underlying_property_graph(), num_partitions, output_property_name_str,
+                                     plan.underlying_))
+
+
+def partition_assert_valid(PropertyGraph pg, uint32_t num_partitions, str property_name):
+    """
+    Raise an exception if the partition IDs in `pg` are out of range. This is not an exhaustive check, just a sanity
+    check.
+
+    :raises: AssertionError
+    """
+    cdef string property_name_str = bytes(property_name, "utf-8")
+    with nogil:
+        handle_result_assert(PartitionAssertValid(pg.underlying_property_graph(), num_partitions, property_name_str))
+
+
+cdef _PartitionStatistics handle_result_PartitionStatistics(Result[_PartitionStatistics] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+cdef class PartitionStatistics:
+    """
+    Compute the :ref:`statistics` of a partition.
+    """
+    cdef _PartitionStatistics underlying
+
+    def __init__(self, PropertyGraph pg, uint32_t num_partitions, str property_name):
+        cdef string property_name_str = bytes(property_name, "utf-8")
+        with nogil:
+            self.underlying = handle_result_PartitionStatistics(_PartitionStatistics.Compute(
+                pg.underlying_property_graph(), num_partitions, property_name_str))
+
+    @property
+    def edge_cut(self) -> int:
+        """
+        The number of edges whose endpoints are in different partitions.
+        """
+        return self.underlying.edge_cut
+
+    @property
+    def max_partition_size(self) -> int:
+        """
+        The number of nodes in the largest partition.
+        """
+        return self.underlying.max_partition_size
+
+    @property
+    def imbalance(self) -> float:
+        """
+        The size of the largest partition relative to the average size.
+        """
+        return self.underlying.imbalance
+
+    def __str__(self) -> str:
+        cdef ostringstream ss
+        self.underlying.Print(ss)
+        return str(ss.str(), "ascii")
@@ -0,0 +1,179 @@
+"""
+Random Walks
+------------
+
+.. autoclass:: katana.analytics.RandomWalksPlan
+    :members:
+    :special-members: __init__
+    :undoc-members:
+
+.. autoclass:: katana.analytics._random_walks._RandomWalksPlanAlgorithm
+    :members:
+    :undoc-members:
+
+.. autofunction:: katana.analytics.random_walks
+"""
+from libc.stdint cimport uint32_t
+from libcpp.memory cimport shared_ptr, static_pointer_cast
+from pyarrow.lib cimport CArray, pyarrow_wrap_array
+from pyarrow.includes.libarrow cimport CFixedSizeListArray
+
+from katana._property_graph cimport PropertyGraph
+from katana.analytics.plan cimport Plan, _Plan
+from katana.cpp.libgalois.graphs.Graph cimport _PropertyGraph
+from katana.cpp.libsupport.result cimport Result, raise_error_code
+
+from enum import Enum
+
+
+cdef extern from "katana/analytics/random_walks/random_walks.h" namespace "katana::analytics" nogil:
+    cppclass _RandomWalksPlan "katana::analytics::RandomWalksPlan" (_Plan):
+        enum Algorithm:
+            kNode2Vec "katana::analytics::RandomWalksPlan::kNode2Vec"
+            kEdge2Vec "katana::analytics::RandomWalksPlan::kEdge2Vec"
+
+        _RandomWalksPlan.Algorithm algorithm() const
+        uint32_t walk_length() const
+        uint32_t number_of_walks() const
+        double backward_probability() const
+        double forward_probability() const
+        uint32_t max_iterations() const
+        uint32_t number_of_edge_types() const
+
+        RandomWalksPlan()
+
+        @staticmethod
+        _RandomWalksPlan Node2Vec(uint32_t walk_length, uint32_t number_of_walks, double backward_probability,
+            double forward_probability)
+
+        @staticmethod
+        _RandomWalksPlan Edge2Vec(uint32_t walk_length, uint32_t number_of_walks, double backward_probability,
+            double forward_probability, uint32_t max_iterations, uint32_t number_of_edge_types)
+
+    uint32_t kDefaultWalkLength "katana::analytics::RandomWalksPlan::kDefaultWalkLength"
+    uint32_t kDefaultNumberOfWalks "katana::analytics::RandomWalksPlan::kDefaultNumberOfWalks"
+    double kDefaultBackwardProbability "katana::analytics::RandomWalksPlan::kDefaultBackwardProbability"
+    double kDefaultForwardProbability "katana::analytics::RandomWalksPlan::kDefaultForwardProbability"
+    uint32_t kDefaultMaxIterations "katana::analytics::RandomWalksPlan::kDefaultMaxIterations"
+    uint32_t kDefaultNumberOfEdgeTypes "katana::analytics::RandomWalksPlan::kDefaultNumberOfEdgeTypes"
+
+    uint32_t kRandomWalksPadding
+
+    Result[shared_ptr[CFixedSizeListArray]] RandomWalksArray(_PropertyGraph* pg, _RandomWalksPlan plan)
+
+
+class _RandomWalksPlanAlgorithm(Enum):
+    """
+    :see: :py:class:`~katana.analytics.RandomWalksPlan` constructors for algorithm documentation.
+    """
+    Node2Vec = _RandomWalksPlan.Algorithm.kNode2Vec
+    Edge2Vec = _RandomWalksPlan.Algorithm.kEdge2Vec
+
+
+cdef class RandomWalksPlan(Plan):
+    """
+    A computational :ref:`Plan` for random walks.
+
+    Static methods construct RandomWalksPlans.
+    """
+    cdef:
+        _RandomWalksPlan underlying_
+
+    cdef _Plan* underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _RandomWalksPlanAlgorithm
+
+    @staticmethod
+    cdef RandomWalksPlan make(_RandomWalksPlan u):
+        f = <RandomWalksPlan>RandomWalksPlan.__new__(RandomWalksPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _RandomWalksPlanAlgorithm:
+        return _RandomWalksPlanAlgorithm(self.underlying_.algorithm())
+
+    @property
+    def walk_length(self) -> int:
+        return self.underlying_.walk_length()
+
+    @property
+    def number_of_walks(self) -> int:
+        return self.underlying_.number_of_walks()
+
+    @property
+    def backward_probability(self) -> float:
+        return self.underlying_.backward_probability()
+
+    @property
+    def forward_probability(self) -> float:
+        return self.underlying_.forward_probability()
+
+    @property
+    def max_iterations(self) -> int:
+        return self.underlying_.max_iterations()
+
+    @property
+    def number_of_edge_types(self) -> int:
+        return self.underlying_.number_of_edge_types()
+
+    @staticmethod
+    def node2vec(uint32_t walk_length = kDefaultWalkLength, uint32_t number_of_walks = kDefaultNumberOfWalks,
+                 double backward_probability = kDefaultBackwardProbability,
+                 double forward_probability = kDefaultForwardProbability) -> RandomWalksPlan:
+        """
+        Node2Vec algorithm to generate random walks on the graph
+        """
+        return RandomWalksPlan.make(_RandomWalksPlan.Node2Vec(
+            walk_length, number_of_walks, backward_probability, forward_probability))
+
+    @staticmethod
+    def edge2vec(uint32_t walk_length = kDefaultWalkLength, uint32_t number_of_walks = kDefaultNumberOfWalks,
+                 double backward_probability = kDefaultBackwardProbability,
+                 double forward_probability = kDefaultForwardProbability,
+                 uint32_t max_iterations = kDefaultMaxIterations,
+                 uint32_t number_of_edge_types = kDefaultNumberOfEdgeTypes) -> RandomWalksPlan:
+        """
+        Edge2Vec algorithm to generate random walks on the graph. Takes the heterogeneity of the edges into account.
+        """
+        return RandomWalksPlan.make(_RandomWalksPlan.Edge2Vec(
+            walk_length, number_of_walks, backward_probability, forward_probability, max_iterations,
+            number_of_edge_types))
+
+
+RANDOM_WALKS_PADDING = kRandomWalksPadding
+
+
+cdef shared_ptr[CFixedSizeListArray] handle_result_walks(Result[shared_ptr[CFixedSizeListArray]] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+def random_walks(PropertyGraph pg, RandomWalksPlan plan = RandomWalksPlan()):
+    """
+    Compute random walks on `pg`, which is expected to be symmetric.
+
+    The walks are written by the algorithm into a single buffer, which is returned without copying as a numpy array
+    of shape `(num_rows, walk_length + 1)` and type `uint32`. Row `i` is a walk starting at node `i % num_nodes`.
+    Walks that end early, at a node without neighbors, are padded with
+    :py:data:`~katana.analytics._random_walks.RANDOM_WALKS_PADDING`.
+
+    Node2vec produces `num_nodes * number_of_walks` rows. Edge2vec produces that many rows for each of its
+    `max_iterations` iterations, and discards the walks that reach a node without neighbors after their start, leaving
+    rows of only padding.
+
+    :type pg: PropertyGraph
+    :param pg: The graph to analyze.
+    :type plan: RandomWalksPlan
+    :param plan: The execution plan to use.
+    :rtype: numpy.ndarray
+    """
+    cdef shared_ptr[CFixedSizeListArray] walks
+    with nogil:
+        walks = handle_result_walks(RandomWalksArray(pg.underlying_property_graph(), plan.underlying_))
+    walks_array = pyarrow_wrap_array(static_pointer_cast[CArray, CFixedSizeListArray](walks))
+    values = walks_array.flatten().to_numpy(zero_copy_only=True)
+    return values.reshape(len(walks_array), walks_array.type.list_size)
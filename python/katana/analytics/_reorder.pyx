@@ -0,0 +1,233 @@
+"""
+Reorder
+-------
+
+.. autoclass:: katana.analytics.ReorderPlan
+    :members:
+    :special-members: __init__
+    :undoc-members:
+
+.. autoclass:: katana.analytics._reorder._ReorderPlanAlgorithm
+    :members:
+    :undoc-members:
+
+.. autofunction:: katana.analytics.reorder
+
+.. autoclass:: katana.analytics.ReorderStatistics
+    :members:
+    :undoc-members:
+
+.. autofunction:: katana.analytics.reorder_assert_valid
+"""
+from libc.stdint cimport uint32_t, uint64_t
+from libcpp.string cimport string
+
+from katana._property_graph cimport PropertyGraph
+from katana.analytics.plan cimport Plan, _Plan
+from katana.cpp.libgalois.graphs.Graph cimport _PropertyGraph
+from katana.cpp.libstd.iostream cimport ostream, ostringstream
+from katana.cpp.libsupport.result cimport Result, handle_result_assert, handle_result_void, raise_error_code
+
+from enum import Enum
+
+
+cdef extern from "katana/analytics/reorder/reorder.h" namespace "katana::analytics" nogil:
+    cppclass _ReorderPlan "katana::analytics::ReorderPlan" (_Plan):
+        enum Algorithm:
+            kReverseCuthillMcKee "katana::analytics::ReorderPlan::kReverseCuthillMcKee"
+            kHubSort "katana::analytics::ReorderPlan::kHubSort"
+            kHubCluster "katana::analytics::ReorderPlan::kHubCluster"
+            kRabbit "katana::analytics::ReorderPlan::kRabbit"
+            kGorder "katana::analytics::ReorderPlan::kGorder"
+            kPartitioned "katana::analytics::ReorderPlan::kPartitioned"
+
+        _ReorderPlan.Algorithm algorithm() const
+        uint32_t gorder_window() const
+        uint32_t num_partitions() const
+
+        ReorderPlan()
+
+        @staticmethod
+        _ReorderPlan ReverseCuthillMcKee()
+        @staticmethod
+        _ReorderPlan HubSort()
+        @staticmethod
+        _ReorderPlan HubCluster()
+        @staticmethod
+        _ReorderPlan Rabbit()
+        @staticmethod
+        _ReorderPlan Gorder(uint32_t gorder_window)
+        @staticmethod
+        _ReorderPlan Partitioned(uint32_t num_partitions)
+
+    uint32_t kDefaultGorderWindow "katana::analytics::ReorderPlan::kDefaultGorderWindow"
+    uint32_t kDefaultNumPartitions "katana::analytics::ReorderPlan::kDefaultNumPartitions"
+
+    Result[void] Reorder(_PropertyGraph* pg, string original_id_property_name, _ReorderPlan plan)
+
+    Result[void] ReorderAssertValid(_PropertyGraph* pg, string original_id_property_name)
+
+    cppclass _ReorderStatistics "katana::analytics::ReorderStatistics":
+        double average_edge_span
+        uint64_t max_edge_span
+
+        void Print(ostream os)
+
+        @staticmethod
+        Result[_ReorderStatistics] Compute(_PropertyGraph* pg)
+
+
+class _ReorderPlanAlgorithm(Enum):
+    """
+    :see: :py:class:`~katana.analytics.ReorderPlan` constructors for algorithm documentation.
+    """
+    ReverseCuthillMcKee = _ReorderPlan.Algorithm.kReverseCuthillMcKee
+    HubSort = _ReorderPlan.Algorithm.kHubSort
+    HubCluster = _ReorderPlan.Algorithm.kHubCluster
+    Rabbit = _ReorderPlan.Algorithm.kRabbit
+    Gorder = _ReorderPlan.Algorithm.kGorder
+    Partitioned = _ReorderPlan.Algorithm.kPartitioned
+
+
+cdef class ReorderPlan(Plan):
+    """
+    A computational :ref:`Plan` for Reorder.
+
+    Static methods construct ReorderPlans.
+    """
+    cdef:
+        _ReorderPlan underlying_
+
+    cdef _Plan* underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _ReorderPlanAlgorithm
+
+    @staticmethod
+    cdef ReorderPlan make(_ReorderPlan u):
+        f = <ReorderPlan>ReorderPlan.__new__(ReorderPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _ReorderPlanAlgorithm:
+        return _ReorderPlanAlgorithm(self.underlying_.algorithm())
+
+    @property
+    def gorder_window(self) -> int:
+        return self.underlying_.gorder_window()
+
+    @property
+    def num_partitions(self) -> int:
+        return self.underlying_.num_partitions()
+
+    @staticmethod
+    def reverse_cuthill_mckee():
+        """
+        Breadth first search from a low degree node of each component, visiting the children of each level in the order
+        of their parents and by ascending degree, and then reverse the order. Levels are expanded in parallel.
+        """
+        return ReorderPlan.make(_ReorderPlan.ReverseCuthillMcKee())
+
+    @staticmethod
+    def hub_sort():
+        """
+        Move the nodes with more than the average degree to the front, sorted by descending degree.
+        """
+        return ReorderPlan.make(_ReorderPlan.HubSort())
+
+    @staticmethod
+    def hub_cluster():
+        """
+        Move the nodes with more than the average degree to the front, keeping their original order.
+        """
+        return ReorderPlan.make(_ReorderPlan.HubCluster())
+
+    @staticmethod
+    def rabbit():
+        """
+        Rabbit order: merge nodes into communities by modularity and place each community contiguously.
+        """
+        return ReorderPlan.make(_ReorderPlan.Rabbit())
+
+    @staticmethod
+    def gorder(uint32_t gorder_window = kDefaultGorderWindow):
+        """
+        An approximation of Gorder: greedily place next the node that shares the most edges and neighbors with the last
+        `gorder_window` placed nodes.
+        """
+        return ReorderPlan.make(_ReorderPlan.Gorder(gorder_window))
+
+    @staticmethod
+    def partitioned(uint32_t num_partitions = kDefaultNumPartitions):
+        """
+        Partition the graph with :py:func:`~katana.analytics.partition` and place the nodes of each partition next to
+        each other.
+        """
+        return ReorderPlan.make(_ReorderPlan.Partitioned(num_partitions))
+
+
+def reorder(PropertyGraph pg, str original_id_property_name, ReorderPlan plan = ReorderPlan()):
+    """
+    Relabel the nodes of the graph to improve the locality of graph algorithms. The topology and all node and edge
+    properties are permuted together.
+
+    :type pg: PropertyGraph
+    :param pg: The graph to reorder.
+    :type original_id_property_name: str
+    :param original_id_property_name: The output property to store the original ID of each node in. This property must
+        not already exist.
+    :type plan: ReorderPlan
+    :param plan: The execution plan to use.
+    """
+    cdef string original_id_property_name_str = bytes(original_id_property_name, "utf-8")
+    with nogil:
+        handle_result_void(Reorder(pg.underlying_property_graph(), original_id_property_name_str, plan.underlying_))
+
+
+def reorder_assert_valid(PropertyGraph pg, str original_id_property_name):
+    """
+    Raise an exception if the original IDs in `pg` are not a permutation of the nodes.
+
+    :raises: AssertionError
+    """
+    cdef string original_id_property_name_str = bytes(original_id_property_name, "utf-8")
+    with nogil:
+        handle_result_assert(ReorderAssertValid(pg.underlying_property_graph(), original_id_property_name_str))
+
+
+cdef _ReorderStatistics handle_result_ReorderStatistics(Result[_ReorderStatistics] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+cdef class ReorderStatistics:
+    """
+    Compute the :ref:`statistics` of the order of the nodes of a graph.
+    """
+    cdef _ReorderStatistics underlying
+
+    def __init__(self, PropertyGraph pg):
+        with nogil:
+            self.underlying = handle_result_ReorderStatistics(_ReorderStatistics.Compute(pg.underlying_property_graph()))
+
+    @property
+    def average_edge_span(self) -> float:
+        """
+        The average absolute difference between the IDs of the endpoints of each edge.
+        """
+        return self.underlying.average_edge_span
+
+    @property
+    def max_edge_span(self) -> int:
+        """
+        The largest absolute difference between the IDs of the endpoints of an edge.
+        """
+        return self.underlying.max_edge_span
+
+    def __str__(self) -> str:
+        cdef ostringstream ss
+        self.underlying.Print(ss)
+        return str(ss.str(), "ascii")
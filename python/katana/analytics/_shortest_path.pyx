@@ -0,0 +1,381 @@
+"""
+Point-to-Point Shortest Path
+----------------------------
+
+.. autoclass:: katana.analytics.ShortestPathPlan
+    :members:
+    :special-members: __init__
+    :undoc-members:
+
+.. autoclass:: katana.analytics._shortest_path._ShortestPathAlgorithm
+    :members:
+    :undoc-members:
+
+.. autoclass:: katana.analytics.ShortestPath
+    :members:
+    :undoc-members:
+
+.. autoclass:: katana.analytics.ShortestPathQuery
+    :members:
+    :special-members: __init__
+
+.. autofunction:: katana.analytics.find_shortest_path
+
+.. autoclass:: katana.analytics.KShortestSimplePathsPlan
+    :members:
+    :special-members: __init__
+    :undoc-members:
+
+.. autoclass:: katana.analytics._shortest_path._KShortestSimplePathsAlgorithm
+    :members:
+    :undoc-members:
+
+.. autofunction:: katana.analytics.k_shortest_simple_paths
+"""
+from libc.stdint cimport uint32_t, uint64_t
+from libcpp.memory cimport unique_ptr
+from libcpp.string cimport string
+from libcpp.utility cimport move
+from libcpp.vector cimport vector
+
+from katana._property_graph cimport PropertyGraph
+from katana.analytics.plan cimport Plan, _Plan
+from katana.cpp.libgalois.graphs.Graph cimport _PropertyGraph
+from katana.cpp.libstd.iostream cimport ostream, ostringstream
+from katana.cpp.libsupport.result cimport Result, raise_error_code
+
+from enum import Enum
+
+
+cdef extern from "katana/analytics/shortest_path/shortest_path.h" namespace "katana::analytics" nogil:
+    cppclass _ShortestPathPlan "katana::analytics::ShortestPathPlan" (_Plan):
+        enum Algorithm:
+            kBidirectionalDijkstra "katana::analytics::ShortestPathPlan::kBidirectionalDijkstra"
+            kBidirectionalAStar "katana::analytics::ShortestPathPlan::kBidirectionalAStar"
+            kAutomatic "katana::analytics::ShortestPathPlan::kAutomatic"
+
+        _ShortestPathPlan.Algorithm algorithm() const
+
+        _ShortestPathPlan()
+
+        @staticmethod
+        _ShortestPathPlan BidirectionalDijkstra()
+
+        @staticmethod
+        _ShortestPathPlan BidirectionalAStar()
+
+    cppclass _KShortestSimplePathsPlan "katana::analytics::KShortestSimplePathsPlan" (_Plan):
+        enum Algorithm:
+            kYen "katana::analytics::KShortestSimplePathsPlan::kYen"
+
+        _KShortestSimplePathsPlan.Algorithm algorithm() const
+        _ShortestPathPlan search_plan() const
+
+        _KShortestSimplePathsPlan()
+
+        @staticmethod
+        _KShortestSimplePathsPlan Yen(_ShortestPathPlan search_plan)
+
+    cppclass _ShortestPath "katana::analytics::ShortestPath":
+        double distance
+        vector[uint32_t] path
+        uint64_t n_settled_nodes
+
+        void Print(ostream os)
+
+    cppclass _ShortestPathQuery "katana::analytics::ShortestPathQuery":
+        @staticmethod
+        Result[unique_ptr[_ShortestPathQuery]] Make(_PropertyGraph* pg, const string& edge_weight_property_name,
+            const vector[string]& coordinate_property_names, _ShortestPathPlan plan)
+
+        Result[_ShortestPath] Find(uint32_t source, uint32_t target)
+
+        Result[vector[_ShortestPath]] FindKShortestSimplePaths(uint32_t source, uint32_t target, uint32_t k,
+            _KShortestSimplePathsPlan plan)
+
+    Result[_ShortestPath] FindShortestPath(_PropertyGraph* pg, uint32_t source, uint32_t target,
+        const string& edge_weight_property_name, const vector[string]& coordinate_property_names,
+        _ShortestPathPlan plan)
+
+    Result[vector[_ShortestPath]] KShortestSimplePaths(_PropertyGraph* pg, uint32_t source, uint32_t target,
+        uint32_t k, const string& edge_weight_property_name, const vector[string]& coordinate_property_names,
+        _KShortestSimplePathsPlan plan)
+
+
+class _ShortestPathAlgorithm(Enum):
+    """
+    The concrete algorithms available for point-to-point shortest paths.
+
+    :see: :py:class:`~katana.analytics.ShortestPathPlan` constructors for algorithm documentation.
+    """
+    BidirectionalDijkstra = _ShortestPathPlan.Algorithm.kBidirectionalDijkstra
+    BidirectionalAStar = _ShortestPathPlan.Algorithm.kBidirectionalAStar
+    Automatic = _ShortestPathPlan.Algorithm.kAutomatic
+
+
+cdef class ShortestPathPlan(Plan):
+    """
+    A computational :ref:`Plan` for point-to-point shortest paths.
+
+    Static methods construct ShortestPathPlans. The default constructor uses A* when coordinate properties are given
+    and Dijkstra otherwise.
+    """
+    cdef:
+        _ShortestPathPlan underlying_
+
+    cdef _Plan* underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _ShortestPathAlgorithm
+
+    @staticmethod
+    cdef ShortestPathPlan make(_ShortestPathPlan u):
+        f = <ShortestPathPlan>ShortestPathPlan.__new__(ShortestPathPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _ShortestPathAlgorithm:
+        return _ShortestPathAlgorithm(self.underlying_.algorithm())
+
+    @staticmethod
+    def bidirectional_dijkstra() -> ShortestPathPlan:
+        """
+        Dijkstra's algorithm from the source and the target at the same time, stopping as soon as no shorter path can
+        exist.
+        """
+        return ShortestPathPlan.make(_ShortestPathPlan.BidirectionalDijkstra())
+
+    @staticmethod
+    def bidirectional_a_star() -> ShortestPathPlan:
+        """
+        Bidirectional Dijkstra guided by the straight line distance between node coordinates. The straight line
+        distance between the endpoints of an edge must not exceed its weight.
+        """
+        return ShortestPathPlan.make(_ShortestPathPlan.BidirectionalAStar())
+
+
+class _KShortestSimplePathsAlgorithm(Enum):
+    """
+    The concrete algorithms available for k shortest simple paths.
+
+    :see: :py:class:`~katana.analytics.KShortestSimplePathsPlan` constructors for algorithm documentation.
+    """
+    Yen = _KShortestSimplePathsPlan.Algorithm.kYen
+
+
+cdef class KShortestSimplePathsPlan(Plan):
+    """
+    A computational :ref:`Plan` for k shortest simple paths.
+    """
+    cdef:
+        _KShortestSimplePathsPlan underlying_
+
+    cdef _Plan* underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _KShortestSimplePathsAlgorithm
+
+    @staticmethod
+    cdef KShortestSimplePathsPlan make(_KShortestSimplePathsPlan u):
+        f = <KShortestSimplePathsPlan>KShortestSimplePathsPlan.__new__(KShortestSimplePathsPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _KShortestSimplePathsAlgorithm:
+        return _KShortestSimplePathsAlgorithm(self.underlying_.algorithm())
+
+    @property
+    def search_plan(self) -> ShortestPathPlan:
+        """
+        The plan of the point-to-point searches used to find each path.
+        """
+        return ShortestPathPlan.make(self.underlying_.search_plan())
+
+    @staticmethod
+    def yen(ShortestPathPlan search_plan = ShortestPathPlan()) -> KShortestSimplePathsPlan:
+        """
+        Yen's algorithm. Each new path is found by searching from every node of the previous path with the part of
+        the path before it masked out, in parallel.
+        """
+        return KShortestSimplePathsPlan.make(_KShortestSimplePathsPlan.Yen(search_plan.underlying_))
+
+
+cdef class ShortestPath:
+    """
+    A path found by :py:func:`find_shortest_path` or :py:class:`ShortestPathQuery`.
+    """
+    cdef _ShortestPath underlying
+
+    @staticmethod
+    cdef ShortestPath make(_ShortestPath u):
+        f = <ShortestPath>ShortestPath.__new__(ShortestPath)
+        f.underlying = u
+        return f
+
+    @property
+    def distance(self) -> float:
+        """
+        The length of the path, or infinity if the target is not reachable.
+        """
+        return self.underlying.distance
+
+    @property
+    def path(self) -> list:
+        """
+        The nodes of the path from the source to the target, inclusive.
+        """
+        return self.underlying.path
+
+    @property
+    def n_settled_nodes(self) -> int:
+        """
+        The number of nodes whose distance was finalized by the search.
+        """
+        return self.underlying.n_settled_nodes
+
+    def __str__(self) -> str:
+        cdef ostringstream ss
+        self.underlying.Print(ss)
+        return str(ss.str(), "ascii")
+
+
+cdef _ShortestPath handle_result_ShortestPath(Result[_ShortestPath] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+cdef vector[_ShortestPath] handle_result_ShortestPaths(Result[vector[_ShortestPath]] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return move(res.value())
+
+
+cdef unique_ptr[_ShortestPathQuery] handle_result_ShortestPathQuery(Result[unique_ptr[_ShortestPathQuery]] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return move(res.value())
+
+
+cdef vector[string] _convert_string_list(l):
+    cdef vector[string] ret
+    for s in l or []:
+        ret.push_back(bytes(s, "utf-8"))
+    return ret
+
+
+cdef class ShortestPathQuery:
+    """
+    Answers repeated point-to-point shortest path queries on a graph. Constructing the query indexes the incoming
+    edges of `pg` once; each query then only touches the nodes its search settles.
+
+    :type pg: PropertyGraph
+    :param pg: The graph to query. It must not be modified while the query is in use.
+    :type edge_weight_property_name: str
+    :param edge_weight_property_name: The input property containing non-negative edge weights.
+    :type coordinate_property_names: list[str]
+    :param coordinate_property_names: Optional numeric node properties giving each node a position for A*.
+    :type plan: ShortestPathPlan
+    :param plan: The execution plan to use.
+    """
+    cdef unique_ptr[_ShortestPathQuery] underlying
+    cdef PropertyGraph pg
+
+    def __init__(self, PropertyGraph pg, str edge_weight_property_name, coordinate_property_names=None,
+                 ShortestPathPlan plan = ShortestPathPlan()):
+        cdef string edge_weight_property_name_str = bytes(edge_weight_property_name, "utf-8")
+        cdef vector[string] coordinate_property_names_vec = _convert_string_list(coordinate_property_names)
+        self.pg = pg
+        with nogil:
+            self.underlying = handle_result_ShortestPathQuery(_ShortestPathQuery.Make(
+                pg.underlying_property_graph(), edge_weight_property_name_str, coordinate_property_names_vec,
+                plan.underlying_))
+
+    def find(self, uint32_t source, uint32_t target) -> ShortestPath:
+        """
+        Find a shortest path from `source` to `target`.
+        """
+        cdef _ShortestPath res
+        with nogil:
+            res = handle_result_ShortestPath(self.underlying.get().Find(source, target))
+        return ShortestPath.make(res)
+
+    def find_k_shortest_simple_paths(self, uint32_t source, uint32_t target, uint32_t k,
+                                     KShortestSimplePathsPlan plan = KShortestSimplePathsPlan()) -> list:
+        """
+        Find up to `k` shortest paths from `source` to `target` that do not repeat nodes, in order of increasing
+        distance. The searches use the plan this query was constructed with.
+        """
+        cdef vector[_ShortestPath] res
+        with nogil:
+            res = handle_result_ShortestPaths(self.underlying.get().FindKShortestSimplePaths(
+                source, target, k, plan.underlying_))
+        return [ShortestPath.make(res[i]) for i in range(res.size())]
+
+
+def find_shortest_path(PropertyGraph pg, uint32_t source, uint32_t target, str edge_weight_property_name,
+                       coordinate_property_names=None, ShortestPathPlan plan = ShortestPathPlan()) -> ShortestPath:
+    """
+    Find a shortest path in `pg` from `source` to `target`. Use :py:class:`ShortestPathQuery` to answer several queries
+    on the same graph.
+
+    :type pg: PropertyGraph
+    :param pg: The graph to analyze.
+    :type source: Node ID
+    :param source: The source node.
+    :type target: Node ID
+    :param target: The target node.
+    :type edge_weight_property_name: str
+    :param edge_weight_property_name: The input property containing non-negative edge weights.
+    :type coordinate_property_names: list[str]
+    :param coordinate_property_names: Optional numeric node properties giving each node a position for A*.
+    :type plan: ShortestPathPlan
+    :param plan: The execution plan to use.
+    """
+    cdef string edge_weight_property_name_str = bytes(edge_weight_property_name, "utf-8")
+    cdef vector[string] coordinate_property_names_vec = _convert_string_list(coordinate_property_names)
+    cdef _ShortestPath res
+    with nogil:
+        res = handle_result_ShortestPath(FindShortestPath(pg.underlying_property_graph(), source, target,
+                                                          edge_weight_property_name_str, coordinate_property_names_vec,
+                                                          plan.underlying_))
+    return ShortestPath.make(res)
+
+
+def k_shortest_simple_paths(PropertyGraph pg, uint32_t source, uint32_t target, uint32_t k,
+                            str edge_weight_property_name, coordinate_property_names=None,
+                            KShortestSimplePathsPlan plan = KShortestSimplePathsPlan()) -> list:
+    """
+    Find up to `k` shortest paths in `pg` from `source` to `target` that do not repeat nodes, in order of increasing
+    distance. Use :py:meth:`ShortestPathQuery.find_k_shortest_simple_paths` to answer several queries on the same
+    graph.
+
+    :type pg: PropertyGraph
+    :param pg: The graph to analyze.
+    :type source: Node ID
+    :param source: The source node.
+    :type target: Node ID
+    :param target: The target node.
+    :type k: int
+    :param k: The maximum number of paths to find.
+    :type edge_weight_property_name: str
+    :param edge_weight_property_name: The input property containing non-negative edge weights.
+    :type coordinate_property_names: list[str]
+    :param coordinate_property_names: Optional numeric node properties giving each node a position for A*.
+    :type plan: KShortestSimplePathsPlan
+    :param plan: The execution plan to use.
+    :rtype: list[ShortestPath]
+    """
+    cdef string edge_weight_property_name_str = bytes(edge_weight_property_name, "utf-8")
+    cdef vector[string] coordinate_property_names_vec = _convert_string_list(coordinate_property_names)
+    cdef vector[_ShortestPath] res
+    with nogil:
+        res = handle_result_ShortestPaths(KShortestSimplePaths(pg.underlying_property_graph(), source, target, k,
+                                                               edge_weight_property_name_str,
+                                                               coordinate_property_names_vec, plan.underlying_))
+    return [ShortestPath.make(res[i]) for i in range(res.size())]
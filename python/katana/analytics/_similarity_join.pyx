@@ -0,0 +1,156 @@
+"""
+Similarity Join
+---------------
+
+.. autoclass:: katana.analytics.SimilarityJoinPlan
+    :members:
+    :special-members: __init__
+    :undoc-members:
+
+.. autoclass:: katana.analytics._similarity_join._SimilarityJoinPlanAlgorithm
+    :members:
+    :undoc-members:
+
+.. autoclass:: katana.analytics._similarity_join._SimilarityJoinPlanMeasure
+    :members:
+    :undoc-members:
+
+.. autofunction:: katana.analytics.similarity_join
+"""
+from libc.stdint cimport uint32_t
+from libcpp.memory cimport shared_ptr
+from pyarrow.lib cimport CTable, pyarrow_wrap_table
+
+from katana._property_graph cimport PropertyGraph
+from katana.analytics.plan cimport Plan, _Plan
+from katana.cpp.libgalois.graphs.Graph cimport _PropertyGraph
+from katana.cpp.libsupport.result cimport Result, raise_error_code
+
+from enum import Enum
+
+
+cdef extern from "katana/analytics/similarity_join/similarity_join.h" namespace "katana::analytics" nogil:
+    cppclass _SimilarityJoinPlan "katana::analytics::SimilarityJoinPlan" (_Plan):
+        enum Algorithm:
+            kMinHashLsh "katana::analytics::SimilarityJoinPlan::kMinHashLsh"
+
+        enum Measure:
+            kJaccard "katana::analytics::SimilarityJoinPlan::kJaccard"
+            kCosine "katana::analytics::SimilarityJoinPlan::kCosine"
+
+        _SimilarityJoinPlan.Algorithm algorithm() const
+        _SimilarityJoinPlan.Measure measure() const
+        uint32_t num_bands() const
+        uint32_t rows_per_band() const
+        uint32_t max_bucket_size() const
+
+        SimilarityJoinPlan()
+
+        @staticmethod
+        _SimilarityJoinPlan MinHashLsh(_SimilarityJoinPlan.Measure measure, uint32_t num_bands,
+            uint32_t rows_per_band, uint32_t max_bucket_size)
+
+    uint32_t kDefaultNumBands "katana::analytics::SimilarityJoinPlan::kDefaultNumBands"
+    uint32_t kDefaultRowsPerBand "katana::analytics::SimilarityJoinPlan::kDefaultRowsPerBand"
+    uint32_t kDefaultMaxBucketSize "katana::analytics::SimilarityJoinPlan::kDefaultMaxBucketSize"
+
+    Result[shared_ptr[CTable]] SimilarityJoin(_PropertyGraph* pg, uint32_t k, _SimilarityJoinPlan plan)
+
+
+class _SimilarityJoinPlanAlgorithm(Enum):
+    """
+    :see: :py:class:`~katana.analytics.SimilarityJoinPlan` constructors for algorithm documentation.
+    """
+    MinHashLsh = _SimilarityJoinPlan.Algorithm.kMinHashLsh
+
+
+class _SimilarityJoinPlanMeasure(Enum):
+    """
+    The similarity of the out-neighbor sets of two nodes.
+    """
+    Jaccard = _SimilarityJoinPlan.Measure.kJaccard
+    Cosine = _SimilarityJoinPlan.Measure.kCosine
+
+
+cdef class SimilarityJoinPlan(Plan):
+    """
+    A computational :ref:`Plan` for the all-pairs top-k similarity join.
+
+    Static methods construct SimilarityJoinPlans.
+    """
+    cdef:
+        _SimilarityJoinPlan underlying_
+
+    cdef _Plan* underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _SimilarityJoinPlanAlgorithm
+    Measure = _SimilarityJoinPlanMeasure
+
+    @staticmethod
+    cdef SimilarityJoinPlan make(_SimilarityJoinPlan u):
+        f = <SimilarityJoinPlan>SimilarityJoinPlan.__new__(SimilarityJoinPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _SimilarityJoinPlanAlgorithm:
+        return _SimilarityJoinPlanAlgorithm(self.underlying_.algorithm())
+
+    @property
+    def measure(self) -> _SimilarityJoinPlanMeasure:
+        return _SimilarityJoinPlanMeasure(self.underlying_.measure())
+
+    @property
+    def num_bands(self) -> int:
+        return self.underlying_.num_bands()
+
+    @property
+    def rows_per_band(self) -> int:
+        return self.underlying_.rows_per_band()
+
+    @property
+    def max_bucket_size(self) -> int:
+        return self.underlying_.max_bucket_size()
+
+    @staticmethod
+    def min_hash_lsh(measure = _SimilarityJoinPlanMeasure.Jaccard, uint32_t num_bands = kDefaultNumBands,
+                     uint32_t rows_per_band = kDefaultRowsPerBand,
+                     uint32_t max_bucket_size = kDefaultMaxBucketSize) -> SimilarityJoinPlan:
+        """
+        MinHash locality sensitive hashing
+
+        Nodes whose MinHash values of their out-neighbors agree on all `rows_per_band` rows of one of `num_bands`
+        bands become candidates, and only candidates are compared exactly. Within a bucket of more than
+        `max_bucket_size` nodes, each node is only paired with the next `max_bucket_size` nodes.
+        """
+        cdef int measure_value = _SimilarityJoinPlanMeasure(measure).value
+        return SimilarityJoinPlan.make(_SimilarityJoinPlan.MinHashLsh(
+            <_SimilarityJoinPlan.Measure>measure_value, num_bands, rows_per_band, max_bucket_size))
+
+
+cdef shared_ptr[CTable] handle_result_table(Result[shared_ptr[CTable]] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+def similarity_join(PropertyGraph pg, uint32_t k, SimilarityJoinPlan plan = SimilarityJoinPlan()):
+    """
+    Find, for each node, up to `k` other nodes with the most similar set of out-neighbors. Nodes without out-edges
+    are not compared.
+
+    :type pg: PropertyGraph
+    :param pg: The graph to analyze.
+    :type k: int
+    :param k: The maximum number of neighbors of each node.
+    :type plan: SimilarityJoinPlan
+    :param plan: The execution plan to use.
+    :returns: A `pyarrow.Table` with the columns `source`, `destination` and `similarity`. The rows of each source are
+        consecutive and in order of decreasing similarity.
+    """
+    cdef shared_ptr[CTable] table
+    with nogil:
+        table = handle_result_table(SimilarityJoin(pg.underlying_property_graph(), k, plan.underlying_))
+    return pyarrow_wrap_table(table)
@@ -18,12 +18,15 @@ Single-Source Shortest Path
     :undoc-members:
 
 .. autofunction:: katana.analytics.sssp_assert_valid
+
+.. autofunction:: katana.analytics.batched_sssp
 """
 from enum import Enum
 
 from libc.stddef cimport ptrdiff_t
-from libc.stdint cimport uint64_t
+from libc.stdint cimport uint32_t, uint64_t
 from libcpp.string cimport string
+from libcpp.vector cimport vector
 
 from katana._property_graph cimport PropertyGraph
 from katana.analytics.plan cimport Plan, Statistics, _Plan
@@ -81,6 +84,9 @@ cdef extern from "katana/analytics/sssp/sssp.h" namespace "katana::analytics" no
     Result[void] Sssp(_PropertyGraph* pg, size_t start_node,
         const string& edge_weight_property_name, const string& output_property_name, _SsspPlan plan)
 
+    Result[void] BatchedSssp(_PropertyGraph* pg, const vector[uint32_t]& sources,
+        const string& edge_weight_property_name, const vector[string]& output_property_names, _SsspPlan plan)
+
     Result[void] SsspAssertValid(_PropertyGraph* pg, size_t start_node,
                                  const string& edge_weight_property_name, const string& output_property_name);
 
@@ -279,6 +285,36 @@ def sssp_assert_valid(PropertyGraph pg, size_t start_node, str edge_weight_prope
         handle_result_assert(SsspAssertValid(pg.underlying_property_graph(), start_node, edge_weight_property_name_str, output_property_name_str))
 
 
+def batched_sssp(PropertyGraph pg, sources, str edge_weight_property_name, output_property_names,
+                 SsspPlan plan = SsspPlan()):
+    """
+    Compute the Single-Source Shortest Path on `pg` from each node in `sources`. The path lengths from `sources[i]`
+    are written to the property `output_property_names[i]`. Sources are relaxed together in batches of 16 so that
+    setup and edge scans are shared between them.
+
+    :type pg: PropertyGraph
+    :param pg: The graph to analyze.
+    :type sources: list[int]
+    :param sources: The source nodes.
+    :type edge_weight_property_name: str
+    :param edge_weight_property_name: The input property containing edge weights.
+    :type output_property_names: list[str]
+    :param output_property_names: The output properties to write path lengths into, one per source. These properties
+        must not already exist.
+    :type plan: SsspPlan
+    :param plan: The execution plan to use. Only :py:meth:`SsspPlan.delta_step` and
+        :py:meth:`SsspPlan.delta_step_barrier` are supported. Defaults to heuristically selecting between them.
+    """
+    cdef vector[uint32_t] sources_vec = sources
+    cdef string edge_weight_property_name_str = bytes(edge_weight_property_name, "utf-8")
+    cdef vector[string] output_property_names_vec
+    for name in output_property_names:
+        output_property_names_vec.push_back(bytes(name, "utf-8"))
+    with nogil:
+        handle_result_void(BatchedSssp(pg.underlying_property_graph(), sources_vec, edge_weight_property_name_str,
+                                       output_property_names_vec, plan.underlying_))
+
+
 cdef _SsspStatistics handle_result_SsspStatistics(Result[_SsspStatistics] res) nogil except *:
     if not res.has_value():
         with gil:
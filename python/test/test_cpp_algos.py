@@ -1,6 +1,8 @@
+import heapq
+
 import numpy as np
 import pytest
-from pyarrow import Schema, table
+from pyarrow import Schema, chunked_array, table
 from pytest import approx, raises
 
 from katana import GaloisError
@@ -13,35 +15,80 @@ from katana.analytics import (
     IndependentSetStatistics,
     JaccardPlan,
     JaccardStatistics,
+    KShortestSimplePathsPlan,
     KCoreStatistics,
     KTrussStatistics,
+    LeidenClusteringPlan,
+    LeidenClusteringStatistics,
     LouvainClusteringStatistics,
+    MatrixCompletionPlan,
+    MatrixCompletionStatistics,
+    MaxFlowPlan,
+    MaxFlowStatistics,
+    MinimumSpanningForestPlan,
+    MinimumSpanningForestStatistics,
+    PagerankPlan,
     PagerankStatistics,
+    PartitionStatistics,
+    PersonalizedPagerankPlan,
+    RandomWalksPlan,
+    ReorderPlan,
+    ReorderStatistics,
+    ShortestPathPlan,
+    ShortestPathQuery,
+    SimilarityJoinPlan,
     SsspStatistics,
+    StronglyConnectedComponentsPlan,
+    StronglyConnectedComponentsStatistics,
     TriangleCountPlan,
+    batched_personalized_pagerank,
+    batched_sssp,
     betweenness_centrality,
     bfs,
     bfs_assert_valid,
     connected_components,
     connected_components_assert_valid,
+    find_shortest_path,
     find_edge_sorted_by_dest,
+    incremental_connected_components,
+    incremental_pagerank,
     independent_set,
     independent_set_assert_valid,
     jaccard,
     jaccard_assert_valid,
+    k_shortest_simple_paths,
     k_core,
     k_core_assert_valid,
     k_truss,
     k_truss_assert_valid,
+    leiden_clustering,
+    leiden_clustering_assert_valid,
     local_clustering_coefficient,
+    local_personalized_pagerank,
     louvain_clustering,
     louvain_clustering_assert_valid,
+    matrix_completion,
+    matrix_completion_assert_valid,
+    max_flow,
+    max_flow_assert_valid,
+    minimum_spanning_forest,
+    minimum_spanning_forest_assert_valid,
+    multi_source_bfs,
     pagerank,
     pagerank_assert_valid,
+    partition,
+    partition_assert_valid,
+    personalized_pagerank,
+    random_walks,
+    reorder,
+    reorder_assert_valid,
+    similarity_join,
     sort_all_edges_by_dest,
     sort_nodes_by_degree,
     sssp,
     sssp_assert_valid,
+    strongly_connected_components,
+    strongly_connected_components_assert_valid,
     subgraph_extraction,
     triangle_count,
 )
@@ -126,6 +173,56 @@ def test_bfs(property_graph: PropertyGraph):
     verify_bfs(property_graph, start_node, new_property_id)
 
 
+def bfs_tree_depths(parents: np.ndarray, source: int) -> np.ndarray:
+    """
+    The depth of each node in a BFS parent tree, which is its BFS distance from source.
+    """
+    infinity = np.iinfo(np.uint32).max
+    depths = np.full(len(parents), infinity, dtype=np.uint32)
+    depths[source] = 0
+    frontier = np.array([source])
+    level = 0
+    while len(frontier) > 0:
+        level += 1
+        frontier = np.flatnonzero(np.isin(parents, frontier) & (depths == infinity))
+        depths[frontier] = level
+    return depths
+
+
+def test_multi_source_bfs(property_graph: PropertyGraph):
+    sources = [0, 1, 2]
+    property_names = ["Dist0", "Dist1", "Dist2"]
+
+    multi_source_bfs(property_graph, sources, property_names)
+
+    infinity = np.iinfo(np.uint32).max
+    distances = property_graph.get_node_property("Dist0").to_numpy()
+    assert np.count_nonzero(distances != infinity) == 752
+
+    for source, name in zip(sources, property_names):
+        bfs(property_graph, source, "Parent" + name)
+        parents = property_graph.get_node_property("Parent" + name).to_numpy()
+        distances = property_graph.get_node_property(name).to_numpy()
+        assert np.array_equal(distances, bfs_tree_depths(parents, source))
+
+
+def test_multi_source_bfs_many_sources():
+    # More than 64 sources, so each node has a mask of several words that
+    # different threads may update at once
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+    sources = list(range(0, 130 * 7, 7))
+    assert len(sources) == 130
+    property_names = ["Dist{}".format(source) for source in sources]
+
+    multi_source_bfs(property_graph, sources, property_names)
+
+    for source, name in zip(sources, property_names):
+        bfs(property_graph, source, "Parent" + name)
+        parents = property_graph.get_node_property("Parent" + name).to_numpy()
+        distances = property_graph.get_node_property(name).to_numpy()
+        assert np.array_equal(distances, bfs_tree_depths(parents, source))
+
+
 def test_sssp(property_graph: PropertyGraph):
     property_name = "NewProp"
     weight_name = "workFrom"
@@ -151,6 +248,121 @@ def test_sssp(property_graph: PropertyGraph):
     verify_sssp(property_graph, start_node, new_property_id)
 
 
+def test_batched_sssp(property_graph: PropertyGraph):
+    weight_name = "workFrom"
+    sources = list(range(20))
+    property_names = [f"Dist{source}" for source in sources]
+
+    batched_sssp(property_graph, sources, weight_name, property_names)
+
+    for source, name in zip(sources, property_names):
+        assert property_graph.get_node_property(name)[source].as_py() == 0
+        sssp_assert_valid(property_graph, source, weight_name, name)
+
+    stats = SsspStatistics(property_graph, property_names[0])
+    assert stats.max_distance == 2011.0
+
+
+def undirected_distances(property_graph: PropertyGraph, weights: np.ndarray, landmarks) -> list:
+    """
+    The shortest path distances from each landmark, taking every edge as undirected, and 0 for unreachable nodes.
+    """
+    neighbors = [[] for _ in range(len(property_graph))]
+    for u in range(len(property_graph)):
+        for e in property_graph.edges(u):
+            v = property_graph.get_edge_dest(e)
+            neighbors[u].append((v, weights[e]))
+            neighbors[v].append((u, weights[e]))
+
+    all_distances = []
+    for landmark in landmarks:
+        distances = np.full(len(property_graph), np.inf)
+        distances[landmark] = 0
+        heap = [(0, landmark)]
+        while heap:
+            d, u = heapq.heappop(heap)
+            if d > distances[u]:
+                continue
+            for v, w in neighbors[u]:
+                if d + w < distances[v]:
+                    distances[v] = d + w
+                    heapq.heappush(heap, (d + w, v))
+        distances[np.isinf(distances)] = 0
+        all_distances.append(distances)
+    return all_distances
+
+
+def test_find_shortest_path(property_graph: PropertyGraph):
+    weight_name = "workFrom"
+    source = 0
+
+    sssp(property_graph, source, weight_name, "Dist")
+    distances = property_graph.get_node_property("Dist").to_numpy()
+    weights = property_graph.get_edge_property(weight_name).to_numpy()
+
+    infinity = np.iinfo(distances.dtype).max // 4
+    reachable = [n for n in range(len(distances)) if distances[n] != infinity]
+    query = ShortestPathQuery(property_graph, weight_name)
+    for target in reachable[:: max(1, len(reachable) // 20)]:
+        result = query.find(source, target)
+        assert result.distance == distances[target]
+        assert result.path[0] == source
+        assert result.path[-1] == target
+
+        length = 0
+        for u, v in zip(result.path, result.path[1:]):
+            edges = [e for e in property_graph.edges(u) if property_graph.get_edge_dest(e) == v]
+            length += min(weights[e] for e in edges)
+        assert length == result.distance
+
+    result = find_shortest_path(
+        property_graph, source, reachable[-1], weight_name, plan=ShortestPathPlan.bidirectional_dijkstra()
+    )
+    assert result.distance == distances[reachable[-1]]
+
+    with raises(GaloisError):
+        find_shortest_path(property_graph, source, 0, weight_name, plan=ShortestPathPlan.bidirectional_a_star())
+
+    # Undirected distances from a landmark differ by at most the weight of any edge between two nodes. Halving the
+    # distances from two landmarks keeps the straight line distance between the endpoints of every edge below its
+    # weight, as A* requires.
+    x, y = undirected_distances(property_graph, weights, [source, reachable[len(reachable) // 2]])
+    property_graph.add_node_property(table({"X": x / 2, "Y": y / 2}))
+    a_star = ShortestPathQuery(property_graph, weight_name, ["X", "Y"], plan=ShortestPathPlan.bidirectional_a_star())
+    dijkstra = ShortestPathQuery(property_graph, weight_name, plan=ShortestPathPlan.bidirectional_dijkstra())
+    for target in reachable[:: max(1, len(reachable) // 20)]:
+        a_star_result = a_star.find(source, target)
+        dijkstra_result = dijkstra.find(source, target)
+        assert a_star_result.distance == distances[target]
+        assert a_star_result.distance == dijkstra_result.distance
+        assert a_star_result.path[0] == source
+        assert a_star_result.path[-1] == target
+
+    result = find_shortest_path(property_graph, source, reachable[-1], weight_name, ["X", "Y"])
+    assert result.distance == distances[reachable[-1]]
+
+
+def test_k_shortest_simple_paths(property_graph: PropertyGraph):
+    weight_name = "workFrom"
+    source = 0
+
+    sssp(property_graph, source, weight_name, "Dist")
+    distances = property_graph.get_node_property("Dist").to_numpy()
+    infinity = np.iinfo(distances.dtype).max // 4
+    target = max((n for n in range(len(distances)) if distances[n] != infinity), key=lambda n: distances[n])
+
+    paths = k_shortest_simple_paths(property_graph, source, target, 5, weight_name, plan=KShortestSimplePathsPlan.yen())
+
+    assert 0 < len(paths) <= 5
+    assert paths[0].distance == distances[target]
+    assert [p.distance for p in paths] == sorted(p.distance for p in paths)
+    assert len({tuple(p.path) for p in paths}) == len(paths)
+    for p in paths:
+        assert p.path[0] == source
+        assert p.path[-1] == target
+        assert len(set(p.path)) == len(p.path)
+
+
 def test_jaccard(property_graph: PropertyGraph):
     property_name = "NewProp"
     compare_node = 0
@@ -176,6 +388,39 @@ def test_jaccard(property_graph: PropertyGraph):
     assert similarities[2812] == approx(0.01428571)
 
 
+def test_similarity_join(property_graph: PropertyGraph):
+    k = 5
+
+    def neighbors(node):
+        return {property_graph.get_edge_dest(e) for e in property_graph.edges(node)}
+
+    for measure in (SimilarityJoinPlan.Measure.Jaccard, SimilarityJoinPlan.Measure.Cosine):
+        table = similarity_join(property_graph, k, SimilarityJoinPlan.min_hash_lsh(measure))
+        assert table.column_names == ["source", "destination", "similarity"]
+        assert table.num_rows > 0
+
+        sources = table.column("source").to_pylist()
+        destinations = table.column("destination").to_pylist()
+        similarities = table.column("similarity").to_pylist()
+        rows_per_source = {}
+        for i, (source, destination, similarity) in enumerate(zip(sources, destinations, similarities)):
+            assert source != destination
+            assert 0 < similarity <= 1
+            rows_per_source[source] = rows_per_source.get(source, 0) + 1
+            if i > 0 and sources[i - 1] == source:
+                assert similarities[i - 1] >= similarity
+        assert max(rows_per_source.values()) <= k
+
+        for i in range(0, table.num_rows, max(1, table.num_rows // 20)):
+            a = neighbors(sources[i])
+            b = neighbors(destinations[i])
+            if measure == SimilarityJoinPlan.Measure.Jaccard:
+                expected = len(a & b) / len(a | b)
+            else:
+                expected = len(a & b) / (len(a) * len(b)) ** 0.5
+            assert similarities[i] == approx(expected)
+
+
 def test_jaccard_sorted(property_graph: PropertyGraph):
     sort_all_edges_by_dest(property_graph)
 
@@ -211,6 +456,75 @@ def test_pagerank(property_graph: PropertyGraph):
     assert stats.average_rank == approx(0.5205338001251221, abs=0.001)
 
 
+def test_pagerank_propagation_blocking(property_graph: PropertyGraph):
+    # Small blocks so that the ranks span many blocks
+    pagerank(property_graph, "Blocked", PagerankPlan.propagation_blocking(block_size=64))
+    pagerank(property_graph, "Unblocked", PagerankPlan.propagation_blocking(block_size=property_graph.num_nodes()))
+
+    blocked = PagerankStatistics(property_graph, "Blocked")
+    unblocked = PagerankStatistics(property_graph, "Unblocked")
+
+    assert blocked.max_rank == approx(unblocked.max_rank)
+    assert blocked.min_rank == approx(unblocked.min_rank)
+    assert blocked.average_rank == approx(unblocked.average_rank)
+    assert blocked.min_rank > 0
+
+
+def test_incremental_pagerank(property_graph: PropertyGraph):
+    property_name = "NewProp"
+    plan = PagerankPlan.push_asynchronous()
+
+    pagerank(property_graph, property_name, plan)
+    before = PagerankStatistics(property_graph, property_name)
+
+    incremental_pagerank(property_graph, property_name, [], [], plan)
+    after = PagerankStatistics(property_graph, property_name)
+
+    assert after.max_rank == before.max_rank
+    assert after.average_rank == before.average_rank
+
+    pagerank_assert_valid(property_graph, property_name)
+
+    with raises(GaloisError):
+        incremental_pagerank(property_graph, property_name, [], [], PagerankPlan.pull_topological())
+
+
+def test_personalized_pagerank(property_graph: PropertyGraph):
+    seeds = [0, 1]
+
+    ranks = local_personalized_pagerank(property_graph, seeds)
+    assert len(ranks) > 0
+    assert all(ranks[i][1] >= ranks[i + 1][1] for i in range(len(ranks) - 1))
+    assert sum(rank for _, rank in ranks) <= 1.0 + 1e-5
+
+    personalized_pagerank(property_graph, seeds, "PPR")
+    personalized_pagerank(property_graph, seeds, "PPRPush", PersonalizedPagerankPlan.push_asynchronous())
+    local_values = property_graph.get_node_property("PPR").to_numpy()
+    push_values = property_graph.get_node_property("PPRPush").to_numpy()
+    for node, rank in ranks:
+        assert local_values[node] == approx(rank)
+    assert (local_values > 0).sum() == len(ranks)
+    assert push_values == approx(local_values, abs=1e-2)
+
+
+def test_batched_personalized_pagerank(property_graph: PropertyGraph):
+    seeds = list(range(20))
+    local_names = [f"Local{seed}" for seed in seeds]
+    push_names = [f"Push{seed}" for seed in seeds]
+
+    batched_personalized_pagerank(property_graph, seeds, local_names)
+    batched_personalized_pagerank(
+        property_graph, seeds, push_names, PersonalizedPagerankPlan.push_asynchronous()
+    )
+
+    for seed, local_name, push_name in zip(seeds, local_names, push_names):
+        local_values = property_graph.get_node_property(local_name).to_numpy()
+        push_values = property_graph.get_node_property(push_name).to_numpy()
+        for node, rank in local_personalized_pagerank(property_graph, [seed]):
+            assert local_values[node] == approx(rank)
+        assert push_values == approx(local_values, abs=1e-2)
+
+
 def test_betweenness_centrality_outer(property_graph: PropertyGraph):
     property_name = "NewProp"
 
@@ -245,6 +559,32 @@ def test_betweenness_centrality_level(property_graph: PropertyGraph):
     assert stats.average_centrality == approx(1.3645)
 
 
+def test_betweenness_centrality_adaptive_sampling(property_graph: PropertyGraph, threads_1):
+    # The bound below only holds with probability 1 - delta. Each thread seeds
+    # its sampler with a fixed seed, so with one thread the samples, and so
+    # the outcome, are the same on every run.
+    _ = threads_1
+    property_name = "NewProp"
+    plan = BetweennessCentralityPlan.adaptive_sampling(0.05, 0.1)
+    assert plan.epsilon == approx(0.05)
+    assert plan.delta == approx(0.1)
+
+    betweenness_centrality(property_graph, property_name, plan=plan)
+
+    node_schema: Schema = property_graph.node_schema()
+    num_node_properties = len(node_schema)
+    new_property_id = num_node_properties - 1
+    assert node_schema.names[new_property_id] == property_name
+
+    # Every normalized centrality is within epsilon of the exact one
+    betweenness_centrality(property_graph, "Exact", plan=BetweennessCentralityPlan.level())
+    num_nodes = property_graph.num_nodes()
+    scale = num_nodes * (num_nodes - 1)
+    estimate = property_graph.get_node_property(property_name).to_numpy() / scale
+    exact = property_graph.get_node_property("Exact").to_numpy() / scale
+    assert np.max(np.abs(estimate - exact)) < plan.epsilon
+
+
 def test_triangle_count():
     property_graph = PropertyGraph(get_input("propertygraphs/rmat15_cleaned_symmetric"))
     original_first_edge_list = [property_graph.get_edge_dest(e) for e in property_graph.edges(0)]
@@ -272,6 +612,25 @@ def test_triangle_count_presorted():
     assert n == 282617
 
 
+def test_random_walks():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+    walk_length = 5
+    number_of_walks = 2
+    padding = np.iinfo(np.uint32).max
+
+    walks = random_walks(property_graph, RandomWalksPlan.node2vec(walk_length, number_of_walks))
+
+    num_nodes = property_graph.num_nodes()
+    assert walks.dtype == np.uint32
+    assert walks.shape == (num_nodes * number_of_walks, walk_length + 1)
+    for i in range(0, len(walks), 37):
+        walk = [n for n in walks[i] if n != padding]
+        assert walk[0] == i % num_nodes
+        assert all(n == padding for n in walks[i][len(walk) :])
+        for src, dst in zip(walk, walk[1:]):
+            assert dst in {property_graph.get_edge_dest(e) for e in property_graph.edges(src)}
+
+
 def test_independent_set():
     property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
 
@@ -303,6 +662,236 @@ def test_connected_components():
     connected_components_assert_valid(property_graph, "output")
 
 
+def test_incremental_connected_components():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+
+    connected_components(property_graph, "output")
+
+    # Edges that are already in the graph cannot merge components
+    srcs = [0 for _ in property_graph.edges(0)]
+    dsts = [property_graph.get_edge_dest(e) for e in property_graph.edges(0)]
+    incremental_connected_components(property_graph, "output", srcs, dsts)
+
+    stats = ConnectedComponentsStatistics(property_graph, "output")
+
+    assert stats.total_components == 69
+    assert stats.largest_component_size == 957
+
+    connected_components_assert_valid(property_graph, "output")
+
+    with raises(GaloisError):
+        incremental_connected_components(property_graph, "output", [0], [property_graph.num_nodes()])
+
+
+def test_matrix_completion():
+    # The ratings of 4 items by 6 users are the dot products of latent vectors
+    # of size 2, so they can be approximated closely.
+    item_vectors = np.array([[1, 2], [2, 1], [1, 1], [2, 2]], dtype=np.float64)
+    user_vectors = np.array([[1, 1], [2, 0], [0, 2], [1, 2], [2, 1], [1, 0]], dtype=np.float64)
+    num_items = len(item_vectors)
+    num_users = len(user_vectors)
+    ratings = (item_vectors @ user_vectors.T).flatten()
+    edge_indices = np.array(
+        [num_users * (n + 1) for n in range(num_items)] + [num_items * num_users] * num_users, dtype=np.uint64
+    )
+    edge_destinations = np.array([num_items + u for _ in range(num_items) for u in range(num_users)], dtype=np.uint32)
+
+    for plan in [MatrixCompletionPlan.sgd(), MatrixCompletionPlan.als()]:
+        property_graph = PropertyGraph.from_csr(edge_indices, edge_destinations)
+        property_graph.add_edge_property(table({"rating": ratings}))
+
+        matrix_completion(property_graph, "rating", "latent", 4, plan)
+
+        matrix_completion_assert_valid(property_graph, "latent")
+
+        stats = MatrixCompletionStatistics(property_graph, "rating", "latent")
+        assert stats.latent_dimension == 4
+        assert stats.root_mean_square_error < 0.5
+
+        # The latent vectors and ratings of all chunks of the properties are used
+        latent = property_graph.get_node_property_chunked("latent")
+        split = len(property_graph) // 2
+        latent = chunked_array(latent.slice(0, split).chunks + latent.slice(split).chunks)
+        assert latent.num_chunks > 1
+        property_graph.remove_node_property("latent")
+        property_graph.add_node_property(table({"latent": latent}))
+        rating = property_graph.get_edge_property_chunked("rating")
+        split = len(ratings) // 2
+        rating = chunked_array(rating.slice(0, split).chunks + rating.slice(split).chunks)
+        assert rating.num_chunks > 1
+        property_graph.remove_edge_property("rating")
+        property_graph.add_edge_property(table({"rating": rating}))
+
+        matrix_completion_assert_valid(property_graph, "latent")
+        chunked_stats = MatrixCompletionStatistics(property_graph, "rating", "latent")
+        assert chunked_stats.root_mean_square_error == approx(stats.root_mean_square_error)
+
+    with raises(GaloisError):
+        matrix_completion(property_graph, "rating", "latent", 4)
+
+
+def test_max_flow():
+    # The flow network of Figure 26.1 of Cormen et al., Introduction to Algorithms
+    edge_indices = np.array([2, 3, 5, 7, 9, 9], dtype=np.uint64)
+    edge_destinations = np.array([1, 2, 3, 1, 4, 2, 5, 3, 5], dtype=np.uint32)
+    capacities = np.array([16, 13, 12, 4, 14, 9, 20, 7, 4], dtype=np.int64)
+    property_graph = PropertyGraph.from_csr(edge_indices, edge_destinations)
+    # The capacities of all chunks of the property are used
+    property_graph.add_edge_property(table({"capacity": chunked_array([capacities[:4], capacities[4:]])}))
+
+    flow_value = max_flow(property_graph, 0, 5, "capacity", "flow", "cut")
+    assert flow_value == 23
+
+    max_flow_assert_valid(property_graph, 0, 5, "capacity", "flow", "cut")
+
+    stats = MaxFlowStatistics(property_graph, 0, "flow", "cut")
+    assert stats.flow_value == 23
+
+    with raises(GaloisError):
+        max_flow(property_graph, 0, 0, "capacity", "flow2", "cut2")
+
+
+def test_max_flow_unit_capacities():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+    property_graph.add_edge_property(table({"capacity": np.ones(property_graph.num_edges(), dtype=np.uint32)}))
+    source = 0
+    sink = property_graph.num_nodes() - 1
+
+    flow_value = max_flow(property_graph, source, sink, "capacity", "flow", "cut", MaxFlowPlan.push_relabel(100))
+
+    max_flow_assert_valid(property_graph, source, sink, "capacity", "flow", "cut")
+    assert flow_value <= len(property_graph.edges(source))
+    assert MaxFlowStatistics(property_graph, source, "flow", "cut").flow_value == flow_value
+
+
+def test_minimum_spanning_forest():
+    # The graph of Figure 23.1 of Cormen et al., Introduction to Algorithms, with every edge stored once
+    edge_indices = np.array([2, 4, 7, 9, 10, 11, 13, 14, 14], dtype=np.uint64)
+    edge_destinations = np.array([1, 7, 2, 7, 3, 5, 8, 4, 5, 5, 6, 7, 8, 8], dtype=np.uint32)
+    weights = np.array([4, 8, 8, 11, 7, 4, 2, 9, 14, 10, 2, 1, 6, 7], dtype=np.int32)
+    property_graph = PropertyGraph.from_csr(edge_indices, edge_destinations)
+    # The weights of all chunks of the property are used
+    property_graph.add_edge_property(table({"weight": chunked_array([weights[:7], weights[7:]])}))
+
+    for i, plan in enumerate([MinimumSpanningForestPlan.boruvka(), MinimumSpanningForestPlan.filter_kruskal()]):
+        total_weight = minimum_spanning_forest(property_graph, "weight", f"forest{i}", plan)
+        assert total_weight == 37
+
+        minimum_spanning_forest_assert_valid(property_graph, "weight", f"forest{i}")
+
+        in_forest = property_graph.get_edge_property(f"forest{i}").to_numpy()
+        assert list(in_forest) == [1, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 1, 0, 0]
+
+        stats = MinimumSpanningForestStatistics(property_graph, "weight", f"forest{i}")
+        assert stats.num_forest_edges == 8
+        assert stats.num_trees == 1
+        assert stats.total_weight == 37
+
+
+def test_minimum_spanning_forest_plans_agree():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+    weights = np.arange(property_graph.num_edges(), dtype=np.uint64) % 13 + 1
+    property_graph.add_edge_property(table({"weight": weights}))
+
+    boruvka_weight = minimum_spanning_forest(property_graph, "weight", "boruvka", MinimumSpanningForestPlan.boruvka())
+    filter_kruskal_weight = minimum_spanning_forest(
+        property_graph, "weight", "filter_kruskal", MinimumSpanningForestPlan.filter_kruskal()
+    )
+    assert boruvka_weight == filter_kruskal_weight
+
+    minimum_spanning_forest_assert_valid(property_graph, "weight", "boruvka")
+    minimum_spanning_forest_assert_valid(property_graph, "weight", "filter_kruskal")
+
+    stats = MinimumSpanningForestStatistics(property_graph, "weight", "boruvka")
+    assert stats.num_forest_edges + stats.num_trees == property_graph.num_nodes()
+
+    with raises(GaloisError):
+        minimum_spanning_forest(property_graph, "weight", "boruvka")
+
+
+def test_strongly_connected_components():
+    # The graph of Figure 22.9 of Cormen et al., Introduction to Algorithms
+    edge_indices = np.array([1, 4, 6, 8, 10, 11, 13, 14], dtype=np.uint64)
+    edge_destinations = np.array([1, 2, 4, 5, 3, 6, 2, 7, 0, 5, 6, 5, 7, 7], dtype=np.uint32)
+    property_graph = PropertyGraph.from_csr(edge_indices, edge_destinations)
+
+    plans = [StronglyConnectedComponentsPlan.multistep(), StronglyConnectedComponentsPlan.coloring()]
+    for i, plan in enumerate(plans):
+        strongly_connected_components(property_graph, f"component{i}", plan)
+
+        strongly_connected_components_assert_valid(property_graph, f"component{i}")
+
+        components = property_graph.get_node_property(f"component{i}").to_numpy()
+        assert list(components) == [0, 0, 2, 2, 0, 5, 5, 7]
+
+        stats = StronglyConnectedComponentsStatistics(property_graph, f"component{i}")
+        assert stats.total_components == 4
+        assert stats.total_non_trivial_components == 3
+        assert stats.largest_component_size == 3
+
+
+def test_strongly_connected_components_symmetric():
+    # The strongly connected components of a symmetric graph are its connected components
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+
+    strongly_connected_components(property_graph, "output")
+
+    stats = StronglyConnectedComponentsStatistics(property_graph, "output")
+
+    assert stats.total_components == 69
+    assert stats.total_non_trivial_components == 1
+    assert stats.largest_component_size == 957
+    assert stats.largest_component_ratio == approx(0.93457)
+
+    strongly_connected_components_assert_valid(property_graph, "output")
+
+    with raises(GaloisError):
+        strongly_connected_components(property_graph, "output")
+
+
+def test_partition():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+    num_partitions = 4
+
+    partition(property_graph, num_partitions, "partition")
+
+    partition_assert_valid(property_graph, num_partitions, "partition")
+
+    stats = PartitionStatistics(property_graph, num_partitions, "partition")
+    assert stats.imbalance <= 1.05
+    assert stats.edge_cut < property_graph.num_edges()
+
+
+def test_reorder():
+    plans = [
+        ReorderPlan.reverse_cuthill_mckee(),
+        ReorderPlan.hub_sort(),
+        ReorderPlan.hub_cluster(),
+        ReorderPlan.rabbit(),
+        ReorderPlan.gorder(),
+        ReorderPlan.partitioned(8),
+    ]
+    for plan in plans:
+        property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+        num_nodes = property_graph.num_nodes()
+        num_edges = property_graph.num_edges()
+        connected_components(property_graph, "component")
+
+        reorder(property_graph, "original_id", plan)
+
+        assert property_graph.num_nodes() == num_nodes
+        assert property_graph.num_edges() == num_edges
+        reorder_assert_valid(property_graph, "original_id")
+
+        # The components were permuted along with the topology
+        connected_components_assert_valid(property_graph, "component")
+        stats = ConnectedComponentsStatistics(property_graph, "component")
+        assert stats.total_components == 69
+        assert stats.largest_component_size == 957
+
+        assert ReorderStatistics(property_graph).max_edge_span < num_nodes
+
+
 def test_k_core():
     property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
 
@@ -352,6 +941,19 @@ def test_louvain_clustering():
     # assert stats.largest_cluster_size == 297
 
 
+def test_leiden_clustering():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat10_symmetric"))
+
+    leiden_clustering(property_graph, "value", "output", LeidenClusteringPlan.do_all())
+
+    # Every cluster must be connected
+    leiden_clustering_assert_valid(property_graph, "value", "output")
+
+    stats = LeidenClusteringStatistics(property_graph, "value", "output")
+    assert 0 < stats.n_clusters <= property_graph.num_nodes()
+    assert stats.largest_cluster_size <= property_graph.num_nodes()
+
+
 def test_local_clustering_coefficient():
     property_graph = PropertyGraph(get_input("propertygraphs/rmat15_cleaned_symmetric"))
 